@@ -1,8 +1,12 @@
 #include <iostream>
 #include <unistd.h>
 #include <string>
+#include <set>
 #include "../src/backtest/Backtester.hpp"
+#include "../src/backtest/BacktestFarm.hpp"
+#include "../src/backtest/ResultCache.hpp"
 #include "../src/util/Config.hpp"
+#include "../src/util/Logger.hpp"
 
 void printUsage() {
     std::cout << "AlgoTrader Backtester" << std::endl;
@@ -13,24 +17,139 @@ void printUsage() {
     std::cout << "  --capital <amount>       Set starting capital (default: $100,000)" << std::endl;
     std::cout << "  --commission <amount>    Set commission per trade (default: $1.00)" << std::endl;
     std::cout << "  --slippage <percentage>  Set slippage percentage (default: 0.05%)" << std::endl;
+    std::cout << "  --cost-model <type>      Transaction cost model, flat or tiered (default: cost_model in config, else flat)" << std::endl;
     std::cout << "  --start-date <YYYY-MM-DD> Start date for backtest (default: 7 days ago)" << std::endl;
     std::cout << "  --end-date <YYYY-MM-DD>  End date for backtest (default: today)" << std::endl;
     std::cout << "  --threads <num>          Number of threads to use (default: all available cores)" << std::endl;
     std::cout << "  --detailed               Enable detailed logging during backtest" << std::endl;
+    std::cout << "  --log-level <level>      debug, info, warn, error or off (default: info, debug with --detailed)" << std::endl;
     std::cout << "  --output <filename>      Save results to CSV file" << std::endl;
+    std::cout << "  --seed <num>             Seed for simulated slippage (default: 42)" << std::endl;
+    std::cout << "  --no-cache               Always run and parse the config, ignoring and not storing cached results" << std::endl;
+    std::cout << "  --checkpoint <file>      Checkpoint the simulation to a file as it runs" << std::endl;
+    std::cout << "  --checkpoint-every <num> Bars between checkpoints (default: " << CHECKPOINT_DEFAULT_INTERVAL << ")" << std::endl;
+    std::cout << "  --resume <file>          Continue from a checkpoint, also applies to every --farm job" << std::endl;
+    std::cout << "  --farm <jobs.json>       Run each config override in a JSON array as its own backtest" << std::endl;
+    std::cout << "  --workers <num>          Worker processes for --farm (default: all available cores)" << std::endl;
     std::cout << "  --help                   Display this help message" << std::endl;
 }
 
+std::string daysBefore(const std::string& date, int days) {
+    std::tm dateTm = {};
+    std::istringstream dateStream(date);
+    dateStream >> std::get_time(&dateTm, "%Y-%m-%d");
+    auto timePoint = std::chrono::system_clock::from_time_t(std::mktime(&dateTm)) - std::chrono::hours(24 * days);
+    auto timeT = std::chrono::system_clock::to_time_t(timePoint);
+    std::stringstream ss;
+    ss << std::put_time(std::localtime(&timeT), "%Y-%m-%d");
+    return ss.str();
+}
+
+std::string today() {
+    auto timeT = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    std::stringstream ss;
+    ss << std::put_time(std::localtime(&timeT), "%Y-%m-%d");
+    return ss.str();
+}
+
+int runFarm(const json& algoConfig, const std::string& jobsFile, int workers, BacktestFarm::Configure configure,
+            const std::string& startDate, const std::string& endDate, const std::string& outputFile) {
+    Config jobsConfig;
+    jobsConfig.loadJson(jobsFile);
+    json jobsJson = jobsConfig.getJson();
+    if (!jobsJson.is_array() || jobsJson.empty()) {
+        throw std::runtime_error("Farm jobs file must hold a JSON array of config overrides");
+    }
+    std::vector<json> jobs(jobsJson.begin(), jobsJson.end());
+
+    BacktestFarm farm(algoConfig);
+    farm.setWorkers(workers);
+    farm.setConfigure(configure);
+
+    // Each ticker is loaded once and shared by every worker
+    std::set<std::string> tickers;
+    for (const json& job : jobs) {
+        tickers.insert(farm.tickerOf(job));
+    }
+    DataConfig tickerConfig = DataConfig::fromJson(algoConfig);
+    for (const std::string& ticker : tickers) {
+        tickerConfig.ticker = ticker;
+        MarketData marketData;
+        marketData.processForDateRange(tickerConfig, startDate, endDate);
+        farm.addDataset(ticker, marketData.getData());
+    }
+
+    std::cout << "Running " << jobs.size() << " backtests over " << farm.getDatasetBars() << " bars with "
+              << (workers > 0 ? std::to_string(workers) : "all available") << " workers" << std::endl;
+
+    auto started = std::chrono::steady_clock::now();
+    std::vector<FarmResult> results = farm.run(jobs);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - started;
+
+    std::cout << "\n===== FARM RESULTS =====\n" << std::endl;
+    std::cout << std::left << std::setw(6) << "Job" << std::setw(10) << "Ticker" << std::right
+              << std::setw(8) << "Trades" << std::setw(12) << "PnL %" << std::setw(10) << "Sharpe"
+              << std::setw(12) << "Max DD %" << std::setw(10) << "Win %" << std::setw(10) << "Secs" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    int failed = 0;
+    for (const FarmResult& result : results) {
+        std::cout << std::left << std::setw(6) << result.jobIndex << std::setw(10) << farm.tickerOf(jobs[result.jobIndex]) << std::right;
+        if (result.failed) {
+            std::cout << "  FAILED: " << result.error << std::endl;
+            failed++;
+            continue;
+        }
+        std::cout << std::setw(8) << result.numTrades << std::setw(12) << result.totalPnLPercent
+                  << std::setw(10) << result.sharpeRatio << std::setw(12) << result.maxDrawdownPercent
+                  << std::setw(10) << result.winRate << std::setw(10) << result.executionSeconds << std::endl;
+    }
+    std::cout << "\n" << results.size() << " backtests in " << elapsed.count() << " seconds";
+    if (failed > 0) {
+        std::cout << ", " << failed << " failed";
+    }
+    std::cout << std::endl;
+
+    if (!outputFile.empty()) {
+        std::ofstream file(outputFile);
+        if (!file) {
+            throw std::runtime_error("Failed to open output file: " + outputFile);
+        }
+        file << "job,ticker,failed,bars,trades,final_equity,pnl,pnl_percent,sharpe,max_drawdown_percent,win_rate,profit_factor,seconds,error,overrides\n";
+        for (const FarmResult& result : results) {
+            std::string overrides = jobs[result.jobIndex].dump();
+            std::replace(overrides.begin(), overrides.end(), '"', '\'');
+            std::string error = result.error;
+            std::replace(error.begin(), error.end(), '"', '\'');
+            file << result.jobIndex << "," << farm.tickerOf(jobs[result.jobIndex]) << "," << result.failed << ","
+                 << result.barCount << "," << result.numTrades << "," << result.finalEquity << ","
+                 << result.totalPnL << "," << result.totalPnLPercent << "," << result.sharpeRatio << ","
+                 << result.maxDrawdownPercent << "," << result.winRate << "," << result.profitFactor << ","
+                 << result.executionSeconds << ",\"" << error << "\",\"" << overrides << "\"\n";
+        }
+        std::cout << "Farm results saved to " << outputFile << std::endl;
+    }
+    return failed == 0 ? 0 : 1;
+}
+
 int main(int argc, char* argv[]) {
     // Default settings
     double startingCapital = 100000.0;
     double commission = 1.0;
     double slippage = 0.0005;
+    std::string costModelType = "";
     bool detailedLogging = false;
     std::string outputFile = "";
     std::string startDate = "";
     std::string endDate = "";
     int numThreads = 0;  // 0 means use all available cores
+    std::string logLevel = "";
+    std::string farmFile = "";
+    int numWorkers = 0;     // 0 means one per core
+    unsigned int seed = 42;
+    bool useCache = true;
+    std::string checkpointFile = "";
+    size_t checkpointEvery = CHECKPOINT_DEFAULT_INTERVAL;
+    std::string resumeFile = "";
     
     // Parse command line arguments
     for (int i = 1; i < argc; i++) {
@@ -45,8 +164,12 @@ int main(int argc, char* argv[]) {
             commission = std::stod(argv[++i]);
         } else if (arg == "--slippage" && i + 1 < argc) {
             slippage = std::stod(argv[++i]) / 100.0; // Convert from percentage
+        } else if (arg == "--cost-model" && i + 1 < argc) {
+            costModelType = argv[++i];
         } else if (arg == "--detailed") {
             detailedLogging = true;
+        } else if (arg == "--log-level" && i + 1 < argc) {
+            logLevel = argv[++i];
         } else if (arg == "--output" && i + 1 < argc) {
             outputFile = argv[++i];
         } else if (arg == "--start-date" && i + 1 < argc) {
@@ -55,6 +178,20 @@ int main(int argc, char* argv[]) {
             endDate = argv[++i];
         } else if (arg == "--threads" && i + 1 < argc) {
             numThreads = std::stoi(argv[++i]);
+        } else if (arg == "--seed" && i + 1 < argc) {
+            seed = static_cast<unsigned int>(std::stoul(argv[++i]));
+        } else if (arg == "--no-cache") {
+            useCache = false;
+        } else if (arg == "--checkpoint" && i + 1 < argc) {
+            checkpointFile = argv[++i];
+        } else if (arg == "--checkpoint-every" && i + 1 < argc) {
+            checkpointEvery = std::stoul(argv[++i]);
+        } else if (arg == "--resume" && i + 1 < argc) {
+            resumeFile = argv[++i];
+        } else if (arg == "--farm" && i + 1 < argc) {
+            farmFile = argv[++i];
+        } else if (arg == "--workers" && i + 1 < argc) {
+            numWorkers = std::stoi(argv[++i]);
         } else {
             std::cerr << "Unknown argument: " << arg << std::endl;
             printUsage();
@@ -63,50 +200,91 @@ int main(int argc, char* argv[]) {
     }
     
     try {
-        // Load configuration
+        if (!logLevel.empty()) {
+            Logger::setLevel(stringToLogLevel(logLevel));
+        } else if (detailedLogging) {
+            Logger::setLevel(LogLevel::DEBUG);
+        }
+
+        // Load configuration, parsed once and cached unless --no-cache
         Config config;
-        json algoConfig = config.loadConfig();
+        AppConfig algoConfig = config.loadAppConfig(useCache);
         
+        // The flat model is what --commission and --slippage configure, any
+        // other model replaces it using its parameters from the config
+        CostModelConfig costConfig = algoConfig.broker.costModel.value_or(CostModelConfig{});
+        if (!costModelType.empty()) {
+            costConfig.type = costModelType;
+        }
+
+        // Shared by the single run and every farm job, so farm jobs can each
+        // branch from the same warmed up checkpoint
+        auto configure = [&](Backtester& backtester) {
+            backtester.setStartingCapital(startingCapital);
+            backtester.setCommissionPerTrade(commission);
+            backtester.setSlippagePercentage(slippage);
+            if (costConfig.type != "flat") {
+                backtester.setCostModel(makeCostModel(costConfig));
+            }
+            if (!resumeFile.empty()) {
+                backtester.resumeFrom(resumeFile);
+            }
+        };
+
+        // Either end of the date range defaults to 7 days from the other
+        if (!startDate.empty() && endDate.empty()) {
+            endDate = today();
+        } else if (startDate.empty() && !endDate.empty()) {
+            startDate = daysBefore(endDate, 7);
+        }
+
+        if (!farmFile.empty()) {
+            if (startDate.empty()) {
+                endDate = today();
+                startDate = daysBefore(endDate, 7);
+            }
+            // Jobs override the config as JSON
+            return runFarm(config.loadConfig(), farmFile, numWorkers, configure, startDate, endDate, outputFile);
+        }
+
         // Create and configure backtester
         Backtester backtester(algoConfig);
-        backtester.setStartingCapital(startingCapital);
-        backtester.setCommissionPerTrade(commission);
-        backtester.setSlippagePercentage(slippage);
+        configure(backtester);
         backtester.enableDetailedLogging(detailedLogging);
         backtester.setNumThreads(numThreads);
+        backtester.setRandomSeed(seed);
+
+        // Identical reruns come straight from the cache
+        std::unique_ptr<ResultCache> cache;
+        if (useCache) {
+            uint64_t maxMb = algoConfig.backtest.resultCacheMaxMb.value_or(RESULT_CACHE_DEFAULT_MAX_MB);
+            cache = std::make_unique<ResultCache>(config.getAbsolutePath(algoConfig.backtest.resultCacheDir.value_or(RESULT_CACHE_DEFAULT_DIR)),
+                                                  maxMb * 1024 * 1024);
+            backtester.setResultCache(cache.get());
+        }
         
         // Set date range if provided
-        if (!startDate.empty() && !endDate.empty()) {
+        if (!startDate.empty()) {
             backtester.setDateRange(startDate, endDate);
-        } else if (!startDate.empty()) {
-            // Get current date for end date
-            auto now = std::chrono::system_clock::now();
-            auto timeT = std::chrono::system_clock::to_time_t(now);
-            std::stringstream ss;
-            ss << std::put_time(std::localtime(&timeT), "%Y-%m-%d");
-            backtester.setDateRange(startDate, ss.str());
-        } else if (!endDate.empty()) {
-            // Calculate start date (7 days before end date)
-            std::tm endTm = {};
-            std::istringstream endDateStream(endDate);
-            endDateStream >> std::get_time(&endTm, "%Y-%m-%d");
-            auto endTimePoint = std::chrono::system_clock::from_time_t(std::mktime(&endTm));
-            auto startTimePoint = endTimePoint - std::chrono::hours(24 * 7);
-            auto startTimeT = std::chrono::system_clock::to_time_t(startTimePoint);
-            std::stringstream ss;
-            ss << std::put_time(std::localtime(&startTimeT), "%Y-%m-%d");
-            backtester.setDateRange(ss.str(), endDate);
         }
         
         if (!outputFile.empty()) {
             backtester.saveResultsToFile(outputFile);
         }
+
+        if (!checkpointFile.empty()) {
+            backtester.setCheckpointFile(checkpointFile, checkpointEvery);
+        }
         
         // Run backtest
         std::cout << "Starting backtest with:" << std::endl;
         std::cout << "- Starting capital: $" << startingCapital << std::endl;
-        std::cout << "- Commission per trade: $" << commission << std::endl;
-        std::cout << "- Slippage: " << (slippage * 100.0) << "%" << std::endl;
+        if (costConfig.type == "flat") {
+            std::cout << "- Commission per trade: $" << commission << std::endl;
+            std::cout << "- Slippage: " << (slippage * 100.0) << "%" << std::endl;
+        } else {
+            std::cout << "- Cost model: " << costConfig.type << std::endl;
+        }
         std::cout << "- Threads: " << (numThreads > 0 ? std::to_string(numThreads) : "all available") << std::endl;
         
         backtester.run();
@@ -0,0 +1,104 @@
+#include <iostream>
+#include <string>
+#include <chrono>
+#include <algorithm>
+#include "../src/broker/LoopbackBroker.hpp"
+
+void printUsage() {
+    std::cout << "AlgoTrader Loopback Latency Test" << std::endl;
+    std::cout << "--------------------------------" << std::endl;
+    std::cout << "Sends orders to a running exchange_sim and reports round trip latency" << std::endl;
+    std::cout << std::endl;
+    std::cout << "Options:" << std::endl;
+    std::cout << "  --port <port>            Exchange simulator port (default: " << ExchangeProtocol::DEFAULT_PORT << ")" << std::endl;
+    std::cout << "  --orders <num>           Number of orders to send (default: 10000)" << std::endl;
+    std::cout << "  --ticker <symbol>        Ticker to trade (default: NVDA)" << std::endl;
+    std::cout << "  --window <num>           Max orders in flight at once (default: 64, 1 = ping-pong)" << std::endl;
+    std::cout << "  --help                   Display this help message" << std::endl;
+}
+
+double percentileMicros(std::vector<uint64_t> latencies, double percentile) {
+    if (latencies.empty()) return 0.0;
+    size_t index = static_cast<size_t>(percentile / 100.0 * (latencies.size() - 1));
+    std::nth_element(latencies.begin(), latencies.begin() + index, latencies.end());
+    return latencies[index] / 1000.0;
+}
+
+void printLatencies(const std::string& label, const std::vector<uint64_t>& latencies) {
+    std::cout << label << " (us): "
+              << "p50=" << percentileMicros(latencies, 50)
+              << " p90=" << percentileMicros(latencies, 90)
+              << " p99=" << percentileMicros(latencies, 99)
+              << " max=" << percentileMicros(latencies, 100) << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    uint16_t port = ExchangeProtocol::DEFAULT_PORT;
+    int numOrders = 10000;
+    std::string ticker = "NVDA";
+    size_t window = 64;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+
+        if (arg == "--help") {
+            printUsage();
+            return 0;
+        } else if (arg == "--port" && i + 1 < argc) {
+            port = static_cast<uint16_t>(std::stoi(argv[++i]));
+        } else if (arg == "--orders" && i + 1 < argc) {
+            numOrders = std::stoi(argv[++i]);
+        } else if (arg == "--ticker" && i + 1 < argc) {
+            ticker = argv[++i];
+        } else if (arg == "--window" && i + 1 < argc) {
+            window = std::max(1, std::stoi(argv[++i]));
+        } else {
+            std::cerr << "Unknown argument: " << arg << std::endl;
+            printUsage();
+            return 1;
+        }
+    }
+
+    LoopbackBroker broker("127.0.0.1", port);
+    if (!broker.connect()) {
+        return 1;
+    }
+
+    float price = broker.getLatestPrice(ticker);
+    auto startTime = std::chrono::steady_clock::now();
+
+    BrokerEvent event;
+    int sent = 0;
+    while (sent < numOrders) {
+        // Keep the pipe full without outrunning the broker's event queue
+        while (sent < numOrders && broker.getInFlightCount() < window) {
+            // Alternate sides so the simulated position stays flat
+            OrderType type = (sent % 2 == 0) ? OrderType::BUY : OrderType::SELL;
+            if (!broker.placeOrder(Order(type, ticker, 1, price))) {
+                std::cerr << "Connection lost after " << sent << " orders" << std::endl;
+                return 1;
+            }
+            sent++;
+        }
+        while (broker.pollEvent(event)) {}
+    }
+
+    if (!broker.waitUntilIdle()) {
+        std::cerr << "Timed out waiting for " << broker.getInFlightCount() << " orders" << std::endl;
+    }
+    while (broker.pollEvent(event)) {}
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+
+    std::cout << "\n===== LOOPBACK LATENCY =====\n" << std::endl;
+    std::cout << "Orders sent: " << numOrders << " (window " << window << ")" << std::endl;
+    std::cout << "Fills: " << broker.getFillLatencies().size()
+              << ", rejects: " << broker.getRejectCount() << std::endl;
+    std::cout << "Throughput: " << (numOrders / elapsed.count()) << " orders/s" << std::endl;
+    printLatencies("Send -> ack", broker.getAckLatencies());
+    printLatencies("Send -> fill", broker.getFillLatencies());
+    std::cout << "\n============================\n" << std::endl;
+
+    broker.disconnect();
+    return 0;
+}
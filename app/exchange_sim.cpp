@@ -0,0 +1,71 @@
+#include <iostream>
+#include <string>
+#include <csignal>
+#include "../src/broker/ExchangeSimulator.hpp"
+#include "../src/util/Config.hpp"
+
+static ExchangeSimulator* activeSimulator = nullptr;
+
+void handleSignal(int signal) {
+    if (activeSimulator != nullptr) {
+        activeSimulator->stop();
+    }
+}
+
+void printUsage() {
+    std::cout << "AlgoTrader Loopback Exchange Simulator" << std::endl;
+    std::cout << "--------------------------------------" << std::endl;
+    std::cout << "Matches orders from LoopbackBroker with the SimulatedBroker logic" << std::endl;
+    std::cout << std::endl;
+    std::cout << "Options:" << std::endl;
+    std::cout << "  --port <port>            Port to listen on (default: " << ExchangeProtocol::DEFAULT_PORT << ")" << std::endl;
+    std::cout << "  --data <file>            Market data CSV to match against (default: today's file from config)" << std::endl;
+    std::cout << "  --help                   Display this help message" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    uint16_t port = ExchangeProtocol::DEFAULT_PORT;
+    std::string dataFile = "";
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+
+        if (arg == "--help") {
+            printUsage();
+            return 0;
+        } else if (arg == "--port" && i + 1 < argc) {
+            port = static_cast<uint16_t>(std::stoi(argv[++i]));
+        } else if (arg == "--data" && i + 1 < argc) {
+            dataFile = argv[++i];
+        } else {
+            std::cerr << "Unknown argument: " << arg << std::endl;
+            printUsage();
+            return 1;
+        }
+    }
+
+    try {
+        MarketData marketData;
+        if (!dataFile.empty()) {
+            marketData.loadData(dataFile);
+        } else {
+            Config config;
+            AppConfig algoConfig = config.loadAppConfig();
+            marketData.process(algoConfig.data);
+        }
+
+        ExchangeSimulator simulator(marketData);
+        activeSimulator = &simulator;
+        std::signal(SIGINT, handleSignal);
+        std::signal(SIGTERM, handleSignal);
+
+        simulator.listen(port);
+        simulator.run();
+
+        activeSimulator = nullptr;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
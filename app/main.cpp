@@ -1,29 +1,157 @@
 #include <iostream>
-#include <unistd.h> 
+#include <csignal>
+#include <filesystem>
+#include <memory>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
 #include "../src/data_access/MarketData.hpp"
+#include "../src/data_access/CSVFollower.hpp"
+#include "../src/data_access/SharedBarRing.hpp"
 #include "../src/strategy_engine/StrategyEngine.hpp"
 #include "../src/strategy_engine/StrategyFactory.hpp"
 #include "../src/broker/SimulatedBroker.hpp"
-
-#define MIN_PER_RUN 1
+#include "../src/util/EventLoop.hpp"
+#include "../src/util/Logger.hpp"
 
 using namespace std;
 
+// Datagram socket on localhost, any message on it announces a new bar
+static int
+openBarSocket(int port)
+{
+    int fd = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        throw std::runtime_error("Could not create bar notification socket");
+    }
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        close(fd);
+        throw std::runtime_error("Could not bind bar notification socket to port " + std::to_string(port));
+    }
+    return fd;
+}
+
 int main()
 {
     Config config;
-    json algoConfig = config.loadConfig();
-    MarketData marketData;
-    marketData.process(algoConfig);
-    StrategyFactory stratFactory(algoConfig);
+    AppConfig algoConfig = config.loadAppConfig();
+    MarketData marketData;     // Filled as bars arrive, the source may not exist yet
+    StrategyFactory stratFactory(algoConfig.strategies);
     StrategyEngine stratEngine;
     SimulatedBroker broker(marketData); // Change this to IBKR
+    if (algoConfig.broker.costModel) {
+        broker.setCostModel(makeCostModel(*algoConfig.broker.costModel));
+    }
 
     stratEngine.setUp(algoConfig, stratFactory, marketData, &broker);
-    while (true)
-    {
+
+    // Rebuild the book from the last run, then journal this one
+    OrderJournal journal(config.getAbsolutePath(algoConfig.broker.journalPath));
+    stratEngine.getOms()->attachJournal(&journal);
+
+    // Strategies run once per new bar. Bars arrive by tailing the day's file
+    // as it is appended to, or straight from the downloader's shared memory
+    // ring when market_data_source is "shared_memory". The bar boundary and
+    // the bar socket also check for bars in case a write was missed.
+    EventLoop loop;
+    Timestamp lastBar;
+
+    // Indicator state is carried over from the last run, so the first bar
+    // can signal without waiting for the indicators to warm up again
+    std::string snapshotPath = config.getAbsolutePath(algoConfig.live.strategySnapshotPath);
+    int snapshotInterval = algoConfig.live.strategySnapshotInterval.value_or(STRATEGY_SNAPSHOT_DEFAULT_INTERVAL);
+    int barsSinceSnapshot = 0;
+
+    bool sharedMemory = algoConfig.data.source == "shared_memory";
+    std::string sharedName = algoConfig.data.sharedBarsName.value_or(SHARED_BARS_DEFAULT_NAME);
+    std::unique_ptr<SharedBarReader> sharedBars;
+    std::unique_ptr<CSVFollower> follower;
+
+    auto onBar = [&](const char* source) {
+        if (marketData.isEmpty()) return;
+
+        MarketCondition bar = marketData.getCurrentData();
+        if (bar.Time == lastBar) return;
+        lastBar = bar.Time;
+
         stratEngine.run();
-        sleep(60*MIN_PER_RUN);
+
+        // The startup pass runs before the loop has woken, there is no signal to measure from
+        if (loop.getWakeTime() > 0) {
+            int64_t latency = OrderLifecycle::now() - loop.getWakeTime();
+            LOG_INFO("Bar {} ({}): signal to order {:.1f} us", bar.DateTime, source, latency / 1000.0);
+        } else {
+            LOG_INFO("Bar {} ({})", bar.DateTime, source);
+        }
+
+        if (snapshotInterval > 0 && ++barsSinceSnapshot >= snapshotInterval) {
+            stratEngine.saveSnapshot(snapshotPath);
+            barsSinceSnapshot = 0;
+        }
+    };
+
+    auto readBars = [&]() {
+        if (!sharedMemory) {
+            follower->follow(marketData.generateFilePath(algoConfig.data), marketData);
+        } else if (sharedBars) {
+            sharedBars->poll(marketData);
+        } else {
+            // The writer may start after the engine
+            try {
+                sharedBars = std::make_unique<SharedBarReader>(sharedName);
+                sharedBars->poll(marketData);
+            } catch (const std::exception& e) {
+                LOG_WARN("No shared bar ring yet: {}", e.what());
+            }
+        }
+    };
+
+    auto checkForBars = [&](const char* source) {
+        readBars();
+        onBar(source);
+    };
+
+    if (!sharedMemory) {
+        std::string filePrefix = algoConfig.data.baseDataFileName + "_" + algoConfig.data.ticker + "_";
+        std::filesystem::path dataDirectory = std::filesystem::path(marketData.generateFilePath(algoConfig.data)).parent_path();
+        follower = std::make_unique<CSVFollower>(dataDirectory.string(), filePrefix);
+        loop.addReader(follower->getFd(), [&]() {
+            if (follower->poll(marketData) > 0) onBar("file");
+        });
     }
+
+    int64_t barSeconds = intervalToSeconds(algoConfig.data.collectInterval);
+    loop.addTimer(std::chrono::seconds(barSeconds), [&]() { checkForBars("timer"); });
+
+    int barSocket = -1;
+    if (algoConfig.data.barNotifyPort) {
+        barSocket = openBarSocket(*algoConfig.data.barNotifyPort);
+        loop.addReader(barSocket, [&]() {
+            char message[256];
+            while (recv(barSocket, message, sizeof(message), 0) >= 0) {}
+            checkForBars("socket");
+        });
+    }
+
+    loop.addSignal(SIGINT, [&loop]() { loop.stop(); });
+    loop.addSignal(SIGTERM, [&loop]() { loop.stop(); });
+
+    // The snapshot is checked against the data already on hand
+    readBars();
+    stratEngine.loadSnapshot(snapshotPath);
+    onBar("startup");
+    loop.run();
+
+    std::cout << "Shutting down" << std::endl;
+    stratEngine.saveSnapshot(snapshotPath);
+    Logger::get().flush();
+    journal.sync();
+    if (barSocket >= 0) close(barSocket);
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,118 @@
+#include <iostream>
+#include <string>
+#include <chrono>
+#include <csignal>
+#include <thread>
+#include "../src/broker/FakeTwsGateway.hpp"
+#include "../src/broker/IBKR.hpp"
+
+static FakeTwsGateway* activeGateway = nullptr;
+
+void handleSignal(int signal) {
+    if (activeGateway != nullptr) {
+        activeGateway->stop();
+    }
+}
+
+void printUsage() {
+    std::cout << "AlgoTrader TWS Session Replay" << std::endl;
+    std::cout << "-----------------------------" << std::endl;
+    std::cout << "Replays a recorded TWS session through FakeTwsGateway. By default an IBKR" << std::endl;
+    std::cout << "client is connected in-process and message throughput is reported." << std::endl;
+    std::cout << std::endl;
+    std::cout << "Options:" << std::endl;
+    std::cout << "  --session <file>         Recorded session to replay (required)" << std::endl;
+    std::cout << "  --serve <port>           Only serve the session on this port, for an external client" << std::endl;
+    std::cout << "  --ticker <symbol>        Ticker to subscribe to (default: AAPL)" << std::endl;
+    std::cout << "  --help                   Display this help message" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    std::string sessionFile = "";
+    std::string ticker = "AAPL";
+    int servePort = -1;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+
+        if (arg == "--help") {
+            printUsage();
+            return 0;
+        } else if (arg == "--session" && i + 1 < argc) {
+            sessionFile = argv[++i];
+        } else if (arg == "--serve" && i + 1 < argc) {
+            servePort = std::stoi(argv[++i]);
+        } else if (arg == "--ticker" && i + 1 < argc) {
+            ticker = argv[++i];
+        } else {
+            std::cerr << "Unknown argument: " << arg << std::endl;
+            printUsage();
+            return 1;
+        }
+    }
+
+    if (sessionFile.empty()) {
+        std::cerr << "A session file is required" << std::endl;
+        printUsage();
+        return 1;
+    }
+
+    try {
+        FakeTwsGateway gateway;
+        gateway.loadSession(sessionFile);
+
+        if (servePort >= 0) {
+            activeGateway = &gateway;
+            std::signal(SIGINT, handleSignal);
+            std::signal(SIGTERM, handleSignal);
+
+            uint16_t port = gateway.listen(static_cast<uint16_t>(servePort));
+            std::cout << "FakeTwsGateway replaying " << sessionFile << " on 127.0.0.1:" << port << std::endl;
+            gateway.run();
+
+            activeGateway = nullptr;
+            return gateway.getMismatchCount() == 0 ? 0 : 1;
+        }
+
+        uint16_t port = gateway.listen(0);
+        std::thread gatewayThread([&gateway]() { gateway.run(); });
+
+        IBKR broker("127.0.0.1", port);
+        if (!broker.connect()) {
+            gateway.stop();
+            gatewayThread.join();
+            return 1;
+        }
+
+        auto startTime = std::chrono::steady_clock::now();
+        uint64_t startCount = broker.getMessagesReceived();
+
+        // Subscribing kicks off the recorded stream
+        broker.getLatestPrice(ticker);
+        BrokerEvent event;
+        while (!gateway.isFinished() || broker.getMessagesReceived() < gateway.getMessagesSent()) {
+            while (broker.pollEvent(event)) {}
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+        uint64_t messages = broker.getMessagesReceived() - startCount;
+
+        std::cout << "\n===== TWS REPLAY =====\n" << std::endl;
+        std::cout << "Session: " << sessionFile << std::endl;
+        std::cout << "Messages received: " << messages << std::endl;
+        std::cout << "Elapsed: " << elapsed.count() << " s" << std::endl;
+        std::cout << "Throughput: " << (messages / elapsed.count()) << " messages/s" << std::endl;
+        std::cout << "Last " << ticker << " price: " << broker.getLatestPrice(ticker) << std::endl;
+        std::cout << "Script mismatches: " << gateway.getMismatchCount() << std::endl;
+        std::cout << "\n======================\n" << std::endl;
+
+        broker.disconnect();
+        gateway.stop();
+        gatewayThread.join();
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,70 @@
+#include <benchmark/benchmark.h>
+#include "BenchmarkData.hpp"
+#include "../src/backtest/Backtester.hpp"
+#include "../src/backtest/BacktestMarketDataAdapter.hpp"
+
+static json
+makeBacktestConfig()
+{
+    return json::parse(R"({
+        "ticker": "NVDA",
+        "collectInterval": "1m",
+        "max_position_size": 10,
+        "max_exposure": 5.0,
+        "slippage_tolerance": 2.0,
+        "strategies": [{
+            "name": "RSI",
+            "active": 1,
+            "period": 14,
+            "overbought_threshold": 70.0,
+            "oversold_threshold": 30.0,
+            "stop_loss": 5,
+            "take_profit": 10
+        }]
+    })");
+}
+
+static void
+BM_BacktestMarketDataAdapterNext(benchmark::State& state)
+{
+    // A full pass over range(0) bars
+    size_t bars = static_cast<size_t>(state.range(0));
+    std::vector<MarketCondition> data = makeSyntheticBars(bars);
+
+    QuietOutput quiet;
+    MarketData marketData;
+    BacktestMarketDataAdapter adapter;
+    adapter.initialize(marketData);
+    adapter.loadMockData(data);
+
+    for (auto _ : state) {
+        adapter.rewind();
+        while (adapter.hasNext()) {
+            adapter.next();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * bars);
+}
+BENCHMARK(BM_BacktestMarketDataAdapterNext)->Arg(1000)->Apply(addBacktestSizes)->Unit(benchmark::kMillisecond);
+
+static void
+BM_BacktesterRun(benchmark::State& state)
+{
+    size_t bars = static_cast<size_t>(state.range(0));
+    std::vector<MarketCondition> data = makeSyntheticBars(bars);
+    json config = makeBacktestConfig();
+
+    QuietOutput quiet;
+    for (auto _ : state) {
+        state.PauseTiming();
+        Backtester backtester(config);
+        backtester.setMarketData(data);
+        backtester.setEquityCurveInterval(0);
+        state.ResumeTiming();
+
+        backtester.run();
+        benchmark::DoNotOptimize(backtester.getPerformanceMetrics().finalEquity);
+    }
+    state.SetItemsProcessed(state.iterations() * bars);
+}
+BENCHMARK(BM_BacktesterRun)->Arg(1000)->Apply(addBacktestSizes)->Unit(benchmark::kMillisecond)->Iterations(1);
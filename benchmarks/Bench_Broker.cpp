@@ -0,0 +1,30 @@
+#include <benchmark/benchmark.h>
+#include "BenchmarkData.hpp"
+#include "../src/broker/SimulatedBroker.hpp"
+
+static void
+BM_SimulatedBrokerProcess(benchmark::State& state)
+{
+    // One bar with a fill against range(0) bars of history
+    std::vector<MarketCondition> bars = makeSyntheticBars(static_cast<size_t>(state.range(0)));
+    MarketData marketData;
+    marketData.update(bars);
+
+    QuietOutput quiet;
+    SimulatedBroker broker(marketData);
+    broker.enableFixedRandomSeed(42);
+
+    Order buy{OrderType::BUY, BENCHMARK_TICKER, 1.0f, bars.front().Close};
+    Order sell{OrderType::SELL, BENCHMARK_TICKER, 1.0f, bars.front().Close};
+    BrokerEvent event;
+    bool buying = true;
+
+    for (auto _ : state) {
+        broker.placeOrder(buying ? buy : sell);
+        broker.process();
+        while (broker.pollEvent(event)) {}
+        buying = !buying;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SimulatedBrokerProcess)->Arg(100)->Arg(10000)->Arg(100000);
@@ -0,0 +1,83 @@
+#include <benchmark/benchmark.h>
+#include "BenchmarkData.hpp"
+#include "../src/data_access/CSVParser.hpp"
+#include "../src/data_access/DataStitcher.hpp"
+
+static void
+BM_CSVParserRead(benchmark::State& state)
+{
+    size_t bars = static_cast<size_t>(state.range(0));
+    ScratchDirectory directory("csv");
+    std::string file = (directory.getPath() / "marketData_NVDA.csv").string();
+
+    QuietOutput quiet;
+    DataStitcher(directory.getPath().string(), BENCHMARK_TICKER).saveStitchedData(makeSyntheticBars(bars), file);
+    size_t bytes = fs::file_size(file);
+
+    for (auto _ : state) {
+        CSVParser parser;
+        parser.Read(file);
+        benchmark::DoNotOptimize(parser.GetData().data());
+    }
+    state.SetItemsProcessed(state.iterations() * bars);
+    state.SetBytesProcessed(state.iterations() * bytes);
+}
+BENCHMARK(BM_CSVParserRead)->Arg(10000)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+static void
+BM_DataStitcherGetStitchedData(benchmark::State& state)
+{
+    // One file per trading day, as the data collector writes them
+    size_t bars = static_cast<size_t>(state.range(0));
+    ScratchDirectory directory("stitch");
+    std::vector<MarketCondition> all = makeSyntheticBars(bars);
+
+    QuietOutput quiet;
+    DataStitcher stitcher(directory.getPath().string(), BENCHMARK_TICKER);
+    for (size_t start = 0; start < all.size(); start += BARS_PER_DAY) {
+        std::vector<MarketCondition> day(all.begin() + start, all.begin() + std::min(all.size(), start + BARS_PER_DAY));
+        std::string date = day.front().Time.formatDate();
+        stitcher.saveStitchedData(day, (directory.getPath() / ("marketData_NVDA_" + date + ".csv")).string());
+    }
+    std::string startDate = all.front().Time.formatDate();
+    std::string endDate = all.back().Time.formatDate();
+
+    for (auto _ : state) {
+        std::vector<MarketCondition> stitched = stitcher.getStitchedData(startDate, endDate);
+        benchmark::DoNotOptimize(stitched.data());
+    }
+    state.SetItemsProcessed(state.iterations() * bars);
+}
+BENCHMARK(BM_DataStitcherGetStitchedData)->Arg(10000)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+static void
+BM_TimestampParse(benchmark::State& state)
+{
+    std::vector<MarketCondition> bars = makeSyntheticBars(BARS_PER_DAY);
+
+    for (auto _ : state) {
+        for (const MarketCondition& bar : bars) {
+            benchmark::DoNotOptimize(Timestamp::parse(bar.DateTime));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * bars.size());
+}
+BENCHMARK(BM_TimestampParse);
+
+static void
+BM_SortUniqueByTime(benchmark::State& state)
+{
+    // Two overlapping files worth of bars, as the stitcher merges them
+    size_t bars = static_cast<size_t>(state.range(0));
+    std::vector<MarketCondition> all = makeSyntheticBars(bars);
+    std::vector<MarketCondition> merged(all.begin() + bars / 2, all.end());
+    merged.insert(merged.end(), all.begin(), all.end());
+
+    for (auto _ : state) {
+        std::vector<MarketCondition> copy = merged;
+        sortUniqueByTime(copy);
+        benchmark::DoNotOptimize(copy.data());
+    }
+    state.SetItemsProcessed(state.iterations() * merged.size());
+}
+BENCHMARK(BM_SortUniqueByTime)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
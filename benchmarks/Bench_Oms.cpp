@@ -0,0 +1,25 @@
+#include <benchmark/benchmark.h>
+#include "BenchmarkData.hpp"
+#include "../src/oms/RiskEngine.hpp"
+
+// The pre-trade check the OMS runs on every order, against the bar snapshot
+// onTick takes once per bar
+static void
+BM_RiskEngineCheck(benchmark::State& state)
+{
+    std::vector<MarketCondition> bars = makeSyntheticBars(100);
+
+    RiskEngine risk;
+    risk.setParams(RiskConfig{10, 5.0, 2.0});
+    risk.onTick(0, bars.back().Close, 100000.0);
+
+    Order order{OrderType::BUY, BENCHMARK_TICKER, 1.0f, bars.back().Close};
+    order.setStopLoss(5);
+    order.setTakeProfit(10);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(risk.check(order, 0));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RiskEngineCheck);
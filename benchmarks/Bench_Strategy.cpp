@@ -0,0 +1,94 @@
+#include <benchmark/benchmark.h>
+#include "BenchmarkData.hpp"
+#include "../src/strategy_engine/RSI.hpp"
+#include "../src/strategy_engine/StrategyRegistry.hpp"
+
+static void
+BM_RSIExecute(benchmark::State& state)
+{
+    // One signal over a history of range(0) bars
+    std::vector<MarketCondition> bars = makeSyntheticBars(static_cast<size_t>(state.range(0)));
+    MarketData marketData;
+    marketData.update(bars);
+
+    StrategyAttribute attributes;
+    attributes.period = 14;
+    attributes.overbought_threshold = 70.0;
+    attributes.oversold_threshold = 30.0;
+    attributes.stop_loss = 5;
+    attributes.take_profit = 10;
+
+    QuietOutput quiet;
+    RSI rsi{attributes};
+    rsi.supplyData(marketData);
+
+    for (auto _ : state) {
+        rsi.execute();
+        benchmark::DoNotOptimize(rsi.onNewOrder());
+        rsi.reset();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RSIExecute)->Arg(100)->Arg(10000)->Arg(100000);
+
+static StrategyAttribute
+fleetAttributes()
+{
+    StrategyAttribute attributes;
+    attributes.name = "RSI";
+    attributes.period = 14;
+    attributes.overbought_threshold = 70.0;
+    attributes.oversold_threshold = 30.0;
+    return attributes;
+}
+
+static void
+BM_StrategyFleetVirtual(benchmark::State& state)
+{
+    // range(0) RSIs behind StrategyBase pointers, as the engine held them before
+    std::vector<MarketCondition> bars = makeSyntheticBars(100);
+    MarketData marketData;
+    marketData.update(bars);
+
+    QuietOutput quiet;
+    std::vector<std::unique_ptr<StrategyBase>> fleet;
+    for (int i = 0; i < state.range(0); i++) {
+        fleet.push_back(std::make_unique<RSI>(fleetAttributes()));
+        fleet.back()->supplyData(marketData);
+    }
+
+    for (auto _ : state) {
+        for (auto& strategy : fleet) {
+            strategy->execute();
+            if (strategy->onNewOrder())
+                benchmark::DoNotOptimize(strategy->getOrder());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StrategyFleetVirtual)->Arg(16)->Arg(1024);
+
+static void
+BM_StrategyFleetStatic(benchmark::State& state)
+{
+    // The same fleet held by value per type and dispatched statically
+    std::vector<MarketCondition> bars = makeSyntheticBars(100);
+    MarketData marketData;
+    marketData.update(bars);
+
+    QuietOutput quiet;
+    StrategyFleet fleet;
+    for (int i = 0; i < state.range(0); i++)
+        fleet.add(RSI::Name, fleetAttributes());
+    fleet.forEach([&marketData](auto& strategy, size_t) { strategy.supplyData(marketData); });
+
+    for (auto _ : state) {
+        fleet.forEach([](auto& strategy, size_t) {
+            strategy.execute();
+            if (strategy.onNewOrder())
+                benchmark::DoNotOptimize(strategy.getOrder());
+        });
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StrategyFleetStatic)->Arg(16)->Arg(1024);
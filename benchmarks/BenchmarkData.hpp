@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../src/data_access/MarketCondition.hpp"
+#include "../src/util/Logger.hpp"
+
+#define BENCHMARK_TICKER "NVDA"
+#define BARS_PER_DAY 390            // One minute bars across a trading session
+#define DEFAULT_MAX_BACKTEST_BARS 10000
+
+namespace fs = std::filesystem;
+
+/**
+ * Synthetic one minute bars for a single ticker, a seeded random walk so
+ * every run sees the same prices. Bars start at 09:30 on 2025-01-02 and run
+ * BARS_PER_DAY to a calendar day.
+ */
+inline std::vector<MarketCondition>
+makeSyntheticBars(size_t count, unsigned int seed = 42)
+{
+    std::mt19937 rng(seed);
+    std::normal_distribution<float> step(0.0f, 0.002f);
+    std::uniform_int_distribution<int> volume(100, 10000);
+
+    std::vector<MarketCondition> bars;
+    bars.reserve(count);
+
+    float price = 100.0f;
+    char dateTime[32];
+    for (size_t i = 0; i < count; i++) {
+        size_t day = i / BARS_PER_DAY;
+        size_t minute = 9 * 60 + 30 + i % BARS_PER_DAY;
+        std::tm date{};
+        date.tm_year = 2025 - 1900;
+        date.tm_mday = 2 + static_cast<int>(day);
+        date.tm_hour = static_cast<int>(minute / 60);
+        date.tm_min = static_cast<int>(minute % 60);
+        timegm(&date);
+        std::strftime(dateTime, sizeof(dateTime), "%Y-%m-%d %H:%M:%S", &date);
+
+        float open = price;
+        price = std::max(1.0f, price * (1.0f + step(rng)));
+        bars.push_back(MarketCondition(dateTime, BENCHMARK_TICKER, open, price, volume(rng), "1m"));
+    }
+    return bars;
+}
+
+/**
+ * Adds 10k, 100k and 1M bar runs up to ALGO_BENCH_MAX_BARS (default 10k).
+ * The backtest loop still copies the bars seen so far on every step, so a
+ * run grows with the square of its length and the larger sizes take hours.
+ */
+template <typename Benchmark>
+inline void
+addBacktestSizes(Benchmark* benchmark)
+{
+    const char* limit = std::getenv("ALGO_BENCH_MAX_BARS");
+    long maxBars = limit ? std::atol(limit) : DEFAULT_MAX_BACKTEST_BARS;
+    for (long bars : {10000L, 100000L, 1000000L}) {
+        if (bars <= maxBars) benchmark->Arg(bars);
+    }
+}
+
+/**
+ * Scratch directory under the system temp path, removed on destruction
+ */
+class ScratchDirectory
+{
+    public:
+        explicit ScratchDirectory(const std::string& name)
+        : path(fs::temp_directory_path() / ("algo_trader_bench_" + name))
+        {
+            fs::remove_all(path);
+            fs::create_directories(path);
+        }
+
+        ~ScratchDirectory() { fs::remove_all(path); }
+
+        const fs::path& getPath() const { return path; }
+
+    private:
+        fs::path path;
+};
+
+/**
+ * Silences std::cout and the logger for the measured section, so the
+ * numbers are the engine and not the terminal. Restores both on exit so
+ * the benchmark reporter can still print.
+ */
+class QuietOutput
+{
+    public:
+        QuietOutput()
+        : previousBuffer(std::cout.rdbuf(nullptr)),
+          previousLevel(Logger::getLevel())
+        {
+            Logger::setLevel(LogLevel::ERROR);
+        }
+
+        ~QuietOutput()
+        {
+            Logger::get().flush();
+            std::cout.rdbuf(previousBuffer);
+            std::cout.clear();
+            Logger::setLevel(previousLevel);
+        }
+
+    private:
+        std::streambuf* previousBuffer;
+        LogLevel previousLevel;
+};
@@ -0,0 +1,261 @@
+#include "BacktestFarm.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdexcept>
+#include <thread>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "../util/Logger.hpp"
+
+template <size_t N>
+static void
+copyField(char (&destination)[N], const std::string& source)
+{
+    std::memset(destination, 0, N);
+    std::memcpy(destination, source.data(), std::min(N, source.size()));
+}
+
+template <size_t N>
+static std::string
+fieldOf(const char (&source)[N])
+{
+    return std::string(source, strnlen(source, N));
+}
+
+BacktestFarm::BacktestFarm(const json& _baseConfig)
+: baseConfig(_baseConfig),
+  workers(0)
+{
+}
+
+void
+BacktestFarm::addDataset(const std::string& ticker, const std::vector<MarketCondition>& bars)
+{
+    if (slices.count(ticker) > 0) {
+        throw std::runtime_error("BacktestFarm: dataset for " + ticker + " already added");
+    }
+
+    slices[ticker] = {staged.size(), bars.size()};
+    staged.reserve(staged.size() + bars.size());
+    for (const MarketCondition& bar : bars) {
+        FarmBar packed{};
+        copyField(packed.dateTime, bar.DateTime);
+        copyField(packed.ticker, bar.Ticker);
+        copyField(packed.interval, bar.TimeInterval);
+        packed.open = bar.Open;
+        packed.close = bar.Close;
+        packed.volume = bar.Volume;
+        staged.push_back(packed);
+    }
+}
+
+void
+BacktestFarm::setWorkers(int _workers)
+{
+    workers = _workers;
+}
+
+void
+BacktestFarm::setConfigure(Configure callback)
+{
+    configure = std::move(callback);
+}
+
+std::string
+BacktestFarm::tickerOf(const json& job) const
+{
+    return job.value("ticker", baseConfig.value("ticker", std::string()));
+}
+
+std::vector<FarmResult>
+BacktestFarm::run(const std::vector<json>& jobs)
+{
+    std::vector<FarmResult> results(jobs.size());
+    for (size_t i = 0; i < jobs.size(); i++) {
+        results[i] = FarmResult{};
+        results[i].jobIndex = static_cast<int32_t>(i);
+        results[i].failed = 1;
+        std::snprintf(results[i].error, sizeof(results[i].error), "worker exited before finishing the job");
+    }
+    if (jobs.empty()) {
+        return results;
+    }
+
+    for (const json& job : jobs) {
+        if (slices.count(tickerOf(job)) == 0) {
+            throw std::runtime_error("BacktestFarm: no dataset for ticker " + tickerOf(job));
+        }
+    }
+
+    // One copy of the dataset, read only before any worker exists
+    size_t mappingSize = std::max<size_t>(staged.size(), 1) * sizeof(FarmBar);
+    void* mapping = mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error(std::string("BacktestFarm: mmap failed: ") + std::strerror(errno));
+    }
+    std::memcpy(mapping, staged.data(), staged.size() * sizeof(FarmBar));
+    mprotect(mapping, mappingSize, PROT_READ);
+    const FarmBar* dataset = static_cast<const FarmBar*>(mapping);
+
+    int count = workers > 0 ? workers : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    count = std::min(count, static_cast<int>(jobs.size()));
+
+    // Anything still buffered would be written again by every child
+    std::cout.flush();
+    Logger::get().flush();
+
+    std::vector<pid_t> pids;
+    std::vector<pollfd> pipes;
+    for (int worker = 0; worker < count; worker++) {
+        int fds[2];
+        if (pipe2(fds, O_CLOEXEC) < 0) {
+            LOG_ERROR("BacktestFarm: pipe failed, running with {} workers", worker);
+            break;
+        }
+
+        pid_t pid = fork();
+        if (pid == 0) {
+            close(fds[0]);
+            for (const pollfd& sibling : pipes) close(sibling.fd);
+            runWorker(worker, count, jobs, dataset, fds[1]);
+            _exit(0);
+        }
+
+        close(fds[1]);
+        if (pid < 0) {
+            close(fds[0]);
+            LOG_ERROR("BacktestFarm: fork failed, running with {} workers", worker);
+            break;
+        }
+        pids.push_back(pid);
+        pipes.push_back({fds[0], POLLIN, 0});
+    }
+
+    // Collect results until every worker has closed its pipe
+    std::vector<std::string> pending(pipes.size());
+    size_t open = pipes.size();
+    while (open > 0) {
+        if (::poll(pipes.data(), pipes.size(), -1) < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+
+        for (size_t i = 0; i < pipes.size(); i++) {
+            if (pipes[i].fd < 0 || pipes[i].revents == 0) continue;
+
+            char buffer[4096];
+            ssize_t bytes = read(pipes[i].fd, buffer, sizeof(buffer));
+            if (bytes > 0) {
+                pending[i].append(buffer, static_cast<size_t>(bytes));
+                while (pending[i].size() >= sizeof(FarmResult)) {
+                    FarmResult result;
+                    std::memcpy(&result, pending[i].data(), sizeof(result));
+                    pending[i].erase(0, sizeof(result));
+                    if (result.jobIndex >= 0 && static_cast<size_t>(result.jobIndex) < results.size()) {
+                        results[result.jobIndex] = result;
+                    }
+                }
+            } else if (bytes == 0 || (errno != EINTR && errno != EAGAIN)) {
+                close(pipes[i].fd);
+                pipes[i].fd = -1;
+                open--;
+            }
+        }
+    }
+
+    for (pid_t pid : pids) {
+        int status = 0;
+        waitpid(pid, &status, 0);
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            LOG_WARN("BacktestFarm: worker {} exited abnormally, its unfinished jobs are marked failed", pid);
+        }
+    }
+
+    for (const FarmResult& result : results) {
+        if (result.failed) {
+            LOG_ERROR("BacktestFarm: job {} failed: {}", result.jobIndex, result.error);
+        }
+    }
+
+    munmap(mapping, mappingSize);
+    return results;
+}
+
+void
+BacktestFarm::runWorker(int worker, int workerCount, const std::vector<json>& jobs, const FarmBar* dataset, int fd)
+{
+    // Every job prints a full report, only the coordinator's summary matters
+    int devNull = ::open("/dev/null", O_WRONLY);
+    if (devNull >= 0) {
+        dup2(devNull, STDOUT_FILENO);
+        close(devNull);
+    }
+
+    for (size_t i = worker; i < jobs.size(); i += workerCount) {
+        FarmResult result = runJob(static_cast<int>(i), jobs[i], dataset);
+        if (write(fd, &result, sizeof(result)) != sizeof(result)) {
+            break;
+        }
+    }
+
+    std::cout.flush();
+    Logger::get().flush();
+    close(fd);
+}
+
+FarmResult
+BacktestFarm::runJob(int jobIndex, const json& job, const FarmBar* dataset)
+{
+    FarmResult result{};
+    result.jobIndex = jobIndex;
+    result.failed = 1;
+
+    try {
+        // Overrides merge as JSON, the result is parsed once for the job
+        json merged = baseConfig;
+        merged.merge_patch(job);
+        AppConfig config = AppConfig::fromJson(merged);
+
+        // Decode this job's slice straight from the shared pages
+        const Slice& slice = slices.at(tickerOf(job));
+        if (slice.count == 0) {
+            throw std::runtime_error("no bars for " + tickerOf(job));
+        }
+        std::vector<MarketCondition> bars;
+        bars.reserve(slice.count);
+        for (const FarmBar* bar = dataset + slice.offset; bar != dataset + slice.offset + slice.count; bar++) {
+            bars.emplace_back(fieldOf(bar->dateTime), fieldOf(bar->ticker), bar->open, bar->close,
+                              bar->volume, fieldOf(bar->interval));
+        }
+
+        Backtester backtester(config);
+        if (configure) {
+            configure(backtester);
+        }
+        backtester.setRandomSeed(config.backtest.randomSeed.value_or(FARM_DEFAULT_SEED));
+        backtester.setMarketData(std::move(bars));
+        backtester.run();
+
+        const PerformanceMetrics& metrics = backtester.getPerformanceMetrics();
+        result.numTrades = metrics.numTrades;
+        result.barCount = static_cast<int32_t>(slice.count);
+        result.finalEquity = metrics.finalEquity;
+        result.totalPnL = metrics.totalPnL;
+        result.totalPnLPercent = metrics.totalPnLPercent;
+        result.sharpeRatio = metrics.sharpeRatio;
+        result.maxDrawdownPercent = metrics.maxDrawdownPercent;
+        result.winRate = metrics.winRate;
+        result.profitFactor = metrics.profitFactor;
+        result.executionSeconds = metrics.executionTime.count();
+        result.failed = 0;
+    } catch (const std::exception& e) {
+        // Logged by the coordinator, this worker's output goes nowhere
+        std::snprintf(result.error, sizeof(result.error), "%s", e.what());
+    }
+    return result;
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+#include "Backtester.hpp"
+
+#define FARM_DEFAULT_SEED 42
+
+/**
+ * One bar in the farm's shared dataset, fixed size so the whole dataset is
+ * a single array every worker reads in place
+ */
+struct FarmBar
+{
+    char dateTime[24];
+    char ticker[12];
+    char interval[8];
+    float open;
+    float close;
+    int32_t volume;
+    uint32_t reserved[2];
+};
+
+/**
+ * What a worker sends back for one job, written whole to its pipe
+ */
+struct FarmResult
+{
+    int32_t jobIndex;
+    int32_t failed;             // Non-zero if the job threw or its worker died
+    int32_t numTrades;
+    int32_t barCount;
+    double finalEquity;
+    double totalPnL;
+    double totalPnLPercent;
+    double sharpeRatio;
+    double maxDrawdownPercent;
+    double winRate;
+    double profitFactor;
+    double executionSeconds;
+    char error[256];            // Why the job failed, empty if it didn't
+};
+
+static_assert(sizeof(FarmBar) == 64, "Farm bars must stay 64 bytes");
+static_assert(sizeof(FarmResult) <= 512, "Farm results must fit one atomic pipe write");
+
+/**
+ * BacktestFarm
+ *
+ * Runs a list of backtest jobs across forked worker processes. Each job is
+ * a JSON merge patch over the base config, so a job can change strategy
+ * parameters, the ticker, or both. Separate processes each get their own
+ * StrategyEngine OMS and allocator, which threads in one process share.
+ *
+ * The coordinator packs every ticker's bars into one anonymous shared
+ * mapping, makes it read only and then forks. The dataset is loaded and
+ * parsed once and workers share its pages. The backtest pipeline works on
+ * owned MarketConditions, so each job decodes its own ticker's slice once
+ * and moves it into its Backtester, which hands it to the strategies one
+ * bar at a time. Worker w runs jobs w, w + N, w + 2N and so on, and writes
+ * a FarmResult per job to its own pipe. Each job's broker is seeded with
+ * the job's "random_seed", or FARM_DEFAULT_SEED, so a job gives the same
+ * result whichever worker runs it.
+ *
+ * Workers send their std::cout, and with it the log, to /dev/null. A job
+ * that throws reports the reason in its FarmResult and the coordinator logs
+ * it. A worker that dies has its unfinished jobs reported as failed.
+ */
+class BacktestFarm
+{
+    public:
+        using Configure = std::function<void(Backtester&)>;
+
+        explicit BacktestFarm(const json& _baseConfig);
+
+        // Bars for one ticker, in time order, copied into the shared dataset on run()
+        void addDataset(const std::string& ticker, const std::vector<MarketCondition>& bars);
+
+        // 0 uses every core, never more workers than jobs
+        void setWorkers(int workers);
+
+        // Applied to every job's Backtester before it runs, e.g. capital and costs
+        void setConfigure(Configure callback);
+
+        // Results in job order
+        std::vector<FarmResult> run(const std::vector<json>& jobs);
+
+        // The ticker a job runs on, its own or the base config's
+        std::string tickerOf(const json& job) const;
+
+        size_t getDatasetBars() const { return staged.size(); }
+
+    private:
+        struct Slice {
+            size_t offset;
+            size_t count;
+        };
+
+        void runWorker(int worker, int workers, const std::vector<json>& jobs, const FarmBar* dataset, int fd);
+        FarmResult runJob(int jobIndex, const json& job, const FarmBar* dataset);
+
+        json baseConfig;
+        int workers;
+        Configure configure;
+        std::vector<FarmBar> staged;
+        std::map<std::string, Slice> slices;
+};
@@ -1,6 +1,7 @@
 #include "BacktestMarketDataAdapter.hpp"
 #include <stdexcept>
 #include <iostream>
+#include "../util/Logger.hpp"
 
 BacktestMarketDataAdapter::BacktestMarketDataAdapter()
     : marketData(nullptr), currentIndex(0)
@@ -20,7 +21,7 @@ BacktestMarketDataAdapter::initialize(MarketData& marketDataInstance)
 }
 
 void 
-BacktestMarketDataAdapter::loadHistoricalData(const json& configData, const std::string& startDate, const std::string& endDate)
+BacktestMarketDataAdapter::loadHistoricalData(const DataConfig& configData, const std::string& startDate, const std::string& endDate)
 {
     validateMarketData();
     
@@ -38,7 +39,7 @@ BacktestMarketDataAdapter::loadHistoricalData(const json& configData, const std:
 }
 
 void 
-BacktestMarketDataAdapter::loadHistoricalDataParallel(const json& configData, int numThreads)
+BacktestMarketDataAdapter::loadHistoricalDataParallel(const DataConfig& configData, int numThreads)
 {
     validateMarketData();
     
@@ -64,11 +65,21 @@ BacktestMarketDataAdapter::loadMockData(const std::vector<MarketCondition>& mock
         throw std::runtime_error("Cannot load empty mock data");
     }
     
-    // Update the MarketData instance with the mock data
-    marketData->update(const_cast<std::vector<MarketCondition>&>(mockData));
+    loadMockData(std::vector<MarketCondition>(mockData));
+}
+
+void 
+BacktestMarketDataAdapter::loadMockData(std::vector<MarketCondition>&& mockData)
+{
+    validateMarketData();
     
-    // Store the full dataset for our own use
-    fullDataset = mockData;
+    if (mockData.empty()) {
+        throw std::runtime_error("Cannot load empty mock data");
+    }
+    
+    // Store the full dataset for our own use, the MarketData instance is
+    // given the first point by rewind() and grows one point per step
+    fullDataset = std::move(mockData);
     
     // Reset the index
     rewind();
@@ -90,17 +101,20 @@ BacktestMarketDataAdapter::next()
         return;
     }
     
-    // Get the current market condition at the current index
-    MarketCondition currentCondition = fullDataset[currentIndex];
-    
-    // Update the MarketData instance with the accumulated data up to the current index
-    // This way strategies can access historical data points
-    std::vector<MarketCondition> accumulatedData(fullDataset.begin(), fullDataset.begin() + currentIndex + 1);
-    marketData->update(accumulatedData);
+    // The MarketData instance holds the data up to the current index, so
+    // strategies can access historical data points. Usually it already has
+    // everything before this point and only this one is added.
+    size_t visible = marketData->getData().size();
+    if (visible == static_cast<size_t>(currentIndex)) {
+        marketData->push(fullDataset[currentIndex]);
+    } else if (visible != static_cast<size_t>(currentIndex) + 1) {
+        std::vector<MarketCondition> accumulatedData(fullDataset.begin(), fullDataset.begin() + currentIndex + 1);
+        marketData->update(accumulatedData);
+    }
     
     // Advance the index
-    std::cout << "DEBUG: Processing timepoint [" << currentCondition.DateTime 
-              << "] at index " << currentIndex << " (data size: " << accumulatedData.size() << ")" << std::endl;
+    LOG_DEBUG("Processing timepoint [{}] at index {} (data size: {})",
+              fullDataset[currentIndex].DateTime, currentIndex, marketData->getData().size());
     currentIndex++;
 }
 
@@ -118,6 +132,24 @@ BacktestMarketDataAdapter::rewind()
     }
 }
 
+void
+BacktestMarketDataAdapter::seek(size_t index)
+{
+    validateMarketData();
+
+    if (index > fullDataset.size()) {
+        throw std::runtime_error("Cannot seek past the end of the data");
+    }
+    if (index == 0) {
+        rewind();
+        return;
+    }
+
+    std::vector<MarketCondition> accumulatedData(fullDataset.begin(), fullDataset.begin() + index);
+    marketData->update(accumulatedData);
+    currentIndex = static_cast<int>(index);
+}
+
 int 
 BacktestMarketDataAdapter::getCurrentIndex() const
 {
@@ -28,20 +28,26 @@ public:
      * @param startDate Start date for backtest data range
      * @param endDate End date for backtest data range
      */
-    void loadHistoricalData(const json& configData, const std::string& startDate, const std::string& endDate);
+    void loadHistoricalData(const DataConfig& configData, const std::string& startDate, const std::string& endDate);
     
     /**
      * Load parallel historical data for backtesting (multi-threaded)
      * @param configData Configuration for data loading
      * @param numThreads Number of threads to use for processing
      */
-    void loadHistoricalDataParallel(const json& configData, int numThreads);
+    void loadHistoricalDataParallel(const DataConfig& configData, int numThreads);
     
     /**
      * Load mock data for backtesting (primarily for testing)
      * @param mockData Vector of market conditions to use for backtesting
      */
     void loadMockData(const std::vector<MarketCondition>& mockData);
+
+    /**
+     * Load mock data for backtesting, taking over the caller's bars
+     * @param mockData Vector of market conditions to use for backtesting
+     */
+    void loadMockData(std::vector<MarketCondition>&& mockData);
     
     /**
      * Check if there are more data points available
@@ -59,6 +65,12 @@ public:
      * Reset to the beginning of the data set
      */
     void rewind();
+
+    /**
+     * Jump to a position as if next() had been called index times
+     * @param index Number of data points already processed
+     */
+    void seek(size_t index);
     
     /**
      * Get the current index in the dataset
@@ -71,6 +83,12 @@ public:
      * @return Total number of data points
      */
     size_t getDataSize() const;
+
+    /**
+     * Get the complete dataset the backtest will step through
+     * @return All loaded data points
+     */
+    const std::vector<MarketCondition>& getDataset() const { return fullDataset; }
     
     /**
      * Get the current data point without advancing
@@ -1,18 +1,34 @@
 #include "Backtester.hpp"
+#include "ResultCache.hpp"
+#include "BuildId.hpp"
 #include <cmath>
-#include <numeric>
+#include "../util/BinaryIO.hpp"
+#include "../util/ContentHash.hpp"
+#include "../util/Logger.hpp"
 #include <iomanip>
 
 Backtester::Backtester(const json& algoConfig)
+        : Backtester(AppConfig::fromJson(algoConfig))
+{
+}
+
+Backtester::Backtester(const AppConfig& algoConfig)
         : marketData(), 
           broker(marketData),
-          stratFactory(algoConfig), 
+          stratFactory(algoConfig.strategies), 
           stratEngine(),
           algoConfig(algoConfig),
           detailedLogging(false),
           resultsFilename(""),
           numThreads(0), // 0 means use all available cores
-          useDirectData(false)
+          useDirectData(false),
+          seeded(false),
+          randomSeed(0),
+          resultCache(nullptr),
+          cacheHit(false),
+          checkpointInterval(0),
+          lastTradedValue(0.0),
+          equityCurveInterval(1)
 {
     // Initialize the performance metrics
     metrics = PerformanceMetrics();
@@ -24,6 +40,13 @@ Backtester::Backtester(const json& algoConfig)
     broker.setStartingCapital(100000.0);
     broker.setCommission(1.0);
     broker.setSlippage(0.0005);
+    if (algoConfig.broker.costModel) {
+        broker.setCostModel(makeCostModel(*algoConfig.broker.costModel));
+    }
+    if (algoConfig.broker.lotMatching) {
+        broker.setLotMatching(stringToLotMatching(*algoConfig.broker.lotMatching));
+    }
+    equityCurveInterval = algoConfig.backtest.equityCurveInterval.value_or(equityCurveInterval);
 
     // Default date range (last 7 days)
     auto now = std::chrono::system_clock::now();
@@ -54,6 +77,10 @@ void Backtester::setSlippagePercentage(double slippage) {
               << (slippage * 100.0) << "% (random variation within +/- this range)" << std::endl;
 }
 
+void Backtester::setCostModel(std::unique_ptr<CostModel> model) {
+    broker.setCostModel(std::move(model));
+}
+
 void Backtester::enableDetailedLogging(bool enable) {
     detailedLogging = enable;
 }
@@ -72,7 +99,68 @@ void Backtester::setNumThreads(int threads) {
     numThreads = threads;
 }
 
+void Backtester::setEquityCurveInterval(size_t bars) {
+    equityCurveInterval = bars;
+}
+
+void Backtester::setRandomSeed(unsigned int seed) {
+    broker.enableFixedRandomSeed(seed);
+    seeded = true;
+    randomSeed = seed;
+}
+
+void Backtester::setResultCache(ResultCache* cache) {
+    resultCache = cache;
+}
+
+void Backtester::setCheckpointFile(const std::string& path, size_t everyBars) {
+    checkpointWriter = std::make_unique<CheckpointWriter>(path);
+    checkpointInterval = everyBars;
+}
+
+void Backtester::resumeFrom(const std::string& path) {
+    resumeFile = path;
+}
+
+// The bars as parsed, whichever files or mock data they came from
+void
+Backtester::hashDataset(ContentHash& hash) const
+{
+    for (const MarketCondition& bar : marketDataAdapter.getDataset()) {
+        hash.update(bar.DateTime);
+        hash.update(bar.Ticker);
+        hash.update(bar.Open);
+        hash.update(bar.Close);
+        hash.update(bar.Volume);
+        hash.update(bar.TimeInterval);
+    }
+}
+
+std::string
+Backtester::cacheKey() const
+{
+    ContentHash hash;
+    hash.update(static_cast<uint32_t>(RESULT_CACHE_VERSION));
+    hash.update(BUILD_ID);
+    hashDataset(hash);
+
+    // Strategies, risk limits, cost model and lot matching all live in the config
+    hash.update(algoConfig.hash());
+
+    hash.update(broker.getStartingCapital());
+    hash.update(broker.getCommissionPerTrade());
+    hash.update(broker.getSlippagePercentage());
+    hash.update(broker.getCostModel().getName());
+    hash.update(randomSeed);
+    hash.update(static_cast<uint64_t>(equityCurveInterval));
+    return hash.hex();
+}
+
 void Backtester::setMarketData(std::vector<MarketCondition>& mockData) {
+    setMarketData(std::vector<MarketCondition>(mockData));
+}
+
+void Backtester::setMarketData(std::vector<MarketCondition>&& mockData) {
     std::cout << "Setting mock market data with " << mockData.size() << " data points" << std::endl;
     
     // Verify the mock data is not empty
@@ -81,8 +169,8 @@ void Backtester::setMarketData(std::vector<MarketCondition>& mockData) {
         return;
     }
     
-    // Load the mock data into the adapter
-    marketDataAdapter.loadMockData(mockData);
+    // Hand the data to the adapter, which keeps the only full copy
+    marketDataAdapter.loadMockData(std::move(mockData));
     
     // Auto-enable direct data mode when mock data is provided
     useDirectData = true;
@@ -112,10 +200,10 @@ Backtester::run()
         // Process market data with date range and parallel processing
         if (numThreads > 0) {
             std::cout << "Using " << numThreads << " threads for processing" << std::endl;
-            marketDataAdapter.loadHistoricalDataParallel(algoConfig, numThreads);
+            marketDataAdapter.loadHistoricalDataParallel(algoConfig.data, numThreads);
         } else {
             std::cout << "Using all available cores for processing" << std::endl;
-            marketDataAdapter.loadHistoricalData(algoConfig, startDate, endDate);
+            marketDataAdapter.loadHistoricalData(algoConfig.data, startDate, endDate);
         }
     } else {
         std::cout << "Using directly provided market data (" << marketDataAdapter.getDataSize() << " data points)" << std::endl;
@@ -127,6 +215,28 @@ Backtester::run()
         return;
     }
     
+    // An identical run was done before, report its results instead. A resumed
+    // run depends on its checkpoint as well, so it is never cached.
+    cacheHit = false;
+    std::string key;
+    if (resultCache && seeded && resumeFile.empty()) {
+        key = cacheKey();
+        CachedResult cached;
+        if (resultCache->load(key, cached)) {
+            cacheHit = true;
+            metrics = cached.metrics;
+            equityCurve = std::move(cached.equityCurve);
+            std::cout << "Using cached results " << key << std::endl;
+
+            Logger::get().flush();
+            printReport();
+            if (!resultsFilename.empty()) {
+                saveResults();
+            }
+            return;
+        }
+    }
+    
     // Ensure we're at the beginning of the data
     marketDataAdapter.rewind();
     
@@ -137,20 +247,25 @@ Backtester::run()
     initializeBacktest();
     
     // Log initial state - ensure we have data before trying to access it
-    if (marketDataAdapter.getDataSize() > 0) {
-        MarketCondition firstPoint = marketDataAdapter.getCurrentData();
-        equityCurve.push_back({firstPoint.DateTime, broker.getCurrentEquity()});
-    } else {
+    if (marketDataAdapter.getDataSize() == 0) {
         std::cerr << "ERROR: Market data is empty after initialization. Exiting run()." << std::endl;
         return;
     }
+    if (!resumeFile.empty()) {
+        // Picks up where the checkpoint left off, throws if it doesn't fit this data
+        loadCheckpoint(resumeFile);
+    } else {
+        MarketCondition firstPoint = marketDataAdapter.getCurrentData();
+        performance.start(broker.getCurrentEquity(), firstPoint.Time.seconds());
+        recordEquity(firstPoint.DateTime, true);
+    }
     
     // Count how many data points we'll process
     size_t totalDataPoints = marketDataAdapter.getDataSize();
     std::cout << "Processing " << totalDataPoints << " market data points" << std::endl;
     
     // Progress tracking
-    size_t lastProgress = 0;
+    size_t lastProgress = marketDataAdapter.getCurrentIndex();
     size_t progressStep = totalDataPoints / 20; // Show progress in 5% increments
     if (progressStep == 0) progressStep = 1;
         
@@ -164,6 +279,12 @@ Backtester::run()
         
         // Show progress
         size_t currentIndex = marketDataAdapter.getCurrentIndex();
+
+        // Snapshot between bars, nothing is left over from this one
+        if (checkpointWriter && checkpointInterval > 0 && currentIndex % checkpointInterval == 0 &&
+            marketDataAdapter.hasNext()) {
+            checkpointWriter->write([this](std::ostream& out) { saveCheckpoint(out); });
+        }
         if (currentIndex - lastProgress >= progressStep) {
             int progressPercent = static_cast<int>((static_cast<double>(currentIndex) / totalDataPoints) * 100);
             std::cout << "Progress: " << progressPercent << "% ("
@@ -177,6 +298,18 @@ Backtester::run()
     if (loopCount >= MAX_LOOPS) {
         std::cerr << "WARNING: Loop safety limit reached. Possible infinite loop detected." << std::endl;
     }
+
+    if (checkpointWriter) {
+        checkpointWriter->wait();
+        std::cout << "Wrote " << checkpointWriter->getWrittenCount() << " checkpoints to "
+                  << checkpointWriter->getPath() << " (" << checkpointWriter->getSkippedCount()
+                  << " skipped while writing)" << std::endl;
+    }
+        
+    // Close the sampled curve on the last bar
+    if (equityCurveInterval > 0 && performance.getBarCount() % equityCurveInterval != 0) {
+        recordEquity(marketDataAdapter.getCurrentData().DateTime, true);
+    }
         
     // Record end time and calculate duration
     auto endTime = std::chrono::high_resolution_clock::now();
@@ -185,6 +318,9 @@ Backtester::run()
     // Calculate final metrics
     calculateMetrics();
     
+    // Write out queued log lines before the report
+    Logger::get().flush();
+    
     // Print report
     printReport();
     
@@ -192,6 +328,10 @@ Backtester::run()
     if (!resultsFilename.empty()) {
         saveResults();
     }
+
+    if (!key.empty()) {
+        resultCache->store(key, {metrics, equityCurve});
+    }
     
     std::cout << "Backtest completed in " 
               << metrics.executionTime.count() << " seconds" << std::endl;
@@ -200,10 +340,14 @@ Backtester::run()
 void
 Backtester::initializeBacktest() 
 {
+    // The OMS is shared by every engine in the process, start from an empty book
+    stratEngine.getOms()->reset();
+
     // Reset performance tracking
     equityCurve.clear();
-    dailyReturns.clear();
     customMetrics.clear();
+    performance.reset();
+    lastTradedValue = broker.getTotalTradedValue();
     
     // Log initial state
     metrics.startingCapital = broker.getStartingCapital();
@@ -221,7 +365,7 @@ Backtester::executeTimeStep()
     std::string timestamp = currentData.DateTime;
     
     // Log the timestamp we're about to process
-    std::cout << "Backtester time step: " << timestamp << std::endl;
+    LOG_DEBUG("Backtester time step: {}", timestamp);
     
     // 2. Execute strategy - this will use the updated marketData
     // The strategy will generate signals based on this data point
@@ -230,217 +374,183 @@ Backtester::executeTimeStep()
     // 3. Simulate broker operations - this includes processing orders from strategies
     // The broker will use the same current data point for execution
     broker.nextStep();
+
+    // Feed this step's fills back to the OMS so positions are current
+    stratEngine.processBrokerEvents();
     
     // 4. Log performance and update metrics
     logPerformance();
     
-    // Add to equity curve using current timestamp
-    equityCurve.push_back({timestamp, broker.getCurrentEquity()});
-    
-    // Calculate daily return and add to returns vector (if equity has changed)
-    if (equityCurve.size() >= 2) {
-        double prevEquity = equityCurve[equityCurve.size() - 2].second;
-        double currentEquity = equityCurve[equityCurve.size() - 1].second;
-        
-        if (prevEquity != 0) {
-            double dailyReturn = (currentEquity - prevEquity) / prevEquity;
-            dailyReturns.push_back(dailyReturn);
-        }
-    }
+    // Fold this bar into the running metrics
+    double tradedValue = broker.getTotalTradedValue();
+    double grossExposure = broker.getLongMarketValue() + std::abs(broker.getShortMarketValue());
+    performance.update(broker.getCurrentEquity(), currentData.Time.seconds(),
+                       grossExposure, tradedValue - lastTradedValue);
+    lastTradedValue = tradedValue;
+
+    recordEquity(timestamp);
 }
 
-void 
-Backtester::logPerformance() 
+// Everything that carries from one bar to the next, in a fixed order:
+// header, backtester, broker, OMS, then each strategy length prefixed, and
+// the magic again so a truncated file is caught. The market data window is
+// rebuilt from the bar index rather than stored.
+void
+Backtester::saveCheckpoint(std::ostream& out) const
 {
-    if (detailedLogging) {
-        std::cout << "Current Equity: " << formatCurrency(broker.getCurrentEquity())
-                  << " | PnL: " << formatCurrency(broker.getPnL())
-                  << " | Drawdown: " << formatPercent(broker.getDrawdown())
-                  << "%" << std::endl;
+    ContentHash dataset;
+    hashDataset(dataset);
+
+    writeBinary(out, CHECKPOINT_MAGIC);
+    writeBinary(out, static_cast<uint32_t>(CHECKPOINT_VERSION));
+    writeBinaryString(out, dataset.hex());
+    writeBinary(out, static_cast<uint64_t>(marketDataAdapter.getDataSize()));
+    writeBinary(out, static_cast<uint64_t>(marketDataAdapter.getCurrentIndex()));
+
+    performance.saveState(out);
+    writeBinary(out, lastTradedValue);
+    writeBinary(out, metrics.startingCapital);
+    writeBinary(out, static_cast<uint64_t>(equityCurve.size()));
+    for (const auto& [timestamp, equity] : equityCurve) {
+        writeBinaryString(out, timestamp);
+        writeBinary(out, equity);
     }
+
+    broker.saveState(out);
+    stratEngine.getOms()->saveState(out);
+
+    const auto& strategies = stratEngine.getStrategies();
+    writeBinary(out, static_cast<uint64_t>(strategies.size()));
+    for (size_t i = 0; i < strategies.size(); i++) {
+        std::ostringstream state;
+        strategies[i].saveState(state);
+        writeBinaryString(out, strategies[i]._strategyAttribute.name);
+        writeBinaryString(out, state.str());
+    }
+
+    writeBinary(out, CHECKPOINT_MAGIC);
 }
 
 void
-Backtester::calculateMetrics() 
+Backtester::loadCheckpoint(const std::string& path)
 {
-    // Basic metrics
-    metrics.finalEquity = broker.getCurrentEquity();
-    metrics.totalPnL = broker.getPnL();
-    metrics.totalPnLPercent = (metrics.finalEquity - metrics.startingCapital) / metrics.startingCapital * 100.0;
-    metrics.numTrades = broker.getNumTrades();
-    
-    // Calculate trade statistics from filled orders
-    const std::vector<Order>& filledOrders = broker.getFilledOrders();
-    
-    // Separate buy and sell orders
-    std::vector<Order> buyOrders;
-    std::vector<Order> sellOrders;
-    
-    for (const auto& order : filledOrders) {
-        if (order.getType() == OrderType::BUY || order.getType() == OrderType::LIMIT_BUY) {
-            buyOrders.push_back(order);
-        } else {
-            sellOrders.push_back(order);
-        }
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("Cannot open checkpoint " + path);
     }
-    
-    // Match buys and sells to determine profitable trades
-    // This is a simplified approach - in a real system, you'd need to match
-    // buy and sell orders properly considering partial fills, multiple sells
-    // for a single position, etc.
-    
-    std::vector<double> tradeProfits;
-    
-    for (const auto& buyOrder : buyOrders) {
-        for (const auto& sellOrder : sellOrders) {
-            if (buyOrder.getTicker() == sellOrder.getTicker()) {
-                // Calculate profit for this pair
-                double buyValue = buyOrder.getQuantity() * buyOrder.getPrice();
-                double sellValue = sellOrder.getQuantity() * sellOrder.getPrice();
-                double profit = sellValue - buyValue;
-                
-                tradeProfits.push_back(profit);
-                break; // Move to next buy order
-            }
-        }
+
+    uint64_t magic = 0;
+    uint32_t version = 0;
+    std::string datasetHash;
+    uint64_t datasetSize = 0;
+    uint64_t barIndex = 0;
+    readBinary(in, magic);
+    readBinary(in, version);
+    readBinaryString(in, datasetHash);
+    readBinary(in, datasetSize);
+    readBinary(in, barIndex);
+    if (!in || magic != CHECKPOINT_MAGIC || version != CHECKPOINT_VERSION) {
+        throw std::runtime_error("Not a backtest checkpoint: " + path);
     }
-    
-    // Calculate trade statistics
-    metrics.winningTrades = std::count_if(tradeProfits.begin(), tradeProfits.end(),
-                                         [](double profit) { return profit > 0; });
-    metrics.losingTrades = std::count_if(tradeProfits.begin(), tradeProfits.end(),
-                                        [](double profit) { return profit <= 0; });
-    
-    // Calculate win rate
-    if (tradeProfits.size() > 0) {
-        metrics.winRate = static_cast<double>(metrics.winningTrades) / tradeProfits.size() * 100.0;
-    } else {
-        metrics.winRate = 0;
+
+    ContentHash dataset;
+    hashDataset(dataset);
+    if (datasetHash != dataset.hex() || datasetSize != marketDataAdapter.getDataSize() || barIndex > datasetSize) {
+        throw std::runtime_error("Checkpoint " + path + " was taken over different market data");
     }
-    
-    // Calculate average win and loss
-    std::vector<double> winningTrades;
-    std::vector<double> losingTrades;
-    
-    for (double profit : tradeProfits) {
-        if (profit > 0) {
-            winningTrades.push_back(profit);
-        } else if (profit < 0) {
-            losingTrades.push_back(profit);
-        }
+
+    performance.loadState(in);
+    readBinary(in, lastTradedValue);
+    readBinary(in, metrics.startingCapital);
+    uint64_t points = 0;
+    readBinary(in, points);
+    equityCurve.clear();
+    for (uint64_t i = 0; in && i < points; i++) {
+        std::string timestamp;
+        double equity = 0.0;
+        readBinaryString(in, timestamp);
+        readBinary(in, equity);
+        equityCurve.push_back({std::move(timestamp), equity});
     }
-    
-    if (!winningTrades.empty()) {
-        metrics.avgWin = std::accumulate(winningTrades.begin(), winningTrades.end(), 0.0) / winningTrades.size();
-    } else {
-        metrics.avgWin = 0;
+
+    broker.loadState(in);
+    stratEngine.getOms()->loadState(in);
+
+    auto& strategies = stratEngine.getStrategies();
+    uint64_t strategyCount = 0;
+    readBinary(in, strategyCount);
+    if (in && strategyCount != strategies.size()) {
+        throw std::runtime_error("Checkpoint " + path + " has " + std::to_string(strategyCount) +
+                                 " strategies, the config has " + std::to_string(strategies.size()));
     }
-    
-    if (!losingTrades.empty()) {
-        metrics.avgLoss = std::accumulate(losingTrades.begin(), losingTrades.end(), 0.0) / losingTrades.size();
-    } else {
-        metrics.avgLoss = 0;
+    for (size_t i = 0; i < strategies.size(); i++) {
+        StrategyBase& strategy = strategies[i];
+        std::string name, state;
+        readBinaryString(in, name);
+        readBinaryString(in, state);
+        if (in && name != strategy._strategyAttribute.name) {
+            throw std::runtime_error("Checkpoint " + path + " has strategy " + name + " where the config has " +
+                                     strategy._strategyAttribute.name);
+        }
+        std::istringstream strategyIn(state);
+        strategy.loadState(strategyIn);
     }
-    
-    // Calculate profit factor
-    double grossProfit = std::accumulate(winningTrades.begin(), winningTrades.end(), 0.0);
-    double grossLoss = std::fabs(std::accumulate(losingTrades.begin(), losingTrades.end(), 0.0));
-    
-    if (grossLoss > 0) {
-        metrics.profitFactor = grossProfit / grossLoss;
-    } else {
-        metrics.profitFactor = grossProfit > 0 ? std::numeric_limits<double>::infinity() : 0;
+
+    readBinary(in, magic);
+    if (!in || magic != CHECKPOINT_MAGIC) {
+        throw std::runtime_error("Checkpoint " + path + " is truncated");
     }
-    
-    // Calculate Sharpe ratio, max drawdown, and annualized return
-    metrics.sharpeRatio = calculateSharpeRatio();
-    metrics.maxDrawdownPercent = calculateMaxDrawdown();
-    metrics.annualizedReturn = calculateAnnualizedReturn();
+
+    marketDataAdapter.seek(barIndex);
+    std::cout << "Resuming from " << path << " at bar " << barIndex << " of " << datasetSize
+              << " (" << marketDataAdapter.getCurrentData().DateTime << ")" << std::endl;
 }
 
-double
-Backtester::calculateSharpeRatio() 
+void
+Backtester::recordEquity(const std::string& timestamp, bool force)
 {
-    if (dailyReturns.empty()) {
-        return 0.0;
+    if (equityCurveInterval == 0) {
+        return;
     }
-    
-    // Calculate mean return
-    double meanReturn = std::accumulate(dailyReturns.begin(), dailyReturns.end(), 0.0) / dailyReturns.size();
-    
-    // Calculate standard deviation
-    double sq_sum = std::inner_product(dailyReturns.begin(), dailyReturns.end(), dailyReturns.begin(), 0.0,
-                                     std::plus<>(), [meanReturn](double x, double y) {
-                                         return (x - meanReturn) * (y - meanReturn);
-                                     });
-    
-    double stddev = std::sqrt(sq_sum / dailyReturns.size());
-    
-    // Risk-free rate (simplified - in real system you'd use actual risk-free rate)
-    double riskFreeRate = 0.0;
-    
-    // Calculate daily Sharpe ratio
-    double dailySharpe;
-    if (stddev == 0.0) {
-        dailySharpe = 0.0;
-    } else {
-        dailySharpe = (meanReturn - riskFreeRate) / stddev;
+    if (force || performance.getBarCount() % equityCurveInterval == 0) {
+        equityCurve.push_back({timestamp, broker.getCurrentEquity()});
     }
-    
-    // Annualize the Sharpe ratio (assuming 252 trading days per year)
-    return dailySharpe * std::sqrt(252);
 }
 
-double
-Backtester::calculateMaxDrawdown() 
+void 
+Backtester::logPerformance() 
 {
-    if (equityCurve.empty()) {
-        return 0.0;
-    }
-    
-    double maxDrawdown = 0.0;
-    double peak = equityCurve[0].second;
-    
-    for (const auto& point : equityCurve) {
-        double equity = point.second;
-        
-        if (equity > peak) {
-            peak = equity;
-        }
-        
-        double drawdown = (peak - equity) / peak * 100.0;
-        maxDrawdown = std::max(maxDrawdown, drawdown);
+    if (detailedLogging) {
+        LOG_INFO("Current Equity: ${:.2f} | PnL: ${:.2f} | Drawdown: {:.2f}%",
+                 broker.getCurrentEquity(), broker.getPnL(), broker.getDrawdown());
     }
-    
-    return maxDrawdown;
 }
 
-double
-Backtester::calculateAnnualizedReturn() 
+void
+Backtester::calculateMetrics() 
 {
-    if (equityCurve.size() < 2) {
-        return 0.0;
-    }
-    
-    // Get first and last equity values
-    double startEquity = equityCurve.front().second;
-    double endEquity = equityCurve.back().second;
-    
-    // Calculate total return
-    double totalReturn = (endEquity - startEquity) / startEquity;
-    
-    // Estimate the number of trading days in the simulation
-    int tradingDays = equityCurve.size();
-    
-    // Calculate annualized return (assuming 252 trading days per year)
-    double yearsElapsed = static_cast<double>(tradingDays) / 252.0;
-    
-    if (yearsElapsed <= 0) {
-        return totalReturn * 100.0; // Just return total return as percentage if period is too short
-    }
+    // Basic metrics
+    metrics.finalEquity = broker.getCurrentEquity();
+    metrics.totalPnL = broker.getPnL();
+    metrics.totalPnLPercent = (metrics.finalEquity - metrics.startingCapital) / metrics.startingCapital * 100.0;
+    metrics.numTrades = broker.getNumTrades();
     
-    // Calculate annualized return
-    return (std::pow(1.0 + totalReturn, 1.0 / yearsElapsed) - 1.0) * 100.0;
+    // Trade statistics are kept by the broker's lot ledger as fills happen
+    const TradeStats& trades = broker.getTradeLedger().getStats();
+    metrics.winningTrades = trades.winningTrades;
+    metrics.losingTrades = trades.losingTrades;
+    metrics.winRate = trades.getWinRate();
+    metrics.avgWin = trades.getAvgWin();
+    metrics.avgLoss = trades.getAvgLoss();
+    metrics.profitFactor = trades.getProfitFactor();
+    
+    // Return and risk metrics were accumulated bar by bar
+    metrics.sharpeRatio = performance.getSharpeRatio();
+    metrics.maxDrawdownPercent = performance.getMaxDrawdownPercent();
+    metrics.annualizedReturn = performance.getAnnualizedReturn();
+    metrics.annualizedVolatility = performance.getAnnualizedVolatility();
+    metrics.exposurePercent = performance.getExposurePercent();
+    metrics.turnover = performance.getTurnover();
 }
 
 void 
@@ -460,6 +570,9 @@ Backtester::printReport()
     std::cout << "- Sharpe ratio: " << std::fixed << std::setprecision(2) << metrics.sharpeRatio << std::endl;
     std::cout << "- Max drawdown: " << formatPercent(metrics.maxDrawdownPercent) << "%" << std::endl;
     std::cout << "- Annualized return: " << formatPercent(metrics.annualizedReturn) << "%" << std::endl;
+    std::cout << "- Annualized volatility: " << formatPercent(metrics.annualizedVolatility) << "%" << std::endl;
+    std::cout << "- Exposure time: " << formatPercent(metrics.exposurePercent) << "%" << std::endl;
+    std::cout << "- Turnover: " << std::fixed << std::setprecision(2) << metrics.turnover << "x" << std::endl;
     
     // Trade statistics
     std::cout << "\nTrade statistics:" << std::endl;
@@ -471,9 +584,46 @@ Backtester::printReport()
     std::cout << "- Average loss: " << formatCurrency(metrics.avgLoss) << std::endl;
     std::cout << "- Profit factor: " << std::fixed << std::setprecision(2) << metrics.profitFactor << std::endl;
     
+    // Cached results have no orders behind them
+    if (!cacheHit) {
+        printLatencyReport();
+    }
+    
     std::cout << "\n============================\n" << std::endl;
 }
 
+void
+Backtester::printLatencyReport()
+{
+    const OrderLifecycle& lifecycle = stratEngine.getOms()->getLifecycle();
+    if (lifecycle.getCompletedCount() == 0) {
+        return;
+    }
+
+    struct Stage {
+        const char* name;
+        OrderStatus from;
+        OrderStatus to;
+    };
+    static const Stage stages[] = {
+        {"Validate", OrderStatus::NEW, OrderStatus::VALIDATED},
+        {"Send", OrderStatus::VALIDATED, OrderStatus::SENT},
+        {"Ack", OrderStatus::SENT, OrderStatus::ACKED},
+        {"Fill", OrderStatus::SENT, OrderStatus::FILLED},
+        {"Signal to fill", OrderStatus::NEW, OrderStatus::FILLED},
+    };
+
+    // Wall clock time through the engine, a simulated fill waits for the next bar
+    std::cout << "\nOrder latency (us, p50 / p99):" << std::endl;
+    for (const Stage& stage : stages) {
+        LatencyStats stats = lifecycle.getLatencies(stage.from, stage.to);
+        if (stats.count == 0) continue;
+        std::cout << "- " << stage.name << ": " << std::fixed << std::setprecision(1)
+                  << stats.p50 / 1000.0 << " / " << stats.p99 / 1000.0
+                  << " (" << stats.count << " orders)" << std::endl;
+    }
+}
+
 void 
 Backtester::saveResults() 
 {
@@ -498,7 +648,10 @@ Backtester::saveResults()
     outFile << "Performance metrics:\n";
     outFile << "- Sharpe ratio: " << std::fixed << std::setprecision(2) << metrics.sharpeRatio << "\n";
     outFile << "- Max drawdown: " << formatPercent(metrics.maxDrawdownPercent) << "%\n";
-    outFile << "- Annualized return: " << formatPercent(metrics.annualizedReturn) << "%\n\n";
+    outFile << "- Annualized return: " << formatPercent(metrics.annualizedReturn) << "%\n";
+    outFile << "- Annualized volatility: " << formatPercent(metrics.annualizedVolatility) << "%\n";
+    outFile << "- Exposure time: " << formatPercent(metrics.exposurePercent) << "%\n";
+    outFile << "- Turnover: " << std::fixed << std::setprecision(2) << metrics.turnover << "x\n\n";
     
     // Trade statistics
     outFile << "Trade statistics:\n";
@@ -14,6 +14,11 @@
 #include "../strategy_engine/StrategyFactory.hpp"
 #include "../broker/SimulatedBroker.hpp"
 #include "BacktestMarketDataAdapter.hpp"
+#include "CheckpointWriter.hpp"
+#include "PerformanceAccumulator.hpp"
+
+class ContentHash;
+class ResultCache;
 
 /**
  * Performance metrics for backtesting results
@@ -33,6 +38,9 @@ struct PerformanceMetrics {
     double avgLoss;
     double profitFactor;
     double annualizedReturn;
+    double annualizedVolatility;
+    double exposurePercent;     // Share of bars with an open position
+    double turnover;            // Traded notional over average equity
     std::chrono::duration<double> executionTime;
 };
 
@@ -47,6 +55,12 @@ class Backtester {
 public:
     /**
      * Constructor
+     * @param algoConfig Parsed configuration for the backtester
+     */
+    Backtester(const AppConfig& algoConfig);
+
+    /**
+     * Constructor, parsing the JSON configuration once
      * @param algoConfig JSON configuration for the backtester
      */
     Backtester(const json& algoConfig);
@@ -60,18 +74,37 @@ public:
     void setStartingCapital(double capital);
     void setCommissionPerTrade(double commission);
     void setSlippagePercentage(double slippage);
+    void setCostModel(std::unique_ptr<CostModel> model);
     void setDataTimeframe(const std::string& timeframe);
     void enableDetailedLogging(bool enable);
     void saveResultsToFile(const std::string& filename);
     void setDateRange(const std::string& startDate, const std::string& endDate);
     void setNumThreads(int threads);
+    // Keep every Nth bar of the equity curve for saved results, 0 keeps none
+    void setEquityCurveInterval(size_t bars);
+    // Fix the broker's slippage draws so runs can be compared
+    void setRandomSeed(unsigned int seed);
+    // Reuse the results of an identical earlier run. Only seeded runs are
+    // cached, an unseeded one is a different draw every time.
+    void setResultCache(ResultCache* cache);
+    // Content hash of the loaded bars, the config, broker settings and seed
+    std::string cacheKey() const;
+    bool wasCacheHit() const { return cacheHit; }
+    // Checkpoint the whole simulation every N bars, written in the background
+    void setCheckpointFile(const std::string& path, size_t everyBars = CHECKPOINT_DEFAULT_INTERVAL);
+    // Continue from a checkpoint instead of the first bar. The data must be the
+    // bars the checkpoint was taken over, the config may differ (what-if runs).
+    void resumeFrom(const std::string& path);
+    size_t getCheckpointsWritten() const { return checkpointWriter ? checkpointWriter->getWrittenCount() : 0; }
     
     // Testing support
     void setMarketData(std::vector<MarketCondition>& mockData);
+    void setMarketData(std::vector<MarketCondition>&& mockData);
     void useDirectMarketData(bool useDirect);
     
     // Result access methods
     const PerformanceMetrics& getPerformanceMetrics() const;
+    const std::vector<std::pair<std::string, double>>& getEquityCurve() const { return equityCurve; }
     
 private:
     // Core components
@@ -82,18 +115,27 @@ private:
     StrategyEngine stratEngine;               // Engine for running strategies
     
     // Configuration
-    json algoConfig;
+    AppConfig algoConfig;
     bool detailedLogging;
     std::string resultsFilename;
     std::string startDate;
     std::string endDate;
     int numThreads;
     bool useDirectData;
+    bool seeded;
+    unsigned int randomSeed;
+    ResultCache* resultCache;
+    bool cacheHit;
+    std::unique_ptr<CheckpointWriter> checkpointWriter;
+    size_t checkpointInterval;
+    std::string resumeFile;
     
     // Performance tracking
     PerformanceMetrics metrics;
-    std::vector<double> dailyReturns;
-    std::vector<std::pair<std::string, double>> equityCurve;
+    PerformanceAccumulator performance;
+    double lastTradedValue;
+    size_t equityCurveInterval;
+    std::vector<std::pair<std::string, double>> equityCurve;    // Sampled, for saved results only
     std::map<std::string, std::vector<double>> customMetrics;
     
     // Simulation methods
@@ -102,12 +144,12 @@ private:
     void logPerformance();
     void calculateMetrics();
     void printReport();
+    void printLatencyReport();
     void saveResults();
-    
-    // Calculation helpers
-    double calculateSharpeRatio();
-    double calculateMaxDrawdown();
-    double calculateAnnualizedReturn();
+    void recordEquity(const std::string& timestamp, bool force = false);
+    void hashDataset(ContentHash& hash) const;
+    void saveCheckpoint(std::ostream& out) const;
+    void loadCheckpoint(const std::string& path);
     
     // Utility methods
     std::string getCurrentTimestamp() const;
@@ -0,0 +1,23 @@
+# Writes OUTPUT with a BUILD_ID define: a hash over the contents of every
+# source file under SOURCE_DIR. Run at build time by backtester_lib so the
+# backtest result cache never serves results from different code. The file
+# is only rewritten when the id changes.
+file(GLOB_RECURSE sources "${SOURCE_DIR}/*.cpp" "${SOURCE_DIR}/*.hpp")
+list(SORT sources)
+
+set(digests "")
+foreach(source ${sources})
+    file(SHA256 "${source}" digest)
+    file(RELATIVE_PATH name "${SOURCE_DIR}" "${source}")
+    string(APPEND digests "${name} ${digest}\n")
+endforeach()
+string(SHA256 buildHash "${digests}")
+string(SUBSTRING "${buildHash}" 0 16 buildId)
+
+set(content "#pragma once\n\n// Generated by BuildId.cmake, do not edit\n#define BUILD_ID \"${buildId}\"\n")
+if(EXISTS "${OUTPUT}")
+    file(READ "${OUTPUT}" existing)
+endif()
+if(NOT "${existing}" STREQUAL "${content}")
+    file(WRITE "${OUTPUT}" "${content}")
+endif()
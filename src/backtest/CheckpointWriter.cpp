@@ -0,0 +1,98 @@
+#include "CheckpointWriter.hpp"
+#include <cstdio>
+#include <fcntl.h>
+#include <fstream>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "../util/Logger.hpp"
+
+CheckpointWriter::CheckpointWriter(const std::string& _path)
+: path(_path),
+  child(-1),
+  written(0),
+  skipped(0),
+  failed(0)
+{
+}
+
+CheckpointWriter::~CheckpointWriter()
+{
+    wait();
+}
+
+bool
+CheckpointWriter::write(const std::function<void(std::ostream&)>& serialize)
+{
+    if (isWriting()) {
+        skipped++;
+        return false;
+    }
+
+    pid_t pid = fork();
+    if (pid < 0) {
+        failed++;
+        LOG_WARN("Checkpoint: fork failed, skipping checkpoint");
+        return false;
+    }
+
+    if (pid == 0) {
+        // Nothing here may log or flush stdio, the parent owns both
+        int status = 1;
+        try {
+            std::string temporary = path + ".tmp";
+            {
+                std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+                serialize(out);
+                out.flush();
+                if (!out) _exit(1);
+            }
+
+            int fd = open(temporary.c_str(), O_RDONLY);
+            if (fd >= 0 && fsync(fd) == 0 && std::rename(temporary.c_str(), path.c_str()) == 0) {
+                status = 0;
+            }
+            if (fd >= 0) close(fd);
+        } catch (...) {
+            status = 1;
+        }
+        _exit(status);
+    }
+
+    child = pid;
+    return true;
+}
+
+void
+CheckpointWriter::wait()
+{
+    reap(true);
+}
+
+bool
+CheckpointWriter::isWriting()
+{
+    reap(false);
+    return child > 0;
+}
+
+void
+CheckpointWriter::reap(bool block)
+{
+    if (child <= 0) {
+        return;
+    }
+
+    int status = 0;
+    pid_t done = waitpid(child, &status, block ? 0 : WNOHANG);
+    if (done == 0) {
+        return;
+    }
+
+    child = -1;
+    if (done > 0 && WIFEXITED(status) && WEXITSTATUS(status) == 0) {
+        written++;
+    } else {
+        failed++;
+        LOG_WARN("Checkpoint: writing {} failed", path);
+    }
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <sys/types.h>
+
+#define CHECKPOINT_MAGIC 0x54504B4354424741ull     // "AGBTCKPT"
+#define CHECKPOINT_VERSION 3
+#define CHECKPOINT_DEFAULT_INTERVAL 100000          // Bars between checkpoints
+
+/**
+ * CheckpointWriter
+ *
+ * Writes backtest checkpoints without stopping the backtest. write() forks:
+ * the child has a copy-on-write image of the process as it was between two
+ * bars, serialises it to a temporary file, fsyncs it and renames it over the
+ * checkpoint, then exits. The backtest carries on as soon as fork returns and
+ * only pays for the pages it dirties while the child is writing.
+ *
+ * One write is in flight at a time. A checkpoint that comes due while the
+ * last is still being written is skipped rather than queued, the next one
+ * will be newer anyway. The checkpoint file is always a complete write.
+ */
+class CheckpointWriter
+{
+    public:
+        explicit CheckpointWriter(const std::string& _path);
+        ~CheckpointWriter();
+
+        CheckpointWriter(const CheckpointWriter&) = delete;
+        CheckpointWriter& operator=(const CheckpointWriter&) = delete;
+
+        // False if skipped because a write is in flight, or the fork failed
+        bool write(const std::function<void(std::ostream&)>& serialize);
+
+        // Block until the write in flight, if any, is done
+        void wait();
+        bool isWriting();
+
+        size_t getWrittenCount() const { return written; }
+        size_t getSkippedCount() const { return skipped; }
+        size_t getFailedCount() const { return failed; }
+        const std::string& getPath() const { return path; }
+
+    private:
+        void reap(bool block);
+
+        std::string path;
+        pid_t child;
+        size_t written;
+        size_t skipped;
+        size_t failed;
+};
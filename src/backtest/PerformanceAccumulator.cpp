@@ -0,0 +1,180 @@
+#include "PerformanceAccumulator.hpp"
+#include <algorithm>
+#include <cmath>
+#include "../util/BinaryIO.hpp"
+
+PerformanceAccumulator::PerformanceAccumulator()
+{
+    reset();
+}
+
+void
+PerformanceAccumulator::reset()
+{
+    startEquity = 0.0;
+    lastEquity = 0.0;
+    firstTimestamp = -1;
+    lastTimestamp = -1;
+    bars = 0;
+    returnCount = 0;
+    meanReturn = 0.0;
+    sumSquaredDeviations = 0.0;
+    peakEquity = 0.0;
+    maxDrawdownPercent = 0.0;
+    exposedBars = 0;
+    totalTradedValue = 0.0;
+    equitySum = 0.0;
+}
+
+void
+PerformanceAccumulator::saveState(std::ostream& out) const
+{
+    writeBinary(out, startEquity);
+    writeBinary(out, lastEquity);
+    writeBinary(out, firstTimestamp);
+    writeBinary(out, lastTimestamp);
+    writeBinary(out, static_cast<uint64_t>(bars));
+    writeBinary(out, static_cast<uint64_t>(returnCount));
+    writeBinary(out, meanReturn);
+    writeBinary(out, sumSquaredDeviations);
+    writeBinary(out, peakEquity);
+    writeBinary(out, maxDrawdownPercent);
+    writeBinary(out, static_cast<uint64_t>(exposedBars));
+    writeBinary(out, totalTradedValue);
+    writeBinary(out, equitySum);
+}
+
+void
+PerformanceAccumulator::loadState(std::istream& in)
+{
+    uint64_t barCount = 0, returns = 0, exposed = 0;
+    readBinary(in, startEquity);
+    readBinary(in, lastEquity);
+    readBinary(in, firstTimestamp);
+    readBinary(in, lastTimestamp);
+    readBinary(in, barCount);
+    readBinary(in, returns);
+    readBinary(in, meanReturn);
+    readBinary(in, sumSquaredDeviations);
+    readBinary(in, peakEquity);
+    readBinary(in, maxDrawdownPercent);
+    readBinary(in, exposed);
+    readBinary(in, totalTradedValue);
+    readBinary(in, equitySum);
+    bars = barCount;
+    returnCount = returns;
+    exposedBars = exposed;
+}
+
+void
+PerformanceAccumulator::start(double equity, int64_t timestamp)
+{
+    reset();
+    startEquity = equity;
+    lastEquity = equity;
+    peakEquity = equity;
+    firstTimestamp = timestamp;
+    lastTimestamp = timestamp;
+}
+
+void
+PerformanceAccumulator::update(double equity, int64_t timestamp, double grossExposure, double tradedValue)
+{
+    bars++;
+
+    if (lastEquity != 0) {
+        double barReturn = (equity - lastEquity) / lastEquity;
+        returnCount++;
+        double delta = barReturn - meanReturn;
+        meanReturn += delta / returnCount;
+        sumSquaredDeviations += delta * (barReturn - meanReturn);
+    }
+
+    peakEquity = std::max(peakEquity, equity);
+    if (peakEquity > 0) {
+        maxDrawdownPercent = std::max(maxDrawdownPercent, (peakEquity - equity) / peakEquity * 100.0);
+    }
+
+    if (grossExposure != 0) exposedBars++;
+    totalTradedValue += tradedValue;
+    equitySum += equity;
+
+    lastEquity = equity;
+    if (timestamp >= 0) lastTimestamp = timestamp;
+}
+
+double
+PerformanceAccumulator::getReturnVariance() const
+{
+    // Population variance, as the Sharpe ratio has always used
+    return returnCount > 0 ? sumSquaredDeviations / returnCount : 0.0;
+}
+
+double
+PerformanceAccumulator::getExposurePercent() const
+{
+    return bars > 0 ? 100.0 * exposedBars / bars : 0.0;
+}
+
+double
+PerformanceAccumulator::getTurnover() const
+{
+    // Traded notional over average equity
+    if (bars == 0 || equitySum == 0) return 0.0;
+    return totalTradedValue / (equitySum / bars);
+}
+
+double
+PerformanceAccumulator::getYearsElapsed() const
+{
+    if (firstTimestamp < 0 || lastTimestamp <= firstTimestamp) {
+        return static_cast<double>(bars + 1) / TRADING_DAYS_PER_YEAR;
+    }
+    return (lastTimestamp - firstTimestamp) / SECONDS_PER_YEAR;
+}
+
+double
+PerformanceAccumulator::getPeriodsPerYear() const
+{
+    if (firstTimestamp < 0 || lastTimestamp <= firstTimestamp || bars == 0) {
+        return TRADING_DAYS_PER_YEAR;
+    }
+    return bars / getYearsElapsed();
+}
+
+double
+PerformanceAccumulator::getSharpeRatio() const
+{
+    double stddev = std::sqrt(getReturnVariance());
+    if (stddev == 0.0) {
+        return 0.0;
+    }
+
+    // Risk-free rate taken as zero
+    return meanReturn / stddev * std::sqrt(getPeriodsPerYear());
+}
+
+double
+PerformanceAccumulator::getAnnualizedVolatility() const
+{
+    return std::sqrt(getReturnVariance() * getPeriodsPerYear()) * 100.0;
+}
+
+double
+PerformanceAccumulator::getAnnualizedReturn() const
+{
+    if (bars == 0 || startEquity == 0) {
+        return 0.0;
+    }
+
+    double totalReturn = (lastEquity - startEquity) / startEquity;
+    double years = getYearsElapsed();
+
+    if (years <= 0) {
+        return totalReturn * 100.0;
+    }
+    if (totalReturn <= -1.0) {
+        return -100.0;
+    }
+    return (std::pow(1.0 + totalReturn, 1.0 / years) - 1.0) * 100.0;
+}
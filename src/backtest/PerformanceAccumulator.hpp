@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+
+#define TRADING_DAYS_PER_YEAR 252             // Used when bar times are unknown
+#define SECONDS_PER_YEAR (365.25 * 24 * 60 * 60)
+
+/**
+ * PerformanceAccumulator
+ *
+ * Online performance statistics for a backtest, updated once per bar in
+ * constant time and space. The mean and variance of per-bar returns use
+ * Welford's method, drawdown is tracked against the running equity peak,
+ * and exposure and turnover are running totals, so nothing depends on
+ * keeping the equity curve.
+ *
+ * Bar timestamps are seconds since epoch. Annualised figures scale by the
+ * number of bars actually seen per calendar year, so minute bars inside
+ * market hours and daily bars both annualise correctly. Without usable
+ * timestamps (-1) they fall back to one bar per trading day.
+ */
+class PerformanceAccumulator
+{
+    public:
+        PerformanceAccumulator();
+
+        void start(double equity, int64_t timestamp);
+        // grossExposure is long plus absolute short value, tradedValue the notional filled this bar
+        void update(double equity, int64_t timestamp, double grossExposure, double tradedValue);
+        void reset();
+
+        // Everything above, for backtest checkpoints
+        void saveState(std::ostream& out) const;
+        void loadState(std::istream& in);
+
+        size_t getBarCount() const { return bars; }
+        double getMeanReturn() const { return meanReturn; }
+        double getReturnVariance() const;
+        double getMaxDrawdownPercent() const { return maxDrawdownPercent; }
+        double getExposurePercent() const;
+        double getTurnover() const;
+        double getPeriodsPerYear() const;
+
+        double getSharpeRatio() const;
+        double getAnnualizedReturn() const;
+        double getAnnualizedVolatility() const;
+
+    private:
+        double getYearsElapsed() const;
+
+        double startEquity;
+        double lastEquity;
+        int64_t firstTimestamp;
+        int64_t lastTimestamp;
+        size_t bars;
+
+        // Welford over per-bar returns
+        size_t returnCount;
+        double meanReturn;
+        double sumSquaredDeviations;
+
+        double peakEquity;
+        double maxDrawdownPercent;
+
+        size_t exposedBars;
+        double totalTradedValue;
+        double equitySum;
+};
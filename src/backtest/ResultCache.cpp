@@ -0,0 +1,186 @@
+#include "ResultCache.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <unistd.h>
+#include "../util/BinaryIO.hpp"
+#include "../util/Logger.hpp"
+
+namespace fs = std::filesystem;
+
+ResultCache::ResultCache(const std::string& _directory, uint64_t _maxBytes)
+: directory(_directory),
+  maxBytes(_maxBytes)
+{
+    fs::create_directories(directory);
+}
+
+std::string
+ResultCache::pathOf(const std::string& key) const
+{
+    return (fs::path(directory) / (key + RESULT_CACHE_EXTENSION)).string();
+}
+
+bool
+ResultCache::load(const std::string& key, CachedResult& result)
+{
+    std::string path = pathOf(key);
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        return false;
+    }
+
+    uint64_t magic = 0;
+    uint32_t version = 0;
+    PerformanceMetrics& m = result.metrics;
+    double executionSeconds = 0.0;
+    uint64_t points = 0;
+
+    bool ok = readBinary(in, magic) && magic == RESULT_CACHE_MAGIC &&
+              readBinary(in, version) && version == RESULT_CACHE_VERSION &&
+              readBinary(in, m.startingCapital) && readBinary(in, m.finalEquity) &&
+              readBinary(in, m.totalPnL) && readBinary(in, m.totalPnLPercent) &&
+              readBinary(in, m.maxDrawdownPercent) && readBinary(in, m.sharpeRatio) &&
+              readBinary(in, m.numTrades) && readBinary(in, m.winningTrades) &&
+              readBinary(in, m.losingTrades) && readBinary(in, m.winRate) &&
+              readBinary(in, m.avgWin) && readBinary(in, m.avgLoss) &&
+              readBinary(in, m.profitFactor) && readBinary(in, m.annualizedReturn) &&
+              readBinary(in, m.annualizedVolatility) && readBinary(in, m.exposurePercent) &&
+              readBinary(in, m.turnover) && readBinary(in, executionSeconds) &&
+              readBinary(in, points);
+
+    result.equityCurve.clear();
+    for (uint64_t i = 0; ok && i < points; i++) {
+        uint32_t length = 0;
+        double equity = 0.0;
+        ok = readBinary(in, length) && length < 256;
+        std::string timestamp(ok ? length : 0, '\0');
+        ok = ok && in.read(timestamp.data(), length) && readBinary(in, equity);
+        if (ok) {
+            result.equityCurve.push_back({std::move(timestamp), equity});
+        }
+    }
+
+    if (!ok) {
+        LOG_WARN("Result cache: removing unreadable entry {}", key);
+        in.close();
+        fs::remove(path);
+        return false;
+    }
+
+    m.executionTime = std::chrono::duration<double>(executionSeconds);
+
+    // Most recently used is the newest modification time
+    std::error_code error;
+    fs::last_write_time(path, fs::file_time_type::clock::now(), error);
+    return true;
+}
+
+void
+ResultCache::store(const std::string& key, const CachedResult& result)
+{
+    std::string path = pathOf(key);
+    std::string temporary = path + ".tmp" + std::to_string(getpid());
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            LOG_WARN("Result cache: cannot write to {}", directory);
+            return;
+        }
+
+        const PerformanceMetrics& m = result.metrics;
+        writeBinary(out, RESULT_CACHE_MAGIC);
+        writeBinary(out, static_cast<uint32_t>(RESULT_CACHE_VERSION));
+        writeBinary(out, m.startingCapital);
+        writeBinary(out, m.finalEquity);
+        writeBinary(out, m.totalPnL);
+        writeBinary(out, m.totalPnLPercent);
+        writeBinary(out, m.maxDrawdownPercent);
+        writeBinary(out, m.sharpeRatio);
+        writeBinary(out, m.numTrades);
+        writeBinary(out, m.winningTrades);
+        writeBinary(out, m.losingTrades);
+        writeBinary(out, m.winRate);
+        writeBinary(out, m.avgWin);
+        writeBinary(out, m.avgLoss);
+        writeBinary(out, m.profitFactor);
+        writeBinary(out, m.annualizedReturn);
+        writeBinary(out, m.annualizedVolatility);
+        writeBinary(out, m.exposurePercent);
+        writeBinary(out, m.turnover);
+        writeBinary(out, m.executionTime.count());
+
+        writeBinary(out, static_cast<uint64_t>(result.equityCurve.size()));
+        for (const auto& [timestamp, equity] : result.equityCurve) {
+            uint32_t length = static_cast<uint32_t>(std::min<size_t>(timestamp.size(), 255));
+            writeBinary(out, length);
+            out.write(timestamp.data(), length);
+            writeBinary(out, equity);
+        }
+
+        if (!out) {
+            out.close();
+            fs::remove(temporary);
+            LOG_WARN("Result cache: failed writing entry {}", key);
+            return;
+        }
+    }
+
+    fs::rename(temporary, path);
+    evict();
+}
+
+void
+ResultCache::evict()
+{
+    struct Entry {
+        fs::path path;
+        uint64_t size;
+        fs::file_time_type lastUsed;
+    };
+
+    std::vector<Entry> entries;
+    uint64_t total = 0;
+    for (const auto& file : fs::directory_iterator(directory)) {
+        if (!file.is_regular_file() || file.path().extension() != RESULT_CACHE_EXTENSION) continue;
+        entries.push_back({file.path(), file.file_size(), file.last_write_time()});
+        total += entries.back().size;
+    }
+    if (total <= maxBytes) {
+        return;
+    }
+
+    std::sort(entries.begin(), entries.end(),
+              [](const Entry& a, const Entry& b) { return a.lastUsed < b.lastUsed; });
+    for (const Entry& entry : entries) {
+        if (total <= maxBytes) break;
+        std::error_code error;
+        if (fs::remove(entry.path, error)) {
+            total -= entry.size;
+        }
+    }
+}
+
+uint64_t
+ResultCache::getSizeBytes() const
+{
+    uint64_t total = 0;
+    for (const auto& file : fs::directory_iterator(directory)) {
+        if (file.is_regular_file() && file.path().extension() == RESULT_CACHE_EXTENSION) {
+            total += file.file_size();
+        }
+    }
+    return total;
+}
+
+size_t
+ResultCache::getEntryCount() const
+{
+    size_t count = 0;
+    for (const auto& file : fs::directory_iterator(directory)) {
+        if (file.is_regular_file() && file.path().extension() == RESULT_CACHE_EXTENSION) {
+            count++;
+        }
+    }
+    return count;
+}
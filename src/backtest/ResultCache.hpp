@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Backtester.hpp"
+
+#define RESULT_CACHE_MAGIC 0x48434354534B4241ull    // "ABKSTCCH"
+#define RESULT_CACHE_VERSION 1
+#define RESULT_CACHE_EXTENSION ".result"
+#define RESULT_CACHE_DEFAULT_DIR ".cache/backtests"
+#define RESULT_CACHE_DEFAULT_MAX_MB 64
+
+/**
+ * What the cache keeps for a run, enough to print and save its report
+ */
+struct CachedResult
+{
+    PerformanceMetrics metrics;
+    std::vector<std::pair<std::string, double>> equityCurve;
+};
+
+/**
+ * ResultCache
+ *
+ * Finished backtest results on disk, one file per key in a directory. The
+ * key is a content hash of everything the run depends on (see
+ * Backtester::cacheKey), including BUILD_ID, a hash of the sources the
+ * binary was built from. An identical rerun is a file read, and a rebuild
+ * with any code change never reads results cached by the old code.
+ *
+ * Entries are written to a temporary file and renamed into place, and a
+ * hit touches the file, so the modification times order entries by last
+ * use. After each store the least recently used entries are removed until
+ * the directory is back under maxBytes. A file that fails to read back is
+ * treated as a miss and removed.
+ */
+class ResultCache
+{
+    public:
+        explicit ResultCache(const std::string& _directory, uint64_t _maxBytes = RESULT_CACHE_DEFAULT_MAX_MB * 1024ull * 1024ull);
+
+        bool load(const std::string& key, CachedResult& result);
+        void store(const std::string& key, const CachedResult& result);
+
+        uint64_t getSizeBytes() const;
+        size_t getEntryCount() const;
+        const std::string& getDirectory() const { return directory; }
+
+    private:
+        std::string pathOf(const std::string& key) const;
+        void evict();
+
+        std::string directory;
+        uint64_t maxBytes;
+};
@@ -1,10 +1,30 @@
 #pragma once
 
+#include <atomic>
+#include <deque>
 #include <iostream>
+#include <mutex>
+#include <span>
 #include "../oms/Order.hpp"
 #include "../oms/Position.hpp"
+#include "../util/SpscQueue.hpp"
+#include "BrokerEvent.hpp"
 
+#define BROKER_EVENT_QUEUE_SIZE 4096
 
+/**
+ * BrokerBase
+ *
+ * Order submission is asynchronous: placeOrder hands the order to the broker
+ * and returns a client order id straight away (0 if the order could not be
+ * sent). Acks, fills, partial fills and rejects arrive later as BrokerEvents
+ * on a lock-free SPSC queue that the engine thread drains with pollEvent.
+ *
+ * Events are never dropped. If the engine falls behind and the queue fills,
+ * further events go to a locked overflow list until pollEvent has drained
+ * it, so they are still delivered in order. The producer can't wait for
+ * room instead, because simulated brokers publish from the engine thread.
+ */
 class BrokerBase
 {
     public:
@@ -14,12 +34,84 @@ class BrokerBase
         virtual int connect() = 0;
         virtual int disconnect() = 0;
         virtual float getLatestPrice(std::string ticker) = 0;
-        virtual int placeOrder(Order order) = 0;
+        virtual int placeOrder(const Order& order) = 0;
         virtual Position getLatestPosition(std::string ticker) = 0;
 
+        // Submit a batch of orders in one call. clientOrderIds[i] receives what
+        // placeOrder would have returned for orders[i]. Returns the number sent.
+        // Brokers override this to put the whole batch on the wire at once.
+        virtual int placeOrders(std::span<const Order> orders, std::span<int> clientOrderIds)
+        {
+            int sent = 0;
+            for (size_t i = 0; i < orders.size(); i++) {
+                clientOrderIds[i] = placeOrder(orders[i]);
+                sent += clientOrderIds[i] != 0;
+            }
+            return sent;
+        }
+
+        // Account equity for risk limits, 0 if the broker does not report it
+        virtual double getEquity() { return 0.0; }
+
+        // Positions recovered from the OMS journal on restart. Live brokers
+        // hold their own account state and ignore them.
+        virtual void restorePosition(const Position&) {}
+
+        // Consumer side of the event queue, engine thread only. The queue holds
+        // older events than the overflow list, so it is drained first.
+        bool pollEvent(BrokerEvent& event)
+        {
+            if (events.tryPop(event)) {
+                return true;
+            }
+            if (overflowSize.load(std::memory_order_acquire) == 0) {
+                return false;
+            }
+
+            std::lock_guard<std::mutex> lock(overflowMutex);
+            event = overflow.front();
+            overflow.pop_front();
+            overflowSize.fetch_sub(1, std::memory_order_release);
+            return true;
+        }
+        size_t getPendingEventCount() const { return events.size() + overflowSize.load(); }
+
+        // Events that found the queue full and went through the overflow list
+        uint64_t getOverflowedEventCount() const { return overflowedEvents.load(); }
+
         std::string brokerName;
 
+    protected:
+        // Producer side of the event queue, one broker thread only. Once an
+        // event has overflowed, later ones follow it until the list is drained.
+        void publishEvent(const BrokerEvent& event)
+        {
+            if (overflowSize.load(std::memory_order_acquire) == 0 && events.tryPush(event)) {
+                return;
+            }
+
+            if (overflowedEvents.fetch_add(1, std::memory_order_relaxed) == 0) {
+                std::cerr << "Warning: " << brokerName
+                          << " broker event queue full, holding events until the engine catches up" << std::endl;
+            }
+            std::lock_guard<std::mutex> lock(overflowMutex);
+            overflow.push_back(event);
+            overflowSize.fetch_add(1, std::memory_order_release);
+        }
+
+        int nextClientOrderId() { return ++lastClientOrderId; }
+
+        // For simulated brokers restoring a checkpoint
+        int getLastClientOrderId() const { return lastClientOrderId; }
+        void setLastClientOrderId(int id) { lastClientOrderId = id; }
+
     private:
         bool connected;
+        int lastClientOrderId = 0;
+        SpscQueue<BrokerEvent, BROKER_EVENT_QUEUE_SIZE> events;
 
+        std::mutex overflowMutex;
+        std::deque<BrokerEvent> overflow;
+        std::atomic<size_t> overflowSize{0};
+        std::atomic<uint64_t> overflowedEvents{0};
 };
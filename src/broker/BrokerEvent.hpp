@@ -0,0 +1,59 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include "../oms/Order.hpp"
+
+enum class BrokerEventType : uint8_t {
+    ACK,
+    FILL,
+    PARTIAL_FILL,
+    REJECT
+};
+
+/**
+ * BrokerEvent
+ *
+ * Asynchronous order update published by a broker and drained by the engine
+ * thread. Fixed size and trivially copyable so it can travel through an
+ * SpscQueue without allocating.
+ */
+struct BrokerEvent
+{
+    static constexpr size_t TICKER_LENGTH = 16;
+
+    BrokerEventType type;
+    OrderType orderType;
+    int clientOrderId;      // Id returned by BrokerBase::placeOrder, 0 for broker initiated orders
+    int orderId;            // Order::getId() of the submitted order, echoed back
+    char ticker[TICKER_LENGTH];
+    float quantity;         // Filled quantity for FILL / PARTIAL_FILL
+    float price;            // Execution price for FILL / PARTIAL_FILL
+    float remainingQuantity;
+
+    std::string getTicker() const { return std::string(ticker, strnlen(ticker, TICKER_LENGTH)); }
+
+    void setTicker(std::string_view symbol)
+    {
+        std::memset(ticker, 0, TICKER_LENGTH);
+        std::memcpy(ticker, symbol.data(), std::min(symbol.size(), TICKER_LENGTH - 1));
+    }
+
+    static BrokerEvent make(BrokerEventType type, const Order& order, int clientOrderId)
+    {
+        BrokerEvent event;
+        std::memset(&event, 0, sizeof(event));
+        event.type = type;
+        event.orderType = order.getType();
+        event.clientOrderId = clientOrderId;
+        event.orderId = order.getId();
+        event.setTicker(order.getTickerView());
+        event.quantity = 0;
+        event.price = order.getPrice();
+        event.remainingQuantity = order.getQuantity();
+        return event;
+    }
+};
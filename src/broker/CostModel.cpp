@@ -0,0 +1,245 @@
+#include "CostModel.hpp"
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+#include "../util/BinaryIO.hpp"
+
+FlatCostModel::FlatCostModel(double _commissionPerTrade, double _slippagePercentage)
+: commissionPerTrade(_commissionPerTrade),
+  slippagePercentage(_slippagePercentage),
+  useFixedSeed(false),
+  randomSeed(0),
+  generator(std::random_device{}())
+{
+}
+
+void
+FlatCostModel::setRandomSeed(unsigned int seed)
+{
+    useFixedSeed = true;
+    randomSeed = seed;
+}
+
+void
+FlatCostModel::saveState(std::ostream& out) const
+{
+    // The standard engines only serialise as text
+    std::ostringstream engine;
+    engine << generator;
+    writeBinaryString(out, engine.str());
+}
+
+void
+FlatCostModel::loadState(std::istream& in)
+{
+    std::string engine;
+    if (readBinaryString(in, engine)) {
+        std::istringstream(engine) >> generator;
+    }
+}
+
+TradeCost
+FlatCostModel::quote(const Order& order, double basePrice)
+{
+    (void)order;
+    TradeCost cost{basePrice, commissionPerTrade, 0.0};
+
+    if (slippagePercentage > 0.0) {
+        // A fixed seed restarts the sequence on every fill so tests see the
+        // same slippage for every order
+        if (useFixedSeed) {
+            generator.seed(randomSeed);
+        }
+
+        std::uniform_real_distribution<> slippageDist(-slippagePercentage, slippagePercentage);
+        cost.slippage = slippageDist(generator);
+        cost.price = basePrice * (1.0 + cost.slippage);
+    }
+
+    return cost;
+}
+
+std::vector<TieredCostModel::CommissionTier>
+TieredCostModel::defaultTiers()
+{
+    return {{300000, 0.0035}, {3000000, 0.002}, {20000000, 0.0015}, {100000000, 0.001}, {0, 0.0005}};
+}
+
+TieredCostModel::TieredCostModel()
+: TieredCostModel(defaultTiers(),
+                  DEFAULT_MIN_COMMISSION,
+                  DEFAULT_MAX_COMMISSION_PERCENT,
+                  DEFAULT_MIN_SPREAD_BPS,
+                  DEFAULT_IMPACT_COEFFICIENT,
+                  DEFAULT_MAX_IMPACT,
+                  DEFAULT_VOLATILITY_WINDOW)
+{
+}
+
+TieredCostModel::TieredCostModel(std::vector<CommissionTier> _tiers,
+                                 double _minCommission,
+                                 double _maxCommissionPercent,
+                                 double minSpreadBps,
+                                 double _impactCoefficient,
+                                 double _maxImpact,
+                                 int volatilityWindow)
+: tiers(std::move(_tiers)),
+  minCommission(_minCommission),
+  maxCommissionPercent(_maxCommissionPercent),
+  minHalfSpread(minSpreadBps / 2.0 / 10000.0),
+  impactCoefficient(_impactCoefficient),
+  maxImpact(_maxImpact),
+  decay(2.0 / (std::max(volatilityWindow, 1) + 1.0)),
+  tierIndex(0),
+  sharesTraded(0.0)
+{
+    if (tiers.empty()) {
+        throw std::runtime_error("TieredCostModel: at least one commission tier is required");
+    }
+}
+
+void
+TieredCostModel::onBar(const MarketCondition& bar)
+{
+    if (bar.Close <= 0) {
+        return;
+    }
+
+    auto [it, inserted] = barCosts.try_emplace(bar.Ticker);
+    BarCosts& costs = it->second;
+
+    if (inserted) {
+        // First bar: the intrabar move is all we have to seed volatility with
+        double firstReturn = bar.Open > 0 ? std::log(bar.Close / bar.Open) : 0.0;
+        costs = {minHalfSpread, 0.0, bar.Close, firstReturn, firstReturn * firstReturn, 0.0, bar.Time};
+    } else if (costs.lastBarTime != bar.Time) {
+        double barReturn = std::log(bar.Close / costs.lastClose);
+        costs.variance += decay * (barReturn * barReturn - costs.variance);
+        costs.autocovariance += decay * (barReturn * costs.lastReturn - costs.autocovariance);
+        costs.lastReturn = barReturn;
+        costs.lastClose = bar.Close;
+        costs.lastBarTime = bar.Time;
+    }
+
+    // Roll: spread = 2 * sqrt(-cov), only defined when returns mean revert
+    double rollHalfSpread = costs.autocovariance < 0.0 ? std::sqrt(-costs.autocovariance) : 0.0;
+    costs.halfSpread = std::max(minHalfSpread, rollHalfSpread);
+    costs.impactPerSqrtShare = impactCoefficient * std::sqrt(costs.variance) / std::sqrt(std::max(bar.Volume, 1));
+}
+
+TradeCost
+TieredCostModel::quote(const Order& order, double basePrice)
+{
+    double quantity = std::abs(order.getQuantity());
+    double halfSpread = minHalfSpread;
+    double impact = 0.0;
+
+    auto it = barCosts.find(order.getTicker());
+    if (it != barCosts.end()) {
+        halfSpread = it->second.halfSpread;
+        impact = std::min(maxImpact, it->second.impactPerSqrtShare * std::sqrt(quantity));
+    }
+
+    // Buyers pay up, sellers give up, both by the same amount
+    double side = order.isBuy() ? 1.0 : -1.0;
+    double slippage = side * (halfSpread + impact);
+    double price = basePrice * (1.0 + slippage);
+
+    return TradeCost{price, commissionFor(quantity, quantity * price), slippage};
+}
+
+void
+TieredCostModel::saveState(std::ostream& out) const
+{
+    writeBinary(out, static_cast<uint64_t>(barCosts.size()));
+    for (const auto& [ticker, costs] : barCosts) {
+        writeBinaryString(out, ticker);
+        writeBinary(out, costs.halfSpread);
+        writeBinary(out, costs.impactPerSqrtShare);
+        writeBinary(out, costs.lastClose);
+        writeBinary(out, costs.lastReturn);
+        writeBinary(out, costs.variance);
+        writeBinary(out, costs.autocovariance);
+        writeBinary(out, costs.lastBarTime.nanos());
+    }
+    writeBinary(out, static_cast<uint64_t>(tierIndex));
+    writeBinary(out, sharesTraded);
+}
+
+void
+TieredCostModel::loadState(std::istream& in)
+{
+    barCosts.clear();
+    uint64_t tickers = 0;
+    readBinary(in, tickers);
+    for (uint64_t i = 0; in && i < tickers; i++) {
+        std::string ticker;
+        BarCosts costs;
+        readBinaryString(in, ticker);
+        readBinary(in, costs.halfSpread);
+        readBinary(in, costs.impactPerSqrtShare);
+        readBinary(in, costs.lastClose);
+        readBinary(in, costs.lastReturn);
+        readBinary(in, costs.variance);
+        readBinary(in, costs.autocovariance);
+        int64_t lastBarNanos = 0;
+        readBinary(in, lastBarNanos);
+        costs.lastBarTime = Timestamp::fromNanos(lastBarNanos);
+        barCosts[ticker] = std::move(costs);
+    }
+
+    uint64_t tier = 0;
+    readBinary(in, tier);
+    readBinary(in, sharesTraded);
+    tierIndex = std::min<size_t>(tier, tiers.size() - 1);
+}
+
+double
+TieredCostModel::getHalfSpread(const std::string& ticker) const
+{
+    auto it = barCosts.find(ticker);
+    return it == barCosts.end() ? minHalfSpread : it->second.halfSpread;
+}
+
+double
+TieredCostModel::commissionFor(double quantity, double tradeValue)
+{
+    // Cumulative volume only grows, so the tier index only ever moves forward
+    while (tierIndex + 1 < tiers.size() && tiers[tierIndex].upToShares > 0 &&
+           sharesTraded >= tiers[tierIndex].upToShares) {
+        tierIndex++;
+    }
+    sharesTraded += quantity;
+
+    double commission = std::max(minCommission, quantity * tiers[tierIndex].perShare);
+    return std::min(commission, maxCommissionPercent * tradeValue);
+}
+
+std::unique_ptr<CostModel>
+makeCostModel(const CostModelConfig& config)
+{
+    if (config.type == "flat") {
+        return std::make_unique<FlatCostModel>(config.commission, config.slippage);
+    }
+
+    if (config.type == "tiered") {
+        std::vector<TieredCostModel::CommissionTier> tiers = TieredCostModel::defaultTiers();
+        if (!config.tiers.empty()) {
+            tiers.clear();
+            for (const CostTier& tier : config.tiers) {
+                tiers.push_back({tier.upToShares, tier.perShare});
+            }
+        }
+
+        return std::make_unique<TieredCostModel>(tiers,
+                                                 config.minCommission,
+                                                 config.maxCommissionPercent,
+                                                 config.minSpreadBps,
+                                                 config.impactCoefficient,
+                                                 config.maxImpact,
+                                                 config.volatilityWindow);
+    }
+
+    throw std::runtime_error("Unknown cost model type: " + config.type);
+}
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "../data_access/MarketCondition.hpp"
+#include "../oms/Order.hpp"
+#include "../util/AppConfig.hpp"
+
+/**
+ * Cost of a single fill as quoted by a CostModel
+ */
+struct TradeCost {
+    double price;           // Execution price after spread, impact and slippage
+    double commission;      // Cash charged for the fill
+    double slippage;        // (price - basePrice) / basePrice, signed
+};
+
+/**
+ * CostModel
+ *
+ * Prices fills for the SimulatedBroker. onBar() is called once per market
+ * bar so a model can precompute whatever depends only on the bar (spread,
+ * volatility, impact scale), leaving quote() as a table lookup and a few
+ * multiplies on the fill path.
+ */
+class CostModel {
+    public:
+        virtual ~CostModel() = default;
+
+        virtual void onBar(const MarketCondition& bar) = 0;
+        virtual TradeCost quote(const Order& order, double basePrice) = 0;
+        virtual std::string getName() const = 0;
+
+        // Only models with a random component care about the seed
+        virtual void setRandomSeed(unsigned int seed) { (void)seed; }
+
+        // What the model has learned from bars and fills so far, for
+        // backtest checkpoints. Settings come from the config, not from here.
+        virtual void saveState(std::ostream& out) const { (void)out; }
+        virtual void loadState(std::istream& in) { (void)in; }
+};
+
+/**
+ * FlatCostModel
+ *
+ * Fixed commission per trade plus uniform random slippage in
+ * [-slippagePercentage, +slippagePercentage]. This is the behaviour the
+ * SimulatedBroker has always had and remains its default.
+ */
+class FlatCostModel : public CostModel {
+    public:
+        FlatCostModel(double commissionPerTrade = 1.0, double slippagePercentage = 0.0005);
+
+        void onBar(const MarketCondition& bar) override { (void)bar; }
+        TradeCost quote(const Order& order, double basePrice) override;
+        std::string getName() const override { return "flat"; }
+        void setRandomSeed(unsigned int seed) override;
+        void saveState(std::ostream& out) const override;
+        void loadState(std::istream& in) override;
+
+    private:
+        double commissionPerTrade;
+        double slippagePercentage;
+        bool useFixedSeed;
+        unsigned int randomSeed;
+        std::mt19937 generator;
+};
+
+/**
+ * TieredCostModel
+ *
+ * Per-share commission that steps down as cumulative traded volume crosses
+ * each tier, clamped to a minimum per order and a maximum share of the trade
+ * value. The fill price pays half the estimated spread plus square root market
+ * impact: impactCoefficient * sigma * sqrt(quantity / barVolume).
+ *
+ * Bars only carry open, close and volume, so the spread is estimated with
+ * Roll's measure (from the autocovariance of successive close-to-close
+ * returns) and floored at minSpreadBps. Sigma is an exponentially weighted
+ * estimate of the same returns.
+ */
+class TieredCostModel : public CostModel {
+    public:
+        struct CommissionTier {
+            double upToShares;      // Tier applies until cumulative volume reaches this, 0 = unbounded
+            double perShare;
+        };
+
+        TieredCostModel();
+        TieredCostModel(std::vector<CommissionTier> tiers,
+                        double minCommission,
+                        double maxCommissionPercent,
+                        double minSpreadBps,
+                        double impactCoefficient,
+                        double maxImpact,
+                        int volatilityWindow);
+
+        void onBar(const MarketCondition& bar) override;
+        TradeCost quote(const Order& order, double basePrice) override;
+        std::string getName() const override { return "tiered"; }
+        void saveState(std::ostream& out) const override;
+        void loadState(std::istream& in) override;
+
+        static std::vector<CommissionTier> defaultTiers();
+
+        double getHalfSpread(const std::string& ticker) const;
+        double getSharesTraded() const { return sharesTraded; }
+
+    private:
+        // Everything quote() needs for a ticker, refreshed on each bar
+        struct BarCosts {
+            double halfSpread;
+            double impactPerSqrtShare;
+            double lastClose;
+            double lastReturn;
+            double variance;
+            double autocovariance;
+            Timestamp lastBarTime;
+        };
+
+        double commissionFor(double quantity, double tradeValue);
+
+        std::vector<CommissionTier> tiers;
+        double minCommission;
+        double maxCommissionPercent;
+        double minHalfSpread;
+        double impactCoefficient;
+        double maxImpact;
+        double decay;
+
+        std::unordered_map<std::string, BarCosts> barCosts;
+        size_t tierIndex;
+        double sharesTraded;
+};
+
+/**
+ * Build a cost model from the "cost_model" section of the algo config, e.g.
+ * { "type": "tiered", "min_commission": 0.35, "tiers": [{"up_to_shares": 300000, "per_share": 0.0035}] }
+ * Missing fields fall back to the defaults in AppConfig.hpp.
+ */
+std::unique_ptr<CostModel> makeCostModel(const CostModelConfig& config);
@@ -0,0 +1,193 @@
+#include "ExchangeProtocol.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <cerrno>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace ExchangeProtocol
+{
+
+size_t
+messageSize(MessageType type)
+{
+    switch (type) {
+        case MessageType::NEW_ORDER: return sizeof(NewOrderMessage);
+        case MessageType::ORDER_ACK: return sizeof(OrderAckMessage);
+        case MessageType::ORDER_FILL: return sizeof(OrderFillMessage);
+        case MessageType::ORDER_REJECT: return sizeof(OrderRejectMessage);
+        case MessageType::POSITION_REQUEST: return sizeof(TickerRequestMessage);
+        case MessageType::POSITION_REPORT: return sizeof(PositionReportMessage);
+        case MessageType::PRICE_REQUEST: return sizeof(TickerRequestMessage);
+        case MessageType::PRICE_REPORT: return sizeof(PriceReportMessage);
+        default: return 0;
+    }
+}
+
+template <typename T>
+static T
+makeMessage(MessageType type)
+{
+    T message;
+    std::memset(&message, 0, sizeof(T));
+    message.header.length = sizeof(T);
+    message.header.type = type;
+    return message;
+}
+
+void
+writeTicker(char (&field)[TICKER_LENGTH], const std::string& ticker)
+{
+    std::memset(field, 0, TICKER_LENGTH);
+    std::memcpy(field, ticker.data(), std::min(ticker.size(), TICKER_LENGTH - 1));
+}
+
+std::string
+readTicker(const char (&field)[TICKER_LENGTH])
+{
+    return std::string(field, strnlen(field, TICKER_LENGTH));
+}
+
+NewOrderMessage
+encodeNewOrder(const Order& order, uint32_t clientOrderId, uint64_t sendTimeNs)
+{
+    NewOrderMessage message = makeMessage<NewOrderMessage>(MessageType::NEW_ORDER);
+    message.clientOrderId = clientOrderId;
+    message.orderType = static_cast<uint8_t>(order.getType());
+    writeTicker(message.ticker, order.getTicker());
+    message.quantity = order.getQuantity();
+    message.price = order.getPrice();
+    message.stopLossPrice = order.getStopLossPrice();
+    message.takeProfitPrice = order.getTakeProfitPrice();
+    message.sendTimeNs = sendTimeNs;
+    return message;
+}
+
+OrderAckMessage
+encodeAck(uint32_t clientOrderId, uint64_t sendTimeNs)
+{
+    OrderAckMessage message = makeMessage<OrderAckMessage>(MessageType::ORDER_ACK);
+    message.clientOrderId = clientOrderId;
+    message.sendTimeNs = sendTimeNs;
+    return message;
+}
+
+OrderFillMessage
+encodeFill(const Order& order, uint32_t clientOrderId, uint64_t sendTimeNs)
+{
+    OrderFillMessage message = makeMessage<OrderFillMessage>(MessageType::ORDER_FILL);
+    message.clientOrderId = clientOrderId;
+    message.orderType = static_cast<uint8_t>(order.getType());
+    writeTicker(message.ticker, order.getTicker());
+    message.filledQuantity = order.getQuantity();
+    message.fillPrice = order.getPrice();
+    message.sendTimeNs = sendTimeNs;
+    return message;
+}
+
+OrderRejectMessage
+encodeReject(uint32_t clientOrderId, uint64_t sendTimeNs)
+{
+    OrderRejectMessage message = makeMessage<OrderRejectMessage>(MessageType::ORDER_REJECT);
+    message.clientOrderId = clientOrderId;
+    message.sendTimeNs = sendTimeNs;
+    return message;
+}
+
+TickerRequestMessage
+encodeTickerRequest(MessageType type, const std::string& ticker)
+{
+    TickerRequestMessage message = makeMessage<TickerRequestMessage>(type);
+    writeTicker(message.ticker, ticker);
+    return message;
+}
+
+PositionReportMessage
+encodePositionReport(const Position& position)
+{
+    PositionReportMessage message = makeMessage<PositionReportMessage>(MessageType::POSITION_REPORT);
+    writeTicker(message.ticker, position.getTicker());
+    message.quantity = position.getQuantity();
+    message.avgPrice = position.getAvgPrice();
+    return message;
+}
+
+PriceReportMessage
+encodePriceReport(const std::string& ticker, float price)
+{
+    PriceReportMessage message = makeMessage<PriceReportMessage>(MessageType::PRICE_REPORT);
+    writeTicker(message.ticker, ticker);
+    message.price = price;
+    return message;
+}
+
+Order
+decodeNewOrder(const NewOrderMessage& message)
+{
+    Order order(
+        static_cast<OrderType>(message.orderType),
+        readTicker(message.ticker),
+        message.quantity,
+        message.price
+    );
+    order.setId(static_cast<int>(message.clientOrderId));
+    order.setStopLossPrice(message.stopLossPrice);
+    order.setTakeProfitPrice(message.takeProfitPrice);
+    return order;
+}
+
+uint64_t
+nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool
+sendAll(int fd, const void* buffer, size_t length)
+{
+    const char* data = static_cast<const char*>(buffer);
+    while (length > 0) {
+        ssize_t sent = ::send(fd, data, length, MSG_NOSIGNAL);
+        if (sent < 0 && errno == EINTR) continue;
+        if (sent <= 0) return false;
+        data += sent;
+        length -= sent;
+    }
+    return true;
+}
+
+bool
+recvAll(int fd, void* buffer, size_t length)
+{
+    char* data = static_cast<char*>(buffer);
+    while (length > 0) {
+        ssize_t received = ::recv(fd, data, length, 0);
+        if (received < 0 && errno == EINTR) continue;
+        if (received <= 0) return false;
+        data += received;
+        length -= received;
+    }
+    return true;
+}
+
+bool
+recvMessage(int fd, char* buffer, MessageType& type)
+{
+    if (!recvAll(fd, buffer, sizeof(MessageHeader))) {
+        return false;
+    }
+
+    MessageHeader header;
+    std::memcpy(&header, buffer, sizeof(MessageHeader));
+    size_t expected = messageSize(header.type);
+    if (expected == 0 || header.length != expected) {
+        return false;
+    }
+
+    type = header.type;
+    return recvAll(fd, buffer + sizeof(MessageHeader), expected - sizeof(MessageHeader));
+}
+
+}
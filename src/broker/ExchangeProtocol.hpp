@@ -0,0 +1,129 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include "../oms/Order.hpp"
+#include "../oms/Position.hpp"
+
+/**
+ * ExchangeProtocol
+ *
+ * Compact binary protocol spoken between the loopback exchange simulator
+ * (app/exchange_sim.cpp) and LoopbackBroker. Every message is a fixed-size
+ * packed struct that starts with a MessageHeader, so a reader only ever needs
+ * to read the header, look up the body size and read the rest.
+ *
+ * Both ends run on the same box, so fields are sent in host byte order.
+ */
+namespace ExchangeProtocol
+{
+    constexpr uint16_t DEFAULT_PORT = 9100;
+    constexpr size_t TICKER_LENGTH = 16;
+
+    enum class MessageType : uint8_t {
+        NEW_ORDER = 1,
+        ORDER_ACK = 2,
+        ORDER_FILL = 3,
+        ORDER_REJECT = 4,
+        POSITION_REQUEST = 5,
+        POSITION_REPORT = 6,
+        PRICE_REQUEST = 7,
+        PRICE_REPORT = 8
+    };
+
+#pragma pack(push, 1)
+    struct MessageHeader {
+        uint16_t length;    // Size of the full message, header included
+        MessageType type;
+    };
+
+    struct NewOrderMessage {
+        MessageHeader header;
+        uint32_t clientOrderId;
+        uint8_t orderType;
+        char ticker[TICKER_LENGTH];
+        float quantity;
+        float price;
+        float stopLossPrice;
+        float takeProfitPrice;
+        uint64_t sendTimeNs;
+    };
+
+    struct OrderAckMessage {
+        MessageHeader header;
+        uint32_t clientOrderId;
+        uint64_t sendTimeNs;    // Echoed from the order so the client can time the round trip
+    };
+
+    struct OrderFillMessage {
+        MessageHeader header;
+        uint32_t clientOrderId;
+        uint8_t orderType;
+        char ticker[TICKER_LENGTH];
+        float filledQuantity;
+        float fillPrice;
+        uint64_t sendTimeNs;
+    };
+
+    struct OrderRejectMessage {
+        MessageHeader header;
+        uint32_t clientOrderId;
+        uint64_t sendTimeNs;
+    };
+
+    struct TickerRequestMessage {
+        MessageHeader header;
+        char ticker[TICKER_LENGTH];
+    };
+
+    struct PositionReportMessage {
+        MessageHeader header;
+        char ticker[TICKER_LENGTH];
+        float quantity;
+        float avgPrice;
+    };
+
+    struct PriceReportMessage {
+        MessageHeader header;
+        char ticker[TICKER_LENGTH];
+        float price;
+    };
+#pragma pack(pop)
+
+    constexpr size_t MAX_MESSAGE_SIZE = std::max({
+        sizeof(NewOrderMessage), sizeof(OrderAckMessage), sizeof(OrderFillMessage),
+        sizeof(OrderRejectMessage), sizeof(TickerRequestMessage),
+        sizeof(PositionReportMessage), sizeof(PriceReportMessage)
+    });
+
+    // Size of a full message of the given type, or 0 if the type is unknown
+    size_t messageSize(MessageType type);
+
+    // Builders for each message type
+    NewOrderMessage encodeNewOrder(const Order& order, uint32_t clientOrderId, uint64_t sendTimeNs);
+    OrderAckMessage encodeAck(uint32_t clientOrderId, uint64_t sendTimeNs);
+    OrderFillMessage encodeFill(const Order& order, uint32_t clientOrderId, uint64_t sendTimeNs);
+    OrderRejectMessage encodeReject(uint32_t clientOrderId, uint64_t sendTimeNs);
+    TickerRequestMessage encodeTickerRequest(MessageType type, const std::string& ticker);
+    PositionReportMessage encodePositionReport(const Position& position);
+    PriceReportMessage encodePriceReport(const std::string& ticker, float price);
+
+    // Rebuild an Order from the wire format
+    Order decodeNewOrder(const NewOrderMessage& message);
+
+    // Copy a ticker in/out of the fixed-width, null padded wire field
+    void writeTicker(char (&field)[TICKER_LENGTH], const std::string& ticker);
+    std::string readTicker(const char (&field)[TICKER_LENGTH]);
+
+    // Monotonic clock in nanoseconds, used for round trip timing
+    uint64_t nowNs();
+
+    // Blocking socket helpers. Return false if the peer closed or on error.
+    bool sendAll(int fd, const void* buffer, size_t length);
+    bool recvAll(int fd, void* buffer, size_t length);
+
+    // Read one complete message into buffer (at least MAX_MESSAGE_SIZE bytes)
+    bool recvMessage(int fd, char* buffer, MessageType& type);
+}
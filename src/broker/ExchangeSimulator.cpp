@@ -0,0 +1,184 @@
+#include "ExchangeSimulator.hpp"
+#include <cstring>
+#include <stdexcept>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace ExchangeProtocol;
+
+ExchangeSimulator::ExchangeSimulator(MarketData& marketData)
+: broker(marketData),
+  listenFd(-1),
+  running(false),
+  ordersHandled(0)
+{
+}
+
+ExchangeSimulator::~ExchangeSimulator()
+{
+    stop();
+}
+
+uint16_t
+ExchangeSimulator::listen(uint16_t port)
+{
+    listenFd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (listenFd < 0) {
+        throw std::runtime_error("ExchangeSimulator: could not create socket");
+    }
+
+    int enable = 1;
+    setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    if (::bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        ::close(listenFd);
+        listenFd = -1;
+        throw std::runtime_error("ExchangeSimulator: could not bind port " + std::to_string(port));
+    }
+
+    if (::listen(listenFd, 1) < 0) {
+        ::close(listenFd);
+        listenFd = -1;
+        throw std::runtime_error("ExchangeSimulator: could not listen");
+    }
+
+    socklen_t length = sizeof(address);
+    getsockname(listenFd, reinterpret_cast<sockaddr*>(&address), &length);
+    running = true;
+
+    // Prime the broker with the current bar so price requests can be
+    // answered before the first order arrives
+    broker.process();
+
+    uint16_t boundPort = ntohs(address.sin_port);
+    std::cout << "ExchangeSimulator listening on 127.0.0.1:" << boundPort << std::endl;
+    return boundPort;
+}
+
+void
+ExchangeSimulator::run()
+{
+    while (running) {
+        int clientFd = ::accept(listenFd, nullptr, nullptr);
+        if (clientFd < 0) {
+            if (!running) break;
+            continue;
+        }
+
+        int enable = 1;
+        setsockopt(clientFd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+
+        std::cout << "ExchangeSimulator: client connected" << std::endl;
+        serveClient(clientFd);
+        ::close(clientFd);
+        std::cout << "ExchangeSimulator: client disconnected after "
+                  << ordersHandled << " orders" << std::endl;
+    }
+}
+
+void
+ExchangeSimulator::stop()
+{
+    running = false;
+    if (listenFd >= 0) {
+        // Unblocks a pending accept()
+        ::shutdown(listenFd, SHUT_RDWR);
+        ::close(listenFd);
+        listenFd = -1;
+    }
+}
+
+void
+ExchangeSimulator::serveClient(int clientFd)
+{
+    char buffer[MAX_MESSAGE_SIZE];
+    MessageType type;
+
+    while (running && recvMessage(clientFd, buffer, type)) {
+        bool ok = true;
+
+        switch (type) {
+            case MessageType::NEW_ORDER: {
+                NewOrderMessage message;
+                std::memcpy(&message, buffer, sizeof(message));
+                ok = handleNewOrder(clientFd, message);
+                break;
+            }
+            case MessageType::POSITION_REQUEST: {
+                TickerRequestMessage request;
+                std::memcpy(&request, buffer, sizeof(request));
+                PositionReportMessage report = encodePositionReport(
+                    broker.getLatestPosition(readTicker(request.ticker)));
+                ok = sendAll(clientFd, &report, sizeof(report));
+                break;
+            }
+            case MessageType::PRICE_REQUEST: {
+                TickerRequestMessage request;
+                std::memcpy(&request, buffer, sizeof(request));
+                std::string ticker = readTicker(request.ticker);
+                PriceReportMessage report = encodePriceReport(ticker, broker.getLatestPrice(ticker));
+                ok = sendAll(clientFd, &report, sizeof(report));
+                break;
+            }
+            default:
+                std::cerr << "ExchangeSimulator: unexpected message type "
+                          << static_cast<int>(type) << std::endl;
+                ok = false;
+                break;
+        }
+
+        if (!ok) break;
+    }
+}
+
+bool
+ExchangeSimulator::handleNewOrder(int clientFd, const NewOrderMessage& message)
+{
+    Order order = decodeNewOrder(message);
+    ordersHandled++;
+
+    // Match with the SimulatedBroker against the current bar, then translate
+    // the broker events it published into wire messages
+    int brokerOrderId = broker.placeOrder(order);
+    broker.process();
+
+    BrokerEvent event;
+    while (broker.pollEvent(event)) {
+        // Stop loss / take profit exits triggered by this bar are reported
+        // unsolicited with a client order id of 0
+        uint32_t clientOrderId = (event.clientOrderId == brokerOrderId) ? message.clientOrderId : 0;
+        bool sent = true;
+
+        switch (event.type) {
+            case BrokerEventType::ACK: {
+                OrderAckMessage ack = encodeAck(clientOrderId, message.sendTimeNs);
+                sent = sendAll(clientFd, &ack, sizeof(ack));
+                break;
+            }
+            case BrokerEventType::FILL:
+            case BrokerEventType::PARTIAL_FILL: {
+                Order filled(event.orderType, event.getTicker(), event.quantity, event.price);
+                OrderFillMessage fill = encodeFill(filled, clientOrderId, message.sendTimeNs);
+                sent = sendAll(clientFd, &fill, sizeof(fill));
+                break;
+            }
+            case BrokerEventType::REJECT: {
+                OrderRejectMessage reject = encodeReject(clientOrderId, message.sendTimeNs);
+                sent = sendAll(clientFd, &reject, sizeof(reject));
+                break;
+            }
+        }
+
+        if (!sent) return false;
+    }
+
+    return true;
+}
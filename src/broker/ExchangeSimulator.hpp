@@ -0,0 +1,50 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include "SimulatedBroker.hpp"
+#include "ExchangeProtocol.hpp"
+
+/**
+ * ExchangeSimulator
+ *
+ * Standalone loopback exchange. Listens on localhost, speaks ExchangeProtocol
+ * and matches incoming orders with the same SimulatedBroker logic used by the
+ * backtester. Paired with LoopbackBroker it lets us time the full live order
+ * path on one box without any external service.
+ */
+class ExchangeSimulator
+{
+    public:
+        ExchangeSimulator(MarketData& marketData);
+        ~ExchangeSimulator();
+
+        /**
+         * Bind and listen on 127.0.0.1
+         * @param port Port to listen on, 0 picks a free port
+         * @return The port actually bound
+         */
+        uint16_t listen(uint16_t port = ExchangeProtocol::DEFAULT_PORT);
+
+        /**
+         * Accept and serve clients one at a time until stop() is called
+         */
+        void run();
+
+        /**
+         * Stop accepting clients and close the listening socket
+         */
+        void stop();
+
+        SimulatedBroker& getBroker() { return broker; }
+        uint64_t getOrdersHandled() const { return ordersHandled; }
+
+    private:
+        void serveClient(int clientFd);
+        bool handleNewOrder(int clientFd, const ExchangeProtocol::NewOrderMessage& message);
+
+        SimulatedBroker broker;
+        int listenFd;
+        std::atomic<bool> running;
+        uint64_t ordersHandled;
+};
@@ -0,0 +1,302 @@
+#include "FakeTwsGateway.hpp"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "ExchangeProtocol.hpp"
+
+using namespace TwsProtocol;
+using ExchangeProtocol::sendAll;
+using ExchangeProtocol::recvAll;
+
+// Batch repeated messages into writes of roughly this size
+static constexpr size_t SEND_BATCH_BYTES = 64 * 1024;
+
+static std::vector<std::string>
+splitOnPipe(const std::string& text)
+{
+    std::vector<std::string> fields;
+    std::stringstream stream(text);
+    std::string field;
+    while (std::getline(stream, field, '|')) {
+        fields.push_back(field);
+    }
+
+    // getline drops a trailing empty field
+    if (!text.empty() && text.back() == '|') {
+        fields.push_back("");
+    }
+    return fields;
+}
+
+static std::string
+joinFields(const std::vector<std::string>& fields)
+{
+    std::string joined;
+    for (size_t i = 0; i < fields.size(); i++) {
+        if (i > 0) joined += '|';
+        joined += fields[i];
+    }
+    return joined;
+}
+
+FakeTwsGateway::FakeTwsGateway(int _serverVersion)
+: serverVersion(_serverVersion),
+  listenFd(-1),
+  clientFd(-1),
+  running(false),
+  nextStep(0),
+  messagesSent(0),
+  messagesReceived(0),
+  mismatches(0),
+  connections(0)
+{
+}
+
+FakeTwsGateway::~FakeTwsGateway()
+{
+    stop();
+}
+
+void
+FakeTwsGateway::loadSession(const std::string& path)
+{
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("FakeTwsGateway: could not open session " + path);
+    }
+
+    steps.clear();
+    nextStep = 0;
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+
+        size_t start = line.find_first_not_of(" \t\r");
+        if (start == std::string::npos || line[start] == '#') {
+            continue;
+        }
+        line = line.substr(start, line.find_last_not_of(" \t\r") - start + 1);
+
+        Step step{StepType::SEND, 1, {}, lineNumber};
+        size_t body = line.find_first_of(" \t");
+        std::string command = line.substr(0, body);
+        std::string rest = body == std::string::npos ? "" : line.substr(line.find_first_not_of(" \t", body));
+
+        if (command[0] == '>') {
+            step.type = StepType::SEND;
+            if (command.size() > 1) {
+                step.repeat = std::stoi(command.substr(1));
+            }
+            step.fields = splitOnPipe(rest);
+        } else if (command == "<") {
+            step.type = StepType::EXPECT;
+            step.fields = splitOnPipe(rest);
+        } else if (command == "!" && rest == "disconnect") {
+            step.type = StepType::DISCONNECT;
+        } else {
+            throw std::runtime_error("FakeTwsGateway: bad step on line " + std::to_string(lineNumber) + " of " + path);
+        }
+
+        steps.push_back(step);
+    }
+}
+
+uint16_t
+FakeTwsGateway::listen(uint16_t port)
+{
+    listenFd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (listenFd < 0) {
+        throw std::runtime_error("FakeTwsGateway: could not create socket");
+    }
+
+    int enable = 1;
+    setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    if (::bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+        ::listen(listenFd, 1) < 0) {
+        ::close(listenFd);
+        listenFd = -1;
+        throw std::runtime_error("FakeTwsGateway: could not listen on port " + std::to_string(port));
+    }
+
+    socklen_t length = sizeof(address);
+    getsockname(listenFd, reinterpret_cast<sockaddr*>(&address), &length);
+    running = true;
+    return ntohs(address.sin_port);
+}
+
+void
+FakeTwsGateway::run()
+{
+    while (running) {
+        int fd = ::accept(listenFd, nullptr, nullptr);
+        if (fd < 0) {
+            if (!running) break;
+            continue;
+        }
+
+        int enable = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+
+        connections++;
+        clientFd = fd;
+        serveClient(fd);
+        clientFd = -1;
+        ::close(fd);
+    }
+}
+
+void
+FakeTwsGateway::stop()
+{
+    running = false;
+    if (listenFd >= 0) {
+        ::shutdown(listenFd, SHUT_RDWR);
+        ::close(listenFd);
+        listenFd = -1;
+    }
+
+    // Unblock a client being served, run() closes it
+    int fd = clientFd.load();
+    if (fd >= 0) {
+        ::shutdown(fd, SHUT_RDWR);
+    }
+}
+
+void
+FakeTwsGateway::serveClient(int fd)
+{
+    if (!handshake(fd)) {
+        return;
+    }
+
+    while (running && nextStep < steps.size()) {
+        const Step& step = steps[nextStep++];
+
+        bool ok = true;
+        switch (step.type) {
+            case StepType::SEND:
+                ok = sendStep(fd, step);
+                break;
+            case StepType::EXPECT:
+                ok = expectStep(fd, step);
+                break;
+            case StepType::DISCONNECT:
+                return;
+        }
+
+        if (!ok) {
+            return;
+        }
+    }
+
+    // Session over, swallow whatever else the client sends until it hangs up
+    std::string payload;
+    while (running && receiveMessage(fd, payload)) {}
+}
+
+bool
+FakeTwsGateway::handshake(int fd)
+{
+    char prefix[4];
+    std::string versions;
+    if (!recvAll(fd, prefix, sizeof(prefix)) || std::string(prefix, 3) != "API" ||
+        !receiveMessage(fd, versions)) {
+        std::cerr << "FakeTwsGateway: client did not send the API handshake" << std::endl;
+        return false;
+    }
+
+    // "v<min>..<max>", answer with the highest version we both speak
+    int version = serverVersion;
+    size_t range = versions.find("..");
+    if (range != std::string::npos) {
+        version = std::min(version, std::stoi(versions.substr(range + 2)));
+    }
+
+    std::string buffer;
+    MessageWriter(buffer).add(version).add("20250101 09:30:00 EST").finish();
+    messagesSent++;
+    return sendAll(fd, buffer.data(), buffer.size());
+}
+
+bool
+FakeTwsGateway::sendStep(int fd, const Step& step)
+{
+    std::string message;
+    MessageWriter writer(message);
+    for (const std::string& field : step.fields) {
+        writer.add(field);
+    }
+    writer.finish();
+
+    std::string buffer;
+    buffer.reserve(std::min(SEND_BATCH_BYTES + message.size(), message.size() * step.repeat));
+
+    for (int i = 0; i < step.repeat; i++) {
+        buffer += message;
+        if (buffer.size() >= SEND_BATCH_BYTES) {
+            if (!sendAll(fd, buffer.data(), buffer.size())) return false;
+            buffer.clear();
+        }
+        messagesSent++;
+    }
+
+    return buffer.empty() || sendAll(fd, buffer.data(), buffer.size());
+}
+
+bool
+FakeTwsGateway::expectStep(int fd, const Step& step)
+{
+    std::string payload;
+    if (!receiveMessage(fd, payload)) {
+        return false;
+    }
+
+    std::vector<std::string> received = splitFields(payload);
+    bool matches = received.size() >= step.fields.size();
+    for (size_t i = 0; matches && i < step.fields.size(); i++) {
+        matches = step.fields[i] == "*" || step.fields[i] == received[i];
+    }
+
+    if (!matches) {
+        mismatches++;
+        std::cerr << "FakeTwsGateway: line " << step.line << " expected " << joinFields(step.fields)
+                  << " but got " << joinFields(received) << std::endl;
+    }
+    return true;
+}
+
+bool
+FakeTwsGateway::receiveMessage(int fd, std::string& payload)
+{
+    char header[HEADER_SIZE];
+    if (!recvAll(fd, header, sizeof(header))) {
+        return false;
+    }
+
+    uint32_t length = readLength(header);
+    if (length > MAX_MESSAGE_LENGTH) {
+        return false;
+    }
+
+    payload.resize(length);
+    if (length > 0 && !recvAll(fd, payload.data(), length)) {
+        return false;
+    }
+
+    messagesReceived++;
+    return true;
+}
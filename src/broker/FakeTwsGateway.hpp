@@ -0,0 +1,85 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "TwsProtocol.hpp"
+
+/**
+ * FakeTwsGateway
+ *
+ * Local stand-in for TWS / IB Gateway that replays a recorded session, so the
+ * IBKR client can be tested and benchmarked offline. The connection handshake
+ * is answered automatically; everything after it comes from the session file,
+ * one step per line with fields separated by '|':
+ *
+ *   # comment
+ *   < 71|2|0|                      expect the client to send this message.
+ *                                  '*' matches any field and fields after the
+ *                                  last one listed are not checked
+ *   > 9|1|1000                     send this message to the client
+ *   >50000 1|6|1000000|4|101.5|1|0 send it 50000 times
+ *   ! disconnect                   drop the client, continue the session on
+ *                                  the next connection
+ *
+ * A client message that doesn't match is reported and counted, and replay
+ * carries on with the next step.
+ */
+class FakeTwsGateway
+{
+    public:
+        FakeTwsGateway(int serverVersion = TwsProtocol::MAX_CLIENT_VERSION);
+        ~FakeTwsGateway();
+
+        // Throws std::runtime_error if the file can't be read or parsed
+        void loadSession(const std::string& path);
+
+        /**
+         * Bind and listen on 127.0.0.1
+         * @param port Port to listen on, 0 picks a free port
+         * @return The port actually bound
+         */
+        uint16_t listen(uint16_t port = 0);
+
+        /**
+         * Accept clients one at a time and replay the session to them until
+         * stop() is called
+         */
+        void run();
+        void stop();
+
+        // Every step of the session has been replayed
+        bool isFinished() const { return nextStep.load() >= steps.size(); }
+        uint64_t getMessagesSent() const { return messagesSent.load(); }
+        uint64_t getMessagesReceived() const { return messagesReceived.load(); }
+        int getMismatchCount() const { return mismatches.load(); }
+        int getConnectionCount() const { return connections.load(); }
+
+    private:
+        enum class StepType { EXPECT, SEND, DISCONNECT };
+
+        struct Step {
+            StepType type;
+            int repeat;
+            std::vector<std::string> fields;
+            int line;
+        };
+
+        void serveClient(int clientFd);
+        bool handshake(int clientFd);
+        bool sendStep(int clientFd, const Step& step);
+        bool expectStep(int clientFd, const Step& step);
+        bool receiveMessage(int clientFd, std::string& payload);
+
+        std::vector<Step> steps;
+        int serverVersion;
+        int listenFd;
+        std::atomic<int> clientFd;
+        std::atomic<bool> running;
+        std::atomic<size_t> nextStep;
+        std::atomic<uint64_t> messagesSent;
+        std::atomic<uint64_t> messagesReceived;
+        std::atomic<int> mismatches;
+        std::atomic<int> connections;
+};
@@ -1,7 +1,49 @@
 #include "IBKR.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
 
-IBKR::IBKR()
+using namespace TwsProtocol;
+
+// Market data request ids share the error message id space with order ids,
+// keep them well clear of anything TWS will hand out as an order id
+static constexpr int FIRST_REQUEST_ID = 1000000;
+
+// Bound the work done per wakeup so a tick flood can't starve our writes
+static constexpr int MAX_READS_PER_WAKEUP = 16;
+
+IBKR::IBKR(const std::string& _host, uint16_t _port, int _clientId)
+: host(_host),
+  port(_port),
+  clientId(_clientId),
+  initialBackoffMs(IBKR_INITIAL_BACKOFF_MS),
+  requestTimeoutMs(IBKR_REQUEST_TIMEOUT_MS),
+  socketFd(-1),
+  epollFd(-1),
+  wakeFd(-1),
+  wantWrite(false),
+  running(false),
+  sessionReady(false),
+  sessionFailed(false),
+  serverVersion(0),
+  nextOrderId(0),
+  messagesReceived(0),
+  reconnectCount(0),
+  sendOffset(0),
+  hadSession(false),
+  nextRequestId(FIRST_REQUEST_ID),
+  positionsReady(false)
 {
+    brokerName = "IBKR";
 }
 
 IBKR::~IBKR()
@@ -12,43 +54,705 @@ IBKR::~IBKR()
 void
 IBKR::SetUp()
 {
-    // if(!connect())
-        // std::runtime_error("Could not connect to IBKR broker after retries" + MAX_CONNECTION_RETRY);
-
+    if (!connect()) {
+        throw std::runtime_error("Could not connect to IBKR broker after " +
+                                 std::to_string(MAX_CONNECTION_RETRY) + " attempts");
+    }
 }
 
 int
 IBKR::connect()
 {
-    std::cout<<"We are about to connect to IBKR broker"<< std::endl;
+    if (loop.joinable()) {
+        return isConnected() ? 1 : 0;
+    }
+
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epollFd < 0 || wakeFd < 0) {
+        std::cerr << "IBKR: could not create event loop: " << std::strerror(errno) << std::endl;
+        disconnect();
+        return 0;
+    }
 
-    std::cout<<"We are connected to IBKR broker"<< std::endl;
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = wakeFd;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &event);
+
+    sessionReady = false;
+    sessionFailed = false;
+    hadSession = false;
+    running = true;
+    loop = std::thread(&IBKR::eventLoop, this);
+
+    {
+        std::unique_lock<std::mutex> lock(stateMutex);
+        stateChanged.wait(lock, [this]() { return sessionReady.load() || sessionFailed.load(); });
+    }
+
+    if (!sessionReady) {
+        disconnect();
+        return 0;
+    }
+
+    std::cout << "Connected to IBKR at " << host << ":" << port
+              << " (server version " << serverVersion << ")" << std::endl;
     return 1;
 }
 
 int
 IBKR::disconnect()
 {
-    std::cout<<"We are disconnected from IBKR broker"<< std::endl;
-    return 0;
-}
+    if (loop.joinable()) {
+        running = false;
+        wake();
+        loop.join();
+        if (hadSession) {
+            std::cout << "Disconnected from IBKR" << std::endl;
+        }
+    }
 
+    closeSocket();
+    if (epollFd >= 0) {
+        ::close(epollFd);
+        epollFd = -1;
+    }
+    if (wakeFd >= 0) {
+        ::close(wakeFd);
+        wakeFd = -1;
+    }
 
+    sessionReady = false;
+    serverVersion = 0;
+    return 1;
+}
 
-float 
+float
 IBKR::getLatestPrice(std::string ticker)
 {
-    return 0;
-}
+    std::unique_lock<std::mutex> lock(cacheMutex);
 
-int 
-IBKR::placeOrder(Order order)
-{
-    return 0;
+    int requestId;
+    auto subscription = subscriptions.find(ticker);
+    if (subscription != subscriptions.end()) {
+        requestId = subscription->second;
+    } else {
+        // First ask for this ticker, start streaming it
+        requestId = nextRequestId++;
+        subscriptions.emplace(ticker, requestId);
+        quotes[requestId] = 0;
+
+        lock.unlock();
+        send([&](std::string& buffer) { writeReqMktData(buffer, requestId, ticker); });
+        lock.lock();
+    }
+
+    cacheUpdated.wait_for(lock, std::chrono::milliseconds(requestTimeoutMs),
+                          [&]() { return quotes[requestId] > 0 || !isConnected(); });
+    return quotes[requestId];
 }
 
 Position
 IBKR::getLatestPosition(std::string ticker)
 {
-    return Position();
+    std::unique_lock<std::mutex> lock(cacheMutex);
+    cacheUpdated.wait_for(lock, std::chrono::milliseconds(requestTimeoutMs),
+                          [this]() { return positionsReady || !isConnected(); });
+
+    auto position = positions.find(ticker);
+    if (position == positions.end()) {
+        return Position(ticker, 0, 0);
+    }
+    return position->second;
+}
+
+int
+IBKR::placeOrder(const Order& order)
+{
+    if (!isConnected()) {
+        return 0;
+    }
+
+    int orderId = nextOrderId.fetch_add(1);
+    int clientOrderId = nextClientOrderId();
+    {
+        std::lock_guard<std::mutex> lock(ordersMutex);
+        workingOrders[orderId] = WorkingOrder{clientOrderId, order, 0, false};
+    }
+
+    bool queued = send([&](std::string& buffer) { writePlaceOrder(buffer, serverVersion, orderId, order); });
+    if (!queued) {
+        rejectUnsent(std::span<const int>(&orderId, 1));
+    }
+    return clientOrderId;
+}
+
+int
+IBKR::placeOrders(std::span<const Order> orders, std::span<int> clientOrderIds)
+{
+    std::fill(clientOrderIds.begin(), clientOrderIds.end(), 0);
+    if (!isConnected() || orders.empty()) {
+        return 0;
+    }
+
+    std::vector<int> orderIds(orders.size());
+    {
+        std::lock_guard<std::mutex> lock(ordersMutex);
+        for (size_t i = 0; i < orders.size(); i++) {
+            orderIds[i] = nextOrderId.fetch_add(1);
+            clientOrderIds[i] = nextClientOrderId();
+            workingOrders[orderIds[i]] = WorkingOrder{clientOrderIds[i], orders[i], 0, false};
+        }
+    }
+
+    // One outbox append and at most one wakeup for the whole batch
+    bool queued = send([&](std::string& buffer) {
+        for (size_t i = 0; i < orders.size(); i++) {
+            writePlaceOrder(buffer, serverVersion, orderIds[i], orders[i]);
+        }
+    });
+    if (!queued) {
+        rejectUnsent(orderIds);
+    }
+    return static_cast<int>(orders.size());
+}
+
+void
+IBKR::rejectUnsent(std::span<const int> orderIds)
+{
+    // The session went away between recording these orders and queueing
+    // them. onSessionLost may already have rejected some; reject the rest
+    // so none is left working without ever reaching the gateway.
+    std::lock_guard<std::mutex> lock(ordersMutex);
+    for (int orderId : orderIds) {
+        auto it = workingOrders.find(orderId);
+        if (it != workingOrders.end()) {
+            publishEvent(BrokerEvent::make(BrokerEventType::REJECT, it->second.order, it->second.clientOrderId));
+            workingOrders.erase(it);
+        }
+    }
+}
+
+template <typename Encoder>
+bool
+IBKR::send(Encoder&& encode)
+{
+    bool wasEmpty;
+    {
+        // Checked under the outbox lock, which onSessionLost holds while it
+        // ends the session, so nothing is queued into a session already gone.
+        // Market data subscriptions are replayed on the next session anyway;
+        // orders are rejected by the caller.
+        std::lock_guard<std::mutex> lock(outboxMutex);
+        if (!isConnected()) {
+            return false;
+        }
+        wasEmpty = outbox.empty();
+        encode(outbox);
+    }
+
+    // The loop drains the whole outbox per wakeup, one signal is enough
+    if (wasEmpty) {
+        wake();
+    }
+    return true;
+}
+
+void
+IBKR::wake()
+{
+    if (wakeFd >= 0) {
+        uint64_t one = 1;
+        ssize_t written = ::write(wakeFd, &one, sizeof(one));
+        (void)written;
+    }
+}
+
+void
+IBKR::eventLoop()
+{
+    int failedAttempts = 0;
+    auto handshakeDeadline = std::chrono::steady_clock::now();
+    epoll_event events[8];
+
+    while (running) {
+        if (socketFd < 0) {
+            if (failedAttempts >= MAX_CONNECTION_RETRY) {
+                std::cerr << "IBKR: giving up on " << host << ":" << port << " after "
+                          << failedAttempts << " attempts" << std::endl;
+                break;
+            }
+
+            // Exponential backoff between attempts
+            if (failedAttempts > 0 && !waitForWake(initialBackoffMs << (failedAttempts - 1))) {
+                break;
+            }
+
+            if (!openSocket()) {
+                failedAttempts++;
+                continue;
+            }
+            handshakeDeadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(requestTimeoutMs);
+        }
+
+        int timeout = -1;
+        if (!sessionReady) {
+            auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                handshakeDeadline - std::chrono::steady_clock::now());
+            timeout = std::max(0, static_cast<int>(remaining.count()));
+        }
+
+        int count = epoll_wait(epollFd, events, 8, timeout);
+        if (count < 0) {
+            if (errno == EINTR) continue;
+            std::cerr << "IBKR: epoll_wait failed: " << std::strerror(errno) << std::endl;
+            break;
+        }
+
+        bool lost = (count == 0 && !sessionReady);
+        if (lost) {
+            std::cerr << "IBKR: handshake with " << host << ":" << port << " timed out" << std::endl;
+        }
+
+        for (int i = 0; i < count && !lost; i++) {
+            if (events[i].data.fd == wakeFd) {
+                uint64_t signals;
+                ssize_t drained = ::read(wakeFd, &signals, sizeof(signals));
+                (void)drained;
+                continue;
+            }
+
+            if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+                lost = !readSocket();
+            }
+        }
+
+        // Pick up anything queued since the last pass and push what we can
+        if (!lost && running) {
+            lost = !flushWrites();
+        }
+
+        if (lost && running) {
+            bool wasReady = sessionReady;
+            onSessionLost();
+            failedAttempts = wasReady ? 0 : failedAttempts + 1;
+        }
+    }
+
+    closeSocket();
+
+    if (!sessionReady) {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        sessionFailed = true;
+    }
+    {
+        std::lock_guard<std::mutex> lock(outboxMutex);
+        sessionReady = false;
+    }
+    stateChanged.notify_all();
+    cacheUpdated.notify_all();
+}
+
+bool
+IBKR::openSocket()
+{
+    socketFd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (socketFd < 0) {
+        std::cerr << "IBKR: could not create socket: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    if (inet_pton(AF_INET, host.c_str(), &address.sin_addr) != 1) {
+        std::cerr << "IBKR: invalid host " << host << std::endl;
+        closeSocket();
+        return false;
+    }
+
+    // Non-blocking connect, completion (or refusal) is reported through epoll
+    if (::connect(socketFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 &&
+        errno != EINPROGRESS) {
+        std::cerr << "IBKR: could not connect to " << host << ":" << port
+                  << ": " << std::strerror(errno) << std::endl;
+        closeSocket();
+        return false;
+    }
+
+    int enable = 1;
+    setsockopt(socketFd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+
+    epoll_event event{};
+    event.events = EPOLLIN | EPOLLOUT;
+    event.data.fd = socketFd;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, socketFd, &event);
+    wantWrite = true;
+
+    inbound.clear();
+    sending.clear();
+    sendOffset = 0;
+    writeHandshake(sending);
+    return true;
+}
+
+void
+IBKR::closeSocket()
+{
+    if (socketFd >= 0) {
+        if (epollFd >= 0) {
+            epoll_ctl(epollFd, EPOLL_CTL_DEL, socketFd, nullptr);
+        }
+        ::close(socketFd);
+        socketFd = -1;
+    }
+    wantWrite = false;
+}
+
+bool
+IBKR::waitForWake(int timeoutMs)
+{
+    epoll_event event;
+    if (epoll_wait(epollFd, &event, 1, timeoutMs) > 0) {
+        uint64_t signals;
+        ssize_t drained = ::read(wakeFd, &signals, sizeof(signals));
+        (void)drained;
+    }
+    return running;
+}
+
+bool
+IBKR::readSocket()
+{
+    for (int i = 0; i < MAX_READS_PER_WAKEUP; i++) {
+        inbound.prepare();
+        ssize_t received = ::recv(socketFd, inbound.writePtr(), inbound.writable(), 0);
+
+        if (received > 0) {
+            inbound.commit(static_cast<size_t>(received));
+
+            // Frames are dispatched straight out of the receive buffer
+            std::string_view payload;
+            try {
+                while (inbound.nextFrame(payload)) {
+                    messagesReceived++;
+                    dispatch(payload);
+                }
+            } catch (const std::runtime_error& e) {
+                std::cerr << "IBKR: " << e.what() << std::endl;
+                return false;
+            }
+            continue;
+        }
+
+        if (received == 0) {
+            return false;
+        }
+        if (errno == EINTR) {
+            continue;
+        }
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            return true;
+        }
+
+        if (sessionReady) {
+            std::cerr << "IBKR: socket error: " << std::strerror(errno) << std::endl;
+        }
+        return false;
+    }
+    return true;
+}
+
+bool
+IBKR::flushWrites()
+{
+    if (socketFd < 0) {
+        return true;
+    }
+
+    // Only pull queued requests once the API session has been started
+    if (sendOffset == sending.size() && serverVersion > 0) {
+        std::lock_guard<std::mutex> lock(outboxMutex);
+        sending.clear();
+        sendOffset = 0;
+        sending.swap(outbox);
+    }
+
+    while (sendOffset < sending.size()) {
+        ssize_t sent = ::send(socketFd, sending.data() + sendOffset, sending.size() - sendOffset,
+                              MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (sent > 0) {
+            sendOffset += static_cast<size_t>(sent);
+            continue;
+        }
+        if (sent < 0 && errno == EINTR) {
+            continue;
+        }
+        if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        }
+        return false;
+    }
+
+    updateWriteInterest();
+    return true;
+}
+
+void
+IBKR::updateWriteInterest()
+{
+    bool needWrite = sendOffset < sending.size();
+    if (needWrite == wantWrite) {
+        return;
+    }
+
+    epoll_event event{};
+    event.events = needWrite ? (EPOLLIN | EPOLLOUT) : EPOLLIN;
+    event.data.fd = socketFd;
+    epoll_ctl(epollFd, EPOLL_CTL_MOD, socketFd, &event);
+    wantWrite = needWrite;
+}
+
+void
+IBKR::onSessionLost()
+{
+    if (sessionReady) {
+        std::cerr << "IBKR: connection to " << host << ":" << port << " lost, reconnecting" << std::endl;
+    }
+
+    closeSocket();
+    inbound.clear();
+    sending.clear();
+    sendOffset = 0;
+    {
+        std::lock_guard<std::mutex> lock(outboxMutex);
+        sessionReady = false;
+        serverVersion = 0;
+        outbox.clear();
+    }
+
+    // Orders the gateway never acknowledged may or may not have arrived.
+    // Report them rejected rather than leave the OMS waiting forever;
+    // acknowledged orders are reported again by TWS on the new session.
+    std::lock_guard<std::mutex> lock(ordersMutex);
+    for (auto it = workingOrders.begin(); it != workingOrders.end();) {
+        if (!it->second.acked) {
+            publishEvent(BrokerEvent::make(BrokerEventType::REJECT, it->second.order, it->second.clientOrderId));
+            it = workingOrders.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void
+IBKR::dispatch(std::string_view payload)
+{
+    FieldReader reader(payload);
+
+    // The first frame of a session is the server's version and time
+    if (serverVersion == 0) {
+        onServerHello(reader);
+        return;
+    }
+
+    switch (static_cast<IncomingMessage>(reader.nextInt())) {
+        case IncomingMessage::TICK_PRICE:
+            onTickPrice(reader);
+            break;
+        case IncomingMessage::ORDER_STATUS:
+            onOrderStatus(reader);
+            break;
+        case IncomingMessage::ERR_MSG:
+            onError(reader);
+            break;
+        case IncomingMessage::NEXT_VALID_ID:
+            onNextValidId(reader);
+            break;
+        case IncomingMessage::POSITION_DATA:
+            onPosition(reader);
+            break;
+        case IncomingMessage::POSITION_END:
+            onPositionEnd();
+            break;
+        default:
+            // Open orders, executions and account messages aren't used yet
+            break;
+    }
+}
+
+void
+IBKR::onServerHello(FieldReader& reader)
+{
+    int version = reader.nextInt();
+    if (version < MIN_CLIENT_VERSION) {
+        std::cerr << "IBKR: unsupported server version " << version << std::endl;
+    }
+    serverVersion = version;
+
+    // Start the API session ahead of anything the engine queued
+    writeStartApi(sending, clientId);
+    writeReqPositions(sending);
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    for (const auto& [ticker, requestId] : subscriptions) {
+        writeReqMktData(sending, requestId, ticker);
+    }
+}
+
+void
+IBKR::onNextValidId(FieldReader& reader)
+{
+    reader.skip(1);     // version
+    int orderId = reader.nextInt();
+
+    // Never step backwards over ids already handed out
+    int current = nextOrderId.load();
+    while (current < orderId && !nextOrderId.compare_exchange_weak(current, orderId)) {}
+
+    if (!sessionReady) {
+        if (hadSession) {
+            reconnectCount++;
+        }
+        hadSession = true;
+        {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            sessionReady = true;
+        }
+        stateChanged.notify_all();
+    }
+}
+
+void
+IBKR::onTickPrice(FieldReader& reader)
+{
+    reader.skip(1);     // version
+    int requestId = reader.nextInt();
+    TickType tickType = static_cast<TickType>(reader.nextInt());
+    double price = reader.nextDouble();
+
+    if (price <= 0) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto quote = quotes.find(requestId);
+    if (quote == quotes.end()) {
+        return;
+    }
+
+    // Track the last trade, falling back to the close until one prints
+    bool isLast = tickType == TickType::LAST || tickType == TickType::DELAYED_LAST;
+    bool isClose = tickType == TickType::CLOSE || tickType == TickType::DELAYED_CLOSE;
+    if (isLast || (isClose && quote->second == 0)) {
+        quote->second = static_cast<float>(price);
+        cacheUpdated.notify_all();
+    }
+}
+
+void
+IBKR::onOrderStatus(FieldReader& reader)
+{
+    if (serverVersion < MIN_SERVER_VER_MARKET_CAP_PRICE) {
+        reader.skip(1);     // version
+    }
+
+    int orderId = reader.nextInt();
+    std::string_view status = reader.next();
+    double filled = reader.nextDouble();
+    double remaining = reader.nextDouble();
+    double avgFillPrice = reader.nextDouble();
+    reader.skip(2);     // permId, parentId
+    double lastFillPrice = reader.nextDouble();
+
+    std::lock_guard<std::mutex> lock(ordersMutex);
+    auto it = workingOrders.find(orderId);
+    if (it == workingOrders.end()) {
+        return;
+    }
+    WorkingOrder& working = it->second;
+
+    if (!working.acked) {
+        working.acked = true;
+        publishEvent(BrokerEvent::make(BrokerEventType::ACK, working.order, working.clientOrderId));
+    }
+
+    // TWS repeats status messages, only report fill quantity we haven't seen
+    if (filled > working.filled) {
+        BrokerEvent event = BrokerEvent::make(
+            remaining > 0 ? BrokerEventType::PARTIAL_FILL : BrokerEventType::FILL,
+            working.order, working.clientOrderId);
+        event.quantity = static_cast<float>(filled - working.filled);
+        event.price = static_cast<float>(lastFillPrice > 0 ? lastFillPrice : avgFillPrice);
+        event.remainingQuantity = static_cast<float>(remaining);
+        working.filled = static_cast<float>(filled);
+        publishEvent(event);
+
+        if (remaining <= 0) {
+            workingOrders.erase(it);
+            return;
+        }
+    }
+
+    if (status == "Cancelled" || status == "ApiCancelled" || status == "Inactive") {
+        BrokerEvent event = BrokerEvent::make(BrokerEventType::REJECT, working.order, working.clientOrderId);
+        event.remainingQuantity = static_cast<float>(remaining);
+        publishEvent(event);
+        workingOrders.erase(it);
+    }
+}
+
+void
+IBKR::onError(FieldReader& reader)
+{
+    reader.skip(1);     // version
+    int id = reader.nextInt();
+    int code = reader.nextInt();
+    std::string_view message = reader.next();
+
+    // 2100-2199 are status notices (farm connected etc), not errors
+    if (code >= 2100 && code < 2200) {
+        return;
+    }
+    std::cerr << "IBKR error " << code << " (id " << id << "): " << message << std::endl;
+
+    // 399 is a warning attached to an order that still goes ahead
+    if (id <= 0 || code == 399) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(ordersMutex);
+    auto it = workingOrders.find(id);
+    if (it != workingOrders.end()) {
+        publishEvent(BrokerEvent::make(BrokerEventType::REJECT, it->second.order, it->second.clientOrderId));
+        workingOrders.erase(it);
+    }
+}
+
+void
+IBKR::onPosition(FieldReader& reader)
+{
+    int version = reader.nextInt();
+    reader.skip(2);     // account, conId
+    std::string symbol(reader.next());
+
+    // secType, lastTradeDate, strike, right, multiplier, exchange, currency,
+    // localSymbol and (from version 2) tradingClass
+    reader.skip(version >= 2 ? 9 : 8);
+    double quantity = reader.nextDouble();
+    double avgCost = version >= 3 ? reader.nextDouble() : 0;
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    positions[symbol] = Position(symbol, static_cast<float>(quantity), static_cast<float>(avgCost));
+}
+
+void
+IBKR::onPositionEnd()
+{
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        positionsReady = true;
+    }
+    cacheUpdated.notify_all();
 }
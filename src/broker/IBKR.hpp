@@ -1,17 +1,139 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
 #include "BrokerBase.hpp"
+#include "TwsProtocol.hpp"
 
-#define MAX_CONNECTION_RETRY 5;
+#define MAX_CONNECTION_RETRY 5
+#define IBKR_INITIAL_BACKOFF_MS 250
+#define IBKR_REQUEST_TIMEOUT_MS 5000
 
-class IBKR : public BrokerBase 
+/**
+ * IBKR
+ *
+ * Client for the TWS / IB Gateway socket API. All socket I/O happens on one
+ * event loop thread built on epoll over a non-blocking socket:
+ *
+ *  - placeOrder and market data requests append encoded messages to an
+ *    outbox and wake the loop through an eventfd, so any number of requests
+ *    can be in flight (pipelined) without waiting for replies.
+ *  - Incoming frames are parsed in place from the receive buffer and turned
+ *    into BrokerEvents (acks, partial fills, fills, rejects).
+ *  - A dropped connection is re-established with exponential backoff, up to
+ *    MAX_CONNECTION_RETRY attempts, and market data / position subscriptions
+ *    are replayed on the new session.
+ *
+ * Prices and positions are streamed into local caches, so getLatestPrice and
+ * getLatestPosition only block the first time a ticker is asked for.
+ */
+class IBKR : public BrokerBase
 {
-    IBKR();
-    ~IBKR();
+    public:
+        IBKR(const std::string& host = "127.0.0.1",
+             uint16_t port = TwsProtocol::DEFAULT_PORT,
+             int clientId = 0);
+        ~IBKR();
+
+        // Connect or throw
+        void SetUp();
+
+        // BrokerBase interface implementation
+        int connect() override;
+        int disconnect() override;
+        float getLatestPrice(std::string ticker) override;
+        int placeOrder(const Order& order) override;
+        int placeOrders(std::span<const Order> orders, std::span<int> clientOrderIds) override;
+        Position getLatestPosition(std::string ticker) override;
+
+        bool isConnected() const { return sessionReady.load(); }
+        int getServerVersion() const { return serverVersion.load(); }
+        uint64_t getMessagesReceived() const { return messagesReceived.load(); }
+        int getReconnectCount() const { return reconnectCount.load(); }
+
+        // Backoff before the first retry, doubled on every further attempt
+        void setInitialBackoff(int milliseconds) { initialBackoffMs = milliseconds; }
+        void setRequestTimeout(int milliseconds) { requestTimeoutMs = milliseconds; }
+
+    private:
+        struct WorkingOrder {
+            int clientOrderId;
+            Order order;
+            float filled;
+            bool acked;
+        };
+
+        // Event loop thread
+        void eventLoop();
+        bool openSocket();
+        void closeSocket();
+        bool readSocket();
+        bool flushWrites();
+        void updateWriteInterest();
+        void onSessionLost();
+        void dispatch(std::string_view payload);
+        void onServerHello(TwsProtocol::FieldReader& reader);
+        void onNextValidId(TwsProtocol::FieldReader& reader);
+        void onTickPrice(TwsProtocol::FieldReader& reader);
+        void onOrderStatus(TwsProtocol::FieldReader& reader);
+        void onError(TwsProtocol::FieldReader& reader);
+        void onPosition(TwsProtocol::FieldReader& reader);
+        void onPositionEnd();
+        bool waitForWake(int timeoutMs);
+
+        // Any thread: queue an encoded request and wake the loop. False if
+        // there is no session to queue it on.
+        template <typename Encoder>
+        bool send(Encoder&& encode);
+        void rejectUnsent(std::span<const int> orderIds);
+        void wake();
+
+        std::string host;
+        uint16_t port;
+        int clientId;
+        int initialBackoffMs;
+        int requestTimeoutMs;
+
+        int socketFd;
+        int epollFd;
+        int wakeFd;
+        bool wantWrite;
+        std::thread loop;
+        std::atomic<bool> running;
+        std::atomic<bool> sessionReady;
+        std::atomic<bool> sessionFailed;
+        std::atomic<int> serverVersion;
+        std::atomic<int> nextOrderId;
+        std::atomic<uint64_t> messagesReceived;
+        std::atomic<int> reconnectCount;
+
+        // Loop thread only
+        TwsProtocol::FrameBuffer inbound;
+        std::string sending;
+        size_t sendOffset;
+        bool hadSession;
+
+        // Requests waiting to be picked up by the loop
+        std::mutex outboxMutex;
+        std::string outbox;
+
+        std::mutex stateMutex;
+        std::condition_variable stateChanged;
 
-    void SetUp();
-    int connect();
-    int disconnect();
-    float getLatestPrice(std::string ticker);
-    int placeOrder(Order order);
-    Position getLatestPosition(std::string ticker);
+        // TWS order id -> order still working at the broker
+        std::mutex ordersMutex;
+        std::unordered_map<int, WorkingOrder> workingOrders;
 
+        // Streaming caches
+        std::mutex cacheMutex;
+        std::condition_variable cacheUpdated;
+        int nextRequestId;
+        std::unordered_map<std::string, int> subscriptions;  // ticker -> market data request id
+        std::unordered_map<int, float> quotes;               // request id -> last price
+        std::unordered_map<std::string, Position> positions;
+        bool positionsReady;
 };
@@ -0,0 +1,338 @@
+#include "LoopbackBroker.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace ExchangeProtocol;
+
+LoopbackBroker::LoopbackBroker(const std::string& _host, uint16_t _port)
+: host(_host),
+  port(_port),
+  socketFd(-1),
+  peerClosed(false),
+  inFlight(0),
+  rejectCount(0),
+  hasResponse(false)
+{
+    brokerName = "Loopback";
+}
+
+LoopbackBroker::~LoopbackBroker()
+{
+    disconnect();
+}
+
+int
+LoopbackBroker::connect()
+{
+    if (isConnected()) {
+        return 1;
+    }
+
+    // The exchange hung up on the last connection, release it first
+    disconnect();
+    peerClosed = false;
+
+    socketFd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (socketFd < 0) {
+        std::cerr << "LoopbackBroker: could not create socket" << std::endl;
+        return 0;
+    }
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    if (inet_pton(AF_INET, host.c_str(), &address.sin_addr) != 1 ||
+        ::connect(socketFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        std::cerr << "LoopbackBroker: could not connect to " << host << ":" << port << std::endl;
+        ::close(socketFd);
+        socketFd = -1;
+        return 0;
+    }
+
+    int enable = 1;
+    setsockopt(socketFd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+
+    reader = std::thread(&LoopbackBroker::readLoop, this);
+
+    std::cout << "Connected to loopback exchange at " << host << ":" << port << std::endl;
+    return 1;
+}
+
+int
+LoopbackBroker::disconnect()
+{
+    if (socketFd >= 0) {
+        // Wake the reader thread before closing so the fd isn't reused under it
+        ::shutdown(socketFd, SHUT_RDWR);
+        if (reader.joinable()) {
+            reader.join();
+        }
+        ::close(socketFd);
+        socketFd = -1;
+    }
+    return 1;
+}
+
+int
+LoopbackBroker::placeOrder(const Order& order)
+{
+    if (!isConnected()) {
+        return 0;
+    }
+
+    uint32_t clientOrderId = static_cast<uint32_t>(nextClientOrderId());
+    {
+        std::lock_guard<std::mutex> lock(ordersMutex);
+        orderIds[clientOrderId] = order.getId();
+    }
+    inFlight++;
+
+    NewOrderMessage message = encodeNewOrder(order, clientOrderId, nowNs());
+    if (!sendAll(socketFd, &message, sizeof(message))) {
+        std::lock_guard<std::mutex> lock(ordersMutex);
+        orderIds.erase(clientOrderId);
+        inFlight--;
+        return 0;
+    }
+
+    return static_cast<int>(clientOrderId);
+}
+
+int
+LoopbackBroker::placeOrders(std::span<const Order> orders, std::span<int> clientOrderIds)
+{
+    std::fill(clientOrderIds.begin(), clientOrderIds.end(), 0);
+    if (!isConnected() || orders.empty()) {
+        return 0;
+    }
+
+    // Encode the whole batch and write it with a single send
+    std::vector<NewOrderMessage> messages(orders.size());
+    {
+        std::lock_guard<std::mutex> lock(ordersMutex);
+        for (size_t i = 0; i < orders.size(); i++) {
+            uint32_t clientOrderId = static_cast<uint32_t>(nextClientOrderId());
+            orderIds[clientOrderId] = orders[i].getId();
+            messages[i] = encodeNewOrder(orders[i], clientOrderId, nowNs());
+            clientOrderIds[i] = static_cast<int>(clientOrderId);
+        }
+    }
+    inFlight += orders.size();
+
+    if (!sendAll(socketFd, messages.data(), messages.size() * sizeof(NewOrderMessage))) {
+        // A short write can't tell us which orders made it, treat the batch as unsent
+        std::lock_guard<std::mutex> lock(ordersMutex);
+        for (int& clientOrderId : clientOrderIds) {
+            orderIds.erase(static_cast<uint32_t>(clientOrderId));
+            clientOrderId = 0;
+        }
+        inFlight -= orders.size();
+        return 0;
+    }
+
+    return static_cast<int>(orders.size());
+}
+
+float
+LoopbackBroker::getLatestPrice(std::string ticker)
+{
+    char buffer[MAX_MESSAGE_SIZE];
+    if (!request(encodeTickerRequest(MessageType::PRICE_REQUEST, ticker), buffer)) {
+        return 0;
+    }
+
+    PriceReportMessage report;
+    std::memcpy(&report, buffer, sizeof(report));
+    return report.price;
+}
+
+Position
+LoopbackBroker::getLatestPosition(std::string ticker)
+{
+    char buffer[MAX_MESSAGE_SIZE];
+    if (!request(encodeTickerRequest(MessageType::POSITION_REQUEST, ticker), buffer)) {
+        return Position(ticker, 0, 0);
+    }
+
+    PositionReportMessage report;
+    std::memcpy(&report, buffer, sizeof(report));
+    return Position(readTicker(report.ticker), report.quantity, report.avgPrice);
+}
+
+bool
+LoopbackBroker::waitUntilIdle(int timeoutMs)
+{
+    std::unique_lock<std::mutex> lock(ordersMutex);
+    return ordersResolved.wait_for(lock, std::chrono::milliseconds(timeoutMs),
+                                   [this]() { return inFlight.load() == 0 || peerClosed.load() || socketFd < 0; })
+           && inFlight.load() == 0;
+}
+
+std::vector<uint64_t>
+LoopbackBroker::getAckLatencies() const
+{
+    std::lock_guard<std::mutex> lock(latencyMutex);
+    return ackLatencies;
+}
+
+std::vector<uint64_t>
+LoopbackBroker::getFillLatencies() const
+{
+    std::lock_guard<std::mutex> lock(latencyMutex);
+    return fillLatencies;
+}
+
+void
+LoopbackBroker::clearLatencies()
+{
+    std::lock_guard<std::mutex> lock(latencyMutex);
+    ackLatencies.clear();
+    fillLatencies.clear();
+}
+
+bool
+LoopbackBroker::request(const TickerRequestMessage& message, char* buffer)
+{
+    if (!isConnected()) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> requestLock(requestMutex);
+    std::unique_lock<std::mutex> lock(responseMutex);
+    hasResponse = false;
+
+    if (!sendAll(socketFd, &message, sizeof(message))) {
+        return false;
+    }
+
+    if (!responseReady.wait_for(lock, std::chrono::seconds(5),
+                                [this]() { return hasResponse || peerClosed.load(); })) {
+        std::cerr << "LoopbackBroker: timed out waiting for response" << std::endl;
+        return false;
+    }
+    if (!hasResponse) {
+        return false;
+    }
+
+    std::memcpy(buffer, response, MAX_MESSAGE_SIZE);
+    return true;
+}
+
+void
+LoopbackBroker::readLoop()
+{
+    char buffer[MAX_MESSAGE_SIZE];
+    MessageType type;
+
+    while (recvMessage(socketFd, buffer, type)) {
+        handleMessage(type, buffer);
+    }
+
+    // Connection gone, release anyone blocked on us. The flag is set under
+    // each waiter's mutex so none of them can miss the wakeup.
+    {
+        std::lock_guard<std::mutex> lock(ordersMutex);
+        peerClosed = true;
+        ordersResolved.notify_all();
+    }
+    std::lock_guard<std::mutex> lock(responseMutex);
+    responseReady.notify_all();
+}
+
+void
+LoopbackBroker::handleMessage(MessageType type, const char* buffer)
+{
+    uint64_t receivedAt = nowNs();
+
+    switch (type) {
+        case MessageType::ORDER_ACK: {
+            OrderAckMessage ack;
+            std::memcpy(&ack, buffer, sizeof(ack));
+            {
+                std::lock_guard<std::mutex> lock(latencyMutex);
+                ackLatencies.push_back(receivedAt - ack.sendTimeNs);
+            }
+
+            int orderId = 0;
+            {
+                std::lock_guard<std::mutex> lock(ordersMutex);
+                auto it = orderIds.find(ack.clientOrderId);
+                if (it != orderIds.end()) orderId = it->second;
+            }
+
+            BrokerEvent event{};
+            event.type = BrokerEventType::ACK;
+            event.clientOrderId = static_cast<int>(ack.clientOrderId);
+            event.orderId = orderId;
+            publishEvent(event);
+            break;
+        }
+        case MessageType::ORDER_FILL:
+        case MessageType::ORDER_REJECT: {
+            bool isFill = (type == MessageType::ORDER_FILL);
+            OrderFillMessage fill{};
+            OrderRejectMessage reject{};
+            uint32_t clientOrderId;
+
+            if (isFill) {
+                std::memcpy(&fill, buffer, sizeof(fill));
+                clientOrderId = fill.clientOrderId;
+            } else {
+                std::memcpy(&reject, buffer, sizeof(reject));
+                clientOrderId = reject.clientOrderId;
+                rejectCount++;
+            }
+
+            BrokerEvent event{};
+            event.type = isFill ? BrokerEventType::FILL : BrokerEventType::REJECT;
+            event.clientOrderId = static_cast<int>(clientOrderId);
+
+            if (isFill) {
+                event.orderType = static_cast<OrderType>(fill.orderType);
+                event.setTicker(readTicker(fill.ticker));
+                event.quantity = fill.filledQuantity;
+                event.price = fill.fillPrice;
+                if (clientOrderId != 0) {
+                    std::lock_guard<std::mutex> lock(latencyMutex);
+                    fillLatencies.push_back(receivedAt - fill.sendTimeNs);
+                }
+            }
+
+            // Unsolicited fills (client order id 0) don't resolve any order
+            std::lock_guard<std::mutex> lock(ordersMutex);
+            auto it = orderIds.find(clientOrderId);
+            if (clientOrderId == 0 || it == orderIds.end()) {
+                publishEvent(event);
+                break;
+            }
+
+            // Publish before resolving so waitUntilIdle() implies the event is queued
+            event.orderId = it->second;
+            publishEvent(event);
+            orderIds.erase(it);
+            inFlight--;
+            if (inFlight.load() == 0) {
+                ordersResolved.notify_all();
+            }
+            break;
+        }
+        case MessageType::POSITION_REPORT:
+        case MessageType::PRICE_REPORT: {
+            std::lock_guard<std::mutex> lock(responseMutex);
+            std::memcpy(response, buffer, messageSize(type));
+            hasResponse = true;
+            responseReady.notify_one();
+            break;
+        }
+        default:
+            std::cerr << "LoopbackBroker: unexpected message type "
+                      << static_cast<int>(type) << std::endl;
+            break;
+    }
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "BrokerBase.hpp"
+#include "ExchangeProtocol.hpp"
+
+/**
+ * LoopbackBroker
+ *
+ * BrokerBase client for the loopback ExchangeSimulator. placeOrder writes the
+ * order to a localhost TCP socket and returns immediately; a reader thread
+ * turns acks, fills and rejects into BrokerEvents. Every order's round trip
+ * (send -> ack, send -> fill) is timed so the live order path can be measured
+ * end to end.
+ */
+class LoopbackBroker : public BrokerBase
+{
+    public:
+        LoopbackBroker(const std::string& host = "127.0.0.1",
+                       uint16_t port = ExchangeProtocol::DEFAULT_PORT);
+        ~LoopbackBroker();
+
+        // BrokerBase interface implementation
+        int connect() override;
+        int disconnect() override;
+        int placeOrder(const Order& order) override;
+        int placeOrders(std::span<const Order> orders, std::span<int> clientOrderIds) override;
+        float getLatestPrice(std::string ticker) override;
+        Position getLatestPosition(std::string ticker) override;
+
+        // False once the exchange closes the connection, until connect() again
+        bool isConnected() const { return socketFd >= 0 && !peerClosed.load(); }
+
+        // Orders sent but not yet filled or rejected
+        size_t getInFlightCount() const { return inFlight.load(); }
+
+        // Block until every order sent so far is filled or rejected
+        bool waitUntilIdle(int timeoutMs = 5000);
+
+        // Round trip latencies in nanoseconds, one entry per order.
+        // Copies, as the reader thread keeps appending.
+        std::vector<uint64_t> getAckLatencies() const;
+        std::vector<uint64_t> getFillLatencies() const;
+        int getRejectCount() const { return rejectCount.load(); }
+        void clearLatencies();
+
+    private:
+        void readLoop();
+        void handleMessage(ExchangeProtocol::MessageType type, const char* buffer);
+        bool request(const ExchangeProtocol::TickerRequestMessage& message, char* response);
+
+        std::string host;
+        uint16_t port;
+        int socketFd;
+        std::atomic<bool> peerClosed;   // Set by the reader when the exchange hangs up
+        std::thread reader;
+        std::atomic<size_t> inFlight;
+        std::atomic<int> rejectCount;
+
+        // Original Order::getId() for each client order id still in flight
+        std::mutex ordersMutex;
+        std::condition_variable ordersResolved;
+        std::unordered_map<uint32_t, int> orderIds;
+
+        mutable std::mutex latencyMutex;
+        std::vector<uint64_t> ackLatencies;
+        std::vector<uint64_t> fillLatencies;
+
+        // Single outstanding price/position request
+        std::mutex requestMutex;
+        std::mutex responseMutex;
+        std::condition_variable responseReady;
+        bool hasResponse;
+        char response[ExchangeProtocol::MAX_MESSAGE_SIZE];
+};
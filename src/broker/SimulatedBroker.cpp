@@ -1,7 +1,9 @@
 #include "SimulatedBroker.hpp"
+#include "../util/Logger.hpp"
 #include <algorithm>
-#include <random>
 #include <cmath>
+#include <sstream>
+#include "../util/BinaryIO.hpp"
 
 SimulatedBroker::SimulatedBroker(MarketData& marketdata)
 : marketData(marketdata)
@@ -15,13 +17,19 @@ SimulatedBroker::SimulatedBroker(MarketData& marketdata)
     highestEquity = startingCapital;
     slippagePercentage = 0.0005; // 0.05% default slippage
     commissionPerTrade = 1.0;    // $1 per trade default commission
+    totalCommission = 0.0;
+    totalTradedValue = 0.0;
     totalTrades = 0;
+    longMarketValue = 0.0;
+    shortMarketValue = 0.0;
+    updatesSinceRevaluation = 0;
     step = 0;
     detailedLogging = false; // Detailed logging disabled by default
     
     // Random seed initialization
     useFixedSeed = false;
     randomSeed = 42; // Default seed
+    resetFlatCostModel();
     
     // Log the default settings
     std::cout << "SimulatedBroker initialized with:"
@@ -37,6 +45,7 @@ void SimulatedBroker::enableFixedRandomSeed(unsigned int seed)
 {
     useFixedSeed = true;
     randomSeed = seed;
+    costModel->setRandomSeed(seed);
     std::cout << "Using fixed random seed: " << seed << " for deterministic testing" << std::endl;
 }
 
@@ -55,19 +64,26 @@ void
 SimulatedBroker::process()
 {
     // Check for valid market data
-    auto data = marketData.getData();
+    const auto& data = marketData.getData();
     if(data.size() == 0)
     {
         throw std::runtime_error("No market data found");
     }
 
     // Always refresh the current condition to ensure we're using the latest data
-    // This is critical for timestamp consistency between strategy signals and order execution
-    currentCondition = marketData.getData()[step];
+    // This is critical for timestamp consistency between strategy signals and order execution.
+    // Stepping past the bars loaded so far keeps pricing off the latest one.
+    currentCondition = data[std::min(static_cast<size_t>(step), data.size() - 1)];
     simulationTime = currentCondition.DateTime;
+
+    // Only the ticker on this bar moved, re-mark just that one
+    markPrice(currentCondition.Ticker, currentCondition.Close);
+
+    // Let the cost model precompute spread and impact for this bar before any fills
+    costModel->onBar(currentCondition);
     
     // Log the current time step being processed
-    std::cout << "SimulatedBroker processing time step: " << simulationTime << std::endl;
+    LOG_DEBUG("SimulatedBroker processing time step: {}", simulationTime);
     
     // Process pending orders with latest market data
     processOrders();
@@ -106,29 +122,30 @@ SimulatedBroker::getLatestPrice(std::string ticker)
     }
     
     // If we had multiple tickers, we'd need more complex logic here
-    std::cerr << "Warning: Requested price for ticker " << ticker 
-              << " but current data is for " << currentCondition.Ticker << std::endl;
+    LOG_WARN("Requested price for ticker {} but current data is for {}", ticker, currentCondition.Ticker);
     return currentCondition.Close;
 }
 
 int 
-SimulatedBroker::placeOrder(Order order)
+SimulatedBroker::placeOrder(const Order& order)
 {
-    // Add order to pending orders queue
-    pendingOrders.push_back(order);
+    // Add order to pending orders queue and acknowledge it straight away,
+    // the fill is published when the order is processed against a bar
+    int clientOrderId = nextClientOrderId();
+    ObjectPool<Order>::Handle handle = orderPool.acquire(order);
+    orderPool[handle].setStatus(OrderStatus::ACKED);
+    pendingOrders.push_back({handle, clientOrderId});
+    publishEvent(BrokerEvent::make(BrokerEventType::ACK, order, clientOrderId));
     
     // Update to ensure we're using the most current timestamp from MarketData
     // Get fresh current data from MarketData to ensure timestamp consistency
     currentCondition = marketData.getCurrentData();
     simulationTime = currentCondition.DateTime;
     
-    std::cout << "Order placed for order " 
-              << order.getId() << " for " 
-              << order.getTypeAsString() << " with " 
-              << order.getQuantity() << " shares of " 
-              << order.getTicker() << " at " 
-              << simulationTime << std::endl;
-    return 1;
+    LOG_DEBUG("Order placed for order {} for {} with {} shares of {} at {}",
+              order.getId(), order.getTypeAsString(), order.getQuantity(),
+              order.getTickerView(), simulationTime);
+    return clientOrderId;
 }
 
 void
@@ -138,20 +155,21 @@ SimulatedBroker::processOrders()
         return;
     }
     
-    // Process all pending orders with current market data
-    std::vector<Order> remainingOrders;
-    
-    for (auto& order : pendingOrders) {
+    // Process all pending orders with current market data, compacting the
+    // ones that weren't processed to the front of the queue
+    size_t remaining = 0;
+    for (size_t i = 0; i < pendingOrders.size(); i++) {
+        PendingOrder pending = pendingOrders[i];
+        Order& order = orderPool[pending.handle];
         if (checkOrderValidity(order)) {
-            executeOrder(order);
+            executeOrder(order, pending.clientOrderId);
+            orderPool.release(pending.handle);
         } else {
             // Keep invalid orders for the next cycle
-            remainingOrders.push_back(order);
+            pendingOrders[remaining++] = pending;
         }
     }
-    
-    // Update pending orders with those that weren't processed
-    pendingOrders = remainingOrders;
+    pendingOrders.resize(remaining);
 }
 
 bool
@@ -167,70 +185,76 @@ SimulatedBroker::checkOrderValidity(const Order& order) const
 }
 
 void
-SimulatedBroker::executeOrder(Order& order)
+SimulatedBroker::executeOrder(Order& order, int clientOrderId)
 {
     // Get current price for the ticker
     float basePrice = getLatestPrice(order.getTicker());
     float originalOrderPrice = order.getPrice();
     
-    double slippageMultiplier = 1.0;
-    double actualSlippagePercent = 0.0;
-    
-    if (slippagePercentage > 0.0) {
-        std::mt19937 gen;
-        
-        if (useFixedSeed) {
-            // Use fixed seed for tests
-            gen.seed(randomSeed);
-        } else {
-            // Use random seed for real trading
-            std::random_device rd;
-            gen.seed(rd());
-        }
-        
-        std::uniform_real_distribution<> slippageDist(-slippagePercentage, slippagePercentage);
-        actualSlippagePercent = slippageDist(gen);
-        slippageMultiplier = 1.0 + actualSlippagePercent;
-    }
-    
-    double executionPrice = basePrice * slippageMultiplier;
+    TradeCost cost = costModel->quote(order, basePrice);
+    double executionPrice = cost.price;
     
     // For limit orders, check price constraints
     if (order.getType() == OrderType::LIMIT_BUY && executionPrice > order.getPrice()) {
         // Cannot execute buy limit order above limit price
-        std::cout << "Limit Buy order not executed: Market price $" << executionPrice 
-                  << " above limit price $" << order.getPrice() << std::endl;
+        LOG_INFO("Limit Buy order not executed: Market price ${:.2f} above limit price ${:.2f}",
+                 executionPrice, order.getPrice());
+        order.setStatus(OrderStatus::REJECTED);
+        publishEvent(BrokerEvent::make(BrokerEventType::REJECT, order, clientOrderId));
         return;
     } else if (order.getType() == OrderType::LIMIT_SELL && executionPrice < order.getPrice()) {
         // Cannot execute sell limit order below limit price
-        std::cout << "Limit Sell order not executed: Market price $" << executionPrice 
-                  << " below limit price $" << order.getPrice() << std::endl;
+        LOG_INFO("Limit Sell order not executed: Market price ${:.2f} below limit price ${:.2f}",
+                 executionPrice, order.getPrice());
+        order.setStatus(OrderStatus::REJECTED);
+        publishEvent(BrokerEvent::make(BrokerEventType::REJECT, order, clientOrderId));
         return;
     }
     
     // Apply commission cost
-    currentCash -= commissionPerTrade;
+    currentCash -= cost.commission;
+    totalCommission += cost.commission;
     
     // Update positions based on order
     updatePositions(order, executionPrice);
+    totalTradedValue += order.getQuantity() * executionPrice;
     
     // Add to filled orders
     order.setPrice(executionPrice); // Update with actual execution price
+    order.setStatus(OrderStatus::FILLED);
     filledOrders.push_back(order);
     totalTrades++;
-    
-    std::cout << "Order executed: " << (order.isBuy() ? "BUY" : "SELL")
-              << " " << order.getQuantity() << " shares of " << order.getTicker()
-              << " at $" << std::fixed << std::setprecision(2) << executionPrice;
-    
-    // Display slippage information
-    if (slippagePercentage > 0.0) {
-        std::cout << " (Order price: $" << std::fixed << std::setprecision(2) << originalOrderPrice
-                  << ", Slippage: " << (actualSlippagePercent >= 0 ? "+" : "")
-                  << std::fixed << std::setprecision(3) << (actualSlippagePercent * 100.0) << "%)";
+
+    BrokerEvent fill = BrokerEvent::make(BrokerEventType::FILL, order, clientOrderId);
+    fill.quantity = order.getQuantity();
+    fill.price = executionPrice;
+    fill.remainingQuantity = 0;
+    publishEvent(fill);
+    
+    // Include slippage information when there was any
+    if (cost.slippage != 0.0) {
+        LOG_INFO("Order executed: {} {} shares of {} at ${:.2f} (Order price: ${:.2f}, Slippage: {:.3f}%)",
+                 order.isBuy() ? "BUY" : "SELL", order.getQuantity(), order.getTickerView(),
+                 executionPrice, originalOrderPrice, cost.slippage * 100.0);
+    } else {
+        LOG_INFO("Order executed: {} {} shares of {} at ${:.2f}",
+                 order.isBuy() ? "BUY" : "SELL", order.getQuantity(), order.getTickerView(), executionPrice);
     }
-    
-    std::cout << std::endl;
+}
+
+void
+SimulatedBroker::restorePosition(const Position& position)
+{
+    // Book the position as a fill at its average price. Commission paid
+    // before the restart is not in the journal and is not charged again.
+    float quantity = position.getQuantity();
+    Order order{quantity < 0 ? OrderType::SELL : OrderType::BUY, position.getTicker(),
+                std::abs(quantity), position.getAvgPrice()};
+    order.setId(position.getId());
+
+    updatePositions(order, position.getAvgPrice());
+    filledOrders.push_back(order);
+    totalTrades++;
 }
 
 void
@@ -242,6 +266,7 @@ SimulatedBroker::updatePositions(const Order& order, double executionPrice)
     
     // Handle buys and sells differently using the helper method
     bool isBuy = order.isBuy();
+    ledger.onFill(ticker, isBuy ? quantity : -quantity, executionPrice);
     
     if (isBuy) {
         // Subtract cost from cash
@@ -264,20 +289,20 @@ SimulatedBroker::updatePositions(const Order& order, double executionPrice)
                         // Long position after covering short
                         existingPos.setQuantity(newTotalShares);
                         existingPos.setAvgPrice(executionPrice); // Reset average price as we're now long
-                        std::cout << "Covered short position for " << ticker << " and established long position of " 
-                                  << newTotalShares << " shares" << std::endl;
+                        LOG_INFO("Covered short position for {} and established long position of {} shares",
+                                 ticker, newTotalShares);
                     } else {
                         // Exactly covered the short position, close position
                         positionHistory.push_back(existingPos);
                         positionsByTicker.erase(ticker);
-                        std::cout << "Completely covered short position for " << ticker << std::endl;
+                        LOG_INFO("Completely covered short position for {}", ticker);
                     }
                 } else {
                     // Partially covering short position
                     existingPos.setQuantity(newTotalShares);
                     // We don't update avg price for partial short covers
-                    std::cout << "Partially covered short position for " << ticker 
-                              << ", remaining short: " << -newTotalShares << " shares" << std::endl;
+                    LOG_INFO("Partially covered short position for {}, remaining short: {} shares",
+                             ticker, -newTotalShares);
                 }
             } else {
                 // Normal buying to increase long position
@@ -288,16 +313,15 @@ SimulatedBroker::updatePositions(const Order& order, double executionPrice)
                 // Update position
                 existingPos.setQuantity(newTotalShares);
                 existingPos.setAvgPrice(newAvgPrice);
-                std::cout << "Increased long position for " << ticker << " to " 
-                          << newTotalShares << " shares at avg price $" 
-                          << std::fixed << std::setprecision(2) << newAvgPrice << std::endl;
+                LOG_INFO("Increased long position for {} to {} shares at avg price ${:.2f}",
+                         ticker, newTotalShares, newAvgPrice);
             }
         } else {
             // New position
             Position newPosition(ticker, quantity, executionPrice);
             positionsByTicker[ticker] = newPosition;
-            std::cout << "Established new long position for " << ticker << " with " 
-                      << quantity << " shares at $" << executionPrice << std::endl;
+            LOG_INFO("Established new long position for {} with {} shares at ${:.2f}",
+                     ticker, quantity, executionPrice);
         }
     } else {
         // Selling
@@ -318,21 +342,20 @@ SimulatedBroker::updatePositions(const Order& order, double executionPrice)
                         // Going short after closing long
                         existingPos.setQuantity(newTotalShares);
                         existingPos.setAvgPrice(executionPrice); // Reset average price as we're now short
-                        std::cout << "Closed long position for " << ticker 
-                                  << " and established short position of " 
-                                  << -newTotalShares << " shares" << std::endl;
+                        LOG_INFO("Closed long position for {} and established short position of {} shares",
+                                 ticker, -newTotalShares);
                     } else {
                         // Exactly closed the long position
                         positionHistory.push_back(existingPos);
                         positionsByTicker.erase(ticker);
-                        std::cout << "Completely closed long position for " << ticker << std::endl;
+                        LOG_INFO("Completely closed long position for {}", ticker);
                     }
                 } else {
                     // Partially reducing long position
                     existingPos.setQuantity(newTotalShares);
                     // Average price remains unchanged when reducing a long position
-                    std::cout << "Partially closed long position for " << ticker 
-                              << ", remaining: " << newTotalShares << " shares" << std::endl;
+                    LOG_INFO("Partially closed long position for {}, remaining: {} shares",
+                             ticker, newTotalShares);
                 }
             } else {
                 // Currently short, selling to increase short position
@@ -342,32 +365,88 @@ SimulatedBroker::updatePositions(const Order& order, double executionPrice)
                 
                 existingPos.setQuantity(newTotalShares);
                 existingPos.setAvgPrice(newAvgPrice);
-                std::cout << "Increased short position for " << ticker << " to " 
-                          << -newTotalShares << " shares at avg price $" 
-                          << std::fixed << std::setprecision(2) << newAvgPrice << std::endl;
+                LOG_INFO("Increased short position for {} to {} shares at avg price ${:.2f}",
+                         ticker, -newTotalShares, newAvgPrice);
             }
         } else {
             // No existing position, establishing a new short position
             Position newPosition(ticker, -quantity, executionPrice);
             positionsByTicker[ticker] = newPosition;
-            std::cout << "Established new short position for " << ticker << " with " 
-                      << quantity << " shares at $" << executionPrice << std::endl;
+            LOG_INFO("Established new short position for {} with {} shares at ${:.2f}",
+                     ticker, quantity, executionPrice);
         }
     }
     
-    // Update portfolio value after position change
+    // Re-mark this ticker at its new quantity and update equity
+    auto position = positionsByTicker.find(ticker);
+    markPosition(ticker, position != positionsByTicker.end() ? position->second.getQuantity() : 0.0);
     updatePortfolioValue();
 }
 
+void
+SimulatedBroker::markPrice(const std::string& ticker, double price)
+{
+    auto mark = marks.find(ticker);
+    if (mark == marks.end()) {
+        marks.emplace(ticker, Mark{0.0, price});
+        return;
+    }
+
+    // Held quantity times the price move
+    applyMarkedValue(mark->second.quantity * mark->second.price, mark->second.quantity * price);
+    mark->second.price = price;
+}
+
+void
+SimulatedBroker::markPosition(const std::string& ticker, double quantity)
+{
+    auto mark = marks.find(ticker);
+    if (mark == marks.end()) {
+        mark = marks.emplace(ticker, Mark{0.0, getLatestPrice(ticker)}).first;
+    }
+
+    applyMarkedValue(mark->second.quantity * mark->second.price, quantity * mark->second.price);
+    mark->second.quantity = quantity;
+}
+
+void
+SimulatedBroker::applyMarkedValue(double oldValue, double newValue)
+{
+    // Take the old value out of its bucket and add the new one, the position
+    // may have flipped between long and short
+    if (oldValue > 0) {
+        longMarketValue -= oldValue;
+    } else {
+        shortMarketValue -= oldValue;
+    }
+
+    if (newValue > 0) {
+        longMarketValue += newValue;
+    } else {
+        shortMarketValue += newValue;
+    }
+}
+
 void 
 SimulatedBroker::updatePortfolioValue()
 {
-    // Calculate portfolio value: cash + value of all positions
-    double portfolioValue = currentCash;
-    
+    // The running totals are already up to date, fall back to a full
+    // revaluation periodically or when a per-position breakdown is wanted
+    if (detailedLogging || ++updatesSinceRevaluation >= MARK_TO_MARKET_CHECK_INTERVAL) {
+        revaluePortfolio();
+    }
+
+    currentEquity = currentCash + longMarketValue + shortMarketValue;
+
+    // Update highest equity for drawdown calculation
+    highestEquity = std::max(highestEquity, currentEquity);
+}
+
+void
+SimulatedBroker::revaluePortfolio()
+{
     if (detailedLogging) {
-        std::cout << "\n--- Portfolio Value Calculation ---" << std::endl;
-        std::cout << "Cash: $" << std::fixed << std::setprecision(2) << currentCash << std::endl;
+        LOG_DEBUG("Portfolio value calculation, cash: ${:.2f}", currentCash);
     }
     
     // Track total long and short values separately for reporting
@@ -376,15 +455,13 @@ SimulatedBroker::updatePortfolioValue()
     
     for (const auto& pair : positionsByTicker) {
         const Position& position = pair.second;
-        std::string ticker = position.getTicker();
+        const std::string& ticker = pair.first;
         double quantity = position.getQuantity();
         double avgPrice = position.getAvgPrice();
-        double currentPrice = getLatestPrice(ticker);
+        auto mark = marks.find(ticker);
+        double currentPrice = mark != marks.end() ? mark->second.price : getLatestPrice(ticker);
         double positionValue = quantity * currentPrice;
         
-        // Add to portfolio value (works for both long and short since quantity will be negative for shorts)
-        portfolioValue += positionValue;
-        
         // Track long and short values separately
         if (quantity > 0) {
             totalLongValue += positionValue;
@@ -402,29 +479,27 @@ SimulatedBroker::updatePortfolioValue()
                 unrealizedPnLPercent = -unrealizedPnLPercent;
             }
             
-            std::cout << ticker << ": " 
-                      << (quantity > 0 ? "LONG " : "SHORT ")
-                      << std::abs(quantity) << " shares @ $" << avgPrice
-                      << ", current price: $" << currentPrice
-                      << ", value: $" << positionValue
-                      << ", unrealized P&L: $" << unrealizedPnL
-                      << " (" << (unrealizedPnLPercent >= 0 ? "+" : "") 
-                      << unrealizedPnLPercent << "%)" << std::endl;
+            LOG_DEBUG("{}: {} {} shares @ ${:.2f}, current price: ${:.2f}, value: ${:.2f}, unrealized P&L: ${:.2f} ({:.2f}%)",
+                      ticker, quantity > 0 ? "LONG" : "SHORT", std::abs(quantity), avgPrice,
+                      currentPrice, positionValue, unrealizedPnL, unrealizedPnLPercent);
         }
     }
-    
-    // Update current equity
-    currentEquity = portfolioValue;
+
+    // The running totals should only differ by accumulated rounding
+    double drift = std::abs((totalLongValue + totalShortValue) - (longMarketValue + shortMarketValue));
+    if (drift > 1e-6 * std::max(1.0, std::abs(totalLongValue) + std::abs(totalShortValue))) {
+        LOG_WARN("SimulatedBroker incremental portfolio value drifted by ${}, resynchronising", drift);
+    }
+
+    longMarketValue = totalLongValue;
+    shortMarketValue = totalShortValue;
+    updatesSinceRevaluation = 0;
     
     if (detailedLogging) {
-        std::cout << "Total Long Value: $" << std::fixed << std::setprecision(2) << totalLongValue << std::endl;
-        std::cout << "Total Short Value: $" << std::fixed << std::setprecision(2) << totalShortValue << std::endl;
-        std::cout << "Total Portfolio Value: $" << std::fixed << std::setprecision(2) << portfolioValue << std::endl;
-        std::cout << "--------------------------------\n" << std::endl;
+        double portfolioValue = currentCash + totalLongValue + totalShortValue;
+        LOG_DEBUG("Total long value: ${:.2f}, short value: ${:.2f}, portfolio value: ${:.2f}",
+                  totalLongValue, totalShortValue, portfolioValue);
     }
-    
-    // Update highest equity for drawdown calculation
-    highestEquity = std::max(highestEquity, currentEquity);
 }
 
 Position
@@ -442,11 +517,12 @@ SimulatedBroker::getLatestPosition(std::string ticker)
 void 
 SimulatedBroker::checkStopLosses()
 {
-    // Create a copy of positionsByTicker to iterate, as we might modify during iteration
-    std::map<std::string, Position> positionsCopy = positionsByTicker;
+    // Executing an exit changes positionsByTicker, so collect the exits
+    // first and execute them once the scan is done
+    exitOrders.clear();
     
     // Iterate through positions and check if current price hits stop loss
-    for (const auto& pair : positionsCopy) {
+    for (const auto& pair : positionsByTicker) {
         const Position& position = pair.second;
         std::string ticker = position.getTicker();
         double quantity = position.getQuantity();
@@ -458,48 +534,49 @@ SimulatedBroker::checkStopLosses()
         
         // Find associated order with stop loss
         for (const auto& order : filledOrders) {
-            if (order.getTicker() == ticker && order.getStopLossPrice() > 0) {
+            if (order.getTickerView() == ticker && order.getStopLossPrice() > 0) {
                 double currentPrice = getLatestPrice(ticker);
                 
                 // Handle stop loss differently for long and short positions
                 if (quantity > 0) {
                     // For LONG positions: Stop loss triggers when price falls below stop level
                     if (currentPrice <= order.getStopLossPrice()) {
-                        std::cout << "LONG position stop loss triggered for " << ticker 
-                                  << " at $" << currentPrice 
-                                  << ", stop price: " << order.getStopLossPrice() << std::endl;
+                        LOG_INFO("LONG position stop loss triggered for {} at ${:.2f}, stop price: {:.2f}",
+                                 ticker, currentPrice, order.getStopLossPrice());
                         
                         // For long positions, we SELL to exit
                         Order stopOrder(OrderType::SELL, ticker, std::abs(order.getQuantity()), currentPrice);
-                        executeOrder(stopOrder);
+                        exitOrders.push_back(stopOrder);
                         break;
                     }
                 } else {
                     // For SHORT positions: Stop loss triggers when price rises above stop level
                     if (currentPrice >= order.getStopLossPrice()) {
-                        std::cout << "SHORT position stop loss triggered for " << ticker 
-                                  << " at $" << currentPrice 
-                                  << ", stop price: " << order.getStopLossPrice() << std::endl;
+                        LOG_INFO("SHORT position stop loss triggered for {} at ${:.2f}, stop price: {:.2f}",
+                                 ticker, currentPrice, order.getStopLossPrice());
                         
                         // For short positions, we BUY to cover and exit
                         Order stopOrder(OrderType::BUY, ticker, std::abs(order.getQuantity()), currentPrice);
-                        executeOrder(stopOrder);
+                        exitOrders.push_back(stopOrder);
                         break;
                     }
                 }
             }
         }
     }
+    
+    for (Order& exitOrder : exitOrders) {
+        executeOrder(exitOrder);
+    }
 }
 
 void 
 SimulatedBroker::checkTakeProfits()
 {
-    // Create a copy of positionsByTicker to iterate, as we might modify during iteration
-    std::map<std::string, Position> positionsCopy = positionsByTicker;
+    exitOrders.clear();
     
     // Iterate through positions and check if current price hits take profit
-    for (const auto& pair : positionsCopy) {
+    for (const auto& pair : positionsByTicker) {
         const Position& position = pair.second;
         std::string ticker = position.getTicker();
         double quantity = position.getQuantity();
@@ -511,38 +588,40 @@ SimulatedBroker::checkTakeProfits()
         
         // Find associated order with take profit
         for (const auto& order : filledOrders) {
-            if (order.getTicker() == ticker && order.getTakeProfitPrice() > 0) {
+            if (order.getTickerView() == ticker && order.getTakeProfitPrice() > 0) {
                 double currentPrice = getLatestPrice(ticker);
                 
                 // Handle take profit differently for long and short positions
                 if (quantity > 0) {
                     // For LONG positions: Take profit triggers when price rises above target level
                     if (currentPrice >= order.getTakeProfitPrice()) {
-                        std::cout << "LONG position take profit triggered for " << ticker 
-                                  << " at $" << currentPrice 
-                                  << ", take profit price: " << order.getTakeProfitPrice() << std::endl;
+                        LOG_INFO("LONG position take profit triggered for {} at ${:.2f}, take profit price: {:.2f}",
+                                 ticker, currentPrice, order.getTakeProfitPrice());
                         
                         // For long positions, we SELL to exit with profit
                         Order tpOrder(OrderType::SELL, ticker, std::abs(quantity), currentPrice);
-                        executeOrder(tpOrder);
+                        exitOrders.push_back(tpOrder);
                         break;
                     }
                 } else {
                     // For SHORT positions: Take profit triggers when price falls below target level
                     if (currentPrice <= order.getTakeProfitPrice()) {
-                        std::cout << "SHORT position take profit triggered for " << ticker 
-                                  << " at $" << currentPrice 
-                                  << ", take profit price: " << order.getTakeProfitPrice() << std::endl;
+                        LOG_INFO("SHORT position take profit triggered for {} at ${:.2f}, take profit price: {:.2f}",
+                                 ticker, currentPrice, order.getTakeProfitPrice());
                         
                         // For short positions, we BUY to cover and exit with profit
                         Order tpOrder(OrderType::BUY, ticker, std::abs(quantity), currentPrice);
-                        executeOrder(tpOrder);
+                        exitOrders.push_back(tpOrder);
                         break;
                     }
                 }
             }
         }
     }
+    
+    for (Order& exitOrder : exitOrders) {
+        executeOrder(exitOrder);
+    }
 }
 
 void 
@@ -605,12 +684,37 @@ SimulatedBroker::setSlippage(double slippagePerc)
     std::cout << "SimulatedBroker: Slippage changed from ±" 
               << std::fixed << std::setprecision(3) << (oldSlippage * 100.0) 
               << "% to ±" << (slippagePercentage * 100.0) << "%" << std::endl;
+    resetFlatCostModel();
 }
 
 void 
 SimulatedBroker::setCommission(double commissionPerc) 
 {
     commissionPerTrade = commissionPerc;
+    resetFlatCostModel();
+}
+
+void
+SimulatedBroker::setCostModel(std::unique_ptr<CostModel> model)
+{
+    if (!model) {
+        throw std::runtime_error("SimulatedBroker: cost model cannot be null");
+    }
+
+    costModel = std::move(model);
+    if (useFixedSeed) {
+        costModel->setRandomSeed(randomSeed);
+    }
+    std::cout << "SimulatedBroker: Using " << costModel->getName() << " cost model" << std::endl;
+}
+
+void
+SimulatedBroker::resetFlatCostModel()
+{
+    costModel = std::make_unique<FlatCostModel>(commissionPerTrade, slippagePercentage);
+    if (useFixedSeed) {
+        costModel->setRandomSeed(randomSeed);
+    }
 }
 
 void 
@@ -626,4 +730,146 @@ void
 SimulatedBroker::setMarketData(MarketData& MarketData) 
 {
     marketData = MarketData;
-}
\ No newline at end of file
+}
+
+static void
+writeCondition(std::ostream& out, const MarketCondition& condition)
+{
+    writeBinaryString(out, condition.DateTime);
+    writeBinaryString(out, condition.Ticker);
+    writeBinary(out, condition.Open);
+    writeBinary(out, condition.Close);
+    writeBinary(out, condition.Volume);
+    writeBinaryString(out, condition.TimeInterval);
+}
+
+static void
+readCondition(std::istream& in, MarketCondition& condition)
+{
+    readBinaryString(in, condition.DateTime);
+    condition.Time = Timestamp::parse(condition.DateTime);
+    readBinaryString(in, condition.Ticker);
+    readBinary(in, condition.Open);
+    readBinary(in, condition.Close);
+    readBinary(in, condition.Volume);
+    readBinaryString(in, condition.TimeInterval);
+}
+
+void
+SimulatedBroker::saveState(std::ostream& out) const
+{
+    writeBinary(out, getLastClientOrderId());
+
+    writeBinary(out, static_cast<uint64_t>(pendingOrders.size()));
+    for (const PendingOrder& pending : pendingOrders) {
+        writeBinary(out, orderPool[pending.handle]);
+        writeBinary(out, pending.clientOrderId);
+    }
+    writeBinaryVector(out, filledOrders);
+    writeBinaryVector(out, cancelledOrders);
+    writeBinaryVector(out, positionHistory);
+
+    writeBinary(out, static_cast<uint64_t>(positionsByTicker.size()));
+    for (const auto& [ticker, position] : positionsByTicker) {
+        writeBinaryString(out, ticker);
+        writeBinary(out, position);
+    }
+    ledger.saveState(out);
+
+    writeBinary(out, static_cast<uint64_t>(marks.size()));
+    for (const auto& [ticker, mark] : marks) {
+        writeBinaryString(out, ticker);
+        writeBinary(out, mark);
+    }
+    writeBinary(out, longMarketValue);
+    writeBinary(out, shortMarketValue);
+    writeBinary(out, updatesSinceRevaluation);
+
+    writeBinary(out, totalTrades);
+    writeBinary(out, currentCash);
+    writeBinary(out, currentEquity);
+    writeBinary(out, highestEquity);
+    writeBinary(out, startingCapital);
+    writeBinary(out, totalCommission);
+    writeBinary(out, totalTradedValue);
+    writeBinary(out, step);
+    writeBinaryString(out, simulationTime);
+    writeCondition(out, currentCondition);
+
+    // Length prefixed, so a different model can skip it
+    std::ostringstream model;
+    costModel->saveState(model);
+    writeBinaryString(out, costModel->getName());
+    writeBinaryString(out, model.str());
+}
+
+void
+SimulatedBroker::loadState(std::istream& in)
+{
+    int lastClientOrderId = 0;
+    readBinary(in, lastClientOrderId);
+    setLastClientOrderId(lastClientOrderId);
+
+    orderPool.clear();
+    pendingOrders.clear();
+    exitOrders.clear();
+    uint64_t pendingCount = 0;
+    readBinary(in, pendingCount);
+    for (uint64_t i = 0; in && i < pendingCount; i++) {
+        Order order;
+        int clientOrderId = 0;
+        readBinary(in, order);
+        readBinary(in, clientOrderId);
+        pendingOrders.push_back({orderPool.acquire(order), clientOrderId});
+    }
+    readBinaryVector(in, filledOrders);
+    readBinaryVector(in, cancelledOrders);
+    readBinaryVector(in, positionHistory);
+
+    positionsByTicker.clear();
+    uint64_t positionCount = 0;
+    readBinary(in, positionCount);
+    for (uint64_t i = 0; in && i < positionCount; i++) {
+        std::string ticker;
+        Position position;
+        readBinaryString(in, ticker);
+        readBinary(in, position);
+        positionsByTicker[ticker] = position;
+    }
+    ledger.loadState(in);
+
+    marks.clear();
+    uint64_t markCount = 0;
+    readBinary(in, markCount);
+    for (uint64_t i = 0; in && i < markCount; i++) {
+        std::string ticker;
+        Mark mark;
+        readBinaryString(in, ticker);
+        readBinary(in, mark);
+        marks[ticker] = mark;
+    }
+    readBinary(in, longMarketValue);
+    readBinary(in, shortMarketValue);
+    readBinary(in, updatesSinceRevaluation);
+
+    readBinary(in, totalTrades);
+    readBinary(in, currentCash);
+    readBinary(in, currentEquity);
+    readBinary(in, highestEquity);
+    readBinary(in, startingCapital);
+    readBinary(in, totalCommission);
+    readBinary(in, totalTradedValue);
+    readBinary(in, step);
+    readBinaryString(in, simulationTime);
+    readCondition(in, currentCondition);
+
+    std::string modelName, model;
+    readBinaryString(in, modelName);
+    readBinaryString(in, model);
+    if (in && modelName == costModel->getName()) {
+        std::istringstream modelIn(model);
+        costModel->loadState(modelIn);
+    } else if (in) {
+        LOG_WARN("Checkpoint has {} cost model state, starting {} fresh", modelName, costModel->getName());
+    }
+}
@@ -1,10 +1,19 @@
 #pragma once
 
 #include "BrokerBase.hpp"
+#include "CostModel.hpp"
+#include "TradeLedger.hpp"
 #include "../data_access/MarketData.hpp"
+#include "../util/ObjectPool.hpp"
+#include <istream>
 #include <map>
 #include <memory>
+#include <ostream>
 #include <string>
+#include <unordered_map>
+
+// Full portfolio revaluation every N incremental updates, to catch drift
+#define MARK_TO_MARKET_CHECK_INTERVAL 256
 
 class SimulatedBroker : public BrokerBase {
     public:
@@ -20,9 +29,11 @@ class SimulatedBroker : public BrokerBase {
         // BrokerBase interface implementation
         int connect() override;
         int disconnect() override;
-        int placeOrder(Order order) override;
+        int placeOrder(const Order& order) override;
         float getLatestPrice(std::string ticker) override;
         Position getLatestPosition(std::string ticker) override;
+        double getEquity() override { return currentEquity; }
+        void restorePosition(const Position& position) override;
         
         // Simulation specific methods
         void process();
@@ -39,6 +50,8 @@ class SimulatedBroker : public BrokerBase {
         double getStartingCapital() const;
         const std::vector<Order>& getFilledOrders() const;
         double getCurrentCash() const { return currentCash; }
+        double getLongMarketValue() const { return longMarketValue; }
+        double getShortMarketValue() const { return shortMarketValue; }
         size_t getPendingOrdersCount() const { return pendingOrders.size(); }
         double getSlippagePercentage() const { return slippagePercentage; }
         double getCommissionPerTrade() const { return commissionPerTrade; }
@@ -49,6 +62,24 @@ class SimulatedBroker : public BrokerBase {
         void setMarketData(MarketData& marketData);
         void setCommission(double commissionPerTrade);
 
+        // Replaces the flat commission/slippage pricing, until the next
+        // setSlippage or setCommission call
+        void setCostModel(std::unique_ptr<CostModel> model);
+        const CostModel& getCostModel() const { return *costModel; }
+        double getTotalCommission() const { return totalCommission; }
+        double getTotalTradedValue() const { return totalTradedValue; }
+
+        // Fills matched into lots as they happen, for trade statistics
+        const TradeLedger& getTradeLedger() const { return ledger; }
+        void setLotMatching(LotMatching matching) { ledger.setMatching(matching); }
+
+        // Account, working orders, lots and cost model state between bars,
+        // for backtest checkpoints. Capital is part of the state, commission,
+        // slippage and seed are settings and keep their current values. The
+        // cost model's state is only restored into a model of the same kind.
+        void saveState(std::ostream& out) const;
+        void loadState(std::istream& in);
+
         
     private:
         // Order processing
@@ -56,8 +87,13 @@ class SimulatedBroker : public BrokerBase {
         void checkStopLosses();
         void checkTakeProfits();
         void updatePortfolioValue();
-        void executeOrder(Order& order);
+        void revaluePortfolio();
+        void markPrice(const std::string& ticker, double price);
+        void markPosition(const std::string& ticker, double quantity);
+        void applyMarkedValue(double oldValue, double newValue);
+        void executeOrder(Order& order, int clientOrderId = 0);
         bool checkOrderValidity(const Order& order) const;
+        void resetFlatCostModel();
         void updatePositions(const Order& order, double executionPrice);
         
         // For testing
@@ -70,13 +106,34 @@ class SimulatedBroker : public BrokerBase {
         MarketCondition currentCondition;
         
         // Orders tracking
+        // Working orders live in a pool and are queued by handle, so orders
+        // waiting across bars neither move nor allocate
+        struct PendingOrder {
+            ObjectPool<Order>::Handle handle;
+            int clientOrderId;
+        };
+        ObjectPool<Order> orderPool;
         std::vector<Order> filledOrders;
-        std::vector<Order> pendingOrders;
+        std::vector<PendingOrder> pendingOrders;
+        std::vector<Order> exitOrders;         // Stop loss / take profit exits found this bar
         std::vector<Order> cancelledOrders;
         
         // Positions and portfolio
         std::vector<Position> positionHistory;
         std::map<std::string, Position> positionsByTicker;
+        TradeLedger ledger;
+
+        // Mark-to-market state. Long and short market value are kept as
+        // running totals and adjusted only for tickers whose price or
+        // quantity changed, so a bar costs O(changed tickers), not O(positions)
+        struct Mark {
+            double quantity;
+            double price;
+        };
+        std::unordered_map<std::string, Mark> marks;
+        double longMarketValue;
+        double shortMarketValue;
+        int updatesSinceRevaluation;
         
         // Performance metrics
         int totalTrades;
@@ -86,6 +143,9 @@ class SimulatedBroker : public BrokerBase {
         double startingCapital;
         double slippagePercentage;
         double commissionPerTrade;
+        double totalCommission;
+        double totalTradedValue;       // Notional of every fill, for turnover
+        std::unique_ptr<CostModel> costModel;
         
         // Simulation state
         int step;
@@ -0,0 +1,138 @@
+#include "TradeLedger.hpp"
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include "../util/BinaryIO.hpp"
+
+LotMatching
+stringToLotMatching(const std::string& matching)
+{
+    if (matching == "fifo" || matching == "FIFO") return LotMatching::FIFO;
+    if (matching == "lifo" || matching == "LIFO") return LotMatching::LIFO;
+
+    throw std::runtime_error("Unknown lot matching: " + matching);
+}
+
+double
+TradeStats::getProfitFactor() const
+{
+    if (grossLoss < 0) {
+        return grossProfit / std::fabs(grossLoss);
+    }
+    return grossProfit > 0 ? std::numeric_limits<double>::infinity() : 0.0;
+}
+
+void
+TradeLedger::onFill(const std::string& ticker, double quantity, double price)
+{
+    std::deque<Lot>& lots = openLots[ticker];
+    double remaining = quantity;
+
+    // Close lots on the other side until the fill is used up or none are left
+    while (remaining != 0 && !lots.empty() && (lots.front().quantity > 0) != (remaining > 0)) {
+        Lot& lot = matching == LotMatching::FIFO ? lots.front() : lots.back();
+        double matched = std::min(std::fabs(remaining), std::fabs(lot.quantity));
+        double signedMatched = lot.quantity > 0 ? matched : -matched;
+
+        close(ticker, lot, signedMatched, price);
+        lot.quantity -= signedMatched;
+        remaining += signedMatched;
+
+        // Float residue from partial closes shouldn't leave a dust lot behind
+        if (std::fabs(lot.quantity) < 1e-9) {
+            if (matching == LotMatching::FIFO) {
+                lots.pop_front();
+            } else {
+                lots.pop_back();
+            }
+        }
+    }
+
+    // Whatever is left opens a new lot, flipping the side if it crossed zero
+    if (std::fabs(remaining) > 1e-9) {
+        lots.push_back(Lot{remaining, price});
+    }
+}
+
+const std::deque<Lot>*
+TradeLedger::getOpenLots(const std::string& ticker) const
+{
+    auto lots = openLots.find(ticker);
+    return lots == openLots.end() ? nullptr : &lots->second;
+}
+
+void
+TradeLedger::reset()
+{
+    openLots.clear();
+    closedLots.clear();
+    stats = TradeStats();
+}
+
+void
+TradeLedger::saveState(std::ostream& out) const
+{
+    writeBinary(out, static_cast<uint64_t>(openLots.size()));
+    for (const auto& [ticker, lots] : openLots) {
+        writeBinaryString(out, ticker);
+        writeBinaryVector(out, std::vector<Lot>(lots.begin(), lots.end()));
+    }
+
+    writeBinary(out, static_cast<uint64_t>(closedLots.size()));
+    for (const ClosedLot& lot : closedLots) {
+        writeBinaryString(out, lot.ticker);
+        writeBinary(out, lot.quantity);
+        writeBinary(out, lot.openPrice);
+        writeBinary(out, lot.closePrice);
+        writeBinary(out, lot.pnl);
+    }
+
+    writeBinary(out, stats);
+}
+
+void
+TradeLedger::loadState(std::istream& in)
+{
+    reset();
+
+    uint64_t tickers = 0;
+    readBinary(in, tickers);
+    for (uint64_t i = 0; in && i < tickers; i++) {
+        std::string ticker;
+        std::vector<Lot> lots;
+        readBinaryString(in, ticker);
+        readBinaryVector(in, lots);
+        openLots[ticker].assign(lots.begin(), lots.end());
+    }
+
+    uint64_t closed = 0;
+    readBinary(in, closed);
+    for (uint64_t i = 0; in && i < closed; i++) {
+        ClosedLot lot;
+        readBinaryString(in, lot.ticker);
+        readBinary(in, lot.quantity);
+        readBinary(in, lot.openPrice);
+        readBinary(in, lot.closePrice);
+        readBinary(in, lot.pnl);
+        closedLots.push_back(std::move(lot));
+    }
+
+    readBinary(in, stats);
+}
+
+void
+TradeLedger::close(const std::string& ticker, const Lot& lot, double quantity, double price)
+{
+    double pnl = quantity * (price - lot.price);
+    closedLots.push_back(ClosedLot{ticker, quantity, lot.price, price, pnl});
+
+    stats.closedTrades++;
+    stats.realizedPnL += pnl;
+    if (pnl > 0) {
+        stats.winningTrades++;
+        stats.grossProfit += pnl;
+    } else if (pnl < 0) {
+        stats.losingTrades++;
+        stats.grossLoss += pnl;
+    }
+}
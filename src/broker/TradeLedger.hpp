@@ -0,0 +1,89 @@
+#pragma once
+
+#include <deque>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+enum class LotMatching {
+    FIFO,
+    LIFO
+};
+
+LotMatching stringToLotMatching(const std::string& matching);
+
+/**
+ * An open lot, quantity is negative for a short
+ */
+struct Lot {
+    double quantity;
+    double price;
+};
+
+/**
+ * The part of a lot closed by one fill
+ */
+struct ClosedLot {
+    std::string ticker;
+    double quantity;        // Negative if the lot was short
+    double openPrice;
+    double closePrice;
+    double pnl;
+};
+
+/**
+ * Running trade statistics over closed lots. A lot closed at its open price
+ * counts as a trade but neither a win nor a loss.
+ */
+struct TradeStats {
+    int closedTrades = 0;
+    int winningTrades = 0;
+    int losingTrades = 0;
+    double grossProfit = 0.0;
+    double grossLoss = 0.0;     // Negative or zero
+    double realizedPnL = 0.0;
+
+    double getWinRate() const { return closedTrades > 0 ? 100.0 * winningTrades / closedTrades : 0.0; }
+    double getAvgWin() const { return winningTrades > 0 ? grossProfit / winningTrades : 0.0; }
+    double getAvgLoss() const { return losingTrades > 0 ? grossLoss / losingTrades : 0.0; }
+    double getProfitFactor() const;
+};
+
+/**
+ * TradeLedger
+ *
+ * Open lots per ticker, matched against opposing fills first in first out
+ * (or last in first out) as the fills happen. Every matched piece is recorded
+ * as a ClosedLot with its realized PnL at fill prices, before commission,
+ * and folded into the running TradeStats, so the statistics cost O(1) per
+ * lot closed and never need recomputing.
+ */
+class TradeLedger
+{
+    public:
+        explicit TradeLedger(LotMatching _matching = LotMatching::FIFO) : matching(_matching) {}
+
+        // quantity is signed, positive for a buy
+        void onFill(const std::string& ticker, double quantity, double price);
+
+        void setMatching(LotMatching _matching) { matching = _matching; }
+        LotMatching getMatching() const { return matching; }
+        const TradeStats& getStats() const { return stats; }
+        const std::vector<ClosedLot>& getClosedLots() const { return closedLots; }
+        const std::deque<Lot>* getOpenLots(const std::string& ticker) const;
+        void reset();
+
+        // Open lots, closed lots and stats, not the matching rule
+        void saveState(std::ostream& out) const;
+        void loadState(std::istream& in);
+
+    private:
+        void close(const std::string& ticker, const Lot& lot, double quantity, double price);
+
+        LotMatching matching;
+        std::unordered_map<std::string, std::deque<Lot>> openLots;
+        std::vector<ClosedLot> closedLots;
+        TradeStats stats;
+};
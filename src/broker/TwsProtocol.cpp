@@ -0,0 +1,434 @@
+#include "TwsProtocol.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+
+namespace TwsProtocol
+{
+    std::string_view
+    FieldReader::next()
+    {
+        size_t end = remaining.find('\0');
+        if (end == std::string_view::npos) {
+            // Unterminated trailing field, take what is left
+            std::string_view field = remaining;
+            remaining = {};
+            return field;
+        }
+
+        std::string_view field = remaining.substr(0, end);
+        remaining.remove_prefix(end + 1);
+        return field;
+    }
+
+    int
+    FieldReader::nextInt()
+    {
+        std::string_view field = next();
+        int value = 0;
+        std::from_chars(field.data(), field.data() + field.size(), value);
+        return value;
+    }
+
+    double
+    FieldReader::nextDouble()
+    {
+        std::string_view field = next();
+        double value = 0;
+        std::from_chars(field.data(), field.data() + field.size(), value);
+        return value;
+    }
+
+    void
+    FieldReader::skip(size_t count)
+    {
+        for (size_t i = 0; i < count && hasMore(); i++) {
+            next();
+        }
+    }
+
+    MessageWriter::MessageWriter(std::string& _buffer)
+    : buffer(_buffer),
+      start(_buffer.size())
+    {
+        buffer.append(HEADER_SIZE, '\0');
+    }
+
+    MessageWriter&
+    MessageWriter::add(std::string_view field)
+    {
+        buffer.append(field);
+        buffer.push_back('\0');
+        return *this;
+    }
+
+    MessageWriter&
+    MessageWriter::add(int value)
+    {
+        char digits[16];
+        auto result = std::to_chars(digits, digits + sizeof(digits), value);
+        return add(std::string_view(digits, result.ptr - digits));
+    }
+
+    MessageWriter&
+    MessageWriter::add(double value)
+    {
+        char digits[32];
+        auto result = std::to_chars(digits, digits + sizeof(digits), value);
+        return add(std::string_view(digits, result.ptr - digits));
+    }
+
+    void
+    MessageWriter::finish()
+    {
+        writeLength(buffer.data() + start, static_cast<uint32_t>(buffer.size() - start - HEADER_SIZE));
+    }
+
+    FrameBuffer::FrameBuffer(size_t initialCapacity)
+    : data(initialCapacity),
+      readPos(0),
+      writePos(0)
+    {
+    }
+
+    void
+    FrameBuffer::prepare(size_t minFree)
+    {
+        if (writable() >= minFree) {
+            return;
+        }
+
+        // Slide the unread bytes to the front before growing
+        if (readPos > 0) {
+            std::memmove(data.data(), data.data() + readPos, buffered());
+            writePos -= readPos;
+            readPos = 0;
+        }
+
+        if (writable() < minFree) {
+            data.resize(std::max(data.size() * 2, writePos + minFree));
+        }
+    }
+
+    bool
+    FrameBuffer::nextFrame(std::string_view& payload)
+    {
+        if (buffered() < HEADER_SIZE) {
+            return false;
+        }
+
+        uint32_t length = readLength(data.data() + readPos);
+        if (length > MAX_MESSAGE_LENGTH) {
+            throw std::runtime_error("TwsProtocol: frame of " + std::to_string(length) + " bytes exceeds limit");
+        }
+
+        if (buffered() < HEADER_SIZE + length) {
+            // Partial frame, make sure the whole thing will fit once it arrives
+            prepare(HEADER_SIZE + length - buffered());
+            return false;
+        }
+
+        payload = std::string_view(data.data() + readPos + HEADER_SIZE, length);
+        readPos += HEADER_SIZE + length;
+        if (readPos == writePos) {
+            readPos = writePos = 0;
+        }
+        return true;
+    }
+
+    void
+    writeHandshake(std::string& buffer)
+    {
+        buffer.append("API", 4);  // includes the terminating NUL
+        std::string versions = "v" + std::to_string(MIN_CLIENT_VERSION) + ".." + std::to_string(MAX_CLIENT_VERSION);
+
+        // The version range is framed but not NUL terminated
+        size_t start = buffer.size();
+        buffer.append(HEADER_SIZE, '\0');
+        buffer.append(versions);
+        writeLength(buffer.data() + start, static_cast<uint32_t>(versions.size()));
+    }
+
+    void
+    writeStartApi(std::string& buffer, int clientId)
+    {
+        MessageWriter(buffer)
+            .add(static_cast<int>(OutgoingMessage::START_API))
+            .add(2)
+            .add(clientId)
+            .add("")        // optional capabilities
+            .finish();
+    }
+
+    void
+    writeReqIds(std::string& buffer)
+    {
+        MessageWriter(buffer)
+            .add(static_cast<int>(OutgoingMessage::REQ_IDS))
+            .add(1)
+            .add(1)
+            .finish();
+    }
+
+    void
+    writeReqPositions(std::string& buffer)
+    {
+        MessageWriter(buffer)
+            .add(static_cast<int>(OutgoingMessage::REQ_POSITIONS))
+            .add(1)
+            .finish();
+    }
+
+    void
+    writeReqMktData(std::string& buffer, int requestId, const std::string& ticker)
+    {
+        MessageWriter(buffer)
+            .add(static_cast<int>(OutgoingMessage::REQ_MKT_DATA))
+            .add(11)
+            .add(requestId)
+            .add(0)             // conId
+            .add(ticker)
+            .add("STK")
+            .add("")            // lastTradeDateOrContractMonth
+            .add(0.0)           // strike
+            .add("")            // right
+            .add("")            // multiplier
+            .add("SMART")
+            .add("")            // primaryExchange
+            .add("USD")
+            .add("")            // localSymbol
+            .add("")            // tradingClass
+            .add(0)             // no delta neutral contract
+            .add("")            // genericTickList
+            .add(0)             // snapshot
+            .add(0)             // regulatorySnapshot
+            .add("")            // mktDataOptions
+            .finish();
+    }
+
+    void
+    writePlaceOrder(std::string& buffer, int serverVersion, int orderId, const Order& order)
+    {
+        MessageWriter writer(buffer);
+        writer.add(static_cast<int>(OutgoingMessage::PLACE_ORDER));
+        if (serverVersion < MIN_SERVER_VER_ORDER_CONTAINER) {
+            writer.add(PLACE_ORDER_VERSION);
+        }
+
+        writer.add(orderId)
+              .add(0)             // conId
+              .add(order.getTicker())
+              .add("STK")
+              .add("")            // lastTradeDateOrContractMonth
+              .add(0.0)           // strike
+              .add("")            // right
+              .add("")            // multiplier
+              .add("SMART")
+              .add("")            // primaryExchange
+              .add("USD")
+              .add("")            // localSymbol
+              .add("")            // tradingClass
+              .add("")            // secIdType
+              .add("")            // secId
+              .add(actionFor(order.getType()));
+
+        // Whole shares only until the server takes fractional quantities
+        if (serverVersion >= MIN_SERVER_VER_FRACTIONAL_POSITIONS) {
+            writer.add(static_cast<double>(order.getQuantity()));
+        } else {
+            writer.add(static_cast<int>(order.getQuantity()));
+        }
+        writer.add(orderTypeFor(order.getType()));
+
+        // Limit price, then aux (stop) price
+        if (order.isLimit()) {
+            writer.add(static_cast<double>(order.getPrice())).add("");
+        } else if (order.isStop()) {
+            writer.add("").add(static_cast<double>(order.getPrice()));
+        } else {
+            writer.add("").add("");
+        }
+
+        // Extended order fields. Empty is the API's "unset" for optional
+        // numbers, flags are 0 / 1.
+        writer.add("DAY")         // tif
+              .add("")            // ocaGroup
+              .add("")            // account
+              .add("O")           // openClose
+              .add(0)             // origin, customer
+              .add("")            // orderRef
+              .add(1)             // transmit
+              .add(0)             // parentId
+              .add(0)             // blockOrder
+              .add(0)             // sweepToFill
+              .add(0)             // displaySize
+              .add(0)             // triggerMethod
+              .add(0)             // outsideRth
+              .add(0)             // hidden
+              .add("")            // sharesAllocation, deprecated
+              .add(0.0)           // discretionaryAmt
+              .add("")            // goodAfterTime
+              .add("")            // goodTillDate
+              .add("")            // faGroup
+              .add("")            // faMethod
+              .add("")            // faPercentage
+              .add("");           // faProfile
+        if (serverVersion >= MIN_SERVER_VER_MODELS_SUPPORT) {
+            writer.add("");       // modelCode
+        }
+
+        writer.add(0)             // shortSaleSlot
+              .add("")            // designatedLocation
+              .add(-1)            // exemptCode
+              .add(0)             // ocaType
+              .add("")            // rule80A
+              .add("")            // settlingFirm
+              .add(0)             // allOrNone
+              .add("")            // minQty
+              .add("")            // percentOffset
+              .add(0)             // eTradeOnly, rejected by current TWS if set
+              .add(0)             // firmQuoteOnly
+              .add("")            // nbboPriceCap
+              .add(0)             // auctionStrategy
+              .add("")            // startingPrice
+              .add("")            // stockRefPrice
+              .add("")            // delta
+              .add("")            // stockRangeLower
+              .add("")            // stockRangeUpper
+              .add(0)             // overridePercentageConstraints
+              .add("")            // volatility
+              .add("")            // volatilityType
+              .add("")            // deltaNeutralOrderType
+              .add("")            // deltaNeutralAuxPrice
+              .add(0)             // continuousUpdate
+              .add("")            // referencePriceType
+              .add("")            // trailStopPrice
+              .add("")            // trailingPercent
+              .add("")            // scaleInitLevelSize
+              .add("")            // scaleSubsLevelSize
+              .add("")            // scalePriceIncrement
+              .add("")            // scaleTable
+              .add("")            // activeStartTime
+              .add("")            // activeStopTime
+              .add("")            // hedgeType
+              .add(0)             // optOutSmartRouting
+              .add("")            // clearingAccount
+              .add("")            // clearingIntent
+              .add(0)             // notHeld
+              .add(0)             // no delta neutral contract
+              .add("")            // algoStrategy
+              .add("")            // algoId
+              .add(0)             // whatIf
+              .add("")            // miscOptions
+              .add(0)             // solicited
+              .add(0)             // randomizeSize
+              .add(0);            // randomizePrice
+
+        if (serverVersion >= MIN_SERVER_VER_PEGGED_TO_BENCHMARK) {
+            writer.add(0)         // conditions count
+                  .add("")        // adjustedOrderType
+                  .add("")        // triggerPrice
+                  .add("")        // lmtPriceOffset
+                  .add("")        // adjustedStopPrice
+                  .add("")        // adjustedStopLimitPrice
+                  .add("")        // adjustedTrailingAmount
+                  .add(0);        // adjustableTrailingUnit
+        }
+        if (serverVersion >= MIN_SERVER_VER_EXT_OPERATOR) {
+            writer.add("");       // extOperator
+        }
+        if (serverVersion >= MIN_SERVER_VER_SOFT_DOLLAR_TIER) {
+            writer.add("").add(""); // softDollarTier name and value
+        }
+        if (serverVersion >= MIN_SERVER_VER_CASH_QTY) {
+            writer.add("");       // cashQty
+        }
+        if (serverVersion >= MIN_SERVER_VER_DECISION_MAKER) {
+            writer.add("").add(""); // mifid2DecisionMaker, mifid2DecisionAlgo
+        }
+        if (serverVersion >= MIN_SERVER_VER_MIFID_EXECUTION) {
+            writer.add("").add(""); // mifid2ExecutionTrader, mifid2ExecutionAlgo
+        }
+        if (serverVersion >= MIN_SERVER_VER_AUTO_PRICE_FOR_HEDGE) {
+            writer.add(0);        // dontUseAutoPriceForHedge
+        }
+        if (serverVersion >= MIN_SERVER_VER_ORDER_CONTAINER) {
+            writer.add(0);        // isOmsContainer
+        }
+        if (serverVersion >= MIN_SERVER_VER_D_PEG_ORDERS) {
+            writer.add(0);        // discretionaryUpToLimitPrice
+        }
+        if (serverVersion >= MIN_SERVER_VER_PRICE_MGMT_ALGO) {
+            writer.add("");       // usePriceMgmtAlgo, server default
+        }
+
+        writer.finish();
+    }
+
+    void
+    writeCancelOrder(std::string& buffer, int orderId)
+    {
+        MessageWriter(buffer)
+            .add(static_cast<int>(OutgoingMessage::CANCEL_ORDER))
+            .add(1)
+            .add(orderId)
+            .finish();
+    }
+
+    const char*
+    actionFor(OrderType type)
+    {
+        switch (type) {
+            case OrderType::SELL:
+            case OrderType::LIMIT_SELL:
+            case OrderType::STOP_SELL:
+                return "SELL";
+            default:
+                return "BUY";
+        }
+    }
+
+    const char*
+    orderTypeFor(OrderType type)
+    {
+        switch (type) {
+            case OrderType::LIMIT_BUY:
+            case OrderType::LIMIT_SELL:
+                return "LMT";
+            case OrderType::STOP_BUY:
+            case OrderType::STOP_SELL:
+                return "STP";
+            default:
+                return "MKT";
+        }
+    }
+
+    uint32_t
+    readLength(const char* header)
+    {
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(header);
+        return (uint32_t(bytes[0]) << 24) | (uint32_t(bytes[1]) << 16) |
+               (uint32_t(bytes[2]) << 8) | uint32_t(bytes[3]);
+    }
+
+    void
+    writeLength(char* header, uint32_t length)
+    {
+        header[0] = static_cast<char>((length >> 24) & 0xFF);
+        header[1] = static_cast<char>((length >> 16) & 0xFF);
+        header[2] = static_cast<char>((length >> 8) & 0xFF);
+        header[3] = static_cast<char>(length & 0xFF);
+    }
+
+    std::vector<std::string>
+    splitFields(std::string_view payload)
+    {
+        std::vector<std::string> fields;
+        FieldReader reader(payload);
+        while (reader.hasMore()) {
+            fields.emplace_back(reader.next());
+        }
+        return fields;
+    }
+}
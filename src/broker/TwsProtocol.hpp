@@ -0,0 +1,173 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../oms/Order.hpp"
+
+/**
+ * TwsProtocol
+ *
+ * Framing and encoding for the Interactive Brokers TWS / IB Gateway socket
+ * API. After the "API\0" prefix every message is a 4 byte big-endian length
+ * followed by NUL terminated text fields, the first of which is the message id.
+ *
+ * Incoming frames are parsed in place: FrameBuffer hands out string_views
+ * into its receive buffer and FieldReader walks the fields of one frame
+ * without copying. Outgoing messages are appended straight onto a send
+ * buffer by MessageWriter so many requests can be pipelined into one write.
+ *
+ * Only the subset of the API that IBKR uses is encoded. placeOrder writes
+ * the full field list the negotiated server version reads, in the order the
+ * reference TWS API client sends it, with every attribute IBKR doesn't use
+ * left at the reference client's default.
+ */
+namespace TwsProtocol
+{
+    constexpr uint16_t DEFAULT_PORT = 7497;         // TWS paper trading
+    constexpr int MIN_CLIENT_VERSION = 100;
+    constexpr int MAX_CLIENT_VERSION = 151;
+    constexpr int MIN_SERVER_VER_MARKET_CAP_PRICE = 131;
+
+    // Server versions that change the PLACE_ORDER layout. Anything below
+    // MIN_CLIENT_VERSION is always present and isn't listed.
+    constexpr int MIN_SERVER_VER_FRACTIONAL_POSITIONS = 101;
+    constexpr int MIN_SERVER_VER_PEGGED_TO_BENCHMARK = 102;
+    constexpr int MIN_SERVER_VER_MODELS_SUPPORT = 103;
+    constexpr int MIN_SERVER_VER_EXT_OPERATOR = 105;
+    constexpr int MIN_SERVER_VER_SOFT_DOLLAR_TIER = 106;
+    constexpr int MIN_SERVER_VER_CASH_QTY = 111;
+    constexpr int MIN_SERVER_VER_DECISION_MAKER = 138;
+    constexpr int MIN_SERVER_VER_MIFID_EXECUTION = 139;
+    constexpr int MIN_SERVER_VER_AUTO_PRICE_FOR_HEDGE = 141;
+    constexpr int MIN_SERVER_VER_ORDER_CONTAINER = 145;
+    constexpr int MIN_SERVER_VER_D_PEG_ORDERS = 148;
+    constexpr int MIN_SERVER_VER_PRICE_MGMT_ALGO = 151;
+
+    // PLACE_ORDER message version, only sent to servers older than ORDER_CONTAINER
+    constexpr int PLACE_ORDER_VERSION = 45;
+
+    constexpr size_t HEADER_SIZE = 4;
+    constexpr size_t MAX_MESSAGE_LENGTH = 0xFFFFFF;  // TWS drops anything bigger
+
+    enum class IncomingMessage : int {
+        TICK_PRICE = 1,
+        ORDER_STATUS = 3,
+        ERR_MSG = 4,
+        OPEN_ORDER = 5,
+        NEXT_VALID_ID = 9,
+        EXECUTION_DATA = 11,
+        MANAGED_ACCTS = 15,
+        POSITION_DATA = 61,
+        POSITION_END = 62
+    };
+
+    enum class OutgoingMessage : int {
+        REQ_MKT_DATA = 1,
+        PLACE_ORDER = 3,
+        CANCEL_ORDER = 4,
+        REQ_IDS = 8,
+        REQ_POSITIONS = 61,
+        START_API = 71
+    };
+
+    enum class TickType : int {
+        BID = 1,
+        ASK = 2,
+        LAST = 4,
+        CLOSE = 9,
+        DELAYED_LAST = 68,
+        DELAYED_CLOSE = 75
+    };
+
+    /**
+     * Sequential, non-owning reader over the fields of one message payload.
+     * Missing or empty numeric fields read as 0.
+     */
+    class FieldReader
+    {
+        public:
+            explicit FieldReader(std::string_view payload) : remaining(payload) {}
+
+            bool hasMore() const { return !remaining.empty(); }
+            std::string_view next();
+            int nextInt();
+            double nextDouble();
+            void skip(size_t count);
+
+        private:
+            std::string_view remaining;
+    };
+
+    /**
+     * Appends one framed message to a send buffer. The length prefix is
+     * patched in by finish(), which must be called once all fields are added.
+     */
+    class MessageWriter
+    {
+        public:
+            explicit MessageWriter(std::string& buffer);
+
+            MessageWriter& add(std::string_view field);
+            MessageWriter& add(const char* field) { return add(std::string_view(field)); }
+            MessageWriter& add(int value);
+            MessageWriter& add(double value);
+            void finish();
+
+        private:
+            std::string& buffer;
+            size_t start;
+    };
+
+    /**
+     * Receive buffer that splits a byte stream into frames. recv() straight
+     * into writePtr(), commit() what arrived, then pull payloads with
+     * nextFrame(). Payload views stay valid until the next prepare() call.
+     */
+    class FrameBuffer
+    {
+        public:
+            explicit FrameBuffer(size_t initialCapacity = 64 * 1024);
+
+            // Make room for at least minFree bytes after the unread data
+            void prepare(size_t minFree = 4096);
+            char* writePtr() { return data.data() + writePos; }
+            size_t writable() const { return data.size() - writePos; }
+            void commit(size_t count) { writePos += count; }
+
+            // Throws std::runtime_error if the peer announces an oversized frame
+            bool nextFrame(std::string_view& payload);
+
+            size_t buffered() const { return writePos - readPos; }
+            void clear() { readPos = writePos = 0; }
+
+        private:
+            std::vector<char> data;
+            size_t readPos;
+            size_t writePos;
+    };
+
+    // Client side of the connection handshake: "API\0" then the version range
+    void writeHandshake(std::string& buffer);
+    void writeStartApi(std::string& buffer, int clientId);
+
+    // Requests
+    void writeReqIds(std::string& buffer);
+    void writeReqPositions(std::string& buffer);
+    void writeReqMktData(std::string& buffer, int requestId, const std::string& ticker);
+    void writePlaceOrder(std::string& buffer, int serverVersion, int orderId, const Order& order);
+    void writeCancelOrder(std::string& buffer, int orderId);
+
+    // TWS names for an order's side and type
+    const char* actionFor(OrderType type);
+    const char* orderTypeFor(OrderType type);
+
+    // Big-endian length prefix helpers
+    uint32_t readLength(const char* header);
+    void writeLength(char* header, uint32_t length);
+
+    // Split a payload into owned fields, used by the fake gateway and tests
+    std::vector<std::string> splitFields(std::string_view payload);
+}
@@ -0,0 +1,139 @@
+#include "CSVFollower.hpp"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <set>
+#include <stdexcept>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "../util/Logger.hpp"
+
+CSVFollower::CSVFollower(const std::string& _directory, const std::string& _namePrefix)
+: directory(_directory),
+  namePrefix(_namePrefix)
+{
+    fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd < 0) {
+        throw std::runtime_error(std::string("CSVFollower: inotify_init1 failed: ") + std::strerror(errno));
+    }
+
+    if (inotify_add_watch(fd, directory.c_str(), IN_MODIFY | IN_CLOSE_WRITE | IN_CREATE | IN_MOVED_TO) < 0) {
+        int error = errno;
+        close(fd);
+        throw std::runtime_error("CSVFollower: cannot watch " + directory + ": " + std::strerror(error));
+    }
+}
+
+CSVFollower::~CSVFollower()
+{
+    close(fd);
+}
+
+size_t
+CSVFollower::poll(MarketData& marketData)
+{
+    // A burst of writes to one file is still a single read of it
+    std::set<std::string> changed;
+    alignas(inotify_event) char buffer[4096];
+    ssize_t length;
+    while ((length = read(fd, buffer, sizeof(buffer))) > 0) {
+        for (char* p = buffer; p < buffer + length;) {
+            const inotify_event* event = reinterpret_cast<const inotify_event*>(p);
+            if (event->len > 0 && std::strncmp(event->name, namePrefix.c_str(), namePrefix.size()) == 0) {
+                changed.insert(event->name);
+            }
+            p += sizeof(inotify_event) + event->len;
+        }
+    }
+
+    size_t appended = 0;
+    for (const std::string& name : changed) {
+        appended += follow(directory + "/" + name, marketData);
+    }
+    return appended;
+}
+
+size_t
+CSVFollower::follow(const std::string& filePath, MarketData& marketData)
+{
+    std::vector<MarketCondition> rows;
+    if (readAppended(filePath, rows) == 0) {
+        return 0;
+    }
+    return marketData.append(rows);
+}
+
+size_t
+CSVFollower::readAppended(const std::string& filePath, std::vector<MarketCondition>& rows)
+{
+    // Not written yet, or removed since the event
+    int file = open(filePath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (file < 0) {
+        return 0;
+    }
+
+    struct stat info;
+    if (fstat(file, &info) < 0) {
+        close(file);
+        return 0;
+    }
+
+    // Rewritten in place or replaced by a rename, start again from the header
+    FileState& state = files[filePath];
+    uint64_t size = static_cast<uint64_t>(info.st_size);
+    if (state.inode != info.st_ino || size < state.offset) {
+        state.offset = 0;
+        state.inode = info.st_ino;
+    }
+
+    if (size == state.offset) {
+        close(file);
+        return 0;
+    }
+
+    std::string text(size - state.offset, '\0');
+    ssize_t bytes = pread(file, text.data(), text.size(), static_cast<off_t>(state.offset));
+    close(file);
+    if (bytes <= 0) {
+        return 0;
+    }
+    text.resize(static_cast<size_t>(bytes));
+
+    // Only complete lines, a partial last line is read again once it is finished
+    size_t end = text.rfind('\n');
+    if (end == std::string::npos) {
+        return 0;
+    }
+
+    size_t start = 0;
+    if (state.offset == 0) {
+        start = text.find('\n') + 1;    // Header
+    }
+
+    size_t before = rows.size();
+    while (start <= end) {
+        size_t newline = text.find('\n', start);
+        std::string line = text.substr(start, newline - start);
+        start = newline + 1;
+
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty()) continue;
+
+        try {
+            rows.push_back(parser.ParseToMarketCondition(line));
+        } catch (const std::exception& e) {
+            LOG_WARN("Skipping malformed market data row: {}", e.what());
+        }
+    }
+
+    state.offset += end + 1;
+    return rows.size() - before;
+}
+
+uint64_t
+CSVFollower::getOffset(const std::string& filePath) const
+{
+    auto found = files.find(filePath);
+    return found == files.end() ? 0 : found->second.offset;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+#include <sys/types.h>
+#include "CSVParser.hpp"
+#include "MarketData.hpp"
+
+/**
+ * CSVFollower
+ *
+ * Tails the market data CSVs in a directory, like tail -f. Keeps a byte
+ * offset per file and on each change reads only what was appended since,
+ * parsing complete lines and leaving a half written last line for the next
+ * read. A file that shrinks or is replaced is read again from the top, and
+ * MarketData::append drops the bars it already has.
+ *
+ * Changes come from inotify on the directory, filtered on a file name
+ * prefix. getFd() can be added to an EventLoop as a reader, poll() then
+ * drains the events and appends the new bars.
+ */
+class CSVFollower
+{
+    public:
+        CSVFollower(const std::string& _directory, const std::string& _namePrefix);
+        ~CSVFollower();
+
+        CSVFollower(const CSVFollower&) = delete;
+        CSVFollower& operator=(const CSVFollower&) = delete;
+
+        int getFd() const { return fd; }
+
+        // Read every changed file since the last poll, returns the bars appended
+        size_t poll(MarketData& marketData);
+
+        // Read one file without waiting for an event, returns the bars appended
+        size_t follow(const std::string& filePath, MarketData& marketData);
+
+        // Parse the complete lines added to filePath since the last read into rows
+        size_t readAppended(const std::string& filePath, std::vector<MarketCondition>& rows);
+
+        uint64_t getOffset(const std::string& filePath) const;
+
+    private:
+        struct FileState {
+            uint64_t offset = 0;
+            ino_t inode = 0;
+        };
+
+        std::string directory;
+        std::string namePrefix;
+        int fd;
+        std::map<std::string, FileState> files;
+        CSVParser parser;
+};
@@ -1,6 +1,5 @@
 #include "DataStitcher.hpp"
 #include <sstream>
-#include <map>
 #include <chrono>
 #include <iomanip>
 
@@ -10,6 +9,13 @@ DataStitcher::DataStitcher(const std::string& dataDir, const std::string& ticker
 
 std::vector<MarketCondition> 
 DataStitcher::getStitchedData(const std::string& startDate, const std::string& endDate) {
+    // Whole days at both ends
+    Timestamp rangeStart = Timestamp::parse(startDate).startOfDay();
+    Timestamp rangeEnd = Timestamp::parse(endDate).startOfDay().plusDays(1);
+    if (!rangeStart.isValid() || !rangeEnd.isValid()) {
+        throw std::runtime_error("Date range should be YYYY-MM-DD, got " + startDate + " to " + endDate);
+    }
+
     // Find all relevant files in the date range
     std::vector<std::string> files = findFilesInRange(startDate, endDate);
     
@@ -35,9 +41,7 @@ DataStitcher::getStitchedData(const std::string& startDate, const std::string& e
     // Filter to only include data in the requested date range
     std::vector<MarketCondition> filteredData;
     for (const auto& condition : stitchedData) {
-        // Extract just the date part for comparison
-        std::string dateStr = condition.DateTime.substr(0, 10);
-        if (isDateInRange(dateStr, startDate, endDate)) {
+        if (isInRange(condition.Time, rangeStart, rangeEnd)) {
             filteredData.push_back(condition);
         }
     }
@@ -125,26 +129,13 @@ DataStitcher::readCSVFile(const std::string& filePath) {
 
 std::vector<MarketCondition> 
 DataStitcher::mergeDataSeries(const std::vector<std::vector<MarketCondition>>& allData) {
-    // Use a map to avoid duplicates, with datetime as the key
-    std::map<std::string, MarketCondition> mergedDataMap;
-    
-    for (const auto& dataSeries : allData) {
-        for (const auto& condition : dataSeries) {
-            mergedDataMap[condition.DateTime] = condition;
-        }
-    }
-    
-    // Convert map to vector and sort by datetime
     std::vector<MarketCondition> mergedData;
-    for (const auto& pair : mergedDataMap) {
-        mergedData.push_back(pair.second);
+    for (const auto& dataSeries : allData) {
+        mergedData.insert(mergedData.end(), dataSeries.begin(), dataSeries.end());
     }
     
-    // Sort by datetime
-    std::sort(mergedData.begin(), mergedData.end(), 
-              [](const MarketCondition& a, const MarketCondition& b) {
-                  return a.DateTime < b.DateTime;
-              });
+    // Sort by time, a bar repeated across files keeps its last copy
+    sortUniqueByTime(mergedData);
     
     return mergedData;
 }
@@ -178,8 +169,8 @@ DataStitcher::saveStitchedData(const std::vector<MarketCondition>& data, const s
 }
 
 bool 
-DataStitcher::isDateInRange(const std::string& dateToCheck, const std::string& startDate, const std::string& endDate) {
-    return (dateToCheck >= startDate && dateToCheck <= endDate);
+DataStitcher::isInRange(Timestamp time, Timestamp start, Timestamp end) {
+    return time >= start && time < end;
 }
 
 std::string 
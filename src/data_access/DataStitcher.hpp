@@ -35,5 +35,5 @@ private:
     std::string extractDateFromFilename(const std::string& filename);
     std::vector<MarketCondition> readCSVFile(const std::string& filePath);
     std::vector<MarketCondition> mergeDataSeries(const std::vector<std::vector<MarketCondition>>& allData);
-    bool isDateInRange(const std::string& dateToCheck, const std::string& startDate, const std::string& endDate);
+    bool isInRange(Timestamp time, Timestamp start, Timestamp end);     // end is exclusive
 };
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "MarketCondition.hpp"
+#include <algorithm>
 
 MarketCondition::MarketCondition(
     std::string _dateTime,
@@ -9,6 +10,7 @@ MarketCondition::MarketCondition(
     std::string _timeInterval)
 
 : DateTime(_dateTime),
+Time(Timestamp::parse(_dateTime)),
 Ticker(_ticker),
 Open(_open),
 Close(_close),
@@ -18,7 +20,17 @@ TimeInterval(_timeInterval)
 
 }
 
-MarketCondition::~MarketCondition() 
+void
+sortUniqueByTime(std::vector<MarketCondition>& bars)
 {
+    std::stable_sort(bars.begin(), bars.end(),
+                     [](const MarketCondition& a, const MarketCondition& b) { return a.Time < b.Time; });
 
-}
\ No newline at end of file
+    auto kept = bars.begin();
+    for (auto bar = bars.begin(); bar != bars.end(); ++bar) {
+        if (std::next(bar) != bars.end() && std::next(bar)->Time == bar->Time) continue;
+        if (kept != bar) *kept = std::move(*bar);
+        ++kept;
+    }
+    bars.erase(kept, bars.end());
+}
@@ -1,5 +1,7 @@
 #pragma once
 #include <iostream>
+#include <vector>
+#include "../util/Timestamp.hpp"
 
 
 class MarketCondition
@@ -14,7 +16,6 @@ class MarketCondition
         std::string _timeInterval);
 
        MarketCondition(){};
-       ~MarketCondition();
 
         bool IsValid() const
         {
@@ -23,10 +24,14 @@ class MarketCondition
 
     public:
         // Add members here
-        std::string DateTime;
+        std::string DateTime;                   // As read, kept for output
+        Timestamp Time;                         // DateTime parsed, for ordering and ranges
         std::string Ticker;
         float Open;
         float Close;
         int Volume;
         std::string TimeInterval;
 };
+
+// Sorts bars by Time and drops repeats of a time, keeping the last one given
+void sortUniqueByTime(std::vector<MarketCondition>& bars);
@@ -18,7 +18,7 @@ MarketData::~MarketData()
 }
 
 void
-MarketData::process(json configData)
+MarketData::process(const DataConfig& configData)
 {
     std::cout << "Processing Market Data" << std::endl;
     string filePath = generateFilePath(configData);
@@ -26,12 +26,12 @@ MarketData::process(json configData)
 }
 
 void
-MarketData::processForDateRange(json configData, const std::string& startDate, const std::string& endDate)
+MarketData::processForDateRange(const DataConfig& configData, const std::string& startDate, const std::string& endDate)
 {
     std::cout << "Processing Market Data for date range from " << startDate << " to " << endDate << std::endl;
     
     // Get ticker from config
-    std::string ticker = configData["ticker"];
+    const std::string& ticker = configData.ticker;
     
     // Get data directory
     std::string dataDir = getDataDirectory();
@@ -55,14 +55,14 @@ MarketData::processForDateRange(json configData, const std::string& startDate, c
     // Sort data by datetime
     std::sort(data.begin(), data.end(), 
               [](const MarketCondition& a, const MarketCondition& b) {
-                  return a.DateTime < b.DateTime;
+                  return a.Time < b.Time;
               });
     
     std::cout << "Loaded " << data.size() << " market data points for date range" << std::endl;
 }
 
 void
-MarketData::processParallel(json configData, int numThreads)
+MarketData::processParallel(const DataConfig& configData, int numThreads)
 {
     // If numThreads is 0, use the number of hardware threads available
     if (numThreads <= 0) {
@@ -72,7 +72,7 @@ MarketData::processParallel(json configData, int numThreads)
     std::cout << "Processing Market Data in parallel using " << numThreads << " threads" << std::endl;
     
     // Get ticker and date range from config
-    std::string ticker = configData["ticker"];
+    const std::string& ticker = configData.ticker;
     
     // Default to last 7 days if not specified
     std::string endDate = DateTimeConversion().timeNowToDate();
@@ -86,9 +86,9 @@ MarketData::processParallel(json configData, int numThreads)
     std::string startDate = ss.str();
     
     // Check if date range is specified in config
-    if (configData.contains("backtest_start_date") && configData.contains("backtest_end_date")) {
-        startDate = configData["backtest_start_date"];
-        endDate = configData["backtest_end_date"];
+    if (configData.backtestStartDate && configData.backtestEndDate) {
+        startDate = *configData.backtestStartDate;
+        endDate = *configData.backtestEndDate;
     }
     
     // Get data directory
@@ -140,23 +140,8 @@ MarketData::processParallel(json configData, int numThreads)
         allData.insert(allData.end(), threadData.begin(), threadData.end());
     }
     
-    // Remove duplicates by creating a map keyed by datetime
-    std::map<std::string, MarketCondition> uniqueData;
-    for (const auto& condition : allData) {
-        uniqueData[condition.DateTime] = condition;
-    }
-    
-    // Convert back to vector
-    allData.clear();
-    for (const auto& pair : uniqueData) {
-        allData.push_back(pair.second);
-    }
-    
-    // Sort by datetime
-    std::sort(allData.begin(), allData.end(), 
-              [](const MarketCondition& a, const MarketCondition& b) {
-                  return a.DateTime < b.DateTime;
-              });
+    // Sort by time, dropping bars read by more than one thread
+    sortUniqueByTime(allData);
     
     // Update our data
     update(allData);
@@ -178,21 +163,39 @@ MarketData::update(std::vector<MarketCondition>& marketData)
     data = marketData;
 }
 
-vector<MarketCondition>
+size_t
+MarketData::append(const std::vector<MarketCondition>& rows)
+{
+    size_t appended = 0;
+    for (const MarketCondition& row : rows) {
+        if (!data.empty() && row.Time <= data.back().Time) continue;
+        data.push_back(row);
+        appended++;
+    }
+    return appended;
+}
+
+void
+MarketData::push(const MarketCondition& bar)
+{
+    data.push_back(bar);
+}
+
+const vector<MarketCondition>&
 MarketData::getData() const
 {
     return data;
 }
 
 string
-MarketData::generateFilePath(json configData)
+MarketData::generateFilePath(const DataConfig& configData)
 {
+    if (configData.marketDataBasePath.empty() || configData.baseDataFileName.empty())
+        throw std::runtime_error("Config: 'marketDataBasePath' and 'baseDataFileName' are needed to find market data files");
+
     string projectRoot = getProjectRoot() + "/";
-    string fileBasePath = configData["marketDataBasePath"];
-    string fileBaseName = configData["baseDataFileName"];
-    string ticker = configData["ticker"];
     string date = DateTimeConversion().timeNowToDate();
-    string filePath = projectRoot + fileBasePath + fileBaseName + "_" + ticker + "_" + date + ".csv";
+    string filePath = projectRoot + configData.marketDataBasePath + configData.baseDataFileName + "_" + configData.ticker + "_" + date + ".csv";
     return filePath;
 }
 
@@ -221,7 +224,7 @@ MarketData::getLastClosePrice()
 }
 
 MarketCondition
-MarketData::getCurrentData()
+MarketData::getCurrentData() const
 {
     if (data.empty()) {
         throw std::runtime_error("No market data available");
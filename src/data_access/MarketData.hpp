@@ -24,7 +24,7 @@ class MarketData
          * Process market data from default sources
          * @param configData Configuration for data processing
          */
-        void process(json configData);
+        void process(const DataConfig& configData);
         
         /**
          * Process market data for a specific date range
@@ -32,14 +32,14 @@ class MarketData
          * @param startDate Start date for the data range
          * @param endDate End date for the data range
          */
-        void processForDateRange(json configData, const std::string& startDate, const std::string& endDate);
+        void processForDateRange(const DataConfig& configData, const std::string& startDate, const std::string& endDate);
         
         /**
          * Process market data in parallel for improved performance
          * @param configData Configuration for data processing
          * @param numThreads Number of threads to use (0 = auto)
          */
-        void processParallel(json configData, int numThreads = 0);
+        void processParallel(const DataConfig& configData, int numThreads = 0);
         
         /**
          * Load data from a specific file
@@ -52,19 +52,34 @@ class MarketData
          * @param marketData New market data
          */
         void update(std::vector<MarketCondition>& marketData);
+
+        /**
+         * Append new bars in place, skipping any at or before the latest bar
+         * so a file that is read again does not duplicate data
+         * @param rows Bars in time order
+         * @return Number of bars appended
+         */
+        size_t append(const std::vector<MarketCondition>& rows);
+
+        /**
+         * Add one bar after the latest without checking its time, for
+         * replaying data already known to be in order
+         * @param bar Next bar
+         */
+        void push(const MarketCondition& bar);
         
         /**
          * Get all market data
-         * @return Vector of market conditions
+         * @return Market conditions in time order, valid until the data is next changed
          */
-        std::vector<MarketCondition> getData() const;
+        const std::vector<MarketCondition>& getData() const;
         
         /**
          * Generate file path for data based on configuration
          * @param configData Configuration data
          * @return File path string
          */
-        string generateFilePath(json configData);
+        string generateFilePath(const DataConfig& configData);
         
         /**
          * Get project root directory
@@ -82,7 +97,13 @@ class MarketData
          * Get the most recent market condition
          * @return Most recent market condition
          */
-        MarketCondition getCurrentData();
+        MarketCondition getCurrentData() const;
+
+        /**
+         * Check whether any data has been loaded
+         * @return True if there is no data
+         */
+        bool isEmpty() const { return data.empty(); }
 
     private:
         std::vector<MarketCondition> data;
@@ -0,0 +1,211 @@
+#include "SharedBarRing.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static uint64_t
+loadAcquire(const uint64_t& value)
+{
+    return std::atomic_ref<uint64_t>(const_cast<uint64_t&>(value)).load(std::memory_order_acquire);
+}
+
+static void
+storeRelease(uint64_t& value, uint64_t update)
+{
+    std::atomic_ref<uint64_t>(value).store(update, std::memory_order_release);
+}
+
+template <size_t N>
+static void
+copyField(char (&destination)[N], const std::string& source)
+{
+    std::memset(destination, 0, N);
+    std::memcpy(destination, source.data(), std::min(N, source.size()));
+}
+
+template <size_t N>
+static std::string
+fieldOf(const char (&source)[N])
+{
+    return std::string(source, strnlen(source, N));
+}
+
+static void
+throwSystemError(const std::string& what, const std::string& name)
+{
+    throw std::runtime_error("Shared bar ring " + name + ": " + what + " failed: " + std::strerror(errno));
+}
+
+SharedBarWriter::SharedBarWriter(const std::string& _name, size_t _capacity)
+: name(_name),
+  capacity(_capacity),
+  mappingSize(SHARED_BARS_HEADER_SIZE + _capacity * sizeof(SharedBarSlot)),
+  mapping(nullptr),
+  published(0)
+{
+    if (capacity == 0) {
+        throw std::runtime_error("Shared bar ring " + name + ": capacity must be positive");
+    }
+
+    int fd = shm_open(name.c_str(), O_CREAT | O_RDWR, 0600);
+    if (fd < 0) throwSystemError("shm_open", name);
+
+    if (ftruncate(fd, static_cast<off_t>(mappingSize)) < 0) {
+        close(fd);
+        throwSystemError("ftruncate", name);
+    }
+
+    mapping = mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        mapping = nullptr;
+        throwSystemError("mmap", name);
+    }
+
+    header = static_cast<SharedBarHeader*>(mapping);
+    slots = reinterpret_cast<SharedBarSlot*>(static_cast<char*>(mapping) + SHARED_BARS_HEADER_SIZE);
+
+    // Readers of a previous run see the count drop and start over
+    storeRelease(header->published, 0);
+    std::memset(slots, 0, capacity * sizeof(SharedBarSlot));
+    header->version = SHARED_BARS_VERSION;
+    header->slotSize = sizeof(SharedBarSlot);
+    header->capacity = capacity;
+    storeRelease(header->magic, SHARED_BARS_MAGIC);
+}
+
+SharedBarWriter::~SharedBarWriter()
+{
+    if (mapping != nullptr) {
+        munmap(mapping, mappingSize);
+        shm_unlink(name.c_str());
+    }
+}
+
+void
+SharedBarWriter::publish(const MarketCondition& bar)
+{
+    SharedBarSlot& slot = slots[published % capacity];
+
+    storeRelease(slot.sequence, 2 * published + 1);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    copyField(slot.dateTime, bar.DateTime);
+    copyField(slot.ticker, bar.Ticker);
+    copyField(slot.interval, bar.TimeInterval);
+    slot.open = bar.Open;
+    slot.close = bar.Close;
+    slot.volume = bar.Volume;
+
+    storeRelease(slot.sequence, 2 * published + 2);
+    published++;
+    storeRelease(header->published, published);
+}
+
+SharedBarReader::SharedBarReader(const std::string& _name)
+: name(_name),
+  capacity(0),
+  mappingSize(0),
+  mapping(nullptr),
+  next(0),
+  dropped(0)
+{
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) throwSystemError("shm_open", name);
+
+    struct stat info;
+    if (fstat(fd, &info) < 0) {
+        close(fd);
+        throwSystemError("fstat", name);
+    }
+    if (static_cast<size_t>(info.st_size) < SHARED_BARS_HEADER_SIZE) {
+        close(fd);
+        throw std::runtime_error("Shared bar ring " + name + ": segment is too small");
+    }
+
+    mappingSize = static_cast<size_t>(info.st_size);
+    mapping = mmap(nullptr, mappingSize, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        mapping = nullptr;
+        throwSystemError("mmap", name);
+    }
+
+    header = static_cast<const SharedBarHeader*>(mapping);
+    slots = reinterpret_cast<const SharedBarSlot*>(static_cast<const char*>(mapping) + SHARED_BARS_HEADER_SIZE);
+    capacity = header->capacity;
+
+    if (loadAcquire(header->magic) != SHARED_BARS_MAGIC || header->version != SHARED_BARS_VERSION ||
+        header->slotSize != sizeof(SharedBarSlot) || capacity == 0 ||
+        SHARED_BARS_HEADER_SIZE + capacity * sizeof(SharedBarSlot) > mappingSize) {
+        munmap(mapping, mappingSize);
+        mapping = nullptr;
+        throw std::runtime_error("Shared bar ring " + name + ": not a version " + std::to_string(SHARED_BARS_VERSION) + " bar ring");
+    }
+}
+
+SharedBarReader::~SharedBarReader()
+{
+    if (mapping != nullptr) {
+        munmap(mapping, mappingSize);
+    }
+}
+
+size_t
+SharedBarReader::read(std::vector<MarketCondition>& rows)
+{
+    size_t before = rows.size();
+    uint64_t available = loadAcquire(header->published);
+
+    // The writer was restarted
+    if (available < next) {
+        next = 0;
+    }
+
+    while (next < available) {
+        uint64_t oldest = available > capacity ? available - capacity : 0;
+        if (next < oldest) {
+            dropped += oldest - next;
+            next = oldest;
+        }
+
+        const SharedBarSlot& slot = slots[next % capacity];
+        uint64_t expected = 2 * next + 2;
+
+        uint64_t begin = loadAcquire(slot.sequence);
+        SharedBarSlot copy;
+        std::memcpy(&copy, &slot, sizeof(copy));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint64_t end = std::atomic_ref<uint64_t>(const_cast<uint64_t&>(slot.sequence)).load(std::memory_order_relaxed);
+
+        if (begin != expected || end != expected) {
+            // Overwritten by the writer a lap ahead while copying, move on
+            available = loadAcquire(header->published);
+            uint64_t resume = std::max(available > capacity ? available - capacity : 0, next + 1);
+            dropped += resume - next;
+            next = resume;
+            continue;
+        }
+
+        rows.push_back(MarketCondition(fieldOf(copy.dateTime), fieldOf(copy.ticker),
+                                       copy.open, copy.close, copy.volume, fieldOf(copy.interval)));
+        next++;
+    }
+    return rows.size() - before;
+}
+
+size_t
+SharedBarReader::poll(MarketData& marketData)
+{
+    std::vector<MarketCondition> rows;
+    if (read(rows) == 0) {
+        return 0;
+    }
+    return marketData.append(rows);
+}
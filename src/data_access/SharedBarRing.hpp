@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "MarketCondition.hpp"
+#include "MarketData.hpp"
+
+// Layout shared with src/python/shared_bars.py, change both together
+#define SHARED_BARS_MAGIC 0x5352414254475441ull     // "ATGTBARS"
+#define SHARED_BARS_VERSION 1
+#define SHARED_BARS_HEADER_SIZE 128
+#define SHARED_BARS_DEFAULT_CAPACITY 4096           // Bars, 256KB of ring
+#define SHARED_BARS_DEFAULT_NAME "/algo_trader_bars"
+
+struct SharedBarHeader
+{
+    uint64_t magic;             // Written last, once the rest is set up
+    uint32_t version;
+    uint32_t slotSize;
+    uint64_t capacity;
+    uint8_t reserved[40];
+    uint64_t published;         // Bars written so far, on its own cache line
+    uint8_t padding[56];
+};
+
+/**
+ * One bar. sequence is a seqlock: 2n+1 while bar n is being written and
+ * 2n+2 once it is complete, so a reader knows both whether the slot holds
+ * the bar it wants and whether it was overwritten while being copied.
+ */
+struct SharedBarSlot
+{
+    uint64_t sequence;
+    char dateTime[24];
+    char ticker[12];
+    char interval[8];
+    float open;
+    float close;
+    int32_t volume;
+};
+
+static_assert(sizeof(SharedBarHeader) == SHARED_BARS_HEADER_SIZE, "Shared bar header must stay 128 bytes");
+static_assert(sizeof(SharedBarSlot) == 64, "Shared bar slots must stay 64 bytes");
+
+/**
+ * SharedBarWriter
+ *
+ * Creates the POSIX shared memory segment and publishes bars into it as a
+ * ring. The Python downloader has its own writer with the same layout, this
+ * one is for tests and C++ producers. Reopening an existing segment resets
+ * it, readers see the count go back and start again from the oldest bar.
+ * The segment is removed on destruction.
+ */
+class SharedBarWriter
+{
+    public:
+        explicit SharedBarWriter(const std::string& _name = SHARED_BARS_DEFAULT_NAME, size_t _capacity = SHARED_BARS_DEFAULT_CAPACITY);
+        ~SharedBarWriter();
+
+        SharedBarWriter(const SharedBarWriter&) = delete;
+        SharedBarWriter& operator=(const SharedBarWriter&) = delete;
+
+        void publish(const MarketCondition& bar);
+
+        uint64_t getPublished() const { return published; }
+        size_t getCapacity() const { return capacity; }
+
+    private:
+        std::string name;
+        size_t capacity;
+        size_t mappingSize;
+        void* mapping;
+        SharedBarHeader* header;
+        SharedBarSlot* slots;
+        uint64_t published;
+};
+
+/**
+ * SharedBarReader
+ *
+ * Maps a segment made by a SharedBarWriter read only and copies out the
+ * bars published since the last read, with no file or text parsing in
+ * between. Starts from the oldest bar still in the ring. A reader that
+ * falls more than a ring behind skips to the oldest bar left and counts
+ * the ones it missed.
+ *
+ * Throws std::runtime_error if the segment does not exist or is not a bar
+ * ring of this version.
+ */
+class SharedBarReader
+{
+    public:
+        explicit SharedBarReader(const std::string& _name = SHARED_BARS_DEFAULT_NAME);
+        ~SharedBarReader();
+
+        SharedBarReader(const SharedBarReader&) = delete;
+        SharedBarReader& operator=(const SharedBarReader&) = delete;
+
+        // Copy the bars published since the last read into rows, returns how many
+        size_t read(std::vector<MarketCondition>& rows);
+
+        // Read and append to marketData, returns the bars appended
+        size_t poll(MarketData& marketData);
+
+        uint64_t getNextSequence() const { return next; }
+        uint64_t getDroppedCount() const { return dropped; }
+        size_t getCapacity() const { return capacity; }
+
+    private:
+        std::string name;
+        size_t capacity;
+        size_t mappingSize;
+        void* mapping;
+        const SharedBarHeader* header;
+        const SharedBarSlot* slots;
+        uint64_t next;
+        uint64_t dropped;
+};
@@ -28,40 +28,50 @@ OrderType stringToOrderType(const string& typeStr) {
     return OrderType::UNKNOWN;
 }
 
+string orderStatusToString(OrderStatus status) {
+    switch (status) {
+        case OrderStatus::NEW: return "NEW";
+        case OrderStatus::VALIDATED: return "VALIDATED";
+        case OrderStatus::SENT: return "SENT";
+        case OrderStatus::ACKED: return "ACKED";
+        case OrderStatus::PARTIALLY_FILLED: return "PARTIALLY_FILLED";
+        case OrderStatus::FILLED: return "FILLED";
+        case OrderStatus::CANCELLED: return "CANCELLED";
+        case OrderStatus::REJECTED: return "REJECTED";
+        default: return "UNKNOWN";
+    }
+}
+
 // Constructor with OrderType
 Order::Order(
     OrderType _type,
-    string _ticker,
+    const string& _ticker,
     float _quantity,
     float _price)
 :
   type(_type),
-  ticker(_ticker),
   quantity(_quantity),
   price(_price),
   stopLossPrice(0),
   takeProfitPrice(0)
 {
+    copyTickerSymbol(ticker, _ticker);
 }
 
 // Constructor with string type (for backward compatibility)
 Order::Order(
-    string _typeStr,
-    string _ticker,
+    const string& _typeStr,
+    const string& _ticker,
     float _quantity,
     float _price)
 :
   type(stringToOrderType(_typeStr)),
-  ticker(_ticker),
   quantity(_quantity),
   price(_price),
   stopLossPrice(0),
   takeProfitPrice(0)
 {
-}
-
-Order::~Order() 
-{
+    copyTickerSymbol(ticker, _ticker);
 }
 
 // Can set negative percentages
@@ -1,7 +1,12 @@
 #pragma once
+#include <algorithm>
+#include <cstdint>
 #include <iostream>
 #include <string>
+#include <string_view>
+#include <cstring>
 #include <stdexcept>
+#include <type_traits>
 
 using namespace std;
 
@@ -17,17 +22,45 @@ enum class OrderType {
     UNKNOWN
 };
 
+// Lifecycle of an order, see OrderLifecycle for the allowed transitions
+enum class OrderStatus : uint8_t {
+    NEW,
+    VALIDATED,
+    SENT,
+    ACKED,
+    PARTIALLY_FILLED,
+    FILLED,
+    CANCELLED,
+    REJECTED
+};
+
+#define ORDER_STATUS_COUNT 8
+
 // Helper functions for OrderType conversion
 string orderTypeToString(OrderType type);
 OrderType stringToOrderType(const string& typeStr);
+string orderStatusToString(OrderStatus status);
+
+// Longest ticker symbol an Order or Position holds, including the terminating null
+#define TICKER_SYMBOL_LENGTH 16
 
+// Copies a symbol into a fixed ticker buffer, truncating and null padding
+inline void copyTickerSymbol(char (&destination)[TICKER_SYMBOL_LENGTH], std::string_view symbol)
+{
+    std::memset(destination, 0, TICKER_SYMBOL_LENGTH);
+    std::memcpy(destination, symbol.data(), std::min(symbol.size(), size_t(TICKER_SYMBOL_LENGTH - 1)));
+}
+
+// Orders are fixed size with no heap members, so copying one is a memcpy and
+// they can live in pools and queues without allocating. The ticker symbol is
+// stored inline; the OMS stamps the interned ticker id when it books the order.
 class Order {
     public:
         Order(){};
         Order(
             // int _id,
             OrderType _type, 
-            string _ticker, 
+            const string& _ticker, 
             float _quantity, 
             float _price
         );
@@ -35,32 +68,37 @@ class Order {
         // For backwards compatibility
         Order(
             // int _id,
-            string _typeStr, 
-            string _ticker, 
+            const string& _typeStr, 
+            const string& _ticker, 
             float _quantity, 
             float _price
         );
-        
-        ~Order();
 
         // getters and setters
         int getId() const { return id;};
         float getPrice() const {return price;}
         OrderType getType() const {return type;}
-        string getTicker() const{ return ticker;}
+        string getTicker() const{ return string(getTickerView());}
+        std::string_view getTickerView() const { return std::string_view(ticker, strnlen(ticker, TICKER_SYMBOL_LENGTH)); }
+        int getTickerId() const { return tickerId; }
         float getQuantity() const {return quantity;};
         float getStopLossPrice() const {return stopLossPrice;}
         float getTakeProfitPrice() const {return takeProfitPrice;}
         string getTypeAsString() const {return orderTypeToString(type);}
+        OrderStatus getStatus() const {return status;}
 
         void setId(int _id) {id = _id;};
         void setStopLoss(float stopLossPercentage);
         void setPrice(float _price){price = _price;}
         void setType(OrderType _type){type = _type;}
         void setTakeProfit(float takeProfitPercentage);
-        void setTicker(string  _ticker) {ticker = _ticker;}
+        void setStopLossPrice(float _stopLossPrice) {stopLossPrice = _stopLossPrice;}
+        void setTakeProfitPrice(float _takeProfitPrice) {takeProfitPrice = _takeProfitPrice;}
+        void setTicker(std::string_view _ticker) {copyTickerSymbol(ticker, _ticker); tickerId = -1;}
+        void setTickerId(int _tickerId) {tickerId = _tickerId;}
+        void setStatus(OrderStatus _status) {status = _status;}
         void setQuantity(float _quantity) {quantity = _quantity;}
-        void setType(string _typeStr){type = stringToOrderType(_typeStr);}
+        void setType(const string& _typeStr){type = stringToOrderType(_typeStr);}
         
         // Helper methods
         bool isMarket() const { return type == OrderType::BUY || type == OrderType::SELL; }
@@ -70,11 +108,15 @@ class Order {
         bool isSell() const { return type == OrderType::SELL || type == OrderType::LIMIT_SELL || type == OrderType::STOP_SELL; }
 
     private:
-        int id;
-        OrderType type;
-        string ticker;
-        float quantity;
-        float price;
-        float stopLossPrice;
-        float takeProfitPrice;
+        int id = 0;
+        int tickerId = -1;      // -1 until interned
+        OrderType type = OrderType::UNKNOWN;
+        OrderStatus status = OrderStatus::NEW;
+        char ticker[TICKER_SYMBOL_LENGTH] = {};
+        float quantity = 0;
+        float price = 0;
+        float stopLossPrice = 0;
+        float takeProfitPrice = 0;
 };
+
+static_assert(std::is_trivially_copyable_v<Order>, "Order must stay trivially copyable");
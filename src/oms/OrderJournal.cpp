@@ -0,0 +1,370 @@
+#include "OrderJournal.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static std::string
+tickerOf(const char (&source)[TICKER_SYMBOL_LENGTH])
+{
+    return std::string(source, strnlen(source, TICKER_SYMBOL_LENGTH));
+}
+
+OrderJournal::OrderJournal(const std::string& _path, size_t _capacity)
+: path(_path),
+  capacity(_capacity),
+  fd(-1),
+  mapping(nullptr),
+  mappingSize(JOURNAL_HEADER_SIZE + _capacity * sizeof(JournalRecord)),
+  records(nullptr),
+  sequence(0),
+  syncedSequence(0),
+  checkpointSequence(0),
+  openCheckpoint(0)
+{
+    if (capacity < 16) {
+        throw std::runtime_error("OrderJournal: capacity must be at least 16 records");
+    }
+
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("OrderJournal: could not open " + path);
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        throw std::runtime_error("OrderJournal: could not stat " + path);
+    }
+    bool created = info.st_size == 0;
+    if (created && ::ftruncate(fd, static_cast<off_t>(mappingSize)) != 0) {
+        ::close(fd);
+        throw std::runtime_error("OrderJournal: could not allocate " + path);
+    }
+
+    // Touching a mapped page past the end of the file is a SIGBUS, so a
+    // truncated journal, or one made with a smaller capacity, is refused
+    if (!created && static_cast<uint64_t>(info.st_size) < mappingSize) {
+        ::close(fd);
+        throw std::runtime_error("OrderJournal: " + path + " is " + std::to_string(info.st_size) + " bytes, a journal of " +
+                                 std::to_string(capacity) + " records needs " + std::to_string(mappingSize));
+    }
+
+    void* mapped = ::mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapped == MAP_FAILED) {
+        ::close(fd);
+        throw std::runtime_error("OrderJournal: could not map " + path);
+    }
+    mapping = static_cast<uint8_t*>(mapped);
+    records = reinterpret_cast<JournalRecord*>(mapping + JOURNAL_HEADER_SIZE);
+
+    Header* header = reinterpret_cast<Header*>(mapping);
+    if (created) {
+        *header = Header{JOURNAL_MAGIC, JOURNAL_VERSION, sizeof(JournalRecord), capacity};
+        ::msync(mapping, JOURNAL_HEADER_SIZE, MS_SYNC);
+    } else if (header->magic != JOURNAL_MAGIC || header->version != JOURNAL_VERSION ||
+               header->recordSize != sizeof(JournalRecord) || header->capacity != capacity) {
+        ::munmap(mapping, mappingSize);
+        ::close(fd);
+        throw std::runtime_error("OrderJournal: " + path + " is not a journal with this layout and capacity");
+    }
+
+    recover();
+}
+
+OrderJournal::~OrderJournal()
+{
+    if (mapping != nullptr) {
+        sync();
+        ::munmap(mapping, mappingSize);
+    }
+    if (fd >= 0) {
+        ::close(fd);
+    }
+}
+
+void
+OrderJournal::appendOrder(JournalRecordType type, const Order& order)
+{
+    JournalOrderEntry entry;
+    entry.id = order.getId();
+    entry.type = static_cast<int32_t>(order.getType());
+    copyTickerSymbol(entry.ticker, order.getTickerView());
+    entry.quantity = order.getQuantity();
+    entry.price = order.getPrice();
+    entry.stopLossPrice = order.getStopLossPrice();
+    entry.takeProfitPrice = order.getTakeProfitPrice();
+    append(type, &entry, sizeof(entry));
+}
+
+void
+OrderJournal::appendOrderRemoved(int id)
+{
+    int32_t entry = id;
+    append(JournalRecordType::ORDER_REMOVED, &entry, sizeof(entry));
+}
+
+void
+OrderJournal::appendPosition(const Position& position)
+{
+    appendPosition(JournalRecordType::POSITION_ADDED, position);
+}
+
+void
+OrderJournal::appendPositionUpdated(const Position& position)
+{
+    appendPosition(JournalRecordType::POSITION_UPDATED, position);
+}
+
+void
+OrderJournal::appendPosition(JournalRecordType type, const Position& position)
+{
+    JournalPositionEntry entry;
+    entry.id = position.getId();
+    copyTickerSymbol(entry.ticker, position.getTickerView());
+    entry.quantity = position.getQuantity();
+    entry.avgPrice = position.getAvgPrice();
+    append(type, &entry, sizeof(entry));
+}
+
+void
+OrderJournal::appendPositionRemoved(int id)
+{
+    int32_t entry = id;
+    append(JournalRecordType::POSITION_REMOVED, &entry, sizeof(entry));
+}
+
+void
+OrderJournal::appendEvent(const BrokerEvent& event)
+{
+    append(JournalRecordType::BROKER_EVENT, &event, sizeof(event));
+}
+
+void
+OrderJournal::beginCheckpoint(int latestOrderId, int latestPositionId)
+{
+    JournalCheckpointEntry entry{latestOrderId, latestPositionId, 0};
+    append(JournalRecordType::CHECKPOINT_BEGIN, &entry, sizeof(entry));
+    openCheckpoint = sequence;
+}
+
+void
+OrderJournal::endCheckpoint()
+{
+    if (openCheckpoint == 0) {
+        throw std::runtime_error("OrderJournal: endCheckpoint without beginCheckpoint");
+    }
+
+    JournalCheckpointEntry entry{0, 0, openCheckpoint};
+    append(JournalRecordType::CHECKPOINT_END, &entry, sizeof(entry));
+
+    // The checkpoint only counts once it is on disk
+    sync();
+    checkpointSequence = openCheckpoint;
+    openCheckpoint = 0;
+}
+
+void
+OrderJournal::append(JournalRecordType type, const void* payload, size_t size)
+{
+    uint64_t next = sequence + 1;
+
+    // Never overwrite the oldest record recovery would still need
+    uint64_t oldestNeeded = checkpointSequence == 0 ? 1 : checkpointSequence;
+    if (next >= oldestNeeded + capacity) {
+        throw std::runtime_error("OrderJournal: ring full, a checkpoint is overdue in " + path);
+    }
+
+    JournalRecord record;
+    std::memset(&record, 0, sizeof(record));
+    record.sequence = next;
+    record.type = type;
+    std::memcpy(record.payload, payload, std::min(size, JournalRecord::PAYLOAD_SIZE));
+    record.checksum = checksumOf(record);
+
+    std::memcpy(&slot(next), &record, sizeof(record));
+    sequence = next;
+
+    if (sequence - syncedSequence >= JOURNAL_SYNC_INTERVAL) {
+        sync();
+    }
+}
+
+void
+OrderJournal::sync()
+{
+    if (sequence == syncedSequence) {
+        return;
+    }
+
+    uint64_t from = syncedSequence + 1;
+    uint64_t firstSlot = (from - 1) % capacity;
+    uint64_t lastSlot = (sequence - 1) % capacity;
+
+    // The dirty run may wrap past the end of the ring
+    if (sequence - from + 1 >= capacity) {
+        syncRange(0, capacity - 1);
+    } else if (firstSlot <= lastSlot) {
+        syncRange(firstSlot, lastSlot);
+    } else {
+        syncRange(firstSlot, capacity - 1);
+        syncRange(0, lastSlot);
+    }
+    syncedSequence = sequence;
+}
+
+void
+OrderJournal::syncRange(uint64_t firstSlot, uint64_t lastSlot)
+{
+    static const size_t pageSize = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+
+    size_t begin = JOURNAL_HEADER_SIZE + firstSlot * sizeof(JournalRecord);
+    size_t end = JOURNAL_HEADER_SIZE + (lastSlot + 1) * sizeof(JournalRecord);
+    begin -= begin % pageSize;
+    ::msync(mapping + begin, end - begin, MS_SYNC);
+}
+
+void
+OrderJournal::replay(const std::function<void(const JournalRecord&)>& visit) const
+{
+    uint64_t start = checkpointSequence;
+    if (start == 0) {
+        start = sequence > capacity ? sequence - capacity + 1 : 1;
+    }
+
+    for (uint64_t recordSequence = start; recordSequence <= sequence && recordSequence > 0; recordSequence++) {
+        visit(slot(recordSequence));
+    }
+}
+
+void
+OrderJournal::recover()
+{
+    // The newest valid record is the head of the ring
+    uint64_t head = 0;
+    for (size_t i = 0; i < capacity; i++) {
+        if (isValid(records[i], records[i].sequence)) {
+            head = std::max(head, records[i].sequence);
+        }
+    }
+    if (head == 0) {
+        return;
+    }
+
+    // Walk forward from the oldest slot the ring can still hold, a gap or a
+    // torn record ends the usable journal
+    uint64_t oldest = head > capacity ? head - capacity + 1 : 1;
+    uint64_t last = oldest - 1;
+    while (last < head && isValid(slot(last + 1), last + 1)) {
+        last++;
+    }
+    if (last < head) {
+        std::cerr << "OrderJournal: " << path << " is damaged after record " << last
+                  << ", discarding " << (head - last) << " records" << std::endl;
+    }
+
+    // Latest checkpoint with both ends intact. Anything after a checkpoint
+    // that never finished is a partial snapshot and is dropped.
+    uint64_t openBegin = 0;
+    for (uint64_t recordSequence = last; recordSequence >= oldest && recordSequence > 0; recordSequence--) {
+        const JournalRecord& record = slot(recordSequence);
+        if (record.type == JournalRecordType::CHECKPOINT_END) {
+            checkpointSequence = decodeCheckpoint(record).beginSequence;
+            break;
+        }
+        if (record.type == JournalRecordType::CHECKPOINT_BEGIN) {
+            openBegin = recordSequence;
+        }
+    }
+    if (openBegin != 0) {
+        last = openBegin - 1;
+    }
+
+    if (checkpointSequence == 0 && oldest > 1) {
+        std::cerr << "OrderJournal: " << path << " wrapped without a checkpoint, replay starts at record "
+                  << oldest << std::endl;
+    }
+
+    sequence = last;
+    syncedSequence = last;
+}
+
+JournalRecord&
+OrderJournal::slot(uint64_t recordSequence) const
+{
+    return records[(recordSequence - 1) % capacity];
+}
+
+bool
+OrderJournal::isValid(const JournalRecord& record, uint64_t recordSequence) const
+{
+    return recordSequence != 0 && record.sequence == recordSequence &&
+           &record == &slot(recordSequence) && record.checksum == checksumOf(record);
+}
+
+uint32_t
+OrderJournal::checksumOf(const JournalRecord& record)
+{
+    // FNV-1a over the record with the checksum field treated as zero
+    JournalRecord copy = record;
+    copy.checksum = 0;
+
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&copy);
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < sizeof(copy); i++) {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
+Order
+OrderJournal::decodeOrder(const JournalRecord& record)
+{
+    JournalOrderEntry entry;
+    std::memcpy(&entry, record.payload, sizeof(entry));
+
+    Order order(static_cast<OrderType>(entry.type), tickerOf(entry.ticker), entry.quantity, entry.price);
+    order.setId(entry.id);
+    order.setStopLossPrice(entry.stopLossPrice);
+    order.setTakeProfitPrice(entry.takeProfitPrice);
+    return order;
+}
+
+Position
+OrderJournal::decodePosition(const JournalRecord& record)
+{
+    JournalPositionEntry entry;
+    std::memcpy(&entry, record.payload, sizeof(entry));
+
+    Position position(tickerOf(entry.ticker), entry.quantity, entry.avgPrice);
+    position.setId(entry.id);
+    return position;
+}
+
+BrokerEvent
+OrderJournal::decodeEvent(const JournalRecord& record)
+{
+    BrokerEvent event;
+    std::memcpy(&event, record.payload, sizeof(event));
+    return event;
+}
+
+JournalCheckpointEntry
+OrderJournal::decodeCheckpoint(const JournalRecord& record)
+{
+    JournalCheckpointEntry entry;
+    std::memcpy(&entry, record.payload, sizeof(entry));
+    return entry;
+}
+
+int
+OrderJournal::decodeId(const JournalRecord& record)
+{
+    int32_t id;
+    std::memcpy(&id, record.payload, sizeof(id));
+    return id;
+}
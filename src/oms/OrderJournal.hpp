@@ -0,0 +1,151 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include "Order.hpp"
+#include "Position.hpp"
+#include "../broker/BrokerEvent.hpp"
+
+#define JOURNAL_MAGIC 0x4C4E524A54475441ull      // "ATGTJRNL"
+#define JOURNAL_VERSION 1
+#define JOURNAL_HEADER_SIZE 4096
+#define JOURNAL_DEFAULT_CAPACITY (1 << 16)       // Records, 4MB of ring
+#define JOURNAL_SYNC_INTERVAL 256                // Records appended between automatic syncs
+
+enum class JournalRecordType : uint8_t {
+    EMPTY,
+    ORDER_ADDED,
+    ORDER_UPDATED,
+    ORDER_REMOVED,
+    POSITION_ADDED,
+    POSITION_REMOVED,
+    BROKER_EVENT,
+    CHECKPOINT_BEGIN,
+    CHECKPOINT_END,
+    POSITION_UPDATED
+};
+
+/**
+ * One fixed size journal slot. The payload holds one of the entry structs
+ * below, or a BrokerEvent, copied in with memcpy.
+ */
+struct JournalRecord
+{
+    static constexpr size_t PAYLOAD_SIZE = 48;
+
+    uint64_t sequence;          // 1-based, 0 marks a slot that was never written
+    uint32_t checksum;          // Over the whole record with this field zeroed
+    JournalRecordType type;
+    uint8_t reserved[3];
+    uint8_t payload[PAYLOAD_SIZE];
+};
+
+struct JournalOrderEntry
+{
+    int32_t id;
+    int32_t type;
+    char ticker[TICKER_SYMBOL_LENGTH];
+    float quantity;
+    float price;
+    float stopLossPrice;
+    float takeProfitPrice;
+};
+
+struct JournalPositionEntry
+{
+    int32_t id;
+    char ticker[TICKER_SYMBOL_LENGTH];
+    float quantity;
+    float avgPrice;
+};
+
+struct JournalCheckpointEntry
+{
+    int32_t latestOrderId;
+    int32_t latestPositionId;
+    uint64_t beginSequence;     // Set on CHECKPOINT_END, the matching begin
+};
+
+static_assert(sizeof(JournalRecord) == 64, "Journal records must stay 64 bytes");
+static_assert(sizeof(BrokerEvent) <= JournalRecord::PAYLOAD_SIZE, "BrokerEvent does not fit a journal record");
+
+/**
+ * OrderJournal
+ *
+ * Append-only write-ahead log of OMS activity, kept in a pre-allocated file
+ * mapped into memory and used as a ring of 64 byte records. Appending is a
+ * memcpy into the mapping; sync() msyncs the dirty pages, and append() calls
+ * it every JOURNAL_SYNC_INTERVAL records so fsyncs are batched.
+ *
+ * The ring never overwrites the latest complete checkpoint. A checkpoint is
+ * a snapshot of live orders and positions written between CHECKPOINT_BEGIN
+ * and CHECKPOINT_END; the owner writes one whenever needsCheckpoint() says
+ * a quarter of the ring has been used since the last. Recovery replays from
+ * the latest complete checkpoint (or the start of the file) to the last
+ * record with a valid checksum.
+ */
+class OrderJournal
+{
+    public:
+        explicit OrderJournal(const std::string& path, size_t capacity = JOURNAL_DEFAULT_CAPACITY);
+        ~OrderJournal();
+
+        OrderJournal(const OrderJournal&) = delete;
+        OrderJournal& operator=(const OrderJournal&) = delete;
+
+        void appendOrder(JournalRecordType type, const Order& order);
+        void appendOrderRemoved(int id);
+        void appendPosition(const Position& position);
+        void appendPositionUpdated(const Position& position);
+        void appendPositionRemoved(int id);
+        void appendEvent(const BrokerEvent& event);
+        void beginCheckpoint(int latestOrderId, int latestPositionId);
+        void endCheckpoint();
+
+        void sync();
+        bool needsCheckpoint() const { return sequence - checkpointSequence > capacity / 4; }
+        bool isEmpty() const { return sequence == 0; }
+
+        // Visit the records needed to rebuild state, oldest first
+        void replay(const std::function<void(const JournalRecord&)>& visit) const;
+
+        uint64_t getSequence() const { return sequence; }
+        size_t getCapacity() const { return capacity; }
+        const std::string& getPath() const { return path; }
+
+        static Order decodeOrder(const JournalRecord& record);
+        static Position decodePosition(const JournalRecord& record);
+        static BrokerEvent decodeEvent(const JournalRecord& record);
+        static JournalCheckpointEntry decodeCheckpoint(const JournalRecord& record);
+        static int decodeId(const JournalRecord& record);
+
+    private:
+        struct Header {
+            uint64_t magic;
+            uint32_t version;
+            uint32_t recordSize;
+            uint64_t capacity;
+        };
+
+        void append(JournalRecordType type, const void* payload, size_t size);
+        void appendPosition(JournalRecordType type, const Position& position);
+        void recover();
+        JournalRecord& slot(uint64_t recordSequence) const;
+        bool isValid(const JournalRecord& record, uint64_t recordSequence) const;
+        void syncRange(uint64_t firstSlot, uint64_t lastSlot);
+        static uint32_t checksumOf(const JournalRecord& record);
+
+        std::string path;
+        size_t capacity;
+        int fd;
+        uint8_t* mapping;
+        size_t mappingSize;
+        JournalRecord* records;
+
+        uint64_t sequence;              // Last sequence written
+        uint64_t syncedSequence;        // Last sequence known to be on disk
+        uint64_t checkpointSequence;    // Begin of the latest complete checkpoint, 0 if none
+        uint64_t openCheckpoint;        // Begin of a checkpoint being written, 0 if none
+};
@@ -0,0 +1,195 @@
+#include "OrderLifecycle.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#define STATUS_BIT(status) (1u << static_cast<int>(OrderStatus::status))
+
+// States each state may move to, indexed by OrderStatus
+static const uint32_t allowedTransitions[ORDER_STATUS_COUNT] = {
+    // NEW
+    STATUS_BIT(VALIDATED) | STATUS_BIT(CANCELLED) | STATUS_BIT(REJECTED),
+    // VALIDATED
+    STATUS_BIT(SENT) | STATUS_BIT(CANCELLED) | STATUS_BIT(REJECTED),
+    // SENT
+    STATUS_BIT(ACKED) | STATUS_BIT(PARTIALLY_FILLED) | STATUS_BIT(FILLED) | STATUS_BIT(CANCELLED) | STATUS_BIT(REJECTED),
+    // ACKED
+    STATUS_BIT(PARTIALLY_FILLED) | STATUS_BIT(FILLED) | STATUS_BIT(CANCELLED) | STATUS_BIT(REJECTED),
+    // PARTIALLY_FILLED
+    STATUS_BIT(PARTIALLY_FILLED) | STATUS_BIT(FILLED) | STATUS_BIT(CANCELLED),
+    // FILLED, CANCELLED and REJECTED are final
+    0, 0, 0
+};
+
+OrderLifecycle::OrderLifecycle(size_t _historyCapacity)
+: historyCapacity(std::max<size_t>(_historyCapacity, 1)),
+  historyHead(0),
+  illegalTransitions(0)
+{
+    history.reserve(historyCapacity);
+}
+
+int64_t
+OrderLifecycle::now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool
+OrderLifecycle::isTerminal(OrderStatus status)
+{
+    return allowedTransitions[static_cast<int>(status)] == 0;
+}
+
+bool
+OrderLifecycle::canTransition(OrderStatus from, OrderStatus to)
+{
+    return (allowedTransitions[static_cast<int>(from)] & (1u << static_cast<int>(to))) != 0;
+}
+
+void
+OrderLifecycle::open(int orderId, int64_t timestamp)
+{
+    Record record{orderId, OrderStatus::NEW, {}};
+    record.timestamps[static_cast<int>(OrderStatus::NEW)] = timestamp;
+
+    uint32_t slot = openIndex.find(orderId);
+    if (slot != IdIndex::NOT_FOUND) {
+        openRecords[slot] = record;
+        return;
+    }
+    openIndex.insert(orderId, static_cast<uint32_t>(openRecords.size()));
+    openRecords.push_back(record);
+}
+
+bool
+OrderLifecycle::transition(int orderId, OrderStatus status, int64_t timestamp)
+{
+    uint32_t slot = openIndex.find(orderId);
+    if (slot == IdIndex::NOT_FOUND || !canTransition(openRecords[slot].status, status)) {
+        illegalTransitions++;
+        return false;
+    }
+
+    // A state entered more than once (repeated partial fills) keeps its first time
+    Record& record = openRecords[slot];
+    int64_t& stamp = record.timestamps[static_cast<int>(status)];
+    if (stamp == 0) {
+        stamp = timestamp;
+    }
+    record.status = status;
+
+    if (isTerminal(status)) {
+        retire(slot);
+    }
+    return true;
+}
+
+OrderStatus
+OrderLifecycle::getStatus(int orderId) const
+{
+    uint32_t slot = openIndex.find(orderId);
+    if (slot != IdIndex::NOT_FOUND) {
+        return openRecords[slot].status;
+    }
+
+    // Completed orders are only searched when asked about directly
+    for (const Record& record : history) {
+        if (record.orderId == orderId) return record.status;
+    }
+    return OrderStatus::NEW;
+}
+
+int64_t
+OrderLifecycle::getTimestamp(int orderId, OrderStatus status) const
+{
+    uint32_t slot = openIndex.find(orderId);
+    if (slot != IdIndex::NOT_FOUND) {
+        return openRecords[slot].timestamps[static_cast<int>(status)];
+    }
+
+    for (const Record& record : history) {
+        if (record.orderId == orderId) return record.timestamps[static_cast<int>(status)];
+    }
+    return 0;
+}
+
+std::vector<int64_t>
+OrderLifecycle::getLatencySamples(OrderStatus from, OrderStatus to) const
+{
+    std::vector<int64_t> samples;
+    samples.reserve(history.size());
+
+    for (const Record& record : history) {
+        int64_t start = record.timestamps[static_cast<int>(from)];
+        int64_t end = record.timestamps[static_cast<int>(to)];
+        if (start != 0 && end != 0) {
+            samples.push_back(end - start);
+        }
+    }
+    return samples;
+}
+
+LatencyStats
+OrderLifecycle::getLatencies(OrderStatus from, OrderStatus to) const
+{
+    std::vector<int64_t> samples = getLatencySamples(from, to);
+
+    LatencyStats stats;
+    if (samples.empty()) {
+        return stats;
+    }
+
+    std::sort(samples.begin(), samples.end());
+
+    // Nearest rank percentiles
+    auto percentile = [&samples](double p) {
+        size_t rank = static_cast<size_t>(std::ceil(p * samples.size()));
+        return samples[std::min(samples.size(), std::max<size_t>(rank, 1)) - 1];
+    };
+
+    double total = 0.0;
+    for (int64_t sample : samples) {
+        total += static_cast<double>(sample);
+    }
+
+    stats.count = samples.size();
+    stats.mean = total / samples.size();
+    stats.p50 = percentile(0.50);
+    stats.p90 = percentile(0.90);
+    stats.p99 = percentile(0.99);
+    stats.max = samples.back();
+    return stats;
+}
+
+void
+OrderLifecycle::reset()
+{
+    openRecords.clear();
+    openIndex.clear();
+    history.clear();
+    historyHead = 0;
+    illegalTransitions = 0;
+}
+
+void
+OrderLifecycle::retire(uint32_t slot)
+{
+    Record record = openRecords[slot];
+
+    if (history.size() < historyCapacity) {
+        history.push_back(record);
+    } else {
+        history[historyHead] = record;
+        historyHead = (historyHead + 1) % historyCapacity;
+    }
+
+    // Same swap-remove as the OMS book
+    if (slot + 1 != openRecords.size()) {
+        openRecords[slot] = openRecords.back();
+        openIndex.insert(openRecords[slot].orderId, slot);
+    }
+    openRecords.pop_back();
+    openIndex.erase(record.orderId);
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Order.hpp"
+#include "../util/IdIndex.hpp"
+
+#define LIFECYCLE_HISTORY_SIZE 16384    // Completed orders kept for latency statistics
+
+/**
+ * Summary of one stage's latency across completed orders, in nanoseconds
+ */
+struct LatencyStats
+{
+    size_t count = 0;
+    double mean = 0.0;
+    int64_t p50 = 0;
+    int64_t p90 = 0;
+    int64_t p99 = 0;
+    int64_t max = 0;
+};
+
+/**
+ * OrderLifecycle
+ *
+ * Status and transition timestamps for every order the OMS has booked, kept
+ * beside the book rather than in Order. Orders move through
+ *
+ *   NEW -> VALIDATED -> SENT -> ACKED -> PARTIALLY_FILLED -> FILLED
+ *
+ * and can end CANCELLED or REJECTED from any live state. ACKED may be
+ * skipped, a broker can report a fill before or without an ack. Transitions
+ * that break these rules are refused and counted.
+ *
+ * Open orders are stored densely and indexed by id. When an order reaches a
+ * terminal state its record moves to a fixed-size ring of completed orders,
+ * which getLatencies() summarises for any pair of states, e.g. NEW to FILLED
+ * for signal-to-fill. Timestamps are steady clock nanoseconds, a timestamp
+ * of 0 means the order never passed through that state.
+ */
+class OrderLifecycle
+{
+    public:
+        explicit OrderLifecycle(size_t historyCapacity = LIFECYCLE_HISTORY_SIZE);
+
+        // Start tracking an order in NEW, stamped with when its signal arrived
+        void open(int orderId, int64_t timestamp);
+        bool transition(int orderId, OrderStatus status, int64_t timestamp = now());
+
+        bool isOpen(int orderId) const { return openIndex.contains(orderId); }
+        OrderStatus getStatus(int orderId) const;
+        int64_t getTimestamp(int orderId, OrderStatus status) const;
+
+        LatencyStats getLatencies(OrderStatus from, OrderStatus to) const;
+        std::vector<int64_t> getLatencySamples(OrderStatus from, OrderStatus to) const;
+
+        size_t getOpenCount() const { return openRecords.size(); }
+        size_t getCompletedCount() const { return history.size(); }
+        uint64_t getIllegalTransitions() const { return illegalTransitions; }
+        void reset();
+
+        static int64_t now();
+        static bool isTerminal(OrderStatus status);
+        static bool canTransition(OrderStatus from, OrderStatus to);
+
+    private:
+        struct Record {
+            int orderId;
+            OrderStatus status;
+            int64_t timestamps[ORDER_STATUS_COUNT];
+        };
+
+        void retire(uint32_t slot);
+
+        std::vector<Record> openRecords;
+        IdIndex openIndex;
+        std::vector<Record> history;    // Ring once full
+        size_t historyCapacity;
+        size_t historyHead;
+        uint64_t illegalTransitions;
+};
@@ -1,11 +1,18 @@
 #include <algorithm>
+#include <cmath>
 
 #include "OrderManagement.hpp"
+#include "../util/BinaryIO.hpp"
 
 // OrderValidator* OrderManagement::validator = new OrderValidator();
 
 OrderManagement::OrderManagement() 
+: orderIndex(OMS_INITIAL_CAPACITY),
+  positionIndex(OMS_INITIAL_CAPACITY),
+  tickerPositionIndex(OMS_INITIAL_CAPACITY)
 {
+    orders.reserve(OMS_INITIAL_CAPACITY);
+    positions.reserve(OMS_INITIAL_CAPACITY);
 }
 
 OrderManagement::~OrderManagement() 
@@ -21,56 +28,540 @@ void
 OrderManagement::addOrder(Order &order)
 {
     order.setId(latestOrderId);
+    order.setTickerId(tickers.intern(order.getTickerView()));
+    orderIndex.insert(order.getId(), static_cast<uint32_t>(orders.size()));
     orders.push_back(order);
     latestOrderId++;
+
+    risk.onOrderOpened(order.getTickerId(), order);
+
+    if (journal != nullptr)
+        journal->appendOrder(JournalRecordType::ORDER_ADDED, order);
 }
 
 void
 OrderManagement::addPosition(Position &position)
 {
     position.setId(latestPositionId);
+    position.setTickerId(tickers.intern(position.getTickerView()));
+    positionIndex.insert(position.getId(), static_cast<uint32_t>(positions.size()));
+    tickerPositionIndex.insert(position.getTickerId(), static_cast<uint32_t>(positions.size()));
     positions.push_back(position);
     latestPositionId++;
+
+    risk.onPositionAdded(position.getTickerId(), position.getQuantity(), position.getAvgPrice());
+
+    if (journal != nullptr)
+        journal->appendPosition(position);
 }
 
 void OrderManagement::removeOrder(int id)
 {
-    std::erase_if(orders, [id](Order& order) { return order.getId() == id; });
+    uint32_t slot = orderIndex.find(id);
+    if (slot == IdIndex::NOT_FOUND)
+        return;
+
+    // Removing an order that is still live cancels it
+    if (lifecycle.isOpen(id))
+        lifecycle.transition(id, OrderStatus::CANCELLED);
+
+    // Whatever is left of the order is no longer working
+    risk.onOrderReduced(orders[slot].getTickerId(), orders[slot], orders[slot].getQuantity());
+
+    // Fill the hole with the last order and repoint its index entry
+    if (slot + 1 != orders.size())
+    {
+        orders[slot] = orders.back();
+        orderIndex.insert(orders[slot].getId(), slot);
+    }
+    orders.pop_back();
+    orderIndex.erase(id);
+
+    if (journal != nullptr)
+        journal->appendOrderRemoved(id);
 }
 
 void OrderManagement::removePosition(int id)
 {
-    std::erase_if(positions, [id](Position& position) { return position.getId() == id; });
+    uint32_t slot = positionIndex.find(id);
+    if (slot == IdIndex::NOT_FOUND)
+        return;
+
+    int tickerId = positions[slot].getTickerId();
+    risk.onPositionRemoved(tickerId, positions[slot].getQuantity());
+
+    // Only drop the ticker entry if it points here, it may name a later
+    // position added directly for the same ticker
+    if (tickerPositionIndex.find(tickerId) == slot)
+        tickerPositionIndex.erase(tickerId);
+
+    uint32_t last = static_cast<uint32_t>(positions.size() - 1);
+    if (slot != last)
+    {
+        positions[slot] = positions.back();
+        positionIndex.insert(positions[slot].getId(), slot);
+        if (tickerPositionIndex.find(positions[slot].getTickerId()) == last)
+            tickerPositionIndex.insert(positions[slot].getTickerId(), slot);
+    }
+    positions.pop_back();
+    positionIndex.erase(id);
+
+    if (journal != nullptr)
+        journal->appendPositionRemoved(id);
 }
 
-void OrderManagement::onNewOrder(Order& order)
+const Order* OrderManagement::findOrder(int id) const
 {
-    // Wait for new order to be added to orders from strat engine
-    bool orderValid = validator.validateOrder(order, marketData, positions);
-    if(orderValid)
+    uint32_t slot = orderIndex.find(id);
+    return slot == IdIndex::NOT_FOUND ? nullptr : &orders[slot];
+}
+
+const Position* OrderManagement::findPosition(int id) const
+{
+    uint32_t slot = positionIndex.find(id);
+    return slot == IdIndex::NOT_FOUND ? nullptr : &positions[slot];
+}
+
+float OrderManagement::getHeldQuantity(const string& ticker) const
+{
+    return static_cast<float>(risk.getHeldQuantity(tickers.find(ticker)));
+}
+
+void OrderManagement::setMarketData(const MarketData& marketdata)
+{
+    marketData = marketdata;
+
+    // Snapshot the bar once here rather than in every order check
+    if (marketData.isEmpty())
+    {
+        risk.invalidate();
+        return;
+    }
+
+    MarketCondition current = marketData.getCurrentData();
+    double equity = broker != nullptr ? broker->getEquity() : 0.0;
+    risk.onTick(tickers.intern(current.Ticker), current.Close, equity);
+}
+
+void OrderManagement::reset()
+{
+    orders.clear();
+    positions.clear();
+    orderIndex.clear();
+    positionIndex.clear();
+    tickerPositionIndex.clear();
+    risk.reset();
+    lifecycle.reset();
+
+    // An empty checkpoint means replay starts from nothing
+    if (journal != nullptr)
+        writeCheckpoint();
+}
+
+// Rebuild the book from the journal, then journal everything from here on.
+// The broker is handed the recovered positions so a simulated account
+// matches the book again; a live broker keeps its own state and ignores them.
+void OrderManagement::attachJournal(OrderJournal* orderJournal)
+{
+    journal = nullptr;
+    if (orderJournal == nullptr)
+        return;
+
+    if (!orderJournal->isEmpty())
     {
+        orderJournal->replay([this](const JournalRecord& record) { restore(record); });
+
+        if (broker != nullptr)
+        {
+            for (const Position& position : positions)
+                broker->restorePosition(position);
+        }
+
+        std::cout << "Recovered " << orders.size() << " open orders and " << positions.size()
+                  << " positions from " << orderJournal->getPath() << std::endl;
+    }
+
+    journal = orderJournal;
+}
+
+void OrderManagement::restore(const JournalRecord& record)
+{
+    switch (record.type)
+    {
+        case JournalRecordType::CHECKPOINT_BEGIN:
+        {
+            JournalCheckpointEntry checkpoint = OrderJournal::decodeCheckpoint(record);
+            reset();
+            latestOrderId = checkpoint.latestOrderId;
+            latestPositionId = checkpoint.latestPositionId;
+            break;
+        }
+
+        case JournalRecordType::ORDER_ADDED:
+        {
+            // addOrder hands out latestOrderId, so point it at the recorded id
+            Order order = OrderJournal::decodeOrder(record);
+            int nextOrderId = std::max(latestOrderId, order.getId() + 1);
+            latestOrderId = order.getId();
+            addOrder(order);
+            latestOrderId = nextOrderId;
+            break;
+        }
+
+        case JournalRecordType::ORDER_UPDATED:
+        {
+            Order order = OrderJournal::decodeOrder(record);
+            uint32_t slot = orderIndex.find(order.getId());
+            if (slot != IdIndex::NOT_FOUND)
+            {
+                risk.onOrderReduced(orders[slot].getTickerId(), orders[slot], orders[slot].getQuantity() - order.getQuantity());
+                orders[slot].setQuantity(order.getQuantity());
+            }
+            break;
+        }
+
+        case JournalRecordType::ORDER_REMOVED:
+            removeOrder(OrderJournal::decodeId(record));
+            break;
+
+        case JournalRecordType::POSITION_ADDED:
+        {
+            Position position = OrderJournal::decodePosition(record);
+            int nextPositionId = std::max(latestPositionId, position.getId() + 1);
+            latestPositionId = position.getId();
+            addPosition(position);
+            latestPositionId = nextPositionId;
+            break;
+        }
+
+        case JournalRecordType::POSITION_REMOVED:
+            removePosition(OrderJournal::decodeId(record));
+            break;
+
+        case JournalRecordType::POSITION_UPDATED:
+        {
+            Position position = OrderJournal::decodePosition(record);
+            uint32_t slot = positionIndex.find(position.getId());
+            if (slot != IdIndex::NOT_FOUND)
+            {
+                risk.onPositionChanged(positions[slot].getTickerId(), position.getQuantity() - positions[slot].getQuantity(),
+                                       position.getAvgPrice());
+                positions[slot].setQuantity(position.getQuantity());
+                positions[slot].setAvgPrice(position.getAvgPrice());
+            }
+            break;
+        }
+
+        // Broker events are kept for the audit trail, the book changes they
+        // caused are journaled separately
+        case JournalRecordType::BROKER_EVENT:
+        case JournalRecordType::CHECKPOINT_END:
+        case JournalRecordType::EMPTY:
+            break;
+    }
+}
+
+void OrderManagement::saveState(std::ostream& out) const
+{
+    writeBinary(out, latestOrderId);
+    writeBinary(out, latestPositionId);
+    writeBinaryVector(out, orders);
+    writeBinaryVector(out, positions);
+}
+
+void OrderManagement::loadState(std::istream& in)
+{
+    int nextOrderId = 1, nextPositionId = 1;
+    vector<Order> savedOrders;
+    vector<Position> savedPositions;
+    readBinary(in, nextOrderId);
+    readBinary(in, nextPositionId);
+    readBinaryVector(in, savedOrders);
+    readBinaryVector(in, savedPositions);
+    if (!in)
+        return;
+
+    // addOrder and addPosition hand out the latest id, so point it at each saved one
+    reset();
+    for (Order& order : savedOrders)
+    {
+        latestOrderId = order.getId();
         addOrder(order);
+    }
+    for (Position& position : savedPositions)
+    {
+        latestPositionId = position.getId();
+        addPosition(position);
+    }
+    latestOrderId = nextOrderId;
+    latestPositionId = nextPositionId;
+}
+
+void OrderManagement::writeCheckpoint()
+{
+    journal->beginCheckpoint(latestOrderId, latestPositionId);
+    for (const Order& order : orders)
+        journal->appendOrder(JournalRecordType::ORDER_ADDED, order);
+    for (const Position& position : positions)
+        journal->appendPosition(position);
+    journal->endCheckpoint();
+}
 
-        // connect with Broker API to place order here
-        if (broker->placeOrder(order))
+void OrderManagement::syncJournal()
+{
+    if (journal == nullptr)
+        return;
+
+    // endCheckpoint syncs as well
+    if (journal->needsCheckpoint())
+        writeCheckpoint();
+    else
+        journal->sync();
+}
+
+void OrderManagement::onNewOrder(Order& order)
+{
+    onNewOrders(std::span<Order>(&order, 1));
+}
+
+// Validate a bar's worth of orders against the current risk snapshot, net
+// offsetting market orders per ticker and submit what is left to the broker
+// in one call. Returns the number of orders sent.
+int OrderManagement::onNewOrders(std::span<Order> batch)
+{
+    lastRiskFailures = 0;
+    if (batch.empty() || broker == nullptr)
+        return 0;
+
+    // Every order in the batch was signalled now
+    int64_t received = OrderLifecycle::now();
+
+    accepted.clear();
+    for (Order& order : batch)
+    {
+        order.setTickerId(tickers.intern(order.getTickerView()));
+        uint32_t failures = risk.check(order, order.getTickerId());
+        lastRiskFailures |= failures;
+        if (failures == 0)
+            accepted.push_back(order);
+    }
+
+    netOrders(accepted);
+
+    // Check again as each order joins the book: netted quantities differ from
+    // what was proposed, and working orders add to exposure
+    submitted.clear();
+    for (Order& order : accepted)
+    {
+        uint32_t failures = risk.check(order, order.getTickerId());
+        lastRiskFailures |= failures;
+        if (failures == 0)
         {
-            Position newPosition = broker->getLatestPosition(order.getTicker());
-            addPosition(newPosition);
+            order.setStatus(OrderStatus::VALIDATED);
+            addOrder(order);
+            lifecycle.open(order.getId(), received);
+            lifecycle.transition(order.getId(), OrderStatus::VALIDATED);
+            submitted.push_back(order);
         }
     }
+
+    if (submitted.empty())
+        return 0;
+
+    // Write ahead: the book is on disk before the broker sees the orders
+    syncJournal();
+
+    // Submission is asynchronous, fills come back through
+    // processBrokerEvents -> onOrderExecuted
+    clientOrderIds.assign(submitted.size(), 0);
+    int sent = broker->placeOrders(submitted, clientOrderIds);
+    for (size_t i = 0; i < submitted.size(); i++)
+    {
+        if (clientOrderIds[i] == 0)
+        {
+            setStatus(submitted[i].getId(), OrderStatus::REJECTED);
+            removeOrder(submitted[i].getId());
+        }
+        else
+        {
+            setStatus(submitted[i].getId(), OrderStatus::SENT);
+        }
+    }
+
+    // A single order keeps the id it was booked under, as before batching
+    if (batch.size() == 1 && submitted.size() == 1)
+        batch[0].setId(submitted[0].getId());
+
+    return sent;
 }
 
-        
+// Market buys and sells for the same ticker offset each other. The side with
+// more quantity survives as one order for the difference, built from that
+// side's largest order so it keeps a sensible stop loss and take profit.
+// Limit and stop orders carry their own prices and are left alone.
+void OrderManagement::netOrders(vector<Order>& batch)
+{
+    nets.clear();
+    netted.clear();
+
+    for (size_t i = 0; i < batch.size(); i++)
+    {
+        const Order& order = batch[i];
+        OrderType type = order.getType();
+        if (type != OrderType::BUY && type != OrderType::SELL)
+        {
+            netted.push_back(order);
+            continue;
+        }
+
+        // A batch holds one order per strategy, a linear search beats hashing
+        int tickerId = order.getTickerId();
+        auto net = std::find_if(nets.begin(), nets.end(), [tickerId](const NetQuantity& n) { return n.tickerId == tickerId; });
+        if (net == nets.end())
+            net = nets.insert(nets.end(), NetQuantity{tickerId, 0.0f, 0.0f, -1, -1});
+
+        int index = static_cast<int>(i);
+        if (type == OrderType::BUY)
+        {
+            net->buyQuantity += order.getQuantity();
+            if (net->largestBuy < 0 || order.getQuantity() > batch[net->largestBuy].getQuantity())
+                net->largestBuy = index;
+        }
+        else
+        {
+            net->sellQuantity += order.getQuantity();
+            if (net->largestSell < 0 || order.getQuantity() > batch[net->largestSell].getQuantity())
+                net->largestSell = index;
+        }
+    }
+
+    for (const NetQuantity& net : nets)
+    {
+        float difference = net.buyQuantity - net.sellQuantity;
+        if (difference == 0.0f)
+            continue;
+
+        Order order = batch[difference > 0 ? net.largestBuy : net.largestSell];
+        order.setQuantity(std::abs(difference));
+        netted.push_back(order);
+    }
+
+    batch.swap(netted);
+}
+
+int OrderManagement::processBrokerEvents()
+{
+    if (broker == nullptr)
+        return 0;
+
+    int processed = 0;
+    BrokerEvent event;
+    while (broker->pollEvent(event))
+    {
+        onBrokerEvent(event);
+        processed++;
+
+        // A long burst of events must not run the ring out before the sync below
+        if (journal != nullptr && journal->needsCheckpoint())
+            writeCheckpoint();
+    }
+
+    if (processed > 0)
+        syncJournal();
+    return processed;
+}
+
+void OrderManagement::onBrokerEvent(const BrokerEvent& event)
+{
+    if (journal != nullptr)
+        journal->appendEvent(event);
+
+    switch (event.type)
+    {
+        case BrokerEventType::ACK:
+            setStatus(event.orderId, OrderStatus::ACKED);
+            break;
+
+        case BrokerEventType::FILL:
+        case BrokerEventType::PARTIAL_FILL:
+        {
+            setStatus(event.orderId, event.type == BrokerEventType::FILL ? OrderStatus::FILLED : OrderStatus::PARTIALLY_FILLED);
+
+            Order fill{event.orderType, event.getTicker(), event.quantity, event.price};
+            fill.setId(event.orderId);
+            onOrderExecuted(fill);
+
+            // A partial fill leaves the rest of the order working
+            uint32_t slot = orderIndex.find(event.orderId);
+            if (event.type == BrokerEventType::PARTIAL_FILL && slot != IdIndex::NOT_FOUND)
+            {
+                risk.onOrderReduced(orders[slot].getTickerId(), orders[slot], event.quantity);
+                orders[slot].setQuantity(std::max(0.0f, orders[slot].getQuantity() - event.quantity));
+                if (journal != nullptr)
+                    journal->appendOrder(JournalRecordType::ORDER_UPDATED, orders[slot]);
+            }
+
+            // Fully filled orders are no longer open
+            if (event.type == BrokerEventType::FILL && event.orderId != 0)
+                removeOrder(event.orderId);
+            break;
+        }
+
+        case BrokerEventType::REJECT:
+            setStatus(event.orderId, OrderStatus::REJECTED);
+            if (event.orderId != 0)
+                removeOrder(event.orderId);
+            break;
+    }
+}
+
+// Moves a tracked order on in its lifecycle and mirrors the status onto the
+// booked order. Orders the lifecycle never saw, such as broker initiated ones
+// or orders restored from the journal, are left alone.
+void OrderManagement::setStatus(int orderId, OrderStatus status)
+{
+    if (!lifecycle.isOpen(orderId) || !lifecycle.transition(orderId, status))
+        return;
+
+    uint32_t slot = orderIndex.find(orderId);
+    if (slot != IdIndex::NOT_FOUND)
+        orders[slot].setStatus(status);
+}
+
+// Fills net into one position per ticker, so the book, and with it each
+// journal checkpoint, is the size of the portfolio rather than the fill history.
+// Adding to a position averages its price, reducing it keeps the price, and a
+// fill that crosses zero opens the other side at the fill price.
 void OrderManagement::onOrderExecuted(Order& order)
 {
-    // Order passes back from Broker API saying we have executed
-    // Create position from order and add to positions
-    // Strats will then use positions to make decisions    
-    Position newPosition{
-        order.getTicker(),
-        order.getQuantity(),
-        order.getPrice() // Broker will change this to average price 
-    };
-
-    addPosition(newPosition);
-}
\ No newline at end of file
+    float filled = order.isSell() ? -order.getQuantity() : order.getQuantity();
+    int tickerId = tickers.intern(order.getTickerView());
+
+    uint32_t slot = tickerPositionIndex.find(tickerId);
+    if (slot == IdIndex::NOT_FOUND)
+    {
+        Position newPosition{order.getTicker(), filled, order.getPrice()};
+        addPosition(newPosition);
+        return;
+    }
+
+    Position* held = &positions[slot];
+    float before = held->getQuantity();
+    float after = before + filled;
+    if (std::abs(after) < POSITION_FLAT_QUANTITY)
+    {
+        removePosition(held->getId());
+        return;
+    }
+
+    if ((before > 0) == (filled > 0))
+        held->setAvgPrice((before * held->getAvgPrice() + filled * order.getPrice()) / after);
+    else if ((before > 0) != (after > 0))
+        held->setAvgPrice(order.getPrice());
+    held->setQuantity(after);
+
+    risk.onPositionChanged(tickerId, filled, order.getPrice());
+
+    if (journal != nullptr)
+        journal->appendPositionUpdated(*held);
+}
@@ -1,17 +1,53 @@
 #pragma once
 
 #include <iostream>
+#include <istream>
+#include <ostream>
+#include <span>
 
 #include "Order.hpp"
 #include "Position.hpp"
 #include "../data_access/MarketData.hpp"
+#include "OrderJournal.hpp"
+#include "OrderLifecycle.hpp"
 #include "OrderValidator.hpp"
+#include "RiskEngine.hpp"
+#include "TickerRegistry.hpp"
 #include "../broker/BrokerBase.hpp"
+#include "../util/IdIndex.hpp"
 
 using namespace std;
 
+#define OMS_INITIAL_CAPACITY 1024   // Orders and positions reserved up front
+#define POSITION_FLAT_QUANTITY 1e-6f // Net quantity below this closes a position
+
 
 // Has no knowledge of MarketData, that is handled by strategy manager
+//
+// Open orders and positions are kept densely packed and indexed by id, so
+// lookup and removal are O(1): a removed entry is replaced by the last one.
+// Held quantity and exposure are aggregated per ticker by the RiskEngine as
+// orders, positions and prices change, which is what new orders are checked
+// against.
+//
+// Orders and positions carry their interned ticker id, and the per-batch
+// working vectors are members reused from bar to bar, so once the book has
+// reached its working size booking and filling an order does not allocate.
+//
+// Each booked order's status and the time it entered each state are kept in
+// the OrderLifecycle, from the signal arriving (NEW) to FILLED, CANCELLED or
+// REJECTED, for latency attribution.
+//
+// Fills are netted into one signed position per ticker, found through an index
+// from ticker id to slot. A fill on the position's side averages its price, one
+// against it reduces the quantity at the same price, one that flattens it
+// removes it, and one that crosses zero opens the other side at the fill
+// price. Positions added directly with addPosition are kept as given, and a
+// fill nets into the latest one added for its ticker.
+//
+// With a journal attached every change to the book is appended to it, and
+// the journal is synced before orders go to the broker, so a restart can
+// rebuild orders, positions and ids by replaying it.
 class OrderManagement
 {
     public:
@@ -21,23 +57,72 @@ class OrderManagement
         void addOrder(Order &order);
         void removePosition(int id);
         void onNewOrder(Order& order);
+        int onNewOrders(std::span<Order> batch);
         void onOrderExecuted(Order& order);
+        void onBrokerEvent(const BrokerEvent& event);
+        int processBrokerEvents();
         void addPosition(Position &position);
-        vector<Order> getOrders(){ return orders; };
-        void reset() { orders.clear(); positions.clear(); };
-        vector<Position> getPositions(){ return positions; };
-        void setUp(json configdata, BrokerBase* Broker)
+        const vector<Order>& getOrders() const { return orders; };
+        const vector<Position>& getPositions() const { return positions; };
+        const Order* findOrder(int id) const;
+        const Position* findPosition(int id) const;
+        float getHeldQuantity(const string& ticker) const;
+        TickerRegistry& getTickers() { return tickers; };
+        const RiskEngine& getRiskEngine() const { return risk; };
+        const OrderLifecycle& getLifecycle() const { return lifecycle; };
+        uint32_t getLastRiskFailures() const { return lastRiskFailures; };
+        void reset();
+        void attachJournal(OrderJournal* orderJournal);
+
+        // Open orders, positions and ids for backtest checkpoints. Loading
+        // rebuilds the book the way journal recovery does; restored orders
+        // have no lifecycle, so latency stats only cover new ones.
+        void saveState(std::ostream& out) const;
+        void loadState(std::istream& in);
+        void setUp(const RiskConfig& riskConfig, BrokerBase* Broker)
         {
-            validator.setParams(configdata);
+            validator.setParams(riskConfig);
+            risk.setParams(riskConfig);
             broker = Broker;
         };
-        void setMarketData(MarketData marketdata) { marketData = marketdata;};
+        void setMarketData(const MarketData& marketdata);
 
-        BrokerBase* broker;
-        vector<Order> orders;
+        BrokerBase* broker = nullptr;
         int latestOrderId = 1;
         MarketData marketData;
         int latestPositionId = 1;
         OrderValidator validator;
+
+    private:
+        struct NetQuantity {
+            int tickerId;
+            float buyQuantity;
+            float sellQuantity;
+            int largestBuy;
+            int largestSell;
+        };
+
+        void netOrders(vector<Order>& batch);
+        void restore(const JournalRecord& record);
+        void writeCheckpoint();
+        void syncJournal();
+        void setStatus(int orderId, OrderStatus status);
+
+        vector<Order> orders;
         vector<Position> positions;
+        IdIndex orderIndex;
+        IdIndex positionIndex;
+        IdIndex tickerPositionIndex;
+        TickerRegistry tickers;
+        RiskEngine risk;
+        OrderLifecycle lifecycle;
+        uint32_t lastRiskFailures = 0;
+        OrderJournal* journal = nullptr;
+
+        // Batch working storage, cleared rather than freed between bars
+        vector<Order> accepted;
+        vector<Order> submitted;
+        vector<Order> netted;
+        vector<NetQuantity> nets;
+        vector<int> clientOrderIds;
 };
\ No newline at end of file
@@ -1,16 +1,12 @@
 #include "OrderValidator.hpp"
+#include "../util/Logger.hpp"
 
 void 
-OrderValidator::setParams(json configData)
+OrderValidator::setParams(const RiskConfig& riskConfig)
 {
-    // Check if required keys exist in configData
-    try {
-        maxPositionSize = configData.at("max_position_size").get<int>();
-        maxExposure = configData.at("max_exposure").get<double>();
-        slippageTolerance = configData.at("slippage_tolerance").get<double>();
-    } catch (const json::exception& e) {
-        throw std::runtime_error("Error: Invalid config data - " + std::string(e.what()));
-    }
+    maxPositionSize = riskConfig.maxPositionSize;
+    maxExposure = riskConfig.maxExposure;
+    slippageTolerance = riskConfig.slippageTolerance;
 
     std::cout << "  --> Params set: " 
                 << "maxPositionSize=" << maxPositionSize << ", "
@@ -143,7 +139,7 @@ bool OrderValidator::checkSlippage(const Order& order, MarketData& marketData)
     double lastClose = marketData.getLastClosePrice();
     
     double slippage = std::abs(orderPrice - lastClose) / ((orderPrice + lastClose) / 2) * 100.0;
-    std::cerr<<slippage<<std::endl;
+    LOG_DEBUG("Order {} slippage {:.4f}% against last close", order.getId(), slippage);
 
     return slippage <= slippageTolerance;
 }
@@ -13,7 +13,7 @@ class OrderValidator
 
         bool validateOrder(const Order& order, MarketData& marketData, std::vector<Position>& positions);
 
-        void setParams(json configData);
+        void setParams(const RiskConfig& riskConfig);
         float getTotalHeldQuantity(const Order& order, std::vector<Position>& positions);
 
         // Validation methods
@@ -2,16 +2,12 @@
         
 
 Position::Position(
-    string _ticker,
+    const string& _ticker,
     float _quantity,
     float _avgPrice)
 :
-    ticker(_ticker), 
     quantity(_quantity), 
     avgPrice(_avgPrice)
 {
-}
-
-Position::~Position()
-{
-}
+    copyTickerSymbol(ticker, _ticker);
+}
\ No newline at end of file
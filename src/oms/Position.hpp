@@ -1,33 +1,40 @@
 #pragma once
 #include <iostream>
+#include "Order.hpp"
 
 
 using namespace std;
 
+// Fixed size like Order, the ticker symbol is stored inline
 class Position
 {
     public:
         Position(){};
         Position(
-            string _ticker,
+            const string& _ticker,
             float _quantity,
             float _avgPrice);
-        ~Position();
 
         // getters and setters
         int getId() const { return id;};
-        string getTicker() const{ return ticker;}
+        string getTicker() const{ return string(getTickerView());}
+        std::string_view getTickerView() const { return std::string_view(ticker, strnlen(ticker, TICKER_SYMBOL_LENGTH)); }
+        int getTickerId() const { return tickerId; }
         float getQuantity() const {return quantity;};
         float getAvgPrice() const {return avgPrice;};
 
         void setId(int _id) {id = _id;};
-        void setTicker(string  _ticker) {ticker = _ticker;}
+        void setTicker(std::string_view _ticker) {copyTickerSymbol(ticker, _ticker); tickerId = -1;}
+        void setTickerId(int _tickerId) {tickerId = _tickerId;}
         void setQuantity(float _quantity) {quantity = _quantity;}
         void setAvgPrice(float _avgPrice) {avgPrice = _avgPrice;}
     
     private:
-        int id;
-        string ticker;
-        float quantity;
-        float avgPrice;
-};
\ No newline at end of file
+        int id = 0;
+        int tickerId = -1;      // -1 until interned
+        char ticker[TICKER_SYMBOL_LENGTH] = {};
+        float quantity = 0;
+        float avgPrice = 0;
+};
+
+static_assert(std::is_trivially_copyable_v<Position>, "Position must stay trivially copyable");
\ No newline at end of file
@@ -0,0 +1,216 @@
+#include "RiskEngine.hpp"
+#include <cmath>
+#include <limits>
+
+RiskEngine::RiskEngine()
+: maxExposure(0.0),
+  maxPositionSize(0.0),
+  slippageTolerance(0.0),
+  snapshot{false, 0.0, 0.0, 0.0, std::numeric_limits<double>::infinity()},
+  grossExposure(0.0),
+  netExposure(0.0),
+  openOrderNotional(0.0)
+{
+}
+
+void
+RiskEngine::setParams(const RiskConfig& riskConfig)
+{
+    maxPositionSize = riskConfig.maxPositionSize;
+    maxExposure = riskConfig.maxExposure;
+    slippageTolerance = riskConfig.slippageTolerance;
+}
+
+void
+RiskEngine::reset()
+{
+    exposures.clear();
+    grossExposure = 0.0;
+    netExposure = 0.0;
+    openOrderNotional = 0.0;
+}
+
+void
+RiskEngine::onTick(int tickerId, double lastClose, double equity)
+{
+    double allowedSlippage = (slippageTolerance / 100.0) * lastClose;
+
+    snapshot.valid = true;
+    snapshot.lastClose = lastClose;
+    snapshot.bandLow = lastClose - allowedSlippage;
+    snapshot.bandHigh = lastClose + allowedSlippage;
+    snapshot.exposureLimit = equity > 0.0 ? maxExposure * equity : std::numeric_limits<double>::infinity();
+
+    onPrice(tickerId, lastClose);
+}
+
+void
+RiskEngine::onPrice(int tickerId, double price)
+{
+    TickerExposure& exposure = exposureFor(tickerId, price);
+    withdraw(exposure);
+    exposure.price = price;
+    deposit(exposure);
+}
+
+void
+RiskEngine::onOrderOpened(int tickerId, const Order& order)
+{
+    TickerExposure& exposure = exposureFor(tickerId, order.getPrice());
+    withdraw(exposure);
+    exposure.openBuy += order.isBuy() ? order.getQuantity() : 0.0;
+    exposure.openSell += order.isSell() ? order.getQuantity() : 0.0;
+    deposit(exposure);
+}
+
+void
+RiskEngine::onOrderReduced(int tickerId, const Order& order, double quantity)
+{
+    TickerExposure& exposure = exposureFor(tickerId, order.getPrice());
+    withdraw(exposure);
+    exposure.openBuy = order.isBuy() ? std::max(0.0, exposure.openBuy - quantity) : exposure.openBuy;
+    exposure.openSell = order.isSell() ? std::max(0.0, exposure.openSell - quantity) : exposure.openSell;
+    deposit(exposure);
+}
+
+void
+RiskEngine::onPositionAdded(int tickerId, double quantity, double price)
+{
+    TickerExposure& exposure = exposureFor(tickerId, price);
+    withdraw(exposure);
+    exposure.position += quantity;
+    exposure.positionCount++;
+    deposit(exposure);
+}
+
+void
+RiskEngine::onPositionRemoved(int tickerId, double quantity)
+{
+    TickerExposure& exposure = exposureFor(tickerId, 0.0);
+    withdraw(exposure);
+    exposure.position -= quantity;
+    // Don't let float drift leave a phantom holding behind
+    if (--exposure.positionCount <= 0) {
+        exposure.position = 0.0;
+        exposure.positionCount = 0;
+    }
+    deposit(exposure);
+}
+
+// A fill netted into an existing position, quantity is signed
+void
+RiskEngine::onPositionChanged(int tickerId, double quantity, double price)
+{
+    TickerExposure& exposure = exposureFor(tickerId, price);
+    withdraw(exposure);
+    exposure.position += quantity;
+    deposit(exposure);
+}
+
+uint32_t
+RiskEngine::check(const Order& order, int tickerId) const
+{
+    if (!snapshot.valid) {
+        return RISK_NO_MARKET_DATA;
+    }
+
+    // Same rules as OrderValidator, evaluated unconditionally and combined with
+    // bitwise ops so the sequence compiles to straight-line code
+    const OrderType type = order.getType();
+    const bool buy = order.isBuy();
+    const bool sell = order.isSell();
+    const bool plainBuy = type == OrderType::BUY;
+    const bool plainSell = type == OrderType::SELL;
+    const float lastClose = static_cast<float>(snapshot.lastClose);
+    const double price = order.getPrice();
+    const float quantity = order.getQuantity();
+    const float stopLoss = order.getStopLossPrice();
+    const float takeProfit = order.getTakeProfitPrice();
+    const bool known = tickerId >= 0 && tickerId < static_cast<int>(exposures.size());
+    const float held = known ? static_cast<float>(exposures[tickerId].position) : 0.0f;
+    const float openBuy = known ? static_cast<float>(exposures[tickerId].openBuy) : 0.0f;
+    const float openSell = known ? static_cast<float>(exposures[tickerId].openSell) : 0.0f;
+
+    // Gross exposure this order adds: the position it leaves, counting working
+    // orders on the same side, against the position before it. Negative when
+    // the order shrinks a long or covers a short, which is always allowed.
+    const double projected = held + (buy ? openBuy : -openSell);
+    const double signedQuantity = buy ? quantity : -quantity;
+    const double added = (std::abs(projected + signedQuantity) - std::abs(projected)) * snapshot.lastClose;
+    const double slippage = std::abs(price - lastClose) / ((price + lastClose) / 2) * 100.0;
+
+    uint32_t failures = 0;
+    failures |= RISK_ORDER_TYPE * !(buy | sell);
+    failures |= RISK_PRICE_BAND * !((buy & (price <= snapshot.bandHigh)) | (sell & (price >= snapshot.bandLow)));
+    failures |= RISK_QUANTITY * !((quantity > 0) & (quantity <= maxPositionSize));
+    failures |= RISK_POSITION_LIMIT * (buy & !(held + openBuy + quantity <= maxPositionSize));
+    failures |= RISK_EXPOSURE * ((added > 0) & !(grossExposure + openOrderNotional + added <= snapshot.exposureLimit));
+    failures |= RISK_STOP_LOSS * ((stopLoss == 0) | (stopLoss == lastClose) |
+                                  (plainBuy & (stopLoss > lastClose)) | (plainSell & (stopLoss < lastClose)));
+    failures |= RISK_TAKE_PROFIT * ((takeProfit == 0) | (takeProfit == lastClose) |
+                                    (plainBuy & (takeProfit < lastClose)) | (plainSell & (takeProfit > lastClose)));
+    failures |= RISK_SLIPPAGE * !(slippage <= slippageTolerance);
+
+    return failures;
+}
+
+std::string
+RiskEngine::describe(uint32_t failures)
+{
+    static const char* names[] = {"order type", "price band", "quantity", "position limit", "exposure",
+                                  "stop loss", "take profit", "slippage", "no market data"};
+
+    std::string description;
+    for (int bit = 0; bit < 9; bit++) {
+        if (failures & (1u << bit)) {
+            description += description.empty() ? "" : ", ";
+            description += names[bit];
+        }
+    }
+    return description.empty() ? "passed" : description;
+}
+
+double
+RiskEngine::getTickerNotional(int tickerId) const
+{
+    if (tickerId < 0 || tickerId >= static_cast<int>(exposures.size())) return 0.0;
+    return exposures[tickerId].position * exposures[tickerId].price;
+}
+
+double
+RiskEngine::getHeldQuantity(int tickerId) const
+{
+    if (tickerId < 0 || tickerId >= static_cast<int>(exposures.size())) return 0.0;
+    return exposures[tickerId].position;
+}
+
+RiskEngine::TickerExposure&
+RiskEngine::exposureFor(int tickerId, double price)
+{
+    if (tickerId >= static_cast<int>(exposures.size())) {
+        exposures.resize(tickerId + 1, TickerExposure{0.0, 0.0, 0.0, 0.0, 0});
+    }
+
+    // Until a tick arrives, mark a new ticker at the first price we see for it
+    TickerExposure& exposure = exposures[tickerId];
+    if (exposure.price == 0.0) {
+        exposure.price = price;
+    }
+    return exposure;
+}
+
+void
+RiskEngine::withdraw(const TickerExposure& exposure)
+{
+    grossExposure -= std::abs(exposure.position * exposure.price);
+    netExposure -= exposure.position * exposure.price;
+    openOrderNotional -= (exposure.openBuy + exposure.openSell) * exposure.price;
+}
+
+void
+RiskEngine::deposit(const TickerExposure& exposure)
+{
+    grossExposure += std::abs(exposure.position * exposure.price);
+    netExposure += exposure.position * exposure.price;
+    openOrderNotional += (exposure.openBuy + exposure.openSell) * exposure.price;
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Order.hpp"
+#include "../util/Config.hpp"
+
+// Failure bits returned by RiskEngine::check, 0 means the order passed
+#define RISK_ORDER_TYPE      (1u << 0)
+#define RISK_PRICE_BAND      (1u << 1)
+#define RISK_QUANTITY        (1u << 2)
+#define RISK_POSITION_LIMIT  (1u << 3)
+#define RISK_EXPOSURE        (1u << 4)
+#define RISK_STOP_LOSS       (1u << 5)
+#define RISK_TAKE_PROFIT     (1u << 6)
+#define RISK_SLIPPAGE        (1u << 7)
+#define RISK_NO_MARKET_DATA  (1u << 8)
+
+/**
+ * RiskEngine
+ *
+ * Pre-trade checks for the OMS. Exposure is maintained incrementally per
+ * ticker id (position, open buy/sell quantity, mark price) together with
+ * running gross, net and open order notional totals, so nothing is rescanned
+ * when an order comes in.
+ *
+ * onTick() caches what every check needs from the market for the current bar
+ * (last close, price band, exposure limit). check() then runs the whole chain
+ * without early exits and returns a bitmask of the checks that failed.
+ *
+ * max_exposure is the largest gross notional, including working orders and
+ * the order being checked, as a multiple of account equity. It is only
+ * enforced once the broker reports an equity, and only on orders that grow
+ * gross exposure, so a book at its limit can still be reduced. The position
+ * limit counts buys still working on the ticker as held.
+ */
+class RiskEngine
+{
+    public:
+        RiskEngine();
+
+        void setParams(const RiskConfig& riskConfig);
+        void reset();
+
+        // Market side
+        void onTick(int tickerId, double lastClose, double equity);
+        void onPrice(int tickerId, double price);
+        void invalidate() { snapshot.valid = false; }
+
+        // Book side, called by OrderManagement as orders and positions change
+        void onOrderOpened(int tickerId, const Order& order);
+        void onOrderReduced(int tickerId, const Order& order, double quantity);
+        void onPositionAdded(int tickerId, double quantity, double price);
+        void onPositionRemoved(int tickerId, double quantity);
+        void onPositionChanged(int tickerId, double quantity, double price);
+
+        uint32_t check(const Order& order, int tickerId) const;
+        static std::string describe(uint32_t failures);
+
+        double getGrossExposure() const { return grossExposure; }
+        double getNetExposure() const { return netExposure; }
+        double getOpenOrderNotional() const { return openOrderNotional; }
+        double getTickerNotional(int tickerId) const;
+        double getHeldQuantity(int tickerId) const;
+
+    private:
+        struct Snapshot {
+            bool valid;
+            double lastClose;
+            double bandLow;
+            double bandHigh;
+            double exposureLimit;
+        };
+
+        struct TickerExposure {
+            double position;
+            double openBuy;
+            double openSell;
+            double price;
+            int positionCount;
+        };
+
+        TickerExposure& exposureFor(int tickerId, double price);
+
+        // Take a ticker's contribution out of the totals before changing it, put it back after
+        void withdraw(const TickerExposure& exposure);
+        void deposit(const TickerExposure& exposure);
+
+        double maxExposure;
+        double maxPositionSize;
+        double slippageTolerance;
+
+        Snapshot snapshot;
+        std::vector<TickerExposure> exposures;    // Indexed by ticker id
+        double grossExposure;
+        double netExposure;
+        double openOrderNotional;
+};
@@ -0,0 +1,62 @@
+#include "TickerRegistry.hpp"
+#include <functional>
+
+TickerRegistry::TickerRegistry()
+: slots(16, NOT_FOUND)
+{
+}
+
+int
+TickerRegistry::find(std::string_view ticker) const
+{
+    size_t hash = std::hash<std::string_view>{}(ticker);
+    for (size_t i = probeStart(hash);; i = (i + 1) & (slots.size() - 1)) {
+        int id = slots[i];
+        if (id == NOT_FOUND) return NOT_FOUND;
+        if (hashes[id] == hash && tickers[id] == ticker) return id;
+    }
+}
+
+int
+TickerRegistry::intern(std::string_view ticker)
+{
+    size_t hash = std::hash<std::string_view>{}(ticker);
+    size_t i = probeStart(hash);
+    for (;; i = (i + 1) & (slots.size() - 1)) {
+        int id = slots[i];
+        if (id == NOT_FOUND) break;
+        if (hashes[id] == hash && tickers[id] == ticker) return id;
+    }
+
+    int id = static_cast<int>(tickers.size());
+    tickers.emplace_back(ticker);
+    hashes.push_back(hash);
+    slots[i] = id;
+
+    // Tickers are never removed, so growing is the only rehash
+    if (tickers.size() * 2 > slots.size()) {
+        grow();
+    }
+    return id;
+}
+
+void
+TickerRegistry::clear()
+{
+    tickers.clear();
+    hashes.clear();
+    slots.assign(16, NOT_FOUND);
+}
+
+void
+TickerRegistry::grow()
+{
+    slots.assign(slots.size() * 2, NOT_FOUND);
+    for (size_t id = 0; id < hashes.size(); id++) {
+        size_t i = probeStart(hashes[id]);
+        while (slots[i] != NOT_FOUND) {
+            i = (i + 1) & (slots.size() - 1);
+        }
+        slots[i] = static_cast<int32_t>(id);
+    }
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * TickerRegistry
+ *
+ * Interns ticker symbols into dense integer ids (0, 1, 2, ...) so per-ticker
+ * state can live in plain vectors indexed by id. Lookup by symbol is an open
+ * addressing probe that compares the symbol only on a hash match.
+ */
+class TickerRegistry
+{
+    public:
+        static constexpr int NOT_FOUND = -1;
+
+        TickerRegistry();
+
+        // Returns the id for ticker, registering it on first sight
+        int intern(std::string_view ticker);
+        int find(std::string_view ticker) const;
+        const std::string& getTicker(int id) const { return tickers[id]; }
+        size_t size() const { return tickers.size(); }
+        void clear();
+
+    private:
+        size_t probeStart(size_t hash) const { return hash & (slots.size() - 1); }
+        void grow();
+
+        std::vector<std::string> tickers;
+        std::vector<size_t> hashes;
+        std::vector<int32_t> slots;     // Ticker id or NOT_FOUND
+};
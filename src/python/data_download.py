@@ -53,6 +53,19 @@ class DataDownload:
         data.fillna(0) 
         data.to_csv(self.date_file_path, index=True, sep=",")
         print(f"Data saved to {self.date_file_path}")
+
+    def publish_shared(self, writer):
+        """
+        Publishes the fetched bars into a SharedBarWriter ring instead of a CSV.
+
+        :param writer: shared_bars.SharedBarWriter the engine is reading.
+        """
+        data = self.get_stock_data(self.ticker)
+        data.index = pd.to_datetime(data.index).tz_localize(None)
+        for timestamp, row in data.fillna(0).iterrows():
+            writer.publish(timestamp.strftime("%Y-%m-%d %H:%M:%S"), self.ticker,
+                           row["Open"], row["Close"], row["Volume"], self.interval)
+        print(f"Published {len(data)} bars to shared memory")
             
     def load_json(self, file_path):
         """
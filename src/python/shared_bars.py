@@ -0,0 +1,121 @@
+import argparse
+import mmap
+import os
+import random
+import socket
+import struct
+import time
+from datetime import datetime, timedelta
+
+# Layout shared with src/data_access/SharedBarRing.hpp, change both together
+MAGIC = 0x5352414254475441  # "ATGTBARS"
+VERSION = 1
+HEADER_SIZE = 128
+SLOT_SIZE = 64
+PUBLISHED_OFFSET = 64
+DEFAULT_NAME = "/algo_trader_bars"
+DEFAULT_CAPACITY = 4096
+
+HEADER = struct.Struct("<IIQ")          # version, slot size, capacity after the magic
+BAR = struct.Struct("<24s12s8sffi")     # everything in a slot after the sequence
+
+
+class SharedBarWriter:
+    """
+    Publishes bars into the POSIX shared memory ring the C++ SharedBarReader
+    maps, so bars reach the engine without a CSV in between.
+
+    Each slot carries a sequence number that is odd while the bar is being
+    written and even once it is complete. The sequence and published count
+    are written as single 8 byte stores through a memoryview, and the reader
+    relies on x86 keeping stores in order, so this writer is x86 only.
+    """
+
+    def __init__(self, name=DEFAULT_NAME, capacity=DEFAULT_CAPACITY, notify_port=None):
+        self.path = "/dev/shm/" + name.lstrip("/")
+        self.capacity = capacity
+        self.published = 0
+        size = HEADER_SIZE + capacity * SLOT_SIZE
+
+        fd = os.open(self.path, os.O_CREAT | os.O_RDWR, 0o600)
+        try:
+            os.ftruncate(fd, size)
+            self.buffer = mmap.mmap(fd, size)
+        finally:
+            os.close(fd)
+        self.words = memoryview(self.buffer).cast("Q")
+
+        # Readers of a previous run see the count drop and start over, the
+        # magic goes in last so a new reader never sees a half set up header
+        self.words[PUBLISHED_OFFSET // 8] = 0
+        self.buffer[HEADER_SIZE:] = bytes(capacity * SLOT_SIZE)
+        HEADER.pack_into(self.buffer, 8, VERSION, SLOT_SIZE, capacity)
+        self.words[0] = MAGIC
+
+        self.notify = None
+        if notify_port is not None:
+            self.notify = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+            self.notify_address = ("127.0.0.1", notify_port)
+
+        print(f"Shared bar ring {name} ready for {capacity} bars")
+
+    def publish(self, date_time, ticker, open_price, close_price, volume, interval):
+        """Writes one bar, then tells the engine on the notify port if there is one."""
+        n = self.published
+        offset = HEADER_SIZE + (n % self.capacity) * SLOT_SIZE
+
+        self.words[offset // 8] = 2 * n + 1
+        BAR.pack_into(self.buffer, offset + 8, date_time.encode(), ticker.encode(), interval.encode(),
+                      open_price, close_price, int(volume))
+        self.words[offset // 8] = 2 * n + 2
+
+        self.published = n + 1
+        self.words[PUBLISHED_OFFSET // 8] = self.published
+
+        if self.notify is not None:
+            self.notify.sendto(b"bar", self.notify_address)
+
+    def close(self, unlink=True):
+        """Unmaps the ring, and removes it unless readers should still find it."""
+        self.words.release()
+        self.buffer.close()
+        if self.notify is not None:
+            self.notify.close()
+        if unlink:
+            os.unlink(self.path)
+
+
+def run_synthetic(writer, ticker, interval, count, interval_ms, seed):
+    """Publishes a seeded random walk of one minute bars, a stand in for the downloader."""
+    rng = random.Random(seed)
+    price = 100.0
+    start = datetime.now().replace(second=0, microsecond=0)
+
+    for i in range(count):
+        open_price = price
+        price = max(1.0, price * (1.0 + rng.gauss(0.0, 0.002)))
+        date_time = (start + timedelta(minutes=i)).strftime("%Y-%m-%d %H:%M:%S")
+        writer.publish(date_time, ticker, open_price, price, rng.randint(100, 10000), interval)
+        if interval_ms > 0:
+            time.sleep(interval_ms / 1000.0)
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="Synthetic bar producer for the shared memory ring")
+    parser.add_argument("--name", default=DEFAULT_NAME)
+    parser.add_argument("--capacity", type=int, default=DEFAULT_CAPACITY)
+    parser.add_argument("--ticker", default="NVDA")
+    parser.add_argument("--interval", default="1m")
+    parser.add_argument("--count", type=int, default=390)
+    parser.add_argument("--interval-ms", type=int, default=1000, help="Wall clock delay between bars")
+    parser.add_argument("--seed", type=int, default=42)
+    parser.add_argument("--notify-port", type=int, default=None, help="UDP port the engine listens on for new bars")
+    parser.add_argument("--keep", action="store_true", help="Leave the ring in place on exit")
+    args = parser.parse_args()
+
+    writer = SharedBarWriter(args.name, args.capacity, args.notify_port)
+    try:
+        run_synthetic(writer, args.ticker, args.interval, args.count, args.interval_ms, args.seed)
+        print(f"Published {writer.published} bars")
+    finally:
+        writer.close(unlink=not args.keep)
@@ -1,8 +1,12 @@
+#pragma once
+
 #include "../oms/Order.hpp"
 #include "StrategyBase.hpp"
 
-class MACD : public StrategyBase {
+class MACD final : public StrategyBase {
     public:
+        static constexpr const char* Name = "MACD";
+
         MACD(StrategyAttribute strategyAttribute) : StrategyBase(strategyAttribute) {}
 
         void execute() override 
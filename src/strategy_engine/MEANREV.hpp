@@ -1,7 +1,11 @@
+#pragma once
+
 #include "StrategyBase.hpp"
 
-class MEANREV : public StrategyBase {
+class MEANREV final : public StrategyBase {
     public:
+        static constexpr const char* Name = "MEANREV";
+
         MEANREV(StrategyAttribute strategyAttribute) : StrategyBase(strategyAttribute) {}
 
         void execute() override 
@@ -1,9 +1,15 @@
+#pragma once
+
 #include "StrategyBase.hpp"
 #include <cassert>
-#include <iomanip> // For std::setprecision
+#include <deque>
+#include "../util/BinaryIO.hpp"
+#include "../util/Logger.hpp"
 
-class RSI : public StrategyBase {
+class RSI final : public StrategyBase {
     public:
+        static constexpr const char* Name = "RSI";
+
         RSI(StrategyAttribute strategyAttribute) : StrategyBase(strategyAttribute) 
         {
             
@@ -15,14 +21,33 @@ class RSI : public StrategyBase {
             run();
         }
 
-        void supplyData(MarketData& marketdata) override
+        const MarketData& getData() const
         {
-            marketData = marketdata;
+            return *marketData;
         }
 
-        MarketData getData()
+        float getRSI() const { return rsi; }
+
+        // The close window and the last bar taken into it, so a restored
+        // RSI carries on from new bars alone
+        void saveState(std::ostream& out) const override
         {
-            return marketData;
+            writeBinaryVector(out, std::vector<float>(closes.begin(), closes.end()));
+            writeBinary(out, lastBarTime.nanos());
+            writeBinary(out, rsi);
+            writeBinaryString(out, decision);
+        }
+
+        void loadState(std::istream& in) override
+        {
+            std::vector<float> window;
+            readBinaryVector(in, window);
+            closes.assign(window.begin(), window.end());
+            int64_t lastBarNanos = 0;
+            readBinary(in, lastBarNanos);
+            lastBarTime = Timestamp::fromNanos(lastBarNanos);
+            readBinary(in, rsi);
+            readBinaryString(in, decision);
         }
 
         float calculateRSI(const std::vector<float>& closes)
@@ -31,8 +56,7 @@ class RSI : public StrategyBase {
             if (closes.size() <= 1) {
                 // Since getRecentCloses() now strictly enforces the period requirement,
                 // we should never get here unless there's an error
-                std::cout << "ERROR - calculateRSI: Called with insufficient data (" 
-                          << closes.size() << " points)" << std::endl;
+                LOG_ERROR("calculateRSI: Called with insufficient data ({} points)", closes.size());
                 return 50.0f; // Return neutral value as a fallback
             }
 
@@ -58,18 +82,17 @@ class RSI : public StrategyBase {
             
             // Handle edge cases
             if (avgLoss == 0.0f && avgGain == 0.0f) {
-                std::cout << "INFO - calculateRSI: No price movement, returning neutral RSI 50" << std::endl;
+                LOG_DEBUG("calculateRSI: No price movement, returning neutral RSI 50");
                 return 50.0f;
             } else if (avgLoss == 0.0f) {
-                std::cout << "INFO - calculateRSI: No losses, returning maximum RSI 100" << std::endl;
+                LOG_DEBUG("calculateRSI: No losses, returning maximum RSI 100");
                 return 100.0f;
             }
             
             float rs = avgGain / avgLoss;
             float rsi = 100.0f - (100.0f / (1.0f + rs));
             
-            std::cout << "INFO - calculateRSI: Calculated RSI(" << period << "): " << std::fixed 
-                      << std::setprecision(2) << rsi << " using " << closes.size() << " data points" << std::endl;
+            LOG_DEBUG("calculateRSI: Calculated RSI({}): {:.2f} using {} data points", period, rsi, closes.size());
             
             return std::round(rsi * 100) / 100;
         }
@@ -88,13 +111,17 @@ class RSI : public StrategyBase {
 
         void run()
         {
-            std::vector<float> recentCloses = getRecentCloses(_strategyAttribute.period);
-            if(recentCloses.size() == 0) {
-                std::cout << "DEBUG - RSI::run - No recent closes, skipping RSI calculation" << std::endl;
+            updateWindow();
+            int period = _strategyAttribute.period;
+            if (period <= 0 || static_cast<int>(closes.size()) < period)
+            {
+                LOG_DEBUG("Skipping RSI calculation: Insufficient data ({} points available, {} required)",
+                          closes.size(), period);
                 return;
             }
+            std::vector<float> recentCloses(closes.begin(), closes.end());
             
-            std::cout << "DEBUG - RSI::run - Got " << recentCloses.size() << " recent closes" << std::endl;
+            LOG_DEBUG("RSI::run - Got {} recent closes", recentCloses.size());
             MarketCondition currentCondition = getCurrentMarketCondition();
             float quantity = 1;
 
@@ -117,36 +144,29 @@ class RSI : public StrategyBase {
                 logDecision(currentCondition, rsi, quantity);
         }
 
-        std::vector<float> getRecentCloses(int period)
+        // Take in the bars after the last one seen, at most a window's worth.
+        // Bars are in time order, so usually this is the one newest bar.
+        void updateWindow()
         {
-            std::vector<float> closes;
-            const auto& data = marketData.getData();
-            int dataSize = static_cast<int>(data.size());
-            
-            if (data.empty() || period <= 0) 
-            {
-                std::cout << "Data is empty, or invalid period set, period:" << period << std::endl;
-                return closes;
-            }
-            
-            if (dataSize < period)
-            {
-                std::cout << "Skipping RSI calculation: Insufficient data (" << dataSize 
-                          << " points available, " << period << " required)" << std::endl;
-                return closes; // Return empty vector
-            }
+            if (marketData == nullptr)
+                return;
+
+            const auto& data = marketData->getData();
+            size_t period = std::max(_strategyAttribute.period, 0);
+            size_t first = data.size();
+            while (first > 0 && data.size() - first < period && data[first - 1].Time > lastBarTime)
+                first--;
 
-            int start = std::max(0, dataSize - period);
-            // std::cout << "DEBUG: Recent closes for RSI calculation:" << std::endl;
-            for (int i = start; i < dataSize; ++i) {
+            for (size_t i = first; i < data.size(); i++)
+            {
                 closes.push_back(data[i].Close);
-                // std::cout << "  [" << i - start << "] " << data[i].DateTime << ": $" 
-                //           << std::fixed << std::setprecision(2) << data[i].Close << std::endl;
+                if (closes.size() > period)
+                    closes.pop_front();
             }
-            return closes;
+            if (first < data.size())
+                lastBarTime = data.back().Time;
         }
 
-
         bool isOverbought()
         {
             return (rsi > _strategyAttribute.overbought_threshold);
@@ -203,25 +223,21 @@ class RSI : public StrategyBase {
 
         MarketCondition getCurrentMarketCondition()
         {
-            return marketData.getCurrentData();
+            return marketData->getCurrentData();
         }
 
         void logDecision(MarketCondition currentCondition, float rsi, float quantity)
         {
-            std::cout << "\n==== RSI SIGNAL ====" << std::endl;
-            std::cout << "Date: " << currentCondition.DateTime << std::endl;
-            std::cout << "Ticker: " << currentCondition.Ticker << std::endl;
-            std::cout << "Price:  $" << std::fixed << std::setprecision(2) << currentCondition.Close << std::endl;
-            std::cout << "Quantity:  " << std::fixed << std::setprecision(2) << quantity << std::endl;
-            std::cout << "RSI:    " << std::fixed << std::setprecision(2) << rsi << std::endl;
-            std::cout << "Action: " << decision << std::endl;
-            std::cout << "===================\n" << std::endl;
+            LOG_INFO("RSI signal: {} {} {:.2f} @ ${:.2f}, RSI {:.2f}, {}",
+                     decision, currentCondition.Ticker, quantity, currentCondition.Close,
+                     rsi, currentCondition.DateTime);
         }
 
         StrategyAttribute getAttributes() { return _strategyAttribute; }
         
     private:
-        float rsi;
+        float rsi = 50.0f;
         string decision;
-        MarketData marketData;
+        std::deque<float> closes;      // The last period closes
+        Timestamp lastBarTime;
 };
@@ -7,18 +7,6 @@
 #include "../data_access/MarketCondition.hpp"
 
 
-// class StrategyBase {
-// public:
-//     virtual ~StrategyBase() = default;
-//     virtual void execute() = 0;  // Pure virtual function
-//     static std::unique_prt<StrategyBase> create(const std::string& name);
-
-// protected:
-    // Register a strategy name with a factory function
-    // static void registerStrategy(const std::string& name, std::function<std::unique_ptr<StrategyBase>()> creator);
-
-// };
-
 class StrategyBase
 {
     public:
@@ -47,15 +35,22 @@ class StrategyBase
             return order; 
         };
 
-        virtual void supplyData(MarketData& marketdata)
+        // Kept by reference, the caller owns the data and keeps it alive
+        // while the strategy executes
+        virtual void supplyData(const MarketData& marketdata)
         {
-            marketData = marketdata;
+            marketData = &marketdata;
         }
 
+        // Indicator state carried from bar to bar, for backtest checkpoints.
+        // Strategies that recompute everything from the market data keep none.
+        virtual void saveState(std::ostream& out) const { (void)out; }
+        virtual void loadState(std::istream& in) { (void)in; }
+
         // Base strats take in entire list of strat params
         // Specific strats pick and choose from this list
         Order order;
-        MarketData marketData;
+        const MarketData* marketData = nullptr;
         bool NewOrder = false;
         StrategyAttribute _strategyAttribute;
 
@@ -1,5 +1,11 @@
 #include "StrategyEngine.hpp"
 #include "StrategyFactory.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include "../util/BinaryIO.hpp"
+#include "../util/Logger.hpp"
 
 OrderManagement* StrategyEngine::oms = new OrderManagement();
 
@@ -15,12 +21,12 @@ StrategyEngine::~StrategyEngine()
 
 
 void 
-StrategyEngine::setUp(json configdata, StrategyFactory &stratFactory, MarketData &marketdata, BrokerBase* broker)
+StrategyEngine::setUp(const AppConfig& appConfig, StrategyFactory &stratFactory, MarketData &marketdata, BrokerBase* broker)
 {    
     std::cout << "Setting up Strategy Engine..." << std::endl;
-    configData = configdata;
-    oms->setUp(configData, broker);
-    strategyList = stratFactory.generateStrategies();
+    oms->setUp(appConfig.risk, broker);
+    strategies = stratFactory.generateFleet();
+    strategyConfigHash = AppConfig::hashStrategies(stratFactory.getStrategyConfigs());
     marketData = &marketdata; // Store a pointer to the MarketData object
 
     std::cout << "  --> Config Data set" << std::endl;
@@ -46,9 +52,16 @@ StrategyEngine::run()
     // In backtest mode, the data is updated by the adapter
     setMarketData(*marketData);
     oms->setMarketData(*marketData);
+
+    // Apply fills that arrived since the last run before strategies decide
+    processBrokerEvents();
     
     // Execute all active strategies
     executeStrategies();
+
+    // Strategy state now includes this bar
+    if (!marketData->isEmpty())
+        lastRunBar = marketData->getCurrentData();
 }
 
 void
@@ -57,11 +70,17 @@ StrategyEngine::setMarketData(MarketData& inputData)
     marketConditions = inputData.getData();
 }
 
+int
+StrategyEngine::processBrokerEvents()
+{
+    return oms->processBrokerEvents();
+}
+
 void
 StrategyEngine::executeStrategies()
 {   
-    Order order;
-    std::vector<Order> proposedOrders;
+    proposedOrders.clear();
+    proposals.clear();
     
     // Check if marketData pointer is valid
     if (marketData == nullptr) {
@@ -69,23 +88,25 @@ StrategyEngine::executeStrategies()
         return;
     }
 
-    // Maybe thread this, thread for each strategy
-    for (auto& strat : strategyList) 
+    // One pass per strategy type, every call made on the concrete class.
+    strategies.forEach([this](auto& strat, size_t slot)
     {
-        strat->supplyData(*marketData);
-        strat->execute();
+        strat.supplyData(*marketData);
+        strat.execute();
 
-        if(strat->onNewOrder())
-        {
-            Order order = strat->getOrder();
-            // proposedOrders.push_back(order);
-            oms->onNewOrder(order);
-        }
-    }
+        if(strat.onNewOrder())
+            proposals.emplace_back(slot, strat.getOrder());
+    });
 
-    // if(DecideToMakeTrade(proposedOrders))
-    //     oms->onNewOrder(order);
+    // Put the orders back in config order, the order the OMS nets them in
+    std::sort(proposals.begin(), proposals.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+    for (auto& proposal : proposals)
+        proposedOrders.push_back(std::move(proposal.second));
 
+    // Validate, net and submit the bar's orders together
+    if (!proposedOrders.empty())
+        oms->onNewOrders(proposedOrders);
 }
 
 void
@@ -93,9 +114,9 @@ StrategyEngine::printStategies()
 {
     std::cout << "Loaded strategies:" << std::endl;
 
-    for (auto& strat : strategyList) 
+    for (size_t i = 0; i < strategies.size(); i++) 
     {
-        std::cout << "  -> "  << strat->_strategyAttribute.name << std::endl;
+        std::cout << "  -> "  << strategies[i]._strategyAttribute.name << std::endl;
     }
 }
 
@@ -117,3 +138,120 @@ StrategyEngine::DecideToMakeTrade(std::vector<Order> proposedOrders)
 
     return true;
 }
+
+bool
+StrategyEngine::saveSnapshot(const std::string& path) const
+{
+    if (lastRunBar.DateTime.empty())
+        return false;
+
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        writeBinary(out, STRATEGY_SNAPSHOT_MAGIC);
+        writeBinary(out, static_cast<uint32_t>(STRATEGY_SNAPSHOT_VERSION));
+        writeBinaryString(out, strategyConfigHash);
+        writeBinaryString(out, lastRunBar.Ticker);
+        writeBinaryString(out, lastRunBar.TimeInterval);
+        writeBinaryString(out, lastRunBar.DateTime);
+        writeBinary(out, lastRunBar.Close);
+
+        writeBinary(out, static_cast<uint64_t>(strategies.size()));
+        for (size_t i = 0; i < strategies.size(); i++)
+        {
+            std::ostringstream state;
+            strategies[i].saveState(state);
+            writeBinaryString(out, strategies[i]._strategyAttribute.name);
+            writeBinaryString(out, state.str());
+        }
+        writeBinary(out, STRATEGY_SNAPSHOT_MAGIC);
+
+        if (!out)
+        {
+            LOG_WARN("Could not write strategy snapshot {}", path);
+            return false;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporary, path, error);
+    return !error;
+}
+
+bool
+StrategyEngine::loadSnapshot(const std::string& path)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in || marketData == nullptr)
+        return false;
+
+    uint64_t magic = 0;
+    uint32_t version = 0;
+    std::string configHash;
+    MarketCondition bar;
+    readBinary(in, magic);
+    readBinary(in, version);
+    readBinaryString(in, configHash);
+    readBinaryString(in, bar.Ticker);
+    readBinaryString(in, bar.TimeInterval);
+    readBinaryString(in, bar.DateTime);
+    readBinary(in, bar.Close);
+    bar.Time = Timestamp::parse(bar.DateTime);
+
+    std::vector<std::pair<std::string, std::string>> states;
+    uint64_t count = 0;
+    readBinary(in, count);
+    for (uint64_t i = 0; in && i < count; i++)
+    {
+        std::string name, state;
+        readBinaryString(in, name);
+        readBinaryString(in, state);
+        states.push_back({std::move(name), std::move(state)});
+    }
+    uint64_t trailer = 0;
+    readBinary(in, trailer);
+
+    if (!in || magic != STRATEGY_SNAPSHOT_MAGIC || version != STRATEGY_SNAPSHOT_VERSION || trailer != STRATEGY_SNAPSHOT_MAGIC)
+    {
+        LOG_WARN("Strategy snapshot {} is unreadable, starting cold", path);
+        return false;
+    }
+
+    if (configHash != strategyConfigHash || states.size() != strategies.size())
+    {
+        LOG_INFO("Strategy config changed since the snapshot, starting cold");
+        return false;
+    }
+    for (size_t i = 0; i < states.size(); i++)
+    {
+        if (states[i].first != strategies[i]._strategyAttribute.name)
+        {
+            LOG_INFO("Strategy config changed since the snapshot, starting cold");
+            return false;
+        }
+    }
+
+    // The latest bar at or before the snapshot's must be that same bar
+    const std::vector<MarketCondition>& data = marketData->getData();
+    if (!data.empty() && data.back().Ticker != bar.Ticker)
+    {
+        LOG_INFO("Strategy snapshot is for {}, not {}, starting cold", bar.Ticker, data.back().Ticker);
+        return false;
+    }
+    auto previous = std::find_if(data.rbegin(), data.rend(),
+                                 [&bar](const MarketCondition& condition) { return condition.Time <= bar.Time; });
+    if (previous != data.rend() && (previous->Time != bar.Time || previous->Close != bar.Close))
+    {
+        LOG_INFO("Market data no longer matches the snapshot at {}, starting cold", bar.DateTime);
+        return false;
+    }
+
+    for (size_t i = 0; i < states.size(); i++)
+    {
+        std::istringstream state(states[i].second);
+        strategies[i].loadState(state);
+    }
+    lastRunBar = bar;
+    LOG_INFO("Restored strategy state from bar {}", bar.DateTime);
+    return true;
+}
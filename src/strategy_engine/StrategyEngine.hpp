@@ -5,8 +5,13 @@
 #include "../oms/OrderManagement.hpp"
 #include "../data_access/MarketData.hpp"
 #include "StrategyFactory.hpp"
+#include "StrategyRegistry.hpp"
 #include "../broker/BrokerBase.hpp"
 
+#define STRATEGY_SNAPSHOT_MAGIC 0x50414E5354525453ull     // "STRTSNAP"
+#define STRATEGY_SNAPSHOT_VERSION 2
+#define STRATEGY_SNAPSHOT_DEFAULT_INTERVAL 30              // Bars between snapshots in the live app
+
 
 class StrategyEngine
 {
@@ -18,13 +23,31 @@ class StrategyEngine
         void run();
         
         // Set up the strategy engine
-        void setUp(json configData, StrategyFactory &stratFactory, MarketData &marketdata, BrokerBase* broker);
+        void setUp(const AppConfig& appConfig, StrategyFactory &stratFactory, MarketData &marketdata, BrokerBase* broker);
 
         // Update market data
         void setMarketData(MarketData& inputData);
+
+        // Drain acks/fills/rejects published by the broker into the OMS
+        int processBrokerEvents();
         
         // Get the order management system
-        OrderManagement* getOms() { return oms;};
+        OrderManagement* getOms() const { return oms;};
+
+        // Strategies grouped by type, indexable in config order
+        StrategyFleet& getStrategies() { return strategies; }
+        const StrategyFleet& getStrategies() const { return strategies; }
+
+        // Every strategy's indicator state, fingerprinted by the last bar the
+        // strategies ran on and a hash of the strategy config. Written to a
+        // temporary file and renamed, false if nothing has run yet.
+        bool saveSnapshot(const std::string& path) const;
+
+        // Restore a snapshot if the config matches and the market data carries
+        // on from its bar: the data either holds that bar with the same close
+        // or starts after it. Otherwise strategies start cold. Returns whether
+        // the snapshot was used.
+        bool loadSnapshot(const std::string& path);
 
     private:
         // Execute strategies on current market data
@@ -35,9 +58,12 @@ class StrategyEngine
 
         bool DecideToMakeTrade(std::vector<Order> proposedOrders);
 
-        json configData;
+        std::string strategyConfigHash;        // Of the factory's strategy configs, fingerprints snapshots
         MarketData* marketData; // Use a pointer to the MarketData object
         static OrderManagement* oms;
         std::vector<MarketCondition> marketConditions;
-        std::vector<std::unique_ptr<StrategyBase>> strategyList;
+        StrategyFleet strategies;
+        std::vector<Order> proposedOrders;     // Reused every bar
+        std::vector<std::pair<size_t, Order>> proposals;   // Config slot and order, reused every bar
+        MarketCondition lastRunBar;            // Empty DateTime until strategies have run
 };  
\ No newline at end of file
@@ -1,9 +1,6 @@
 #include <fstream>
 #include "StrategyFactory.hpp"
 #include "StrategyAttribute.hpp"
-#include "RSI.hpp"
-#include "MACD.hpp"
-#include "MEANREV.hpp"
 
 // Parse Strategies into StratFactory
 // StartBase will be the base for each strat
@@ -30,12 +27,19 @@ StrategyFactory::StrategyFactory(const json& configData)
     loadJsonData(configData);
 }
 
+// Constructor with strategies already parsed from the app config
+StrategyFactory::StrategyFactory(const std::vector<StrategyConfig>& strategyConfigs)
+: strategies(strategyConfigs)
+{
+}
+
 void
 StrategyFactory::loadJson(string filePath)
 {
     // For the test case with a specific strategies file
     config.loadJson(filePath);
     strategyData = config.getJson();
+    strategies = StrategyConfig::listFromJson(strategyData);
 }
 
 string
@@ -57,50 +61,38 @@ StrategyFactory::loadJsonData(const json& configData)
         std::cerr << "Warning: No 'strategies' section found in provided config!" << std::endl;
         strategyData["strategies"] = json::array();
     }
+    strategies = StrategyConfig::listFromJson(strategyData);
 }
 
-// Strat factory
-// std::vector<std::unique_ptr<StrategyBase>> 
-// StrategyFactory::generateStrategies() 
-// {
-    
-//     std::vector<std::unique_ptr<StrategyBase>> strategies;
-//     int numStrats = strategyData["strategies"].size();
-
-//     for (int i = 0; i < numStrats; ++i) {
-//         std::string name = strategyData["strategies"][i]["name"];
-//         auto strategy = StrategyBase::create(name);
-//         if (strategy) {
-//             strategies.push_back(std::move(strategy));
-//         } else {
-//             std::cerr << "Failed to create strategy: " << name << std::endl;
-//         }
-//     }
-//     return strategies;
-// }
+// Active strategies by value, grouped by type, for the engine's loop
+StrategyFleet
+StrategyFactory::generateFleet()
+{
+    StrategyFleet fleet;
+    for (const StrategyConfig& strategy : strategies) {
+        // Leave if strat not active
+        if (!strategy.active)
+            continue;
 
+        if (!fleet.add(strategy.name, strategy.attributes))
+            std::cerr << "Warning: Unknown strategy '" << strategy.name << "' in config, skipping" << std::endl;
+    }
+    return fleet;
+}
 
+// Active strategies on their own, in config order
 std::vector<std::unique_ptr<StrategyBase>> 
 StrategyFactory::generateStrategies() 
 {   
-    std::vector<std::unique_ptr<StrategyBase>> strategies;
-    int numStrats = strategyData["strategies"].size();
-
-    for (int i = 0; i < numStrats; ++i) {
-        std::string name = strategyData["strategies"][i]["name"];
-        int active = strategyData["strategies"][i]["active"].get<int>();
-        StrategyAttribute attributes(strategyData["strategies"][i]);
-
+    std::vector<std::unique_ptr<StrategyBase>> created;
+    for (const StrategyConfig& strategy : strategies) {
         // Leave if strat not active
-        if(!active)
+        if (!strategy.active)
             continue;
 
-        if(name == "RSI")
-            strategies.push_back(std::make_unique<RSI>(attributes));
-        else if (name == "MACD")
-            strategies.push_back(std::make_unique<MACD>(attributes));
-        else if (name == "MEANREV")
-            strategies.push_back(std::make_unique<MEANREV>(attributes));
+        auto instance = StrategyFleet::create(strategy.name, strategy.attributes);
+        if (instance)
+            created.push_back(std::move(instance));
     }
-    return strategies;
-}
\ No newline at end of file
+    return created;
+}
@@ -2,6 +2,7 @@
 
 #include "../util/Config.hpp"
 #include "StrategyBase.hpp"
+#include "StrategyRegistry.hpp"
 
 
 // Using consolidated config file now
@@ -12,16 +13,20 @@ class StrategyFactory
         StrategyFactory();
         StrategyFactory(string filePath);
         StrategyFactory(const json& configData);
+        StrategyFactory(const std::vector<StrategyConfig>& strategyConfigs);
         ~StrategyFactory(){};
 
         void loadJson(string filePath);
         json getJson(){ return strategyData;};
         void loadJsonData(const json& configData);
+        const std::vector<StrategyConfig>& getStrategyConfigs() const { return strategies; }
+        StrategyFleet generateFleet();
         std::vector<std::unique_ptr<StrategyBase>> generateStrategies();
 
     private:
 
         Config config;
         json strategyData;
+        std::vector<StrategyConfig> strategies;    // Parsed from strategyData
         string formatStrategyPath();
 };  
\ No newline at end of file
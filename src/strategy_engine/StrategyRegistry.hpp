@@ -0,0 +1,146 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "StrategyBase.hpp"
+#include "RSI.hpp"
+#include "MACD.hpp"
+#include "MEANREV.hpp"
+
+/**
+ * StrategyFleetOf
+ *
+ * The strategies a config turned on, held by value in one contiguous vector
+ * per strategy type. The types are fixed at compile time, the config only
+ * picks names from them, so the engine's loop over a type's vector calls
+ * execute, onNewOrder and getOrder on the concrete (final) class with no
+ * indirect call, and a fleet of one strategy type walks memory in order.
+ *
+ * Each strategy also has a slot, its position in the config. Cold paths
+ * (printing, snapshots, checkpoints) look strategies up by slot through
+ * StrategyBase.
+ */
+template <typename... Strategies>
+class StrategyFleetOf
+{
+    public:
+        static_assert(sizeof...(Strategies) > 0, "A fleet needs at least one strategy type");
+
+        // Instances of one type with the config slot of each
+        template <typename Strategy>
+        struct Group
+        {
+            std::vector<Strategy> strategies;
+            std::vector<size_t> slots;
+        };
+
+        static bool isRegistered(std::string_view name)
+        {
+            return typeIndex(name) < sizeof...(Strategies);
+        }
+
+        // Add a strategy by config name, false if no type has that name
+        bool add(std::string_view name, const StrategyAttribute& attributes)
+        {
+            return addAs(typeIndex(name), attributes, std::index_sequence_for<Strategies...>{});
+        }
+
+        // A single heap allocated strategy by config name, nullptr if unknown
+        static std::unique_ptr<StrategyBase> create(std::string_view name, const StrategyAttribute& attributes)
+        {
+            std::unique_ptr<StrategyBase> strategy;
+            ((name == Strategies::Name ? (strategy = std::make_unique<Strategies>(attributes), true) : false) || ...);
+            return strategy;
+        }
+
+        // Call f(strategy, slot) on every strategy, one type at a time
+        template <typename F>
+        void forEach(F&& f)
+        {
+            std::apply([&f](auto&... group) { (forEachIn(group, f), ...); }, groups);
+        }
+
+        template <typename Strategy>
+        std::vector<Strategy>& all() { return std::get<Group<Strategy>>(groups).strategies; }
+
+        template <typename Strategy>
+        const std::vector<Strategy>& all() const { return std::get<Group<Strategy>>(groups).strategies; }
+
+        size_t size() const { return order.size(); }
+        bool empty() const { return order.empty(); }
+
+        // Strategy in config order
+        StrategyBase& operator[](size_t slot)
+        {
+            return at(order[slot].first, order[slot].second, std::index_sequence_for<Strategies...>{});
+        }
+
+        const StrategyBase& operator[](size_t slot) const
+        {
+            return const_cast<StrategyFleetOf&>(*this)[slot];
+        }
+
+    private:
+        static constexpr std::array<std::string_view, sizeof...(Strategies)> names{Strategies::Name...};
+
+        static constexpr bool namesAreUnique()
+        {
+            for (size_t i = 0; i < names.size(); i++)
+                for (size_t j = i + 1; j < names.size(); j++)
+                    if (names[i] == names[j])
+                        return false;
+            return true;
+        }
+        static_assert(namesAreUnique(), "Two strategy types share a config name");
+
+        static constexpr size_t typeIndex(std::string_view name)
+        {
+            size_t index = 0;
+            while (index < names.size() && names[index] != name)
+                index++;
+            return index;
+        }
+
+        template <size_t... I>
+        bool addAs(size_t type, const StrategyAttribute& attributes, std::index_sequence<I...>)
+        {
+            return ((type == I ? (emplace<I>(attributes), true) : false) || ...);
+        }
+
+        template <size_t I>
+        void emplace(const StrategyAttribute& attributes)
+        {
+            auto& group = std::get<I>(groups);
+            order.push_back({I, group.strategies.size()});
+            group.slots.push_back(order.size() - 1);
+            group.strategies.emplace_back(attributes);
+        }
+
+        template <size_t... I>
+        StrategyBase& at(size_t type, size_t index, std::index_sequence<I...>)
+        {
+            StrategyBase* strategy = nullptr;
+            ((type == I ? (strategy = &std::get<I>(groups).strategies[index], true) : false) || ...);
+            return *strategy;
+        }
+
+        template <typename Strategy, typename F>
+        static void forEachIn(Group<Strategy>& group, F& f)
+        {
+            for (size_t i = 0; i < group.strategies.size(); i++)
+                f(group.strategies[i], group.slots[i]);
+        }
+
+        std::tuple<Group<Strategies>...> groups;
+        std::vector<std::pair<size_t, size_t>> order;  // Slot to (type, index in its group)
+};
+
+// Every strategy a config can name. A new strategy is added here, with a
+// static Name matching its config "name".
+using StrategyFleet = StrategyFleetOf<RSI, MACD, MEANREV>;
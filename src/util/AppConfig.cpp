@@ -0,0 +1,539 @@
+#include "AppConfig.hpp"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <type_traits>
+#include <unistd.h>
+#include "BinaryIO.hpp"
+#include "ContentHash.hpp"
+#include "Logger.hpp"
+
+namespace {
+
+template <typename T>
+std::string
+expected()
+{
+    if constexpr (std::is_same_v<T, std::string>) return "a string";
+    else if constexpr (std::is_same_v<T, bool>) return "true or false";
+    else if constexpr (std::is_unsigned_v<T>) return "a whole number, 0 or more";
+    else if constexpr (std::is_integral_v<T>) return "a whole number";
+    else return "a number";
+}
+
+template <typename T>
+void
+readOptional(const json& config, const std::string& key, T& value, const std::string& where = "")
+{
+    if (!config.contains(key)) {
+        return;
+    }
+
+    const json& field = config[key];
+    bool matches = std::is_same_v<T, std::string> ? field.is_string()
+                 : std::is_same_v<T, bool> ? field.is_boolean() || field.is_number_integer()
+                 : std::is_integral_v<T> ? field.is_number_integer() || (field.is_number_float() && field.get<double>() == static_cast<double>(static_cast<int64_t>(field.get<double>())))
+                 : field.is_number();
+
+    // get<T>() would wrap a negative number round to a huge unsigned one
+    if constexpr (std::is_unsigned_v<T> && !std::is_same_v<T, bool>) {
+        matches = matches && field.get<double>() >= 0;
+    }
+    if (!matches) {
+        throw std::runtime_error("Config: '" + where + key + "' should be " + expected<T>() + ", got " + field.dump());
+    }
+    if constexpr (std::is_same_v<T, bool>) {
+        value = field.is_boolean() ? field.get<bool>() : field.get<int>() != 0;
+    } else {
+        value = field.get<T>();
+    }
+}
+
+template <typename T>
+void
+readOptional(const json& config, const std::string& key, std::optional<T>& value, const std::string& where = "")
+{
+    if (config.contains(key)) {
+        T read{};
+        readOptional(config, key, read, where);
+        value = read;
+    }
+}
+
+template <typename T>
+void
+readRequired(const json& config, const std::string& key, T& value, const std::string& where = "")
+{
+    if (!config.contains(key)) {
+        throw std::runtime_error("Config: missing '" + where + key + "'");
+    }
+    readOptional(config, key, value, where);
+}
+
+// Strings and optionals on top of the raw BinaryIO helpers
+
+void
+writeField(std::ostream& out, const std::string& value)
+{
+    writeBinaryString(out, value);
+}
+
+void
+readField(std::istream& in, std::string& value)
+{
+    readBinaryString(in, value);
+}
+
+template <typename T>
+void
+writeField(std::ostream& out, const T& value)
+{
+    writeBinary(out, value);
+}
+
+template <typename T>
+void
+readField(std::istream& in, T& value)
+{
+    readBinary(in, value);
+}
+
+void writeField(std::ostream& out, const CostModelConfig& costModel);
+void readField(std::istream& in, CostModelConfig& costModel);
+
+template <typename T>
+void
+writeField(std::ostream& out, const std::optional<T>& value)
+{
+    writeBinary(out, static_cast<uint8_t>(value.has_value()));
+    if (value) writeField(out, *value);
+}
+
+template <typename T>
+void
+readField(std::istream& in, std::optional<T>& value)
+{
+    uint8_t present = 0;
+    readBinary(in, present);
+    value.reset();
+    if (in && present) {
+        T read{};
+        readField(in, read);
+        value = std::move(read);
+    }
+}
+
+void
+writeField(std::ostream& out, const StrategyAttribute& attributes)
+{
+    writeField(out, attributes.period);
+    writeField(out, attributes.oversold_threshold);
+    writeField(out, attributes.overbought_threshold);
+    writeField(out, attributes.short_period);
+    writeField(out, attributes.long_period);
+    writeField(out, attributes.signal_period);
+    writeField(out, attributes.lookback_period);
+    writeField(out, attributes.exit_threshold);
+    writeField(out, attributes.entry_threshold);
+    writeField(out, attributes.moving_average_period);
+    writeField(out, attributes.name);
+    writeField(out, attributes.price_type);
+    writeField(out, attributes.trade_size);
+    writeField(out, attributes.stop_loss);
+    writeField(out, attributes.take_profit);
+}
+
+void
+readField(std::istream& in, StrategyAttribute& attributes)
+{
+    readField(in, attributes.period);
+    readField(in, attributes.oversold_threshold);
+    readField(in, attributes.overbought_threshold);
+    readField(in, attributes.short_period);
+    readField(in, attributes.long_period);
+    readField(in, attributes.signal_period);
+    readField(in, attributes.lookback_period);
+    readField(in, attributes.exit_threshold);
+    readField(in, attributes.entry_threshold);
+    readField(in, attributes.moving_average_period);
+    readField(in, attributes.name);
+    readField(in, attributes.price_type);
+    readField(in, attributes.trade_size);
+    readField(in, attributes.stop_loss);
+    readField(in, attributes.take_profit);
+}
+
+void
+writeField(std::ostream& out, const CostModelConfig& costModel)
+{
+    writeField(out, costModel.type);
+    writeField(out, costModel.commission);
+    writeField(out, costModel.slippage);
+    writeBinary(out, static_cast<uint64_t>(costModel.tiers.size()));
+    for (const CostTier& tier : costModel.tiers) {
+        writeField(out, tier.upToShares);
+        writeField(out, tier.perShare);
+    }
+    writeField(out, costModel.minCommission);
+    writeField(out, costModel.maxCommissionPercent);
+    writeField(out, costModel.minSpreadBps);
+    writeField(out, costModel.impactCoefficient);
+    writeField(out, costModel.maxImpact);
+    writeField(out, costModel.volatilityWindow);
+}
+
+void
+readField(std::istream& in, CostModelConfig& costModel)
+{
+    readField(in, costModel.type);
+    readField(in, costModel.commission);
+    readField(in, costModel.slippage);
+    uint64_t tiers = 0;
+    readBinary(in, tiers);
+    costModel.tiers.clear();
+    for (uint64_t i = 0; in && i < tiers && i < BINARY_IO_MAX_COUNT; i++) {
+        CostTier tier;
+        readField(in, tier.upToShares);
+        readField(in, tier.perShare);
+        costModel.tiers.push_back(tier);
+    }
+    readField(in, costModel.minCommission);
+    readField(in, costModel.maxCommissionPercent);
+    readField(in, costModel.minSpreadBps);
+    readField(in, costModel.impactCoefficient);
+    readField(in, costModel.maxImpact);
+    readField(in, costModel.volatilityWindow);
+}
+
+void
+writeStrategies(std::ostream& out, const std::vector<StrategyConfig>& strategies)
+{
+    writeBinary(out, static_cast<uint64_t>(strategies.size()));
+    for (const StrategyConfig& strategy : strategies) {
+        writeField(out, strategy.name);
+        writeField(out, strategy.active);
+        writeField(out, strategy.attributes);
+    }
+}
+
+std::string
+readFile(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Failed to open JSON file: " + path);
+    }
+    std::ostringstream text;
+    text << file.rdbuf();
+    return text.str();
+}
+
+} // namespace
+
+DataConfig
+DataConfig::fromJson(const json& config)
+{
+    DataConfig data;
+    readRequired(config, "ticker", data.ticker);
+    readOptional(config, "marketDataBasePath", data.marketDataBasePath);
+    readOptional(config, "baseDataFileName", data.baseDataFileName);
+    readOptional(config, "collectInterval", data.collectInterval);
+    readOptional(config, "market_data_source", data.source);
+    readOptional(config, "shared_bars_name", data.sharedBarsName);
+    readOptional(config, "bar_notify_port", data.barNotifyPort);
+    readOptional(config, "backtest_start_date", data.backtestStartDate);
+    readOptional(config, "backtest_end_date", data.backtestEndDate);
+
+    if (data.ticker.empty()) {
+        throw std::runtime_error("Config: 'ticker' is empty");
+    }
+    if (data.source != "csv" && data.source != "shared_memory") {
+        throw std::runtime_error("Config: 'market_data_source' should be \"csv\" or \"shared_memory\", got \"" + data.source + "\"");
+    }
+    if (data.backtestStartDate.has_value() != data.backtestEndDate.has_value()) {
+        throw std::runtime_error("Config: 'backtest_start_date' and 'backtest_end_date' go together");
+    }
+    return data;
+}
+
+RiskConfig
+RiskConfig::fromJson(const json& config)
+{
+    RiskConfig risk;
+    readRequired(config, "max_position_size", risk.maxPositionSize);
+    readRequired(config, "max_exposure", risk.maxExposure);
+    readRequired(config, "slippage_tolerance", risk.slippageTolerance);
+
+    if (risk.maxPositionSize <= 0 || risk.maxExposure <= 0.0 || risk.slippageTolerance < 0.0) {
+        throw std::runtime_error("Config: 'max_position_size' and 'max_exposure' should be above 0 and 'slippage_tolerance' not below it");
+    }
+    return risk;
+}
+
+CostModelConfig
+CostModelConfig::fromJson(const json& config)
+{
+    const std::string where = "cost_model.";
+    CostModelConfig costModel;
+    readOptional(config, "type", costModel.type, where);
+    readOptional(config, "commission", costModel.commission, where);
+    readOptional(config, "slippage", costModel.slippage, where);
+    readOptional(config, "min_commission", costModel.minCommission, where);
+    readOptional(config, "max_commission_percent", costModel.maxCommissionPercent, where);
+    readOptional(config, "min_spread_bps", costModel.minSpreadBps, where);
+    readOptional(config, "impact_coefficient", costModel.impactCoefficient, where);
+    readOptional(config, "max_impact", costModel.maxImpact, where);
+    readOptional(config, "volatility_window", costModel.volatilityWindow, where);
+
+    if (config.contains("tiers")) {
+        if (!config["tiers"].is_array()) {
+            throw std::runtime_error("Config: '" + where + "tiers' should be an array");
+        }
+        for (size_t i = 0; i < config["tiers"].size(); i++) {
+            std::string tierWhere = where + "tiers[" + std::to_string(i) + "].";
+            CostTier tier;
+            readOptional(config["tiers"][i], "up_to_shares", tier.upToShares, tierWhere);
+            readRequired(config["tiers"][i], "per_share", tier.perShare, tierWhere);
+            costModel.tiers.push_back(tier);
+        }
+    }
+
+    if (costModel.type != "flat" && costModel.type != "tiered") {
+        throw std::runtime_error("Unknown cost model type: " + costModel.type);
+    }
+    return costModel;
+}
+
+BrokerConfig
+BrokerConfig::fromJson(const json& config)
+{
+    BrokerConfig broker;
+    if (config.contains("cost_model")) {
+        broker.costModel = CostModelConfig::fromJson(config["cost_model"]);
+    }
+    readOptional(config, "lot_matching", broker.lotMatching);
+    readOptional(config, "journal_path", broker.journalPath);
+    return broker;
+}
+
+std::vector<StrategyConfig>
+StrategyConfig::listFromJson(const json& config)
+{
+    std::vector<StrategyConfig> strategies;
+    if (!config.contains("strategies")) {
+        return strategies;
+    }
+    if (!config["strategies"].is_array()) {
+        throw std::runtime_error("Config: 'strategies' should be an array");
+    }
+
+    for (size_t i = 0; i < config["strategies"].size(); i++) {
+        const json& entry = config["strategies"][i];
+        std::string where = "strategies[" + std::to_string(i) + "].";
+        StrategyConfig strategy;
+        readRequired(entry, "name", strategy.name, where);
+        readRequired(entry, "active", strategy.active, where);
+        try {
+            strategy.attributes = StrategyAttribute(entry);
+        } catch (const json::exception& e) {
+            throw std::runtime_error("Config: strategy " + where + " (" + strategy.name + ") - " + e.what());
+        }
+        strategies.push_back(std::move(strategy));
+    }
+    return strategies;
+}
+
+LiveConfig
+LiveConfig::fromJson(const json& config)
+{
+    LiveConfig live;
+    readOptional(config, "strategy_snapshot_path", live.strategySnapshotPath);
+    readOptional(config, "strategy_snapshot_interval", live.strategySnapshotInterval);
+    return live;
+}
+
+BacktestConfig
+BacktestConfig::fromJson(const json& config)
+{
+    BacktestConfig backtest;
+    readOptional(config, "equity_curve_interval", backtest.equityCurveInterval);
+    readOptional(config, "result_cache_dir", backtest.resultCacheDir);
+    readOptional(config, "result_cache_max_mb", backtest.resultCacheMaxMb);
+    readOptional(config, "random_seed", backtest.randomSeed);
+    return backtest;
+}
+
+AppConfig
+AppConfig::fromJson(const json& config)
+{
+    if (!config.is_object()) {
+        throw std::runtime_error("Config: expected a JSON object at the top level");
+    }
+
+    AppConfig app;
+    app.data = DataConfig::fromJson(config);
+    app.risk = RiskConfig::fromJson(config);
+    app.broker = BrokerConfig::fromJson(config);
+    app.strategies = StrategyConfig::listFromJson(config);
+    app.live = LiveConfig::fromJson(config);
+    app.backtest = BacktestConfig::fromJson(config);
+    return app;
+}
+
+AppConfig
+AppConfig::load(const std::string& path, const std::string& cachePath)
+{
+    std::string text = readFile(path);
+    ContentHash source;
+    source.update(text);
+    std::string sourceHash = source.hex();
+
+    if (!cachePath.empty()) {
+        std::ifstream cached(cachePath, std::ios::binary);
+        uint64_t magic = 0;
+        uint32_t version = 0;
+        std::string cachedHash;
+        readBinary(cached, magic);
+        readBinary(cached, version);
+        readBinaryString(cached, cachedHash);
+        if (cached && magic == APP_CONFIG_CACHE_MAGIC && version == APP_CONFIG_CACHE_VERSION && cachedHash == sourceHash) {
+            AppConfig app;
+            app.loadState(cached);
+            readBinary(cached, magic);
+            if (cached && magic == APP_CONFIG_CACHE_MAGIC) {
+                return app;
+            }
+        }
+    }
+
+    AppConfig app;
+    try {
+        app = fromJson(json::parse(text));
+    } catch (const json::parse_error& e) {
+        throw std::runtime_error("Config: " + path + " is not valid JSON - " + e.what());
+    }
+
+    if (!cachePath.empty()) {
+        // Best effort, a config that cannot be cached is still loaded
+        std::error_code error;
+        std::filesystem::path cacheFile(cachePath);
+        if (cacheFile.has_parent_path()) {
+            std::filesystem::create_directories(cacheFile.parent_path(), error);
+        }
+        // Per process, a live app and a backtest may start in the same tree at once
+        std::string temporary = cachePath + ".tmp" + std::to_string(getpid());
+        {
+            std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+            writeBinary(out, APP_CONFIG_CACHE_MAGIC);
+            writeBinary(out, static_cast<uint32_t>(APP_CONFIG_CACHE_VERSION));
+            writeBinaryString(out, sourceHash);
+            app.saveState(out);
+            writeBinary(out, APP_CONFIG_CACHE_MAGIC);
+            if (!out) {
+                error = std::make_error_code(std::errc::io_error);
+            }
+        }
+        if (!error) {
+            std::filesystem::rename(temporary, cachePath, error);
+        }
+        if (error) {
+            std::filesystem::remove(temporary, error);
+            LOG_WARN("Could not write config cache {}", cachePath);
+        }
+    }
+    return app;
+}
+
+void
+AppConfig::saveState(std::ostream& out) const
+{
+    writeField(out, data.ticker);
+    writeField(out, data.marketDataBasePath);
+    writeField(out, data.baseDataFileName);
+    writeField(out, data.collectInterval);
+    writeField(out, data.source);
+    writeField(out, data.sharedBarsName);
+    writeField(out, data.barNotifyPort);
+    writeField(out, data.backtestStartDate);
+    writeField(out, data.backtestEndDate);
+
+    writeField(out, risk.maxPositionSize);
+    writeField(out, risk.maxExposure);
+    writeField(out, risk.slippageTolerance);
+
+    writeField(out, broker.costModel);
+    writeField(out, broker.lotMatching);
+    writeField(out, broker.journalPath);
+
+    writeStrategies(out, strategies);
+
+    writeField(out, live.strategySnapshotPath);
+    writeField(out, live.strategySnapshotInterval);
+
+    writeField(out, backtest.equityCurveInterval);
+    writeField(out, backtest.resultCacheDir);
+    writeField(out, backtest.resultCacheMaxMb);
+    writeField(out, backtest.randomSeed);
+}
+
+void
+AppConfig::loadState(std::istream& in)
+{
+    readField(in, data.ticker);
+    readField(in, data.marketDataBasePath);
+    readField(in, data.baseDataFileName);
+    readField(in, data.collectInterval);
+    readField(in, data.source);
+    readField(in, data.sharedBarsName);
+    readField(in, data.barNotifyPort);
+    readField(in, data.backtestStartDate);
+    readField(in, data.backtestEndDate);
+
+    readField(in, risk.maxPositionSize);
+    readField(in, risk.maxExposure);
+    readField(in, risk.slippageTolerance);
+
+    readField(in, broker.costModel);
+    readField(in, broker.lotMatching);
+    readField(in, broker.journalPath);
+
+    uint64_t count = 0;
+    readBinary(in, count);
+    strategies.clear();
+    for (uint64_t i = 0; in && i < count && i < BINARY_IO_MAX_COUNT; i++) {
+        StrategyConfig strategy;
+        readField(in, strategy.name);
+        readField(in, strategy.active);
+        readField(in, strategy.attributes);
+        strategies.push_back(std::move(strategy));
+    }
+
+    readField(in, live.strategySnapshotPath);
+    readField(in, live.strategySnapshotInterval);
+
+    readField(in, backtest.equityCurveInterval);
+    readField(in, backtest.resultCacheDir);
+    readField(in, backtest.resultCacheMaxMb);
+    readField(in, backtest.randomSeed);
+}
+
+std::string
+AppConfig::hash() const
+{
+    std::ostringstream encoded;
+    saveState(encoded);
+    ContentHash hash;
+    hash.update(encoded.str());
+    return hash.hex();
+}
+
+std::string
+AppConfig::hashStrategies(const std::vector<StrategyConfig>& strategies)
+{
+    std::ostringstream encoded;
+    writeStrategies(encoded, strategies);
+    ContentHash hash;
+    hash.update(encoded.str());
+    return hash.hex();
+}
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "../strategy_engine/StrategyAttribute.hpp"
+
+#define APP_CONFIG_CACHE_MAGIC 0x4E49424746434741ull     // "AGCFGBIN"
+#define APP_CONFIG_CACHE_VERSION 1
+#define APP_CONFIG_CACHE_PATH ".cache/app_config.bin"
+
+// Defaults for TieredCostModel, loosely following a retail tiered US equity schedule
+#define DEFAULT_MIN_COMMISSION 0.35
+#define DEFAULT_MAX_COMMISSION_PERCENT 0.01
+#define DEFAULT_MIN_SPREAD_BPS 1.0
+#define DEFAULT_IMPACT_COEFFICIENT 0.1
+#define DEFAULT_MAX_IMPACT 0.05
+#define DEFAULT_VOLATILITY_WINDOW 20
+
+using json = nlohmann::json;
+
+// Where bars come from
+struct DataConfig
+{
+    std::string ticker;
+    std::string marketDataBasePath;                 // Both needed to find the day's CSV
+    std::string baseDataFileName;
+    std::string collectInterval = "1m";
+    std::string source = "csv";                     // "csv" or "shared_memory"
+    std::optional<std::string> sharedBarsName;
+    std::optional<int> barNotifyPort;
+    std::optional<std::string> backtestStartDate;   // Both or neither
+    std::optional<std::string> backtestEndDate;
+
+    static DataConfig fromJson(const json& config);
+};
+
+// Limits the OMS checks every order against
+struct RiskConfig
+{
+    int maxPositionSize = 0;
+    double maxExposure = 0.0;
+    double slippageTolerance = 0.0;
+
+    static RiskConfig fromJson(const json& config);
+};
+
+struct CostTier
+{
+    double upToShares = 0.0;
+    double perShare = 0.0;
+};
+
+// The "cost_model" section, missing fields fall back to the defaults above
+struct CostModelConfig
+{
+    std::string type = "flat";                      // "flat" or "tiered"
+    double commission = 1.0;
+    double slippage = 0.0005;
+    std::vector<CostTier> tiers;                    // Empty for the model's default tiers
+    double minCommission = DEFAULT_MIN_COMMISSION;
+    double maxCommissionPercent = DEFAULT_MAX_COMMISSION_PERCENT;
+    double minSpreadBps = DEFAULT_MIN_SPREAD_BPS;
+    double impactCoefficient = DEFAULT_IMPACT_COEFFICIENT;
+    double maxImpact = DEFAULT_MAX_IMPACT;
+    int volatilityWindow = DEFAULT_VOLATILITY_WINDOW;
+
+    static CostModelConfig fromJson(const json& config);
+};
+
+struct BrokerConfig
+{
+    std::optional<CostModelConfig> costModel;       // Unset keeps the broker's own commission and slippage
+    std::optional<std::string> lotMatching;
+    std::string journalPath = "data/oms.journal";
+
+    static BrokerConfig fromJson(const json& config);
+};
+
+// One entry of "strategies", in config order
+struct StrategyConfig
+{
+    std::string name;
+    bool active = false;
+    StrategyAttribute attributes;
+
+    static std::vector<StrategyConfig> listFromJson(const json& config);
+};
+
+struct LiveConfig
+{
+    std::string strategySnapshotPath = "data/strategy_state.snapshot";
+    std::optional<int> strategySnapshotInterval;
+
+    static LiveConfig fromJson(const json& config);
+};
+
+struct BacktestConfig
+{
+    std::optional<int> equityCurveInterval;
+    std::optional<std::string> resultCacheDir;
+    std::optional<uint64_t> resultCacheMaxMb;
+    std::optional<unsigned int> randomSeed;
+
+    static BacktestConfig fromJson(const json& config);
+};
+
+/**
+ * AppConfig
+ *
+ * The algo config parsed and checked once, then passed around by const
+ * reference instead of looking keys up in the JSON wherever they are used.
+ * Unset optionals leave the choice to the component that owns the default.
+ *
+ * Errors name the key and what was expected, e.g.
+ *   Config: 'max_exposure' should be a number, got "5%"
+ *
+ * load() can go through a binary cache of the parsed config, keyed by a
+ * hash of the config file, so a start or a sweep job over an unchanged
+ * config skips the JSON parse and the checks.
+ */
+struct AppConfig
+{
+    DataConfig data;
+    RiskConfig risk;
+    BrokerConfig broker;
+    std::vector<StrategyConfig> strategies;
+    LiveConfig live;
+    BacktestConfig backtest;
+
+    static AppConfig fromJson(const json& config);
+
+    // Parse a config file, through the cache at cachePath unless it is empty
+    static AppConfig load(const std::string& path, const std::string& cachePath = "");
+
+    void saveState(std::ostream& out) const;
+    void loadState(std::istream& in);
+
+    // Of the binary encoding, for cache keys
+    std::string hash() const;
+    static std::string hashStrategies(const std::vector<StrategyConfig>& strategies);
+};
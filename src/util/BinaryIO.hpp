@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+// Largest string or vector a reader accepts, so a corrupt count fails the
+// stream instead of allocating
+#define BINARY_IO_MAX_COUNT (1ull << 31)
+
+// Raw native-endian values, for files written and read back on the same
+// machine (result cache, checkpoints). Reads leave the stream failed on a
+// short read, so a reader can check the stream once at the end.
+
+template <typename T>
+inline void
+writeBinary(std::ostream& out, const T& value)
+{
+    static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values are written raw");
+    out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <typename T>
+inline bool
+readBinary(std::istream& in, T& value)
+{
+    static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values are read raw");
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(value)));
+}
+
+inline void
+writeBinaryString(std::ostream& out, std::string_view text)
+{
+    writeBinary(out, static_cast<uint64_t>(text.size()));
+    out.write(text.data(), text.size());
+}
+
+inline bool
+readBinaryString(std::istream& in, std::string& text)
+{
+    uint64_t size = 0;
+    if (!readBinary(in, size) || size > BINARY_IO_MAX_COUNT) {
+        in.setstate(std::ios::failbit);
+        return false;
+    }
+    text.resize(size);
+    return static_cast<bool>(in.read(text.data(), size));
+}
+
+template <typename T>
+inline void
+writeBinaryVector(std::ostream& out, const std::vector<T>& values)
+{
+    static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values are written raw");
+    writeBinary(out, static_cast<uint64_t>(values.size()));
+    out.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+}
+
+template <typename T>
+inline bool
+readBinaryVector(std::istream& in, std::vector<T>& values)
+{
+    static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values are read raw");
+    uint64_t count = 0;
+    if (!readBinary(in, count) || count > BINARY_IO_MAX_COUNT / sizeof(T)) {
+        in.setstate(std::ios::failbit);
+        return false;
+    }
+    values.resize(count);
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(values.data()), count * sizeof(T)));
+}
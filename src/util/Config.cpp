@@ -15,7 +15,6 @@ Config::loadConfig()
     if(!loaded)
     {
         loadJson(formConfigPath());
-        std::cout << "JSON Data: " << configData.dump(4) << std::endl;
         return configData;
     }
     else
@@ -41,6 +40,14 @@ Config::loadJson(const std::string& path)
     loaded = true;
 }
 
+AppConfig
+Config::loadAppConfig(bool useCache)
+{
+    string path = formConfigPath();
+    std::cout << "Loading config from: " << path << std::endl;
+    return AppConfig::load(path, useCache ? getAbsolutePath(APP_CONFIG_CACHE_PATH) : "");
+}
+
 string
 Config::formConfigPath()
 {
@@ -1,6 +1,7 @@
 #pragma once
 #include <iostream>
 #include <nlohmann/json.hpp>
+#include "AppConfig.hpp"
 
 #define JSON_CONFIG_NAME "/src/config/config.json"
 
@@ -20,6 +21,10 @@ class Config
         
         // Load the default config file
         json loadConfig();
+
+        // The default config file parsed and checked, through the binary
+        // config cache under the project root unless useCache is false
+        AppConfig loadAppConfig(bool useCache = true);
         
         // Get the loaded JSON data
         json getJson(){ return configData; };
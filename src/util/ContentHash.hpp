@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+/**
+ * ContentHash
+ *
+ * Streaming 128-bit FNV-1a, for naming things by their content (cache
+ * entries, checkpoints). Not cryptographic, but 128 bits keep accidental
+ * collisions out of reach for any number of entries a local cache will see.
+ *
+ * Strings are length-prefixed, so ("ab", "c") and ("a", "bc") differ.
+ */
+class ContentHash
+{
+    public:
+        ContentHash() : state(OFFSET_BASIS) {}
+
+        void update(const void* data, size_t size)
+        {
+            const unsigned char* bytes = static_cast<const unsigned char*>(data);
+            for (size_t i = 0; i < size; i++) {
+                state ^= bytes[i];
+                state *= PRIME;
+            }
+        }
+
+        void update(std::string_view text)
+        {
+            uint64_t length = text.size();
+            update(&length, sizeof(length));
+            update(text.data(), text.size());
+        }
+
+        template <typename T>
+        std::enable_if_t<std::is_arithmetic_v<T>> update(T value)
+        {
+            update(&value, sizeof(value));
+        }
+
+        // 32 lowercase hex digits
+        std::string hex() const
+        {
+            static const char digits[] = "0123456789abcdef";
+            std::string text(32, '0');
+            unsigned __int128 value = state;
+            for (int i = 31; i >= 0; i--) {
+                text[i] = digits[static_cast<unsigned>(value & 0xF)];
+                value >>= 4;
+            }
+            return text;
+        }
+
+    private:
+        static constexpr unsigned __int128 OFFSET_BASIS =
+            (static_cast<unsigned __int128>(0x6c62272e07bb0142ull) << 64) | 0x62b821756295c58dull;
+        static constexpr unsigned __int128 PRIME =
+            (static_cast<unsigned __int128>(0x0000000001000000ull) << 64) | 0x000000000000013bull;
+
+        unsigned __int128 state;
+};
@@ -1,4 +1,5 @@
 #include "DateTimeConversion.hpp"
+#include "Timestamp.hpp"
 #include <iomanip>
 #include <sstream>
 
@@ -44,3 +45,10 @@ std::string DateTimeConversion::timeNowToDate()
     std::strftime(buffer, sizeof(buffer), "%Y-%m-%d", &t);
     return std::string(buffer);
 }
+
+std::time_t
+DateTimeConversion::toEpoch(const std::string& dateTime)
+{
+    Timestamp parsed = Timestamp::parse(dateTime);
+    return parsed.isValid() ? parsed.seconds() : -1;
+}
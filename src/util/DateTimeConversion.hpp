@@ -15,6 +15,9 @@ public:
     std::string timeNowToString();
     void setTime(std::time_t epochTime);
 
+    // Seconds since epoch for a UTC "YYYY-MM-DD[ HH:MM:SS]" string, -1 if it can't be read
+    static std::time_t toEpoch(const std::string& dateTime);
+
 private:
     std::tm t{};
 };
@@ -0,0 +1,225 @@
+#include "EventLoop.hpp"
+#include <cctype>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <stdexcept>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <sys/signalfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+#define NANOS_PER_SECOND 1000000000LL
+
+static void
+throwSystemError(const std::string& what)
+{
+    throw std::runtime_error("EventLoop: " + what + " failed: " + std::strerror(errno));
+}
+
+int64_t
+intervalToSeconds(const std::string& interval)
+{
+    size_t digits = 0;
+    while (digits < interval.size() && std::isdigit(static_cast<unsigned char>(interval[digits]))) {
+        digits++;
+    }
+    if (digits == 0 || digits + 1 != interval.size()) {
+        throw std::runtime_error("Unknown bar interval: " + interval);
+    }
+
+    int64_t count = std::stoll(interval.substr(0, digits));
+    switch (interval.back()) {
+        case 's': return count;
+        case 'm': return count * 60;
+        case 'h': return count * 60 * 60;
+        case 'd': return count * 24 * 60 * 60;
+    }
+    throw std::runtime_error("Unknown bar interval: " + interval);
+}
+
+EventLoop::EventLoop()
+: stopped(false),
+  wakeTime(0)
+{
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd < 0) throwSystemError("epoll_create1");
+
+    wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wakeFd < 0) throwSystemError("eventfd");
+    add(wakeFd, {SourceType::WAKE, nullptr, "", true});
+}
+
+EventLoop::~EventLoop()
+{
+    for (auto& [fd, source] : sources) {
+        if (source.owned) close(fd);
+    }
+    close(epollFd);
+}
+
+void
+EventLoop::add(int fd, Source source)
+{
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = fd;
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) < 0) {
+        if (source.owned) close(fd);
+        throwSystemError("epoll_ctl");
+    }
+    sources[fd] = std::move(source);
+}
+
+void
+EventLoop::addTimer(std::chrono::nanoseconds interval, Callback callback, bool alignToInterval)
+{
+    int64_t period = interval.count();
+    if (period <= 0) {
+        throw std::runtime_error("EventLoop: timer interval must be positive");
+    }
+
+    int fd = timerfd_create(CLOCK_REALTIME, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (fd < 0) throwSystemError("timerfd_create");
+
+    // First expiry on the next multiple of the interval since the epoch
+    timespec now{};
+    clock_gettime(CLOCK_REALTIME, &now);
+    int64_t nowNs = now.tv_sec * NANOS_PER_SECOND + now.tv_nsec;
+    int64_t first = alignToInterval ? (nowNs / period + 1) * period : nowNs + period;
+
+    itimerspec spec{};
+    spec.it_value.tv_sec = first / NANOS_PER_SECOND;
+    spec.it_value.tv_nsec = first % NANOS_PER_SECOND;
+    spec.it_interval.tv_sec = period / NANOS_PER_SECOND;
+    spec.it_interval.tv_nsec = period % NANOS_PER_SECOND;
+    if (timerfd_settime(fd, TFD_TIMER_ABSTIME, &spec, nullptr) < 0) {
+        close(fd);
+        throwSystemError("timerfd_settime");
+    }
+
+    add(fd, {SourceType::TIMER, std::move(callback), "", true});
+}
+
+void
+EventLoop::addFileWatch(const std::string& directory, const std::string& namePrefix, Callback callback)
+{
+    int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd < 0) throwSystemError("inotify_init1");
+
+    if (inotify_add_watch(fd, directory.c_str(), IN_MODIFY | IN_CLOSE_WRITE | IN_CREATE | IN_MOVED_TO) < 0) {
+        close(fd);
+        throwSystemError("inotify_add_watch on " + directory);
+    }
+
+    add(fd, {SourceType::FILE_WATCH, std::move(callback), namePrefix, true});
+}
+
+void
+EventLoop::addSignal(int signal, Callback callback)
+{
+    // The signal has to be blocked for signalfd to see it
+    sigset_t mask;
+    sigemptyset(&mask);
+    sigaddset(&mask, signal);
+    if (sigprocmask(SIG_BLOCK, &mask, nullptr) < 0) throwSystemError("sigprocmask");
+
+    int fd = signalfd(-1, &mask, SFD_NONBLOCK | SFD_CLOEXEC);
+    if (fd < 0) throwSystemError("signalfd");
+
+    add(fd, {SourceType::SIGNAL, std::move(callback), "", true});
+}
+
+void
+EventLoop::addReader(int fd, Callback callback)
+{
+    add(fd, {SourceType::READER, std::move(callback), "", false});
+}
+
+bool
+EventLoop::drain(int fd, Source& source)
+{
+    switch (source.type) {
+        case SourceType::TIMER: {
+            uint64_t expirations;
+            return read(fd, &expirations, sizeof(expirations)) == sizeof(expirations);
+        }
+        case SourceType::WAKE: {
+            uint64_t count;
+            while (read(fd, &count, sizeof(count)) == sizeof(count)) {}
+            return false;
+        }
+        case SourceType::SIGNAL: {
+            signalfd_siginfo info;
+            bool any = false;
+            while (read(fd, &info, sizeof(info)) == sizeof(info)) any = true;
+            return any;
+        }
+        case SourceType::FILE_WATCH: {
+            // Only wake for the watched files, not everything in the directory
+            alignas(inotify_event) char buffer[4096];
+            bool matched = false;
+            ssize_t length;
+            while ((length = read(fd, buffer, sizeof(buffer))) > 0) {
+                for (char* p = buffer; p < buffer + length;) {
+                    const inotify_event* event = reinterpret_cast<const inotify_event*>(p);
+                    if (event->len > 0 && std::strncmp(event->name, source.namePrefix.c_str(), source.namePrefix.size()) == 0) {
+                        matched = true;
+                    }
+                    p += sizeof(inotify_event) + event->len;
+                }
+            }
+            return matched;
+        }
+        case SourceType::READER:
+            return true;
+    }
+    return false;
+}
+
+int
+EventLoop::runOnce(int timeoutMs)
+{
+    epoll_event events[EVENT_LOOP_MAX_EVENTS];
+    int ready = epoll_wait(epollFd, events, EVENT_LOOP_MAX_EVENTS, timeoutMs);
+    if (ready < 0) {
+        if (errno == EINTR) return 0;
+        throwSystemError("epoll_wait");
+    }
+
+    wakeTime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+
+    int handled = 0;
+    for (int i = 0; i < ready; i++) {
+        auto found = sources.find(events[i].data.fd);
+        if (found == sources.end()) continue;
+
+        Source& source = found->second;
+        if (drain(found->first, source) && source.callback) {
+            source.callback();
+            handled++;
+        }
+    }
+    return handled;
+}
+
+void
+EventLoop::run()
+{
+    while (!stopped.load(std::memory_order_acquire)) {
+        runOnce(-1);
+    }
+}
+
+void
+EventLoop::stop()
+{
+    stopped.store(true, std::memory_order_release);
+    uint64_t one = 1;
+    if (write(wakeFd, &one, sizeof(one)) < 0) {
+        // Already signalled, the counter is full
+    }
+}
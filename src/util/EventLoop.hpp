@@ -0,0 +1,82 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+
+#define EVENT_LOOP_MAX_EVENTS 16
+
+// Bar length in seconds for an interval such as "30s", "1m", "5m", "1h" or "1d"
+int64_t intervalToSeconds(const std::string& interval);
+
+/**
+ * EventLoop
+ *
+ * Single-threaded epoll loop over timers, file changes, signals and readable
+ * descriptors. Callbacks run on the thread calling run() or runOnce(), one
+ * per source per wake however many events the source had queued.
+ *
+ * Timers are timerfds on the realtime clock and can be aligned to their
+ * interval, so a one minute timer fires on each minute boundary rather than
+ * a minute after it was added. File watches use inotify on the parent
+ * directory, so a file that is created, replaced or appended to all count,
+ * matched on a file name prefix. getWakeTime() is when epoll returned for
+ * the events being handled, to measure how long a callback took to react.
+ *
+ * Linux only. Failing system calls throw std::runtime_error.
+ */
+class EventLoop
+{
+    public:
+        using Callback = std::function<void()>;
+
+        EventLoop();
+        ~EventLoop();
+
+        EventLoop(const EventLoop&) = delete;
+        EventLoop& operator=(const EventLoop&) = delete;
+
+        void addTimer(std::chrono::nanoseconds interval, Callback callback, bool alignToInterval = true);
+        void addFileWatch(const std::string& directory, const std::string& namePrefix, Callback callback);
+        void addSignal(int signal, Callback callback);
+        // The caller owns fd, the callback must read it until it would block
+        void addReader(int fd, Callback callback);
+
+        // Wait up to timeoutMs (-1 forever), returns the number of sources handled
+        int runOnce(int timeoutMs);
+        // Runs until stop(), runOnce() still works on a stopped loop
+        void run();
+        // Safe to call from any thread or a callback, including before run()
+        void stop();
+
+        bool isStopped() const { return stopped.load(std::memory_order_acquire); }
+        int64_t getWakeTime() const { return wakeTime; }
+
+    private:
+        enum class SourceType {
+            TIMER,
+            FILE_WATCH,
+            SIGNAL,
+            READER,
+            WAKE
+        };
+
+        struct Source {
+            SourceType type;
+            Callback callback;
+            std::string namePrefix;     // FILE_WATCH only
+            bool owned;                 // Close the fd on destruction
+        };
+
+        void add(int fd, Source source);
+        bool drain(int fd, Source& source);
+
+        int epollFd;
+        int wakeFd;
+        std::unordered_map<int, Source> sources;
+        std::atomic<bool> stopped;
+        int64_t wakeTime;
+};
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+/**
+ * IdIndex
+ *
+ * Open addressing hash index from an integer id to a uint32_t slot in some
+ * separately owned storage. Linear probing over a power-of-two table kept at
+ * most half full, with backward shift deletion so there are no tombstones and
+ * lookups stay short however many ids come and go.
+ */
+class IdIndex
+{
+    public:
+        static constexpr uint32_t NOT_FOUND = std::numeric_limits<uint32_t>::max();
+
+        explicit IdIndex(size_t initialCapacity = 16) : count(0)
+        {
+            size_t capacity = 16;
+            while (capacity < initialCapacity * 2) {
+                capacity <<= 1;
+            }
+            entries.assign(capacity, Entry{0, NOT_FOUND});
+        }
+
+        uint32_t find(int id) const
+        {
+            for (size_t i = home(id);; i = (i + 1) & mask()) {
+                const Entry& entry = entries[i];
+                if (entry.slot == NOT_FOUND) return NOT_FOUND;
+                if (entry.id == id) return entry.slot;
+            }
+        }
+
+        bool contains(int id) const { return find(id) != NOT_FOUND; }
+
+        // Inserts id, or repoints it if already present
+        void insert(int id, uint32_t slot)
+        {
+            if ((count + 1) * 2 > entries.size()) {
+                grow();
+            }
+
+            for (size_t i = home(id);; i = (i + 1) & mask()) {
+                Entry& entry = entries[i];
+                if (entry.slot == NOT_FOUND) {
+                    entry = Entry{id, slot};
+                    count++;
+                    return;
+                }
+                if (entry.id == id) {
+                    entry.slot = slot;
+                    return;
+                }
+            }
+        }
+
+        bool erase(int id)
+        {
+            size_t hole = home(id);
+            while (true) {
+                if (entries[hole].slot == NOT_FOUND) return false;
+                if (entries[hole].id == id) break;
+                hole = (hole + 1) & mask();
+            }
+
+            // Pull later members of the probe run back into the hole so every
+            // entry stays reachable from its home bucket
+            for (size_t next = (hole + 1) & mask(); entries[next].slot != NOT_FOUND; next = (next + 1) & mask()) {
+                size_t nextHome = home(entries[next].id);
+                bool movable = hole <= next ? (nextHome <= hole || nextHome > next)
+                                            : (nextHome <= hole && nextHome > next);
+                if (movable) {
+                    entries[hole] = entries[next];
+                    hole = next;
+                }
+            }
+
+            entries[hole].slot = NOT_FOUND;
+            count--;
+            return true;
+        }
+
+        void clear()
+        {
+            entries.assign(entries.size(), Entry{0, NOT_FOUND});
+            count = 0;
+        }
+
+        size_t size() const { return count; }
+
+    private:
+        struct Entry {
+            int id;
+            uint32_t slot;
+        };
+
+        size_t mask() const { return entries.size() - 1; }
+
+        // Fibonacci hashing spreads sequential ids across the table
+        size_t home(int id) const
+        {
+            return (static_cast<uint64_t>(static_cast<uint32_t>(id)) * 0x9E3779B97F4A7C15ull >> 32) & mask();
+        }
+
+        void grow()
+        {
+            std::vector<Entry> old;
+            old.swap(entries);
+            entries.assign(old.size() * 2, Entry{0, NOT_FOUND});
+            count = 0;
+            for (const Entry& entry : old) {
+                if (entry.slot != NOT_FOUND) {
+                    insert(entry.id, entry.slot);
+                }
+            }
+        }
+
+        std::vector<Entry> entries;
+        size_t count;
+};
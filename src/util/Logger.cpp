@@ -0,0 +1,258 @@
+#include "Logger.hpp"
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <pthread.h>
+#include <stdexcept>
+
+std::atomic<uint8_t> Logger::level_{static_cast<uint8_t>(LogLevel::INFO)};
+
+const char*
+logLevelToString(LogLevel level)
+{
+    switch (level) {
+        case LogLevel::DEBUG: return "DEBUG";
+        case LogLevel::INFO: return "INFO";
+        case LogLevel::WARN: return "WARN";
+        case LogLevel::ERROR: return "ERROR";
+        case LogLevel::OFF: return "OFF";
+    }
+    return "UNKNOWN";
+}
+
+LogLevel
+stringToLogLevel(const std::string& level)
+{
+    if (level == "debug" || level == "DEBUG") return LogLevel::DEBUG;
+    if (level == "info" || level == "INFO") return LogLevel::INFO;
+    if (level == "warn" || level == "WARN") return LogLevel::WARN;
+    if (level == "error" || level == "ERROR") return LogLevel::ERROR;
+    if (level == "off" || level == "OFF") return LogLevel::OFF;
+
+    throw std::runtime_error("Unknown log level: " + level);
+}
+
+Logger&
+Logger::get()
+{
+    static Logger logger;
+    return logger;
+}
+
+Logger::Logger()
+: output(&std::cout),
+  dropped(0),
+  reportedDropped(0),
+  running(true)
+{
+    writer = std::thread(&Logger::run, this);
+    pthread_atfork(&Logger::beforeFork, &Logger::afterFork, &Logger::afterFork);
+}
+
+void
+Logger::beforeFork()
+{
+    // Same order as drain()
+    Logger& logger = get();
+    logger.drainMutex.lock();
+    logger.queuesMutex.lock();
+}
+
+void
+Logger::afterFork()
+{
+    Logger& logger = get();
+    logger.queuesMutex.unlock();
+    logger.drainMutex.unlock();
+}
+
+Logger::~Logger()
+{
+    running.store(false, std::memory_order_release);
+    if (writer.joinable()) {
+        writer.join();
+    }
+    flush();
+}
+
+int64_t
+Logger::now()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+Logger::Queue&
+Logger::localQueue()
+{
+    // Each thread registers a queue on its first record. The logger keeps
+    // ownership so records queued just before a thread exits still get written.
+    struct Registration {
+        ThreadQueue* queue = nullptr;
+        ~Registration()
+        {
+            if (queue) queue->retired.store(true, std::memory_order_release);
+        }
+    };
+    thread_local Registration registration;
+
+    if (!registration.queue) {
+        auto queue = std::make_unique<ThreadQueue>();
+        registration.queue = queue.get();
+
+        std::lock_guard<std::mutex> lock(queuesMutex);
+        queues.push_back(std::move(queue));
+    }
+    return registration.queue->queue;
+}
+
+void
+Logger::run()
+{
+    while (running.load(std::memory_order_acquire)) {
+        if (!drain()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+}
+
+bool
+Logger::drain()
+{
+    std::lock_guard<std::mutex> drainLock(drainMutex);
+    std::lock_guard<std::mutex> queuesLock(queuesMutex);
+
+    bool wrote = false;
+    LogRecord record;
+    for (size_t i = 0; i < queues.size();) {
+        ThreadQueue& thread = *queues[i];
+        bool retired = thread.retired.load(std::memory_order_acquire);
+
+        while (thread.queue.tryPop(record)) {
+            write(record);
+            wrote = true;
+        }
+
+        // Retired threads can't push again, so once drained they can go
+        if (retired) {
+            queues[i] = std::move(queues.back());
+            queues.pop_back();
+        } else {
+            i++;
+        }
+    }
+
+    wrote |= reportDropped();
+
+    if (wrote) {
+        output->flush();
+    }
+    return wrote;
+}
+
+// Full queues drop records on the logging thread, say so in the log itself
+// each time the count has moved. Called with drainMutex held.
+bool
+Logger::reportDropped()
+{
+    uint64_t total = dropped.load(std::memory_order_relaxed);
+    if (total == reportedDropped) {
+        return false;
+    }
+
+    LogRecord record{};
+    record.level = LogLevel::WARN;
+    record.timestamp = now();
+    record.format = "{} log records dropped";
+    record.argCount = 1;
+    capture(record.args[0], total - reportedDropped);
+    write(record);
+
+    reportedDropped = total;
+    return true;
+}
+
+void
+Logger::flush()
+{
+    drain();
+}
+
+void
+Logger::setOutput(std::ostream& stream)
+{
+    flush();
+    std::lock_guard<std::mutex> lock(drainMutex);
+    output = &stream;
+}
+
+void
+Logger::write(const LogRecord& record)
+{
+    std::time_t seconds = static_cast<std::time_t>(record.timestamp / 1000000);
+    std::tm time{};
+    localtime_r(&seconds, &time);
+
+    char prefix[32];
+    std::snprintf(prefix, sizeof(prefix), "%02d:%02d:%02d.%06d %-5s ",
+                  time.tm_hour, time.tm_min, time.tm_sec,
+                  static_cast<int>(record.timestamp % 1000000), logLevelToString(record.level));
+
+    *output << prefix << format(record) << '\n';
+}
+
+std::string
+Logger::format(const LogRecord& record)
+{
+    std::string text;
+    size_t next = 0;
+    char buffer[64];
+
+    for (const char* c = record.format; *c; c++) {
+        if (c[0] != '{') {
+            text += *c;
+            continue;
+        }
+
+        // {} or {:.Nf}, anything else is written as it is
+        const char* close = std::strchr(c, '}');
+        if (!close) {
+            text += c;
+            break;
+        }
+        int precision = -1;
+        if (close != c + 1 && std::sscanf(c, "{:.%df}", &precision) != 1) {
+            text.append(c, close + 1);
+            c = close;
+            continue;
+        }
+        c = close;
+
+        if (next >= record.argCount) {
+            text += "{}";
+            continue;
+        }
+
+        const LogArg& arg = record.args[next++];
+        switch (arg.type) {
+            case LogArg::Type::INT:
+                std::snprintf(buffer, sizeof(buffer), "%lld", static_cast<long long>(arg.i));
+                break;
+            case LogArg::Type::UINT:
+                std::snprintf(buffer, sizeof(buffer), "%llu", static_cast<unsigned long long>(arg.u));
+                break;
+            case LogArg::Type::DOUBLE:
+                if (precision >= 0) {
+                    std::snprintf(buffer, sizeof(buffer), "%.*f", precision, arg.d);
+                } else {
+                    std::snprintf(buffer, sizeof(buffer), "%g", arg.d);
+                }
+                break;
+            case LogArg::Type::STRING:
+                text += arg.s;
+                continue;
+        }
+        text += buffer;
+    }
+    return text;
+}
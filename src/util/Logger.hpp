@@ -0,0 +1,204 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "SpscQueue.hpp"
+
+#define LOG_QUEUE_SIZE 1024         // Records buffered per logging thread
+#define LOG_MAX_ARGS 8
+#define LOG_STRING_ARG_SIZE 24      // Longer string arguments are truncated
+
+// Levels below this are compiled out, e.g. -DLOG_COMPILE_LEVEL=1 drops DEBUG
+#ifndef LOG_COMPILE_LEVEL
+#define LOG_COMPILE_LEVEL 0
+#endif
+
+enum class LogLevel : uint8_t {
+    DEBUG,
+    INFO,
+    WARN,
+    ERROR,
+    OFF
+};
+
+const char* logLevelToString(LogLevel level);
+LogLevel stringToLogLevel(const std::string& level);
+
+/**
+ * One captured argument. Numbers are kept as they are and strings are copied,
+ * formatting waits for the writer thread.
+ */
+struct LogArg {
+    enum class Type : uint8_t { INT, UINT, DOUBLE, STRING };
+
+    Type type;
+    union {
+        int64_t i;
+        uint64_t u;
+        double d;
+        char s[LOG_STRING_ARG_SIZE];
+    };
+};
+
+struct LogRecord {
+    LogLevel level;
+    uint8_t argCount;
+    int64_t timestamp;      // System clock microseconds
+    const char* format;     // Must be a string literal
+    LogArg args[LOG_MAX_ARGS];
+};
+
+/**
+ * Logger
+ *
+ * Asynchronous, levelled logging. A call below the compile-time level is
+ * removed, a call below the runtime level costs one relaxed load, and an
+ * enabled call copies its format string pointer and arguments into a
+ * lock-free ring owned by the calling thread. A background writer drains
+ * every ring, formats and writes, so the thread that logs never formats or
+ * touches the stream. If a ring is full the record is dropped and counted.
+ *
+ * Formats use {} for each argument, with {:.Nf} for fixed precision.
+ *
+ *   LOG_INFO("Filled {} {} at ${:.2f}", quantity, ticker, price);
+ *
+ * flush() writes everything queued so far, call it before writing to the
+ * same stream directly.
+ *
+ * The logger's locks are held across fork(), so a child never inherits
+ * them locked. The writer thread does not survive into the child, which
+ * writes its records with flush() and should leave with _exit().
+ */
+class Logger
+{
+    public:
+        static Logger& get();
+
+        static constexpr bool isCompiledIn(LogLevel level)
+        {
+            return static_cast<uint8_t>(level) >= COMPILE_LEVEL;
+        }
+        static bool isEnabled(LogLevel level)
+        {
+            return static_cast<uint8_t>(level) >= level_.load(std::memory_order_relaxed);
+        }
+        static void setLevel(LogLevel level) { level_.store(static_cast<uint8_t>(level), std::memory_order_relaxed); }
+        static LogLevel getLevel() { return static_cast<LogLevel>(level_.load(std::memory_order_relaxed)); }
+
+        template <typename... Args>
+        void log(LogLevel level, const char* format, const Args&... args)
+        {
+            static_assert(sizeof...(Args) <= LOG_MAX_ARGS, "Too many log arguments");
+
+            LogRecord record;
+            record.level = level;
+            record.argCount = sizeof...(Args);
+            record.timestamp = now();
+            record.format = format;
+
+            [[maybe_unused]] size_t index = 0;
+            (capture(record.args[index++], args), ...);
+
+            if (!localQueue().tryPush(record)) {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        void flush();
+        void setOutput(std::ostream& stream);
+        uint64_t getDroppedCount() const { return dropped.load(std::memory_order_relaxed); }
+
+        // Formats a record as the writer would, without the level and time prefix
+        static std::string format(const LogRecord& record);
+
+        ~Logger();
+
+    private:
+        using Queue = SpscQueue<LogRecord, LOG_QUEUE_SIZE>;
+
+        static constexpr uint8_t COMPILE_LEVEL = LOG_COMPILE_LEVEL;
+
+        struct ThreadQueue {
+            Queue queue;
+            std::atomic<bool> retired{false};
+        };
+
+        Logger();
+        Logger(const Logger&) = delete;
+        Logger& operator=(const Logger&) = delete;
+
+        Queue& localQueue();
+        static void beforeFork();
+        static void afterFork();
+        void run();
+        bool drain();
+        bool reportDropped();
+        void write(const LogRecord& record);
+        static int64_t now();
+
+        template <typename T>
+        static void capture(LogArg& arg, const T& value)
+        {
+            if constexpr (std::is_same_v<T, bool>) {
+                captureString(arg, value ? "true" : "false");
+            } else if constexpr (std::is_enum_v<T>) {
+                arg.type = LogArg::Type::INT;
+                arg.i = static_cast<int64_t>(value);
+            } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+                arg.type = LogArg::Type::INT;
+                arg.i = value;
+            } else if constexpr (std::is_integral_v<T>) {
+                arg.type = LogArg::Type::UINT;
+                arg.u = value;
+            } else if constexpr (std::is_floating_point_v<T>) {
+                arg.type = LogArg::Type::DOUBLE;
+                arg.d = value;
+            } else {
+                captureString(arg, std::string_view(value));
+            }
+        }
+
+        static void captureString(LogArg& arg, std::string_view value)
+        {
+            size_t length = std::min(value.size(), sizeof(arg.s) - 1);
+            arg.type = LogArg::Type::STRING;
+            std::memcpy(arg.s, value.data(), length);
+            arg.s[length] = '\0';
+        }
+
+        static std::atomic<uint8_t> level_;
+
+        std::mutex queuesMutex;     // Registering threads
+        std::vector<std::unique_ptr<ThreadQueue>> queues;
+        std::mutex drainMutex;      // Only one consumer drains at a time
+        std::ostream* output;
+        std::atomic<uint64_t> dropped;
+        uint64_t reportedDropped;   // Under drainMutex, dropped as of the last report
+        std::atomic<bool> running;
+        std::thread writer;
+};
+
+#define LOG_AT(level, ...)                                              \
+    do {                                                                \
+        if constexpr (Logger::isCompiledIn(level)) {                    \
+            if (Logger::isEnabled(level)) {                             \
+                Logger::get().log(level, __VA_ARGS__);                  \
+            }                                                           \
+        }                                                               \
+    } while (0)
+
+#define LOG_DEBUG(...) LOG_AT(LogLevel::DEBUG, __VA_ARGS__)
+#define LOG_INFO(...) LOG_AT(LogLevel::INFO, __VA_ARGS__)
+#define LOG_WARN(...) LOG_AT(LogLevel::WARN, __VA_ARGS__)
+#define LOG_ERROR(...) LOG_AT(LogLevel::ERROR, __VA_ARGS__)
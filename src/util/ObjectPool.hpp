@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+/**
+ * ObjectPool
+ *
+ * Arena of fixed-size objects handed out by 32-bit handle. Storage grows in
+ * chunks that never move, so references stay valid until the handle is
+ * released, and released slots go on a free list to be reused. Once the pool
+ * has grown to its working size, acquire and release don't touch the heap.
+ */
+template <typename T>
+class ObjectPool
+{
+    public:
+        using Handle = uint32_t;
+        static constexpr Handle INVALID = std::numeric_limits<uint32_t>::max();
+
+        explicit ObjectPool(size_t initialCapacity = 0) : live(0)
+        {
+            reserve(initialCapacity);
+        }
+
+        Handle acquire(const T& value)
+        {
+            if (freeList.empty()) {
+                addChunk();
+            }
+
+            Handle handle = freeList.back();
+            freeList.pop_back();
+            (*this)[handle] = value;
+            live++;
+            return handle;
+        }
+
+        void release(Handle handle)
+        {
+            freeList.push_back(handle);
+            live--;
+        }
+
+        T& operator[](Handle handle) { return chunks[handle >> CHUNK_SHIFT][handle & CHUNK_MASK]; }
+        const T& operator[](Handle handle) const { return chunks[handle >> CHUNK_SHIFT][handle & CHUNK_MASK]; }
+
+        void reserve(size_t capacity)
+        {
+            while (getCapacity() < capacity) {
+                addChunk();
+            }
+        }
+
+        // Releases every handle, keeps the storage
+        void clear()
+        {
+            freeList.clear();
+            for (size_t handle = getCapacity(); handle-- > 0;) {
+                freeList.push_back(static_cast<Handle>(handle));
+            }
+            live = 0;
+        }
+
+        size_t size() const { return live; }
+        size_t getCapacity() const { return chunks.size() * CHUNK_SIZE; }
+
+    private:
+        static constexpr size_t CHUNK_SHIFT = 8;
+        static constexpr size_t CHUNK_SIZE = size_t(1) << CHUNK_SHIFT;
+        static constexpr size_t CHUNK_MASK = CHUNK_SIZE - 1;
+
+        void addChunk()
+        {
+            Handle first = static_cast<Handle>(getCapacity());
+            chunks.push_back(std::make_unique<T[]>(CHUNK_SIZE));
+
+            // The free list can hold every slot, so release never allocates.
+            // Lowest handles go out first.
+            freeList.reserve(getCapacity());
+            for (size_t i = CHUNK_SIZE; i-- > 0;) {
+                freeList.push_back(first + static_cast<Handle>(i));
+            }
+        }
+
+        std::vector<std::unique_ptr<T[]>> chunks;
+        std::vector<Handle> freeList;
+        size_t live;
+};
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+/**
+ * SpscQueue
+ *
+ * Bounded, lock-free single-producer / single-consumer ring buffer.
+ * One thread may call tryPush, one (other) thread may call tryPop.
+ * Capacity must be a power of two. The indices count up freely and are
+ * masked on access, so no slot is kept free and all Capacity slots hold
+ * items. Neither side blocks: tryPush returns false when the queue is full
+ * and tryPop returns false when it is empty, and callers decide what to do.
+ */
+template <typename T, size_t Capacity>
+class SpscQueue
+{
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+                  "SpscQueue capacity must be a power of two");
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "SpscQueue only holds trivially copyable items");
+
+    public:
+        SpscQueue() : head(0), tail(0) {}
+
+        SpscQueue(const SpscQueue&) = delete;
+        SpscQueue& operator=(const SpscQueue&) = delete;
+
+        // Producer side. Returns false if the queue is full.
+        bool tryPush(const T& item)
+        {
+            size_t currentTail = tail.load(std::memory_order_relaxed);
+            if (currentTail - head.load(std::memory_order_acquire) == Capacity) {
+                return false;
+            }
+
+            slots[currentTail & MASK] = item;
+            tail.store(currentTail + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Consumer side. Returns false if the queue is empty.
+        bool tryPop(T& item)
+        {
+            size_t currentHead = head.load(std::memory_order_relaxed);
+            if (currentHead == tail.load(std::memory_order_acquire)) {
+                return false;
+            }
+
+            item = slots[currentHead & MASK];
+            head.store(currentHead + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Approximate when called concurrently with push/pop
+        size_t size() const
+        {
+            return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+        }
+
+        bool empty() const { return size() == 0; }
+        static constexpr size_t capacity() { return Capacity; }
+
+    private:
+        static constexpr size_t MASK = Capacity - 1;
+
+        // Keep the indices on separate cache lines to avoid false sharing
+        alignas(64) std::atomic<size_t> head;
+        alignas(64) std::atomic<size_t> tail;
+        alignas(64) std::array<T, Capacity> slots;
+};
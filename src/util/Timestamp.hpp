@@ -0,0 +1,212 @@
+#pragma once
+
+#include <charconv>
+#include <compare>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+
+#define NANOS_PER_SECOND 1000000000LL
+#define SECONDS_PER_DAY 86400LL
+
+/**
+ * Timestamp
+ *
+ * A point in time as int64 nanoseconds since the Unix epoch, UTC. Bars carry
+ * one parsed from their DateTime string when they are read, and sorting,
+ * range filtering and de-duplicating compare these rather than strings.
+ *
+ * parse() reads the fixed "YYYY-MM-DD HH:MM:SS" layout (a 'T' separator and
+ * a bare "YYYY-MM-DD" are also accepted) without sscanf, locale or time zone
+ * lookups. Every character is checked and the failures are OR-ed together,
+ * so there is no branch per field. Text off that layout, such as unpadded
+ * "2025-3-1" or "2025-03-32", goes through a slower field by field read
+ * that normalises out of range fields the way timegm does. Anything else
+ * gives an invalid Timestamp, which sorts before every valid one.
+ *
+ * format() writes the same layout back, for output only.
+ */
+class Timestamp
+{
+    public:
+        constexpr Timestamp() : ns(INVALID) {}
+
+        static constexpr Timestamp fromNanos(int64_t nanos) { return Timestamp(nanos); }
+        static constexpr Timestamp fromSeconds(int64_t seconds) { return Timestamp(seconds * NANOS_PER_SECOND); }
+
+        static Timestamp parse(std::string_view text)
+        {
+            if (text.size() != DATE_LENGTH && text.size() != DATE_TIME_LENGTH) {
+                return parseLoose(text);
+            }
+
+            // A date only string leaves midnight from the padding
+            char c[DATE_TIME_LENGTH] = {'0', '0', '0', '0', '-', '0', '0', '-', '0', '0',
+                                        ' ', '0', '0', ':', '0', '0', ':', '0', '0'};
+            for (size_t i = 0; i < text.size(); i++) {
+                c[i] = text[i];
+            }
+
+            unsigned bad = 0;
+            auto digit = [&](size_t i) {
+                unsigned value = static_cast<unsigned char>(c[i]) - '0';
+                bad |= value > 9;
+                return static_cast<int>(value);
+            };
+            auto pair = [&](size_t i) { return digit(i) * 10 + digit(i + 1); };
+
+            int year = pair(0) * 100 + pair(2);
+            int month = pair(5);
+            int day = pair(8);
+            int hour = pair(11);
+            int minute = pair(14);
+            int second = pair(17);
+
+            bad |= (c[4] != '-') | (c[7] != '-') | (c[13] != ':') | (c[16] != ':');
+            bad |= (c[10] != ' ') & (c[10] != 'T');
+            bad |= static_cast<unsigned>(month - 1) > 11;
+            bad |= static_cast<unsigned>(day - 1) > 30;
+            bad |= static_cast<unsigned>(hour) > 23;
+            bad |= static_cast<unsigned>(minute) > 59;
+            bad |= static_cast<unsigned>(second) > 60;      // Leap second
+
+            if (bad) return parseLoose(text);
+            return fromCivil(year, month, day, hour, minute, second);
+        }
+
+        constexpr int64_t nanos() const { return ns; }
+        constexpr int64_t seconds() const { return floorDiv(ns, NANOS_PER_SECOND); }
+        constexpr bool isValid() const { return ns != INVALID; }
+
+        // Midnight at the start of this timestamp's day
+        constexpr Timestamp startOfDay() const
+        {
+            return isValid() ? fromSeconds(floorDiv(seconds(), SECONDS_PER_DAY) * SECONDS_PER_DAY) : *this;
+        }
+
+        constexpr Timestamp plusDays(int64_t days) const
+        {
+            return isValid() ? Timestamp(ns + days * SECONDS_PER_DAY * NANOS_PER_SECOND) : *this;
+        }
+
+        constexpr auto operator<=>(const Timestamp&) const = default;
+
+        // "YYYY-MM-DD HH:MM:SS", empty if invalid
+        std::string format() const
+        {
+            if (!isValid()) return "";
+
+            std::string text(DATE_TIME_LENGTH, ' ');
+            int64_t secs = seconds();
+            int64_t days = floorDiv(secs, SECONDS_PER_DAY);
+            int64_t timeOfDay = secs - days * SECONDS_PER_DAY;
+
+            writeDate(text.data(), days);
+            writePair(text.data() + 11, static_cast<int>(timeOfDay / 3600));
+            text[13] = ':';
+            writePair(text.data() + 14, static_cast<int>(timeOfDay / 60 % 60));
+            text[16] = ':';
+            writePair(text.data() + 17, static_cast<int>(timeOfDay % 60));
+            return text;
+        }
+
+        // "YYYY-MM-DD", empty if invalid
+        std::string formatDate() const
+        {
+            if (!isValid()) return "";
+
+            std::string text(DATE_LENGTH, ' ');
+            writeDate(text.data(), floorDiv(seconds(), SECONDS_PER_DAY));
+            return text;
+        }
+
+    private:
+        static constexpr int64_t INVALID = std::numeric_limits<int64_t>::min();
+        static constexpr size_t DATE_LENGTH = 10;
+        static constexpr size_t DATE_TIME_LENGTH = 19;
+
+        constexpr explicit Timestamp(int64_t nanos) : ns(nanos) {}
+
+        static constexpr Timestamp fromCivil(int year, int month, int day, int hour, int minute, int second)
+        {
+            return fromSeconds(daysFromCivil(year, month, day) * SECONDS_PER_DAY
+                               + hour * 3600 + minute * 60 + second);
+        }
+
+        // "Y-M-D[ H:M:S]" with any number of digits per field and any values
+        static Timestamp parseLoose(std::string_view text)
+        {
+            const char* next = text.data();
+            const char* end = text.data() + text.size();
+            auto field = [&](int& value, const char* separators) {
+                auto [stop, error] = std::from_chars(next, end, value);
+                if (error != std::errc() || stop == next) return false;
+                next = stop;
+                if (*separators == '\0') return true;
+                if (next == end || std::string_view(separators).find(*next) == std::string_view::npos) return false;
+                next++;
+                return true;
+            };
+
+            int year = 0, month = 0, day = 0, hour = 0, minute = 0, second = 0;
+            if (!field(year, "-") || !field(month, "-")) return Timestamp();
+            bool dateOnly = std::string_view(next, end).find_first_of(" T") == std::string_view::npos;
+            if (!field(day, dateOnly ? "" : " T")) return Timestamp();
+            if (!dateOnly && (!field(hour, ":") || !field(minute, ":") || !field(second, ""))) return Timestamp();
+            if (next != end) return Timestamp();
+
+            // Day, hour, minute and second carry over on their own, months need the year moved
+            int monthIndex = month - 1;
+            year += monthIndex / 12 - (monthIndex % 12 < 0);
+            month = (monthIndex % 12 + 12) % 12 + 1;
+            return fromCivil(year, month, day, hour, minute, second);
+        }
+
+        static constexpr int64_t floorDiv(int64_t value, int64_t divisor)
+        {
+            int64_t quotient = value / divisor;
+            return quotient - ((value % divisor) < 0);
+        }
+
+        // Days since 1970-01-01 in the proleptic Gregorian calendar, after
+        // Howard Hinnant's days_from_civil
+        static constexpr int64_t daysFromCivil(int year, int month, int day)
+        {
+            year -= month <= 2;
+            int64_t era = (year >= 0 ? year : year - 399) / 400;
+            int64_t yearOfEra = year - era * 400;
+            int64_t dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+            int64_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+            return era * 146097 + dayOfEra - 719468;
+        }
+
+        // The inverse, civil_from_days, written as "YYYY-MM-DD"
+        static void writeDate(char* out, int64_t days)
+        {
+            days += 719468;
+            int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+            int64_t dayOfEra = days - era * 146097;
+            int64_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+            int64_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+            int64_t monthIndex = (5 * dayOfYear + 2) / 153;
+            int day = static_cast<int>(dayOfYear - (153 * monthIndex + 2) / 5 + 1);
+            int month = static_cast<int>(monthIndex < 10 ? monthIndex + 3 : monthIndex - 9);
+            int year = static_cast<int>(yearOfEra + era * 400 + (month <= 2));
+
+            writePair(out, year / 100 % 100);
+            writePair(out + 2, year % 100);
+            out[4] = '-';
+            writePair(out + 5, month);
+            out[7] = '-';
+            writePair(out + 8, day);
+        }
+
+        static void writePair(char* out, int value)
+        {
+            out[0] = static_cast<char>('0' + value / 10);
+            out[1] = static_cast<char>('0' + value % 10);
+        }
+
+        int64_t ns;
+};
@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include "../../src/backtest/BacktestFarm.hpp"
+
+// Oscillating one minute bars, enough swings for RSI to trade
+static std::vector<MarketCondition>
+makeBars(const std::string& ticker, int count, float base)
+{
+    std::vector<MarketCondition> bars;
+    char dateTime[32];
+    float previous = base;
+    for (int i = 0; i < count; i++) {
+        std::snprintf(dateTime, sizeof(dateTime), "2025-01-02 %02d:%02d:00", 9 + (30 + i) / 60 % 24, (30 + i) % 60);
+        float close = base + 5.0f * std::sin(i / 6.0f) + 0.02f * i;
+        bars.push_back(MarketCondition(dateTime, ticker, previous, close, 1000 + i, "1m"));
+        previous = close;
+    }
+    return bars;
+}
+
+static json
+rsiJob(int period, const std::string& ticker = "")
+{
+    json job = {{"strategies", {{{"name", "RSI"}, {"active", 1}, {"period", period},
+                                 {"overbought_threshold", 70.0}, {"oversold_threshold", 30.0},
+                                 {"stop_loss", 10}, {"take_profit", 10}}}}};
+    if (!ticker.empty()) {
+        job["ticker"] = ticker;
+    }
+    return job;
+}
+
+class BacktestFarmTests : public ::testing::Test
+{
+    public:
+        Config config;
+        json baseConfig;
+
+        void SetUp() override
+        {
+            config.loadJson(config.getTestPath("strategy_tests/test_data/config_test.json"));
+            baseConfig = config.getJson();
+            baseConfig["ticker"] = "NVDA";
+        }
+
+        BacktestFarm makeFarm()
+        {
+            BacktestFarm farm(baseConfig);
+            farm.addDataset("NVDA", makeBars("NVDA", 240, 100.0f));
+            farm.addDataset("AAPL", makeBars("AAPL", 180, 50.0f));
+            return farm;
+        }
+};
+
+TEST_F(BacktestFarmTests, ResultsComeBackInJobOrder)
+{
+    BacktestFarm farm = makeFarm();
+    farm.setWorkers(2);
+    std::vector<json> jobs = {rsiJob(7), rsiJob(14), rsiJob(7, "AAPL"), rsiJob(21, "AAPL")};
+
+    std::vector<FarmResult> results = farm.run(jobs);
+
+    ASSERT_EQ(results.size(), jobs.size());
+    for (size_t i = 0; i < results.size(); i++) {
+        EXPECT_EQ(results[i].jobIndex, static_cast<int>(i));
+        EXPECT_EQ(results[i].failed, 0);
+        EXPECT_GT(results[i].finalEquity, 0.0);
+    }
+    EXPECT_GT(results[0].numTrades, 0);
+    EXPECT_EQ(results[0].barCount, 240);
+    EXPECT_EQ(results[2].barCount, 180);
+}
+
+TEST_F(BacktestFarmTests, JobResultDoesNotDependOnTheWorker)
+{
+    std::vector<json> jobs = {rsiJob(7), rsiJob(14), rsiJob(7, "AAPL")};
+
+    BacktestFarm single = makeFarm();
+    single.setWorkers(1);
+    std::vector<FarmResult> serial = single.run(jobs);
+
+    BacktestFarm spread = makeFarm();
+    spread.setWorkers(3);
+    std::vector<FarmResult> parallel = spread.run(jobs);
+
+    ASSERT_EQ(serial.size(), parallel.size());
+    for (size_t i = 0; i < serial.size(); i++) {
+        EXPECT_EQ(serial[i].numTrades, parallel[i].numTrades);
+        EXPECT_DOUBLE_EQ(serial[i].finalEquity, parallel[i].finalEquity);
+    }
+}
+
+TEST_F(BacktestFarmTests, ConfigureIsAppliedToEveryJob)
+{
+    BacktestFarm farm = makeFarm();
+    farm.setWorkers(2);
+    farm.setConfigure([](Backtester& backtester) { backtester.setStartingCapital(5000.0); });
+
+    std::vector<FarmResult> results = farm.run({rsiJob(7), rsiJob(14)});
+    for (const FarmResult& result : results) {
+        EXPECT_EQ(result.failed, 0);
+        EXPECT_NEAR(result.finalEquity - result.totalPnL, 5000.0, 1e-6);
+    }
+}
+
+TEST_F(BacktestFarmTests, FailedJobDoesNotStopTheOthers)
+{
+    BacktestFarm farm = makeFarm();
+    farm.addDataset("EMPTY", {});
+    farm.setWorkers(2);
+
+    std::vector<FarmResult> results = farm.run({rsiJob(7), rsiJob(7, "EMPTY"), rsiJob(14)});
+    EXPECT_EQ(results[0].failed, 0);
+    EXPECT_EQ(results[1].failed, 1);
+    EXPECT_EQ(results[2].failed, 0);
+
+    // The reason comes back from the worker
+    EXPECT_STREQ(results[1].error, "no bars for EMPTY");
+    EXPECT_STREQ(results[0].error, "");
+}
+
+TEST_F(BacktestFarmTests, UnknownTickerThrows)
+{
+    BacktestFarm farm = makeFarm();
+    EXPECT_THROW(farm.run({rsiJob(7, "MSFT")}), std::runtime_error);
+}
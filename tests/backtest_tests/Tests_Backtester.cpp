@@ -253,7 +253,7 @@ TEST_F(BacktesterTests, DISABLED_CommissionAffectsTradingPerformance) {
     // Run with low commission
     createBacktesterWithSettings(100000.0, 1.0);
     backtester->run();
-    const PerformanceMetrics& lowCommMetrics = backtester->getPerformanceMetrics();
+    PerformanceMetrics lowCommMetrics = backtester->getPerformanceMetrics();
     
     // Run with high commission
     createBacktesterWithSettings(100000.0, 100.0); // Much higher commission
@@ -268,7 +268,7 @@ TEST_F(BacktesterTests, SlippageAffectsTradingPerformance) {
     // Run with low slippage
     createBacktesterWithSettings(100000.0, 1.0, 0.0001);
     backtester->run();
-    const PerformanceMetrics& lowSlippageMetrics = backtester->getPerformanceMetrics();
+    PerformanceMetrics lowSlippageMetrics = backtester->getPerformanceMetrics();
     
     // Run with high slippage
     createBacktesterWithSettings(100000.0, 1.0, 0.01); // 1% slippage
@@ -286,7 +286,7 @@ TEST_F(BacktesterTests, DISABLED_CapitalLevelAffectsAbsolutePnLButNotPercentage)
     // Run with low capital
     createBacktesterWithSettings(10000.0);
     backtester->run();
-    const PerformanceMetrics& lowCapitalMetrics = backtester->getPerformanceMetrics();
+    PerformanceMetrics lowCapitalMetrics = backtester->getPerformanceMetrics();
     
     // Run with high capital
     createBacktesterWithSettings(100000.0);
@@ -314,7 +314,7 @@ TEST_F(BacktesterTests, ExecutionTimeTracking) {
 TEST_F(BacktesterTests, DISABLED_MultipleRunsProduceConsistentResults) {
     createBacktesterWithSettings();
     backtester->run();
-    const PerformanceMetrics& firstRunMetrics = backtester->getPerformanceMetrics();
+    PerformanceMetrics firstRunMetrics = backtester->getPerformanceMetrics();
     
     // Create a new backtester with the same settings
     createBacktesterWithSettings();
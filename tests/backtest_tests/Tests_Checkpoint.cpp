@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <filesystem>
+#include "../../src/backtest/Backtester.hpp"
+
+namespace fs = std::filesystem;
+
+#define CHECKPOINT_TEST_BARS 300
+#define CHECKPOINT_TEST_INTERVAL 150
+
+class CheckpointTests : public ::testing::Test
+{
+    public:
+        fs::path checkpoint;
+        Config config;
+        json baseConfig;
+
+        void SetUp() override
+        {
+            checkpoint = fs::temp_directory_path() / ("checkpoint_" + std::string(::testing::UnitTest::GetInstance()->current_test_info()->name()) + ".ckpt");
+            fs::remove(checkpoint);
+            config.loadJson(config.getTestPath("strategy_tests/test_data/config_test.json"));
+            baseConfig = config.getJson();
+        }
+
+        void TearDown() override
+        {
+            fs::remove(checkpoint);
+        }
+
+        std::vector<MarketCondition> makeBars(int count)
+        {
+            std::vector<MarketCondition> bars;
+            char dateTime[32];
+            for (int i = 0; i < count; i++) {
+                std::snprintf(dateTime, sizeof(dateTime), "2025-01-02 %02d:%02d:00", 9 + (30 + i) / 60, (30 + i) % 60);
+                float close = 100.0f + 5.0f * std::sin(i / 6.0f) + 0.02f * i;
+                bars.push_back(MarketCondition(dateTime, "NVDA", close, close, 1000 + i, "1m"));
+            }
+            return bars;
+        }
+
+        std::unique_ptr<Backtester> makeBacktester(int bars = CHECKPOINT_TEST_BARS)
+        {
+            auto backtester = std::make_unique<Backtester>(baseConfig);
+            backtester->setRandomSeed(7);
+            std::vector<MarketCondition> data = makeBars(bars);
+            backtester->setMarketData(data);
+            return backtester;
+        }
+
+        // Runs the whole way, leaving a checkpoint from halfway through
+        std::unique_ptr<Backtester> runWithCheckpoint()
+        {
+            auto backtester = makeBacktester();
+            backtester->setCheckpointFile(checkpoint.string(), CHECKPOINT_TEST_INTERVAL);
+            backtester->run();
+            return backtester;
+        }
+};
+
+TEST_F(CheckpointTests, CheckpointingDoesNotChangeTheResult)
+{
+    auto reference = makeBacktester();
+    reference->run();
+
+    auto checkpointed = runWithCheckpoint();
+    EXPECT_EQ(checkpointed->getCheckpointsWritten(), 1);
+    EXPECT_TRUE(fs::exists(checkpoint));
+    EXPECT_DOUBLE_EQ(checkpointed->getPerformanceMetrics().finalEquity, reference->getPerformanceMetrics().finalEquity);
+    EXPECT_EQ(checkpointed->getPerformanceMetrics().numTrades, reference->getPerformanceMetrics().numTrades);
+}
+
+TEST_F(CheckpointTests, ResumedRunMatchesUninterruptedRun)
+{
+    auto reference = runWithCheckpoint();
+    const PerformanceMetrics& expected = reference->getPerformanceMetrics();
+    ASSERT_GT(expected.numTrades, 0);
+
+    auto resumed = makeBacktester();
+    resumed->resumeFrom(checkpoint.string());
+    resumed->run();
+    const PerformanceMetrics& actual = resumed->getPerformanceMetrics();
+
+    EXPECT_DOUBLE_EQ(actual.startingCapital, expected.startingCapital);
+    EXPECT_DOUBLE_EQ(actual.finalEquity, expected.finalEquity);
+    EXPECT_EQ(actual.numTrades, expected.numTrades);
+    EXPECT_EQ(actual.winningTrades, expected.winningTrades);
+    EXPECT_DOUBLE_EQ(actual.sharpeRatio, expected.sharpeRatio);
+    EXPECT_DOUBLE_EQ(actual.maxDrawdownPercent, expected.maxDrawdownPercent);
+    EXPECT_DOUBLE_EQ(actual.turnover, expected.turnover);
+    ASSERT_EQ(resumed->getEquityCurve().size(), reference->getEquityCurve().size());
+    EXPECT_EQ(resumed->getEquityCurve().back(), reference->getEquityCurve().back());
+}
+
+TEST_F(CheckpointTests, WhatIfBranchKeepsTheWarmUp)
+{
+    auto reference = runWithCheckpoint();
+
+    auto branch = makeBacktester();
+    branch->setCommissionPerTrade(5.0);
+    branch->resumeFrom(checkpoint.string());
+    branch->run();
+
+    // Identical up to the checkpoint, its own path after it
+    const auto& expected = reference->getEquityCurve();
+    const auto& actual = branch->getEquityCurve();
+    ASSERT_EQ(actual.size(), expected.size());
+    EXPECT_EQ(actual[CHECKPOINT_TEST_INTERVAL], expected[CHECKPOINT_TEST_INTERVAL]);
+    EXPECT_NE(actual.back().second, expected.back().second);
+}
+
+TEST_F(CheckpointTests, DifferentDataIsRejected)
+{
+    runWithCheckpoint();
+
+    auto resumed = makeBacktester(CHECKPOINT_TEST_BARS - 1);
+    resumed->resumeFrom(checkpoint.string());
+    EXPECT_THROW(resumed->run(), std::runtime_error);
+}
+
+TEST_F(CheckpointTests, TruncatedCheckpointIsRejected)
+{
+    runWithCheckpoint();
+    fs::resize_file(checkpoint, fs::file_size(checkpoint) - 16);
+
+    auto resumed = makeBacktester();
+    resumed->resumeFrom(checkpoint.string());
+    EXPECT_THROW(resumed->run(), std::runtime_error);
+}
@@ -225,7 +225,7 @@ TEST_F(BacktestIntegrationTests, DISABLED_CommissionImpactOnBacktestResults) {
     createBacktester();
     
     backtester->run();
-    const PerformanceMetrics& lowCommMetrics = backtester->getPerformanceMetrics();
+    PerformanceMetrics lowCommMetrics = backtester->getPerformanceMetrics();
     
     createBroker();
     broker->setCommission(20.0);
@@ -246,7 +246,7 @@ TEST_F(BacktestIntegrationTests, SlippageImpactOnBacktestResults) {
     createBacktester();
     
     backtester->run();
-    const PerformanceMetrics& lowSlippageMetrics = backtester->getPerformanceMetrics();
+    PerformanceMetrics lowSlippageMetrics = backtester->getPerformanceMetrics();
     
     createBroker();
     broker->setSlippage(0.01);
@@ -269,7 +269,7 @@ TEST_F(BacktestIntegrationTests, DISABLED_StartingCapitalImpactOnBacktestResults
     createBacktester();
     
     backtester->run();
-    const PerformanceMetrics& lowCapitalMetrics = backtester->getPerformanceMetrics();
+    PerformanceMetrics lowCapitalMetrics = backtester->getPerformanceMetrics();
     
     createBroker();
     broker->setStartingCapital(1000000.0); // $1,000,000
@@ -307,7 +307,7 @@ TEST_F(BacktestIntegrationTests, DISABLED_LongTermVsShortTermBacktesting) {
     createBacktester();
     
     backtester->run();
-    const PerformanceMetrics& shortTermMetrics = backtester->getPerformanceMetrics();
+    PerformanceMetrics shortTermMetrics = backtester->getPerformanceMetrics();
     
     auto longTermData = TestMarketDataProvider::createTrendingMarketData(60);
     mockAdapter->setMockData(longTermData);
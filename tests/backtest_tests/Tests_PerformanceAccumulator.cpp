@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <numeric>
+#include <sstream>
+#include <vector>
+#include "PerformanceAccumulator.hpp"
+
+#define DAY (24 * 60 * 60)
+
+TEST(PerformanceAccumulatorTests, MatchesTwoPassMeanAndVariance)
+{
+    std::vector<double> equity = {100.0, 101.0, 99.5, 102.0, 102.0, 98.0, 103.5};
+
+    PerformanceAccumulator acc;
+    acc.start(equity[0], 0);
+    std::vector<double> returns;
+    for (size_t i = 1; i < equity.size(); i++) {
+        acc.update(equity[i], i * DAY, 0.0, 0.0);
+        returns.push_back((equity[i] - equity[i - 1]) / equity[i - 1]);
+    }
+
+    double mean = std::accumulate(returns.begin(), returns.end(), 0.0) / returns.size();
+    double variance = 0.0;
+    for (double r : returns) variance += (r - mean) * (r - mean);
+    variance /= returns.size();
+
+    EXPECT_EQ(acc.getBarCount(), returns.size());
+    EXPECT_NEAR(acc.getMeanReturn(), mean, 1e-12);
+    EXPECT_NEAR(acc.getReturnVariance(), variance, 1e-12);
+}
+
+TEST(PerformanceAccumulatorTests, TracksDrawdownFromRunningPeak)
+{
+    PerformanceAccumulator acc;
+    acc.start(100.0, -1);
+    acc.update(120.0, -1, 0.0, 0.0);
+    acc.update(90.0, -1, 0.0, 0.0);
+    acc.update(130.0, -1, 0.0, 0.0);
+    acc.update(117.0, -1, 0.0, 0.0);
+
+    EXPECT_DOUBLE_EQ(acc.getMaxDrawdownPercent(), 25.0);
+}
+
+TEST(PerformanceAccumulatorTests, AnnualisesFromBarInterval)
+{
+    // Hourly bars over 10 days: 240 bars in 10/365.25 years
+    PerformanceAccumulator hourly;
+    hourly.start(100.0, 0);
+    for (int i = 1; i <= 240; i++) {
+        hourly.update(100.0, i * 3600, 0.0, 0.0);
+    }
+    EXPECT_NEAR(hourly.getPeriodsPerYear(), 240 * 36.525, 1e-6);
+
+    // A year of daily bars that doubles equity returns 100%
+    PerformanceAccumulator daily;
+    daily.start(100.0, 0);
+    for (int i = 1; i <= 365; i++) {
+        daily.update(100.0 * std::pow(2.0, i / 365.25), static_cast<int64_t>(i * SECONDS_PER_YEAR / 365), 0.0, 0.0);
+    }
+    EXPECT_NEAR(daily.getAnnualizedReturn(), 100.0, 0.5);
+}
+
+TEST(PerformanceAccumulatorTests, FallsBackToTradingDaysWithoutTimestamps)
+{
+    PerformanceAccumulator acc;
+    acc.start(100.0, -1);
+    acc.update(101.0, -1, 0.0, 0.0);
+
+    EXPECT_DOUBLE_EQ(acc.getPeriodsPerYear(), TRADING_DAYS_PER_YEAR);
+}
+
+TEST(PerformanceAccumulatorTests, MeasuresExposureAndTurnover)
+{
+    PerformanceAccumulator acc;
+    acc.start(1000.0, 0);
+    acc.update(1000.0, DAY, 500.0, 500.0);
+    acc.update(1000.0, 2 * DAY, 500.0, 0.0);
+    acc.update(1000.0, 3 * DAY, 0.0, 500.0);
+    acc.update(1000.0, 4 * DAY, 0.0, 0.0);
+
+    EXPECT_DOUBLE_EQ(acc.getExposurePercent(), 50.0);
+    EXPECT_DOUBLE_EQ(acc.getTurnover(), 1.0);
+    EXPECT_DOUBLE_EQ(acc.getSharpeRatio(), 0.0);
+}
+
+TEST(PerformanceAccumulatorTests, SavedStateContinuesIdentically)
+{
+    PerformanceAccumulator original;
+    original.start(100.0, 0);
+    original.update(101.0, DAY, 50.0, 10.0);
+    original.update(99.0, 2 * DAY, 0.0, 0.0);
+
+    std::stringstream state;
+    original.saveState(state);
+    PerformanceAccumulator restored;
+    restored.loadState(state);
+    ASSERT_TRUE(state);
+
+    original.update(104.0, 3 * DAY, 80.0, 20.0);
+    restored.update(104.0, 3 * DAY, 80.0, 20.0);
+    EXPECT_EQ(restored.getBarCount(), original.getBarCount());
+    EXPECT_DOUBLE_EQ(restored.getSharpeRatio(), original.getSharpeRatio());
+    EXPECT_DOUBLE_EQ(restored.getMaxDrawdownPercent(), original.getMaxDrawdownPercent());
+    EXPECT_DOUBLE_EQ(restored.getExposurePercent(), original.getExposurePercent());
+    EXPECT_DOUBLE_EQ(restored.getTurnover(), original.getTurnover());
+}
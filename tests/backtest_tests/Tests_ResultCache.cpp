@@ -0,0 +1,172 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include "../../src/backtest/ResultCache.hpp"
+
+namespace fs = std::filesystem;
+
+static CachedResult
+makeResult(double finalEquity)
+{
+    CachedResult result;
+    result.metrics = PerformanceMetrics();
+    result.metrics.startingCapital = 100000.0;
+    result.metrics.finalEquity = finalEquity;
+    result.metrics.totalPnL = finalEquity - 100000.0;
+    result.metrics.numTrades = 12;
+    result.metrics.sharpeRatio = 1.5;
+    result.metrics.profitFactor = 2.0;
+    result.metrics.executionTime = std::chrono::duration<double>(3.25);
+    result.equityCurve = {{"2025-01-02 09:30:00", 100000.0}, {"2025-01-02 09:31:00", finalEquity}};
+    return result;
+}
+
+class ResultCacheTests : public ::testing::Test
+{
+    public:
+        fs::path directory;
+        Config config;
+        json baseConfig;
+
+        void SetUp() override
+        {
+            directory = fs::temp_directory_path() / ("result_cache_" + std::string(::testing::UnitTest::GetInstance()->current_test_info()->name()));
+            fs::remove_all(directory);
+            config.loadJson(config.getTestPath("strategy_tests/test_data/config_test.json"));
+            baseConfig = config.getJson();
+        }
+
+        void TearDown() override
+        {
+            fs::remove_all(directory);
+        }
+
+        std::vector<MarketCondition> makeBars(int count)
+        {
+            std::vector<MarketCondition> bars;
+            char dateTime[32];
+            for (int i = 0; i < count; i++) {
+                std::snprintf(dateTime, sizeof(dateTime), "2025-01-02 %02d:%02d:00", 9 + (30 + i) / 60, (30 + i) % 60);
+                float close = 100.0f + 5.0f * std::sin(i / 6.0f);
+                bars.push_back(MarketCondition(dateTime, "NVDA", close, close, 1000 + i, "1m"));
+            }
+            return bars;
+        }
+
+        // A seeded backtest over the same bars every time
+        std::unique_ptr<Backtester> makeBacktester(ResultCache& cache, unsigned int seed, bool seeded = true)
+        {
+            auto backtester = std::make_unique<Backtester>(baseConfig);
+            if (seeded) {
+                backtester->setRandomSeed(seed);
+            }
+            backtester->setResultCache(&cache);
+            std::vector<MarketCondition> bars = makeBars(120);
+            backtester->setMarketData(bars);
+            return backtester;
+        }
+};
+
+TEST_F(ResultCacheTests, StoredResultLoadsBack)
+{
+    ResultCache cut(directory.string());
+    cut.store("abc", makeResult(101000.0));
+
+    CachedResult loaded;
+    ASSERT_TRUE(cut.load("abc", loaded));
+    EXPECT_DOUBLE_EQ(loaded.metrics.finalEquity, 101000.0);
+    EXPECT_DOUBLE_EQ(loaded.metrics.totalPnL, 1000.0);
+    EXPECT_EQ(loaded.metrics.numTrades, 12);
+    EXPECT_DOUBLE_EQ(loaded.metrics.executionTime.count(), 3.25);
+    ASSERT_EQ(loaded.equityCurve.size(), 2);
+    EXPECT_EQ(loaded.equityCurve[1].first, "2025-01-02 09:31:00");
+    EXPECT_DOUBLE_EQ(loaded.equityCurve[1].second, 101000.0);
+}
+
+TEST_F(ResultCacheTests, UnknownKeyMisses)
+{
+    ResultCache cut(directory.string());
+    CachedResult loaded;
+    EXPECT_FALSE(cut.load("missing", loaded));
+}
+
+TEST_F(ResultCacheTests, EvictsTheLeastRecentlyUsedEntry)
+{
+    uint64_t entrySize;
+    {
+        ResultCache measure(directory.string());
+        measure.store("a", makeResult(1.0));
+        entrySize = measure.getSizeBytes();
+    }
+
+    ResultCache cut(directory.string(), entrySize * 2 + entrySize / 2);
+    cut.store("b", makeResult(2.0));
+
+    // Using a makes b the oldest
+    CachedResult loaded;
+    ASSERT_TRUE(cut.load("a", loaded));
+    cut.store("c", makeResult(3.0));
+
+    EXPECT_EQ(cut.getEntryCount(), 2);
+    EXPECT_TRUE(cut.load("a", loaded));
+    EXPECT_FALSE(cut.load("b", loaded));
+    EXPECT_TRUE(cut.load("c", loaded));
+}
+
+TEST_F(ResultCacheTests, CorruptEntryIsAMissAndIsRemoved)
+{
+    ResultCache cut(directory.string());
+    std::ofstream(directory / ("bad" RESULT_CACHE_EXTENSION)) << "not a result";
+
+    CachedResult loaded;
+    EXPECT_FALSE(cut.load("bad", loaded));
+    EXPECT_EQ(cut.getEntryCount(), 0);
+}
+
+TEST_F(ResultCacheTests, IdenticalBacktestIsServedFromTheCache)
+{
+    ResultCache cache(directory.string());
+
+    auto first = makeBacktester(cache, 7);
+    first->run();
+    EXPECT_FALSE(first->wasCacheHit());
+    EXPECT_EQ(cache.getEntryCount(), 1);
+
+    auto second = makeBacktester(cache, 7);
+    second->run();
+    EXPECT_TRUE(second->wasCacheHit());
+    EXPECT_EQ(first->cacheKey(), second->cacheKey());
+    EXPECT_DOUBLE_EQ(second->getPerformanceMetrics().finalEquity, first->getPerformanceMetrics().finalEquity);
+    EXPECT_EQ(second->getPerformanceMetrics().numTrades, first->getPerformanceMetrics().numTrades);
+    EXPECT_EQ(second->getEquityCurve().size(), first->getEquityCurve().size());
+}
+
+TEST_F(ResultCacheTests, AnyInputChangeIsANewEntry)
+{
+    ResultCache cache(directory.string());
+    makeBacktester(cache, 7)->run();
+
+    auto otherSeed = makeBacktester(cache, 8);
+    otherSeed->run();
+    EXPECT_FALSE(otherSeed->wasCacheHit());
+
+    auto otherCapital = makeBacktester(cache, 7);
+    otherCapital->setStartingCapital(50000.0);
+    otherCapital->run();
+    EXPECT_FALSE(otherCapital->wasCacheHit());
+
+    baseConfig["strategies"][0]["period"] = 7;
+    auto otherStrategy = makeBacktester(cache, 7);
+    otherStrategy->run();
+    EXPECT_FALSE(otherStrategy->wasCacheHit());
+
+    EXPECT_EQ(cache.getEntryCount(), 4);
+}
+
+TEST_F(ResultCacheTests, UnseededRunIsNotCached)
+{
+    ResultCache cache(directory.string());
+    makeBacktester(cache, 0, false)->run();
+    EXPECT_EQ(cache.getEntryCount(), 0);
+}
@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include "../../src/broker/CostModel.hpp"
+
+class CostModelTests : public ::testing::Test
+{
+public:
+    // No minimum, no cap, 1bp spread floor and no impact unless a test asks for it
+    TieredCostModel makeTiered(double impactCoefficient = 0.0, double maxImpact = 1.0)
+    {
+        return TieredCostModel({{100, 0.01}, {0, 0.005}}, 0.0, 1.0, 1.0, impactCoefficient, maxImpact, 20);
+    }
+
+    MarketCondition bar(const std::string& time, float open, float close, int volume = 10000)
+    {
+        return MarketCondition(time, "AAPL", open, close, volume, "1d");
+    }
+};
+
+TEST_F(CostModelTests, FlatModelChargesCommissionPerTrade)
+{
+    FlatCostModel model(2.5, 0.0);
+    TradeCost cost = model.quote(Order(OrderType::BUY, "AAPL", 100.0f, 100.0f), 100.0);
+
+    EXPECT_DOUBLE_EQ(cost.price, 100.0);
+    EXPECT_DOUBLE_EQ(cost.commission, 2.5);
+    EXPECT_DOUBLE_EQ(cost.slippage, 0.0);
+}
+
+TEST_F(CostModelTests, FlatModelWithFixedSeedRepeatsSlippage)
+{
+    FlatCostModel model(1.0, 0.001);
+    model.setRandomSeed(42);
+
+    TradeCost first = model.quote(Order(OrderType::BUY, "AAPL", 10.0f, 100.0f), 100.0);
+    TradeCost second = model.quote(Order(OrderType::SELL, "AAPL", 10.0f, 100.0f), 100.0);
+
+    EXPECT_DOUBLE_EQ(first.price, second.price);
+    EXPECT_LE(std::abs(first.slippage), 0.001);
+    EXPECT_DOUBLE_EQ(first.price, 100.0 * (1.0 + first.slippage));
+}
+
+TEST_F(CostModelTests, TieredCommissionStepsDownWithVolume)
+{
+    TieredCostModel model = makeTiered();
+
+    EXPECT_DOUBLE_EQ(model.quote(Order(OrderType::BUY, "AAPL", 100.0f, 50.0f), 50.0).commission, 1.0);
+    EXPECT_DOUBLE_EQ(model.quote(Order(OrderType::SELL, "AAPL", 100.0f, 50.0f), 50.0).commission, 0.5);
+    EXPECT_DOUBLE_EQ(model.getSharesTraded(), 200.0);
+}
+
+TEST_F(CostModelTests, TieredCommissionIsClampedToMinimumAndMaximum)
+{
+    TieredCostModel model({{0, 0.0035}}, 0.35, 0.01, 0.0, 0.0, 1.0, 20);
+
+    // 10 shares would be $0.035, the minimum applies
+    EXPECT_DOUBLE_EQ(model.quote(Order(OrderType::BUY, "AAPL", 10.0f, 100.0f), 100.0).commission, 0.35);
+
+    // 1000 shares at $0.10 would be $3.50, capped at 1% of the $100 trade
+    EXPECT_NEAR(model.quote(Order(OrderType::BUY, "PENNY", 1000.0f, 0.1f), 0.1).commission, 1.0, 1e-9);
+}
+
+TEST_F(CostModelTests, BuysPayAndSellsGiveUpHalfTheSpread)
+{
+    TieredCostModel model = makeTiered();
+    double halfSpread = 0.5 / 10000.0;
+
+    TradeCost buy = model.quote(Order(OrderType::BUY, "AAPL", 10.0f, 100.0f), 100.0);
+    TradeCost sell = model.quote(Order(OrderType::LIMIT_SELL, "AAPL", 10.0f, 100.0f), 100.0);
+
+    EXPECT_DOUBLE_EQ(buy.price, 100.0 * (1.0 + halfSpread));
+    EXPECT_DOUBLE_EQ(sell.price, 100.0 * (1.0 - halfSpread));
+    EXPECT_DOUBLE_EQ(buy.slippage, -sell.slippage);
+}
+
+TEST_F(CostModelTests, ImpactGrowsWithSquareRootOfOrderSize)
+{
+    TieredCostModel model = makeTiered(0.5);
+    model.onBar(bar("2025-01-01", 100.0f, 102.0f));
+    model.onBar(bar("2025-01-02", 102.0f, 101.0f));
+
+    double halfSpread = model.getHalfSpread("AAPL");
+    double small = model.quote(Order(OrderType::BUY, "AAPL", 100.0f, 101.0f), 101.0).slippage - halfSpread;
+    double large = model.quote(Order(OrderType::BUY, "AAPL", 400.0f, 101.0f), 101.0).slippage - halfSpread;
+
+    EXPECT_GT(small, 0.0);
+    EXPECT_NEAR(large / small, 2.0, 1e-9);
+}
+
+TEST_F(CostModelTests, ImpactIsCappedAndScaledByBarVolume)
+{
+    TieredCostModel thin = makeTiered(0.5, 0.02);
+    thin.onBar(bar("2025-01-01", 100.0f, 110.0f, 1));
+
+    double halfSpread = thin.getHalfSpread("AAPL");
+    EXPECT_NEAR(thin.quote(Order(OrderType::BUY, "AAPL", 1000.0f, 110.0f), 110.0).slippage, halfSpread + 0.02, 1e-12);
+
+    TieredCostModel liquid = makeTiered(0.5, 0.02);
+    liquid.onBar(bar("2025-01-01", 100.0f, 110.0f, 10000000));
+    EXPECT_LT(liquid.quote(Order(OrderType::BUY, "AAPL", 1000.0f, 110.0f), 110.0).slippage, halfSpread + 0.02);
+}
+
+TEST_F(CostModelTests, MeanRevertingClosesWidenTheSpreadEstimate)
+{
+    TieredCostModel model = makeTiered();
+    double floor = model.getHalfSpread("AAPL");
+
+    // Bid-ask bounce: close alternates between the two sides of the book
+    for (int i = 0; i < 20; i++) {
+        float close = i % 2 == 0 ? 100.0f : 100.2f;
+        model.onBar(bar("2025-01-" + std::to_string(i + 1), close, close));
+    }
+
+    EXPECT_GT(model.getHalfSpread("AAPL"), floor);
+}
+
+TEST_F(CostModelTests, RepeatedBarIsOnlyCountedOnce)
+{
+    TieredCostModel once = makeTiered(0.5);
+    TieredCostModel twice = makeTiered(0.5);
+
+    for (int i = 0; i < 5; i++) {
+        MarketCondition condition = bar("2025-01-0" + std::to_string(i + 1), 100.0f + i, 101.0f - i);
+        once.onBar(condition);
+        twice.onBar(condition);
+        twice.onBar(condition);
+    }
+
+    Order order(OrderType::BUY, "AAPL", 50.0f, 100.0f);
+    EXPECT_DOUBLE_EQ(once.quote(order, 100.0).price, twice.quote(order, 100.0).price);
+}
+
+TEST_F(CostModelTests, CostModelIsBuiltFromConfig)
+{
+    json tiered = {{"type", "tiered"}, {"min_commission", 0.0}, {"max_commission_percent", 1.0},
+                   {"tiers", {{{"up_to_shares", 0}, {"per_share", 0.01}}}}};
+    std::unique_ptr<CostModel> model = makeCostModel(CostModelConfig::fromJson(tiered));
+    EXPECT_EQ(model->getName(), "tiered");
+    EXPECT_DOUBLE_EQ(model->quote(Order(OrderType::BUY, "AAPL", 100.0f, 10.0f), 10.0).commission, 1.0);
+
+    json flat = {{"type", "flat"}, {"commission", 3.0}, {"slippage", 0.0}};
+    EXPECT_EQ(makeCostModel(CostModelConfig::fromJson(flat))->getName(), "flat");
+    EXPECT_DOUBLE_EQ(makeCostModel(CostModelConfig::fromJson(flat))->quote(Order(OrderType::BUY, "AAPL", 1.0f, 10.0f), 10.0).commission, 3.0);
+
+    EXPECT_THROW(makeCostModel(CostModelConfig::fromJson({{"type", "fancy"}})), std::runtime_error);
+}
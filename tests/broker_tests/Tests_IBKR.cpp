@@ -0,0 +1,270 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <thread>
+#include "../../src/broker/FakeTwsGateway.hpp"
+#include "../../src/broker/IBKR.hpp"
+#include "../../src/util/Config.hpp"
+
+class IBKRTests : public ::testing::Test
+{
+public:
+    std::unique_ptr<FakeTwsGateway> gateway;
+    std::unique_ptr<IBKR> cut;
+    std::thread gatewayThread;
+    Config config;
+
+    void startSession(const std::string& session, int serverVersion = TwsProtocol::MAX_CLIENT_VERSION)
+    {
+        gateway = std::make_unique<FakeTwsGateway>(serverVersion);
+        gateway->loadSession(config.getTestPath("broker_tests/test_data/" + session));
+        uint16_t port = gateway->listen(0);
+        gatewayThread = std::thread([this]() { gateway->run(); });
+
+        cut = std::make_unique<IBKR>("127.0.0.1", port);
+        cut->setInitialBackoff(10);
+        cut->setRequestTimeout(2000);
+    }
+
+    void TearDown() override
+    {
+        if (cut) cut->disconnect();
+        if (gateway) gateway->stop();
+        if (gatewayThread.joinable()) gatewayThread.join();
+    }
+
+    bool waitFor(const std::function<bool()>& condition, int timeoutMs = 2000)
+    {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+        while (!condition()) {
+            if (std::chrono::steady_clock::now() > deadline) return false;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+
+    bool nextEvent(BrokerEvent& event)
+    {
+        return waitFor([&]() { return cut->pollEvent(event); });
+    }
+};
+
+TEST_F(IBKRTests, MessageWriterFramesFields)
+{
+    std::string buffer;
+    TwsProtocol::MessageWriter(buffer).add(9).add(1).add("AAPL").add(151.25).finish();
+
+    ASSERT_EQ(buffer.size(), TwsProtocol::HEADER_SIZE + 16);
+    EXPECT_EQ(TwsProtocol::readLength(buffer.data()), 16u);
+
+    TwsProtocol::FieldReader reader(std::string_view(buffer).substr(TwsProtocol::HEADER_SIZE));
+    EXPECT_EQ(reader.nextInt(), 9);
+    EXPECT_EQ(reader.nextInt(), 1);
+    EXPECT_EQ(reader.next(), "AAPL");
+    EXPECT_DOUBLE_EQ(reader.nextDouble(), 151.25);
+    EXPECT_FALSE(reader.hasMore());
+}
+
+TEST_F(IBKRTests, FrameBufferReassemblesSplitFrames)
+{
+    std::string stream;
+    TwsProtocol::MessageWriter(stream).add(1).add("first").finish();
+    TwsProtocol::MessageWriter(stream).add(2).add("second").finish();
+
+    // Deliver the bytes one at a time, as a slow socket might
+    TwsProtocol::FrameBuffer buffer(8);
+    std::vector<std::string> frames;
+    std::string_view payload;
+    for (char byte : stream) {
+        buffer.prepare(1);
+        *buffer.writePtr() = byte;
+        buffer.commit(1);
+        while (buffer.nextFrame(payload)) {
+            frames.emplace_back(payload);
+        }
+    }
+
+    ASSERT_EQ(frames.size(), 2);
+    EXPECT_EQ(TwsProtocol::splitFields(frames[0])[1], "first");
+    EXPECT_EQ(TwsProtocol::splitFields(frames[1])[1], "second");
+    EXPECT_EQ(buffer.buffered(), 0);
+}
+
+TEST_F(IBKRTests, FrameBufferRejectsOversizedFrame)
+{
+    TwsProtocol::FrameBuffer buffer;
+    TwsProtocol::writeLength(buffer.writePtr(), TwsProtocol::MAX_MESSAGE_LENGTH + 1);
+    buffer.commit(TwsProtocol::HEADER_SIZE);
+
+    std::string_view payload;
+    EXPECT_THROW(buffer.nextFrame(payload), std::runtime_error);
+}
+
+TEST_F(IBKRTests, PlaceOrderMatchesReferenceEncoding)
+{
+    std::ifstream file(config.getTestPath("broker_tests/test_data/tws_place_order.messages"));
+    ASSERT_TRUE(file.is_open());
+
+    int checked = 0;
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') continue;
+
+        std::istringstream stream(line);
+        int serverVersion, orderId;
+        std::string type, expected;
+        float quantity, price;
+        stream >> serverVersion >> orderId >> type >> quantity >> price >> expected;
+
+        std::string buffer;
+        TwsProtocol::writePlaceOrder(buffer, serverVersion, orderId, Order(type, "AAPL", quantity, price));
+        std::vector<std::string> fields =
+            TwsProtocol::splitFields(std::string_view(buffer).substr(TwsProtocol::HEADER_SIZE));
+
+        std::string encoded;
+        for (size_t i = 0; i < fields.size(); i++) {
+            encoded += (i > 0 ? "|" : "") + fields[i];
+        }
+        EXPECT_EQ(encoded, expected) << "server version " << serverVersion;
+        checked++;
+    }
+    EXPECT_EQ(checked, 3);
+}
+
+TEST_F(IBKRTests, PlaceOrderFollowsNegotiatedVersion)
+{
+    startSession("ibkr_order_v144.session", 144);
+    ASSERT_EQ(cut->connect(), 1);
+    EXPECT_EQ(cut->getServerVersion(), 144);
+
+    cut->placeOrder(Order(OrderType::BUY, "AAPL", 10.0f, 151.0f));
+
+    BrokerEvent event;
+    ASSERT_TRUE(nextEvent(event));
+    EXPECT_EQ(event.type, BrokerEventType::ACK);
+    ASSERT_TRUE(nextEvent(event));
+    EXPECT_EQ(event.type, BrokerEventType::FILL);
+    EXPECT_EQ(gateway->getMismatchCount(), 0);
+}
+
+TEST_F(IBKRTests, ConnectsAndStreamsPositionsAndPrices)
+{
+    startSession("ibkr_connect.session");
+    ASSERT_EQ(cut->connect(), 1);
+    EXPECT_TRUE(cut->isConnected());
+    EXPECT_EQ(cut->getServerVersion(), TwsProtocol::MAX_CLIENT_VERSION);
+
+    Position position = cut->getLatestPosition("AAPL");
+    EXPECT_FLOAT_EQ(position.getQuantity(), 25.0f);
+    EXPECT_FLOAT_EQ(position.getAvgPrice(), 150.5f);
+    EXPECT_FLOAT_EQ(cut->getLatestPosition("MSFT").getQuantity(), 0.0f);
+
+    EXPECT_FLOAT_EQ(cut->getLatestPrice("AAPL"), 151.25f);
+    ASSERT_TRUE(waitFor([&]() { return gateway->isFinished(); }));
+    ASSERT_TRUE(waitFor([&]() { return cut->getMessagesReceived() == gateway->getMessagesSent(); }));
+    EXPECT_FLOAT_EQ(cut->getLatestPrice("AAPL"), 151.25f);
+    EXPECT_EQ(gateway->getMismatchCount(), 0);
+}
+
+TEST_F(IBKRTests, OrderIsAckedPartiallyFilledAndFilled)
+{
+    startSession("ibkr_order_fill.session");
+    ASSERT_EQ(cut->connect(), 1);
+
+    Order order(OrderType::BUY, "AAPL", 10.0f, 151.0f);
+    order.setId(42);
+    int clientOrderId = cut->placeOrder(order);
+    EXPECT_GT(clientOrderId, 0);
+
+    BrokerEvent event;
+    ASSERT_TRUE(nextEvent(event));
+    EXPECT_EQ(event.type, BrokerEventType::ACK);
+    EXPECT_EQ(event.clientOrderId, clientOrderId);
+    EXPECT_EQ(event.orderId, 42);
+
+    ASSERT_TRUE(nextEvent(event));
+    EXPECT_EQ(event.type, BrokerEventType::PARTIAL_FILL);
+    EXPECT_FLOAT_EQ(event.quantity, 4.0f);
+    EXPECT_FLOAT_EQ(event.price, 151.0f);
+    EXPECT_FLOAT_EQ(event.remainingQuantity, 6.0f);
+
+    // The repeated status is ignored, the next event is the final fill
+    ASSERT_TRUE(nextEvent(event));
+    EXPECT_EQ(event.type, BrokerEventType::FILL);
+    EXPECT_EQ(event.getTicker(), "AAPL");
+    EXPECT_FLOAT_EQ(event.quantity, 6.0f);
+    EXPECT_FLOAT_EQ(event.price, 151.2f);
+}
+
+TEST_F(IBKRTests, GatewayErrorRejectsOrder)
+{
+    startSession("ibkr_order_fill.session");
+    ASSERT_EQ(cut->connect(), 1);
+
+    // Pipeline both orders without waiting on the first
+    cut->placeOrder(Order(OrderType::BUY, "AAPL", 10.0f, 151.0f));
+    int rejectedId = cut->placeOrder(Order(OrderType::LIMIT_SELL, "AAPL", 5.0f, 200.0f));
+
+    BrokerEvent event;
+    bool rejected = false;
+    while (!rejected && nextEvent(event)) {
+        rejected = event.type == BrokerEventType::REJECT;
+    }
+
+    ASSERT_TRUE(rejected);
+    EXPECT_EQ(event.clientOrderId, rejectedId);
+    EXPECT_EQ(gateway->getMismatchCount(), 0);
+}
+
+TEST_F(IBKRTests, ReconnectsAndRejectsUnacknowledgedOrders)
+{
+    startSession("ibkr_reconnect.session");
+    ASSERT_EQ(cut->connect(), 1);
+
+    int lostId = cut->placeOrder(Order(OrderType::BUY, "AAPL", 1.0f, 150.0f));
+
+    BrokerEvent event;
+    ASSERT_TRUE(nextEvent(event));
+    EXPECT_EQ(event.type, BrokerEventType::REJECT);
+    EXPECT_EQ(event.clientOrderId, lostId);
+
+    ASSERT_TRUE(waitFor([&]() { return cut->isConnected() && cut->getReconnectCount() == 1; }));
+    EXPECT_EQ(gateway->getConnectionCount(), 2);
+
+    cut->placeOrder(Order(OrderType::BUY, "AAPL", 1.0f, 150.0f));
+    ASSERT_TRUE(nextEvent(event));
+    EXPECT_EQ(event.type, BrokerEventType::ACK);
+    ASSERT_TRUE(nextEvent(event));
+    EXPECT_EQ(event.type, BrokerEventType::FILL);
+    EXPECT_EQ(gateway->getMismatchCount(), 0);
+}
+
+TEST_F(IBKRTests, GivesUpAfterMaxConnectionRetries)
+{
+    // Grab a free port and release it so nothing is listening there
+    FakeTwsGateway unused;
+    uint16_t port = unused.listen(0);
+    unused.stop();
+
+    IBKR broker("127.0.0.1", port);
+    broker.setInitialBackoff(1);
+
+    EXPECT_EQ(broker.connect(), 0);
+    EXPECT_FALSE(broker.isConnected());
+    EXPECT_EQ(broker.placeOrder(Order(OrderType::BUY, "AAPL", 1.0f, 150.0f)), 0);
+    EXPECT_THROW(broker.SetUp(), std::runtime_error);
+}
+
+TEST_F(IBKRTests, ReplaysTickStream)
+{
+    startSession("ibkr_tick_stream.session");
+    ASSERT_EQ(cut->connect(), 1);
+
+    EXPECT_GT(cut->getLatestPrice("AAPL"), 0.0f);
+    ASSERT_TRUE(waitFor([&]() { return gateway->isFinished(); }, 10000));
+    ASSERT_TRUE(waitFor([&]() { return cut->getMessagesReceived() == gateway->getMessagesSent(); }, 10000));
+    EXPECT_FLOAT_EQ(cut->getLatestPrice("AAPL"), 151.25f);
+}
@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include "../../src/broker/ExchangeSimulator.hpp"
+#include "../../src/broker/LoopbackBroker.hpp"
+
+class LoopbackBrokerTests : public ::testing::Test 
+{
+public:
+    std::unique_ptr<MarketData> marketData;
+    std::unique_ptr<ExchangeSimulator> simulator;
+    std::unique_ptr<LoopbackBroker> cut;
+    std::thread serverThread;
+
+    void SetUp() override 
+    {
+        std::vector<MarketCondition> mockData;
+        for (int i = 0; i < 5; i++) {
+            float price = 100.0f + i;
+            mockData.push_back(MarketCondition(
+                "2025-03-2" + std::to_string(i) + " 10:00:00", "AAPL", price, price, 1000, "1m"));
+        }
+
+        marketData = std::make_unique<MarketData>();
+        marketData->update(mockData);
+
+        simulator = std::make_unique<ExchangeSimulator>(*marketData);
+        simulator->getBroker().setSlippage(0.0);
+        uint16_t port = simulator->listen(0);
+        serverThread = std::thread([this]() { simulator->run(); });
+
+        cut = std::make_unique<LoopbackBroker>("127.0.0.1", port);
+        ASSERT_EQ(cut->connect(), 1);
+    }
+
+    void TearDown() override 
+    {
+        cut->disconnect();
+        simulator->stop();
+        serverThread.join();
+    }
+};
+
+TEST_F(LoopbackBrokerTests, NewOrderMessageRoundTrips)
+{
+    Order order(OrderType::LIMIT_SELL, "AAPL", 25.0f, 101.5f);
+    order.setStopLossPrice(110.0f);
+    order.setTakeProfitPrice(90.0f);
+
+    ExchangeProtocol::NewOrderMessage message = ExchangeProtocol::encodeNewOrder(order, 7, 123);
+    Order decoded = ExchangeProtocol::decodeNewOrder(message);
+
+    EXPECT_EQ(message.header.length, sizeof(ExchangeProtocol::NewOrderMessage));
+    EXPECT_EQ(decoded.getId(), 7);
+    EXPECT_EQ(decoded.getType(), OrderType::LIMIT_SELL);
+    EXPECT_EQ(decoded.getTicker(), "AAPL");
+    EXPECT_FLOAT_EQ(decoded.getQuantity(), 25.0f);
+    EXPECT_FLOAT_EQ(decoded.getPrice(), 101.5f);
+    EXPECT_FLOAT_EQ(decoded.getStopLossPrice(), 110.0f);
+    EXPECT_FLOAT_EQ(decoded.getTakeProfitPrice(), 90.0f);
+}
+
+TEST_F(LoopbackBrokerTests, CanGetLatestPrice)
+{
+    EXPECT_GT(cut->getLatestPrice("AAPL"), 0.0f);
+}
+
+TEST_F(LoopbackBrokerTests, OrderIsAckedAndFilled)
+{
+    Order order(OrderType::BUY, "AAPL", 10.0f, 100.0f);
+    order.setId(42);
+
+    int clientOrderId = cut->placeOrder(order);
+    EXPECT_GT(clientOrderId, 0);
+    ASSERT_TRUE(cut->waitUntilIdle());
+
+    EXPECT_EQ(cut->getAckLatencies().size(), 1);
+    EXPECT_EQ(cut->getFillLatencies().size(), 1);
+
+    BrokerEvent event;
+    ASSERT_TRUE(cut->pollEvent(event));
+    EXPECT_EQ(event.type, BrokerEventType::ACK);
+    EXPECT_EQ(event.clientOrderId, clientOrderId);
+    EXPECT_EQ(event.orderId, 42);
+
+    ASSERT_TRUE(cut->pollEvent(event));
+    EXPECT_EQ(event.type, BrokerEventType::FILL);
+    EXPECT_EQ(event.orderId, 42);
+    EXPECT_EQ(event.getTicker(), "AAPL");
+    EXPECT_FLOAT_EQ(event.quantity, 10.0f);
+    EXPECT_FALSE(cut->pollEvent(event));
+}
+
+TEST_F(LoopbackBrokerTests, PlaceOrderDoesNotWaitForFill)
+{
+    for (int i = 0; i < 50; i++) {
+        EXPECT_GT(cut->placeOrder(Order(OrderType::BUY, "AAPL", 1.0f, 100.0f)), 0);
+    }
+
+    ASSERT_TRUE(cut->waitUntilIdle());
+    EXPECT_EQ(cut->getInFlightCount(), 0);
+    EXPECT_EQ(cut->getFillLatencies().size(), 50);
+    EXPECT_EQ(cut->getPendingEventCount(), 100);
+}
+
+TEST_F(LoopbackBrokerTests, PlaceOrdersSendsTheBatchTogether)
+{
+    std::vector<Order> batch{Order(OrderType::BUY, "AAPL", 10.0f, 100.0f),
+                             Order(OrderType::SELL, "AAPL", 4.0f, 100.0f),
+                             Order(OrderType::BUY, "AAPL", 1.0f, 100.0f)};
+    std::vector<int> clientOrderIds(batch.size());
+
+    EXPECT_EQ(cut->placeOrders(batch, clientOrderIds), 3);
+    EXPECT_GT(clientOrderIds[0], 0);
+    EXPECT_NE(clientOrderIds[0], clientOrderIds[1]);
+
+    ASSERT_TRUE(cut->waitUntilIdle());
+    EXPECT_EQ(simulator->getOrdersHandled(), 3);
+    EXPECT_FLOAT_EQ(cut->getLatestPosition("AAPL").getQuantity(), 7.0f);
+}
+
+TEST_F(LoopbackBrokerTests, PositionReflectsFills)
+{
+    cut->placeOrder(Order(OrderType::BUY, "AAPL", 10.0f, 100.0f));
+    cut->placeOrder(Order(OrderType::SELL, "AAPL", 4.0f, 100.0f));
+    ASSERT_TRUE(cut->waitUntilIdle());
+
+    Position position = cut->getLatestPosition("AAPL");
+    EXPECT_FLOAT_EQ(position.getQuantity(), 6.0f);
+    EXPECT_EQ(simulator->getOrdersHandled(), 2);
+}
+
+TEST_F(LoopbackBrokerTests, LimitOrderOutsidePriceIsRejected)
+{
+    // Limit buy well below the market cannot execute
+    EXPECT_GT(cut->placeOrder(Order(OrderType::LIMIT_BUY, "AAPL", 10.0f, 50.0f)), 0);
+    ASSERT_TRUE(cut->waitUntilIdle());
+    EXPECT_EQ(cut->getRejectCount(), 1);
+
+    BrokerEvent event;
+    ASSERT_TRUE(cut->pollEvent(event));
+    EXPECT_EQ(event.type, BrokerEventType::ACK);
+    ASSERT_TRUE(cut->pollEvent(event));
+    EXPECT_EQ(event.type, BrokerEventType::REJECT);
+}
+
+TEST_F(LoopbackBrokerTests, WaitsEndWhenTheExchangeHangsUp)
+{
+    // The simulator finishes the message in hand and then drops the client,
+    // leaving the second order of the batch unanswered
+    ASSERT_GT(cut->getLatestPrice("AAPL"), 0.0f);
+    simulator->stop();
+    std::vector<Order> batch{Order(OrderType::BUY, "AAPL", 10.0f, 100.0f),
+                             Order(OrderType::BUY, "AAPL", 5.0f, 100.0f)};
+    std::vector<int> clientOrderIds(batch.size());
+    ASSERT_EQ(cut->placeOrders(batch, clientOrderIds), 2);
+
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(cut->waitUntilIdle(5000));
+    EXPECT_FALSE(cut->isConnected());
+    EXPECT_EQ(cut->getLatestPrice("AAPL"), 0.0f);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(2));
+
+    EXPECT_EQ(cut->placeOrder(Order(OrderType::BUY, "AAPL", 1.0f, 100.0f)), 0);
+}
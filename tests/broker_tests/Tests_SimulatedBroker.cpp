@@ -156,6 +156,56 @@ TEST_F(SimulatedBrokerTests, OrdersAreExecuted)
     EXPECT_EQ(broker->getNumTrades(), 1);
 }
 
+TEST_F(SimulatedBrokerTests, PlaceOrderPublishesAckThenFill) 
+{
+    Order order = createBuyOrder();
+    order.setId(7);
+    int clientOrderId = broker->placeOrder(order);
+    EXPECT_GT(clientOrderId, 0);
+
+    BrokerEvent event;
+    ASSERT_TRUE(broker->pollEvent(event));
+    EXPECT_EQ(event.type, BrokerEventType::ACK);
+    EXPECT_EQ(event.clientOrderId, clientOrderId);
+    EXPECT_FALSE(broker->pollEvent(event));
+
+    executeStep();
+
+    ASSERT_TRUE(broker->pollEvent(event));
+    EXPECT_EQ(event.type, BrokerEventType::FILL);
+    EXPECT_EQ(event.orderId, 7);
+    EXPECT_EQ(event.getTicker(), "AAPL");
+    EXPECT_FLOAT_EQ(event.quantity, order.getQuantity());
+    EXPECT_GT(event.price, 0.0f);
+}
+
+TEST_F(SimulatedBrokerTests, EventsPastTheQueueCapacityAreNotDropped) 
+{
+    // Publish half as many events again as the queue holds before polling any
+    const int orders = BROKER_EVENT_QUEUE_SIZE + BROKER_EVENT_QUEUE_SIZE / 2;
+    for (int i = 0; i < orders; i++) {
+        Order order = createBuyOrder();
+        order.setId(i);
+        ASSERT_GT(broker->placeOrder(order), 0);
+    }
+    EXPECT_EQ(broker->getPendingEventCount(), static_cast<size_t>(orders));
+    EXPECT_EQ(broker->getOverflowedEventCount(), static_cast<uint64_t>(orders - BROKER_EVENT_QUEUE_SIZE));
+
+    // Every ack arrives, in the order it was published
+    BrokerEvent event;
+    for (int i = 0; i < orders; i++) {
+        ASSERT_TRUE(broker->pollEvent(event)) << "event " << i;
+        EXPECT_EQ(event.type, BrokerEventType::ACK);
+        ASSERT_EQ(event.orderId, i);
+    }
+    EXPECT_FALSE(broker->pollEvent(event));
+
+    // Drained, so new events go through the queue again
+    broker->placeOrder(createBuyOrder());
+    ASSERT_TRUE(broker->pollEvent(event));
+    EXPECT_EQ(broker->getOverflowedEventCount(), static_cast<uint64_t>(orders - BROKER_EVENT_QUEUE_SIZE));
+}
+
 TEST_F(SimulatedBrokerTests, PositionsAreCreated) 
 {
     broker->placeOrder(createBuyOrder("AAPL", 100.0f));
@@ -729,4 +779,72 @@ TEST_F(SimulatedBrokerTests, IntegrationWithMultipleOrdersAndMarketMovements)
     
     EXPECT_GE(actualPnL, expectedMinPnL);
     EXPECT_LE(actualPnL, expectedMaxPnL);
-}
\ No newline at end of file
+}
+TEST_F(SimulatedBrokerTests, MarketValueTracksPriceMoves) 
+{
+    broker->setSlippage(0.0);
+    broker->placeOrder(createBuyOrder("AAPL", 100.0f));
+    executeStep();
+
+    EXPECT_DOUBLE_EQ(broker->getLongMarketValue(), 100.0 * 100.0);
+    EXPECT_DOUBLE_EQ(broker->getShortMarketValue(), 0.0);
+
+    // Next bar closes at 101, only the price move is applied
+    executeStep();
+    EXPECT_DOUBLE_EQ(broker->getLongMarketValue(), 100.0 * 101.0);
+    EXPECT_DOUBLE_EQ(broker->getCurrentEquity(), broker->getCurrentCash() + 100.0 * 101.0);
+}
+
+TEST_F(SimulatedBrokerTests, ShortPositionIsMarkedNegative) 
+{
+    broker->setSlippage(0.0);
+    broker->placeOrder(createSellOrder("AAPL", 50.0f));
+    executeStep();
+    executeStep();
+
+    EXPECT_DOUBLE_EQ(broker->getLongMarketValue(), 0.0);
+    EXPECT_DOUBLE_EQ(broker->getShortMarketValue(), -50.0 * 101.0);
+
+    // Flip from short to long on the next bar
+    broker->placeOrder(createBuyOrder("AAPL", 80.0f));
+    executeStep();
+    EXPECT_DOUBLE_EQ(broker->getShortMarketValue(), 0.0);
+    EXPECT_DOUBLE_EQ(broker->getLongMarketValue(), 30.0 * 102.0);
+}
+
+TEST_F(SimulatedBrokerTests, IncrementalValuationMatchesFullRevaluation) 
+{
+    for (int i = 0; i < 9; i++) {
+        if (i % 3 == 0) broker->placeOrder(createBuyOrder("AAPL", 10.0f + i));
+        if (i % 4 == 1) broker->placeOrder(createSellOrder("AAPL", 25.0f));
+        executeStep();
+    }
+    Position position = broker->getLatestPosition("AAPL");
+    EXPECT_NEAR(broker->getCurrentEquity(),
+                broker->getCurrentCash() + position.getQuantity() * broker->getLatestPrice("AAPL"), 1e-6);
+
+    // Detailed logging forces a full revaluation from the positions on the next bar
+    broker->enableDetailedLogging(true);
+    broker->process();
+
+    position = broker->getLatestPosition("AAPL");
+    EXPECT_NEAR(broker->getCurrentEquity(),
+                broker->getCurrentCash() + position.getQuantity() * broker->getLatestPrice("AAPL"), 1e-6);
+}
+
+TEST_F(SimulatedBrokerTests, TieredCostModelPricesFills) 
+{
+    broker->setCostModel(std::make_unique<TieredCostModel>());
+    broker->placeOrder(createBuyOrder("AAPL", 100.0f));
+    executeStep();
+
+    // Buys pay at least half the minimum spread over the bar close
+    const Order& fill = broker->getFilledOrders().back();
+    EXPECT_GT(fill.getPrice(), 100.0f);
+    EXPECT_DOUBLE_EQ(broker->getTotalCommission(), DEFAULT_MIN_COMMISSION);
+    EXPECT_NEAR(broker->getCurrentCash(), 100000.0 - 100.0 * fill.getPrice() - DEFAULT_MIN_COMMISSION, 0.01);
+
+    // Going back to flat pricing
+    broker->setCommission(1.0);
+    EXPECT_EQ(broker->getCostModel().getName(), "flat");
+}
@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include "TradeLedger.hpp"
+
+TEST(TradeLedgerTests, FifoClosesOldestLotFirst)
+{
+    TradeLedger ledger(LotMatching::FIFO);
+    ledger.onFill("AAPL", 10, 100.0);
+    ledger.onFill("AAPL", 10, 110.0);
+    ledger.onFill("AAPL", -10, 120.0);
+
+    ASSERT_EQ(ledger.getClosedLots().size(), 1);
+    EXPECT_DOUBLE_EQ(ledger.getClosedLots()[0].openPrice, 100.0);
+    EXPECT_DOUBLE_EQ(ledger.getStats().realizedPnL, 200.0);
+
+    const std::deque<Lot>* open = ledger.getOpenLots("AAPL");
+    ASSERT_NE(open, nullptr);
+    ASSERT_EQ(open->size(), 1);
+    EXPECT_DOUBLE_EQ(open->front().price, 110.0);
+}
+
+TEST(TradeLedgerTests, LifoClosesNewestLotFirst)
+{
+    TradeLedger ledger(LotMatching::LIFO);
+    ledger.onFill("AAPL", 10, 100.0);
+    ledger.onFill("AAPL", 10, 110.0);
+    ledger.onFill("AAPL", -10, 120.0);
+
+    ASSERT_EQ(ledger.getClosedLots().size(), 1);
+    EXPECT_DOUBLE_EQ(ledger.getClosedLots()[0].openPrice, 110.0);
+    EXPECT_DOUBLE_EQ(ledger.getStats().realizedPnL, 100.0);
+}
+
+TEST(TradeLedgerTests, PartialCloseSpansLots)
+{
+    TradeLedger ledger;
+    ledger.onFill("AAPL", 5, 100.0);
+    ledger.onFill("AAPL", 5, 90.0);
+    ledger.onFill("AAPL", -7, 95.0);
+
+    // 5 closed at a 25 profit, 2 at a 10 profit
+    const TradeStats& stats = ledger.getStats();
+    EXPECT_EQ(stats.closedTrades, 2);
+    EXPECT_EQ(stats.winningTrades, 1);
+    EXPECT_EQ(stats.losingTrades, 1);
+    EXPECT_DOUBLE_EQ(stats.grossProfit, 10.0);
+    EXPECT_DOUBLE_EQ(stats.grossLoss, -25.0);
+
+    const std::deque<Lot>* open = ledger.getOpenLots("AAPL");
+    ASSERT_EQ(open->size(), 1);
+    EXPECT_DOUBLE_EQ(open->front().quantity, 3.0);
+    EXPECT_DOUBLE_EQ(open->front().price, 90.0);
+}
+
+TEST(TradeLedgerTests, FillThroughZeroOpensOppositeLot)
+{
+    TradeLedger ledger;
+    ledger.onFill("AAPL", 10, 100.0);
+    ledger.onFill("AAPL", -15, 105.0);
+
+    EXPECT_DOUBLE_EQ(ledger.getStats().realizedPnL, 50.0);
+    const std::deque<Lot>* open = ledger.getOpenLots("AAPL");
+    ASSERT_EQ(open->size(), 1);
+    EXPECT_DOUBLE_EQ(open->front().quantity, -5.0);
+    EXPECT_DOUBLE_EQ(open->front().price, 105.0);
+
+    // Covering the short below its open price is a win
+    ledger.onFill("AAPL", 5, 100.0);
+    EXPECT_DOUBLE_EQ(ledger.getStats().realizedPnL, 75.0);
+    EXPECT_EQ(ledger.getStats().winningTrades, 2);
+    EXPECT_TRUE(ledger.getOpenLots("AAPL")->empty());
+}
+
+TEST(TradeLedgerTests, TickersAreMatchedSeparately)
+{
+    TradeLedger ledger;
+    ledger.onFill("AAPL", 10, 100.0);
+    ledger.onFill("MSFT", -10, 200.0);
+
+    EXPECT_EQ(ledger.getStats().closedTrades, 0);
+    EXPECT_EQ(ledger.getOpenLots("TSLA"), nullptr);
+}
+
+TEST(TradeLedgerTests, StatsSummariseWinsAndLosses)
+{
+    TradeLedger ledger;
+    ledger.onFill("AAPL", 1, 100.0);
+    ledger.onFill("AAPL", -1, 130.0);
+    ledger.onFill("AAPL", 1, 100.0);
+    ledger.onFill("AAPL", -1, 110.0);
+    ledger.onFill("AAPL", 1, 100.0);
+    ledger.onFill("AAPL", -1, 80.0);
+
+    const TradeStats& stats = ledger.getStats();
+    EXPECT_EQ(stats.closedTrades, 3);
+    EXPECT_NEAR(stats.getWinRate(), 66.6667, 1e-3);
+    EXPECT_DOUBLE_EQ(stats.getAvgWin(), 20.0);
+    EXPECT_DOUBLE_EQ(stats.getAvgLoss(), -20.0);
+    EXPECT_DOUBLE_EQ(stats.getProfitFactor(), 2.0);
+
+    ledger.reset();
+    EXPECT_EQ(ledger.getStats().closedTrades, 0);
+    EXPECT_TRUE(ledger.getClosedLots().empty());
+}
+
+TEST(TradeLedgerTests, ParsesMatchingNames)
+{
+    EXPECT_EQ(stringToLotMatching("FIFO"), LotMatching::FIFO);
+    EXPECT_EQ(stringToLotMatching("lifo"), LotMatching::LIFO);
+    EXPECT_THROW(stringToLotMatching("average"), std::runtime_error);
+}
@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <poll.h>
+#include "../../src/data_access/CSVFollower.hpp"
+
+namespace fs = std::filesystem;
+
+#define CSV_HEADER "DATE,TICKER,OPEN,CLOSE,VOLUME,INTERVAL\n"
+
+class CSVFollowerTests : public ::testing::Test
+{
+    public:
+        fs::path directory;
+        std::string filePath;
+
+        void SetUp() override
+        {
+            // One directory per test, ctest may run them side by side
+            directory = fs::temp_directory_path() / ("csv_follower_" + std::string(::testing::UnitTest::GetInstance()->current_test_info()->name()));
+            filePath = (directory / "marketData_NVDA_2025-01-02.csv").string();
+            fs::remove_all(directory);
+            fs::create_directories(directory);
+        }
+
+        void TearDown() override
+        {
+            fs::remove_all(directory);
+        }
+
+        void write(const std::string& text, std::ios::openmode mode = std::ios::app)
+        {
+            std::ofstream file(filePath, mode);
+            file << text;
+        }
+};
+
+TEST_F(CSVFollowerTests, ReadsRowsAfterTheHeader)
+{
+    CSVFollower cut(directory.string(), "marketData_NVDA_");
+    write(CSV_HEADER "2025-01-02 09:30:00,NVDA,100,101,500,1m\n2025-01-02 09:31:00,NVDA,101,102,600,1m\n");
+
+    std::vector<MarketCondition> rows;
+    EXPECT_EQ(cut.readAppended(filePath, rows), 2);
+    ASSERT_EQ(rows.size(), 2);
+    EXPECT_EQ(rows[0].DateTime, "2025-01-02 09:30:00");
+    EXPECT_EQ(rows[1].Close, 102);
+    EXPECT_EQ(cut.getOffset(filePath), fs::file_size(filePath));
+}
+
+TEST_F(CSVFollowerTests, OnlyReadsWhatWasAppended)
+{
+    CSVFollower cut(directory.string(), "marketData_NVDA_");
+    write(CSV_HEADER "2025-01-02 09:30:00,NVDA,100,101,500,1m\n");
+
+    std::vector<MarketCondition> rows;
+    cut.readAppended(filePath, rows);
+    EXPECT_EQ(cut.readAppended(filePath, rows), 0);
+
+    write("2025-01-02 09:31:00,NVDA,101,102,600,1m\n");
+    rows.clear();
+    EXPECT_EQ(cut.readAppended(filePath, rows), 1);
+    EXPECT_EQ(rows[0].DateTime, "2025-01-02 09:31:00");
+}
+
+TEST_F(CSVFollowerTests, LeavesAPartialLineUntilItIsFinished)
+{
+    CSVFollower cut(directory.string(), "marketData_NVDA_");
+    write(CSV_HEADER "2025-01-02 09:30:00,NVDA,100,101,500,1m\n2025-01-02 09:31:00,NVDA,10");
+
+    std::vector<MarketCondition> rows;
+    EXPECT_EQ(cut.readAppended(filePath, rows), 1);
+
+    write("1,102,600,1m\n");
+    rows.clear();
+    EXPECT_EQ(cut.readAppended(filePath, rows), 1);
+    EXPECT_EQ(rows[0].Open, 101);
+    EXPECT_EQ(rows[0].Volume, 600);
+}
+
+TEST_F(CSVFollowerTests, RewrittenFileDoesNotDuplicateBars)
+{
+    CSVFollower cut(directory.string(), "marketData_NVDA_");
+    MarketData marketData;
+    write(CSV_HEADER "2025-01-02 09:30:00,NVDA,100,101,500,1m\n2025-01-02 09:31:00,NVDA,101,102,600,1m\n");
+    EXPECT_EQ(cut.follow(filePath, marketData), 2);
+
+    // The downloader writes a fresh, shorter file for a new session
+    write(CSV_HEADER "2025-01-02 09:32:00,NVDA,102,103,700,1m\n", std::ios::trunc);
+    EXPECT_EQ(cut.follow(filePath, marketData), 1);
+
+    // Then the whole file again with one more bar
+    write(CSV_HEADER "2025-01-02 09:32:00,NVDA,102,103,700,1m\n2025-01-02 09:33:00,NVDA,103,104,800,1m\n", std::ios::trunc);
+    EXPECT_EQ(cut.follow(filePath, marketData), 1);
+
+    auto data = marketData.getData();
+    ASSERT_EQ(data.size(), 4);
+    EXPECT_EQ(data.back().DateTime, "2025-01-02 09:33:00");
+}
+
+TEST_F(CSVFollowerTests, PollAppendsRowsFromWatchedFiles)
+{
+    CSVFollower cut(directory.string(), "marketData_NVDA_");
+    MarketData marketData;
+
+    std::ofstream(directory / "marketData_AAPL_2025-01-02.csv") << CSV_HEADER "2025-01-02 09:30:00,AAPL,1,2,3,1m\n";
+    write(CSV_HEADER "2025-01-02 09:30:00,NVDA,100,101,500,1m\n");
+
+    pollfd ready{cut.getFd(), POLLIN, 0};
+    ASSERT_EQ(::poll(&ready, 1, 1000), 1);
+    EXPECT_EQ(cut.poll(marketData), 1);
+    EXPECT_EQ(marketData.getCurrentData().Ticker, "NVDA");
+
+    write("2025-01-02 09:31:00,NVDA,101,102,600,1m\n");
+    ASSERT_EQ(::poll(&ready, 1, 1000), 1);
+    EXPECT_EQ(cut.poll(marketData), 1);
+    EXPECT_EQ(marketData.getData().size(), 2);
+}
+
+TEST_F(CSVFollowerTests, SkipsMalformedRows)
+{
+    CSVFollower cut(directory.string(), "marketData_NVDA_");
+    write(CSV_HEADER "not,a,row\n2025-01-02 09:30:00,NVDA,100,101,500,1m\n");
+
+    std::vector<MarketCondition> rows;
+    EXPECT_EQ(cut.readAppended(filePath, rows), 1);
+}
+
+TEST_F(CSVFollowerTests, MissingFileReadsNothing)
+{
+    CSVFollower cut(directory.string(), "marketData_NVDA_");
+    std::vector<MarketCondition> rows;
+    EXPECT_EQ(cut.readAppended(filePath, rows), 0);
+    EXPECT_EQ(cut.getOffset(filePath), 0);
+}
+
+TEST(MarketDataAppendTests, SkipsBarsAlreadyHeld)
+{
+    MarketData cut;
+    std::vector<MarketCondition> first = {
+        MarketCondition("2025-01-02 09:30:00", "NVDA", 100, 101, 500, "1m"),
+        MarketCondition("2025-01-02 09:31:00", "NVDA", 101, 102, 600, "1m")
+    };
+    EXPECT_EQ(cut.append(first), 2);
+
+    std::vector<MarketCondition> second = {
+        MarketCondition("2025-01-02 09:31:00", "NVDA", 101, 102, 600, "1m"),
+        MarketCondition("2025-01-02 09:32:00", "NVDA", 102, 103, 700, "1m")
+    };
+    EXPECT_EQ(cut.append(second), 1);
+    EXPECT_EQ(cut.getData().size(), 3);
+}
@@ -60,4 +60,19 @@ TEST_F(MarketDataTests, CanGetTheLastClosePrice)
 {
     cut.loadData(dataFilePath);
     EXPECT_EQ(cut.getLastClosePrice(), 109);
-}
\ No newline at end of file
+}
+TEST_F(MarketDataTests, BarsSortByParsedTimeKeepingTheLastRepeat)
+{
+    // "2025-02-10" sorts before "2025-02-9" as text, not as a time
+    std::vector<MarketCondition> bars = {
+        MarketCondition("2025-02-10 09:30:00", "AAPL", 100, 102, 1000, "1m"),
+        MarketCondition("2025-02-9 09:30:00", "AAPL", 100, 101, 1000, "1m"),
+        MarketCondition("2025-02-10 09:30:00", "AAPL", 100, 103, 1000, "1m"),
+    };
+    sortUniqueByTime(bars);
+
+    ASSERT_EQ(bars.size(), 2);
+    EXPECT_EQ(bars[0].Close, 101);
+    EXPECT_EQ(bars[1].Close, 103);
+    EXPECT_LT(bars[0].Time, bars[1].Time);
+}
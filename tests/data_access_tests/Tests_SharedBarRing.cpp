@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "../../src/data_access/SharedBarRing.hpp"
+
+// Unique per process so parallel test runs do not share a ring
+static std::string
+ringName(const std::string& test)
+{
+    return "/algo_trader_bars_test_" + test + "_" + std::to_string(getpid());
+}
+
+static MarketCondition
+barAt(int minute, float close)
+{
+    char dateTime[32];
+    std::snprintf(dateTime, sizeof(dateTime), "2025-01-02 %02d:%02d:00", 9 + (30 + minute) / 60, (30 + minute) % 60);
+    return MarketCondition(dateTime, "NVDA", close - 1, close, 100 + minute, "1m");
+}
+
+TEST(SharedBarRingTests, ReaderSeesPublishedBars)
+{
+    SharedBarWriter writer(ringName("published"), 16);
+    SharedBarReader reader(ringName("published"));
+
+    writer.publish(barAt(0, 100));
+    writer.publish(barAt(1, 101));
+
+    std::vector<MarketCondition> rows;
+    ASSERT_EQ(reader.read(rows), 2);
+    EXPECT_EQ(rows[0].DateTime, "2025-01-02 09:30:00");
+    EXPECT_EQ(rows[0].Ticker, "NVDA");
+    EXPECT_EQ(rows[0].TimeInterval, "1m");
+    EXPECT_EQ(rows[1].Open, 100);
+    EXPECT_EQ(rows[1].Close, 101);
+    EXPECT_EQ(rows[1].Volume, 101);
+
+    EXPECT_EQ(reader.read(rows), 0);
+    writer.publish(barAt(2, 102));
+    EXPECT_EQ(reader.read(rows), 1);
+    EXPECT_EQ(reader.getNextSequence(), 3);
+}
+
+TEST(SharedBarRingTests, SlowReaderSkipsToTheOldestBarLeft)
+{
+    SharedBarWriter writer(ringName("lapped"), 4);
+    SharedBarReader reader(ringName("lapped"));
+
+    for (int i = 0; i < 10; i++) {
+        writer.publish(barAt(i, 100 + i));
+    }
+
+    std::vector<MarketCondition> rows;
+    ASSERT_EQ(reader.read(rows), 4);
+    EXPECT_EQ(reader.getDroppedCount(), 6);
+    EXPECT_EQ(rows.front().Close, 106);
+    EXPECT_EQ(rows.back().Close, 109);
+}
+
+TEST(SharedBarRingTests, PollAppendsToMarketData)
+{
+    SharedBarWriter writer(ringName("poll"), 16);
+    SharedBarReader reader(ringName("poll"));
+    MarketData marketData;
+
+    writer.publish(barAt(0, 100));
+    writer.publish(barAt(1, 101));
+    EXPECT_EQ(reader.poll(marketData), 2);
+    EXPECT_EQ(marketData.getCurrentData().Close, 101);
+}
+
+TEST(SharedBarRingTests, ReaderStartsAgainWhenTheWriterRestarts)
+{
+    std::string name = ringName("restart");
+    std::vector<MarketCondition> rows;
+    SharedBarWriter writer(name, 16);
+    SharedBarReader reader(name);
+
+    writer.publish(barAt(0, 100));
+    writer.publish(barAt(1, 101));
+    reader.read(rows);
+
+    // A new writer over the same segment, before the old one is gone
+    SharedBarWriter restarted(name, 16);
+    restarted.publish(barAt(2, 102));
+    rows.clear();
+    ASSERT_EQ(reader.read(rows), 1);
+    EXPECT_EQ(rows[0].Close, 102);
+}
+
+TEST(SharedBarRingTests, MissingRingThrows)
+{
+    EXPECT_THROW(SharedBarReader(ringName("missing")), std::runtime_error);
+}
+
+TEST(SharedBarRingTests, ReadsBarsFromThePythonProducer)
+{
+    std::string name = ringName("python");
+    Config config;
+    std::string script = config.getAbsolutePath("src/python/shared_bars.py");
+    std::string command = "python3 " + script + " --name " + name +
+                          " --count 50 --interval-ms 0 --keep > /dev/null 2>&1";
+    if (std::system(command.c_str()) != 0) {
+        GTEST_SKIP() << "python3 not available";
+    }
+
+    SharedBarReader reader(name);
+    std::vector<MarketCondition> rows;
+    EXPECT_EQ(reader.read(rows), 50);
+    shm_unlink(name.c_str());
+
+    ASSERT_EQ(rows.size(), 50);
+    EXPECT_EQ(rows.front().Ticker, "NVDA");
+    for (size_t i = 1; i < rows.size(); i++) {
+        EXPECT_LT(rows[i - 1].DateTime, rows[i].DateTime);
+        EXPECT_FLOAT_EQ(rows[i].Open, rows[i - 1].Close);
+    }
+}
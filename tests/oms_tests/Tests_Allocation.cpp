@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <new>
+#include "../../src/oms/OrderManagement.hpp"
+
+// Count heap allocations made while counting is switched on
+static bool countAllocations = false;
+static size_t allocations = 0;
+
+void* operator new(std::size_t size)
+{
+    if (countAllocations) {
+        allocations++;
+    }
+    if (void* memory = std::malloc(size ? size : 1)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+
+class AcceptingBroker : public BrokerBase
+{
+    public:
+        int connect() override { return 1; }
+        int disconnect() override { return 1; }
+        float getLatestPrice(std::string) override { return 0; }
+        Position getLatestPosition(std::string) override { return Position(); }
+        int placeOrder(const Order&) override { return ++lastId; }
+
+        int lastId = 0;
+};
+
+TEST(OrderAllocationTests, SteadyStateTradingDoesNotAllocate)
+{
+    Config config;
+    config.loadJson(config.getTestPath("strategy_tests/test_data/config_test.json"));
+    AcceptingBroker broker;
+    OrderManagement cut;
+    cut.setUp(RiskConfig::fromJson(config.loadConfig()), &broker);
+
+    MarketData marketData;
+    marketData.loadData(config.getTestPath("data_access_tests/test_data/market_data_test_1.csv"));
+    cut.setMarketData(marketData);
+
+    // Book, fill and close one order per bar
+    auto trade = [&cut]() {
+        Order order{OrderType::BUY, "AAPL", 1, 109.0};
+        order.setStopLoss(5);
+        order.setTakeProfit(5);
+        cut.onNewOrder(order);
+
+        BrokerEvent fill = BrokerEvent::make(BrokerEventType::FILL, order, 1);
+        fill.quantity = order.getQuantity();
+        fill.price = order.getPrice();
+        cut.onBrokerEvent(fill);
+
+        cut.removePosition(cut.getPositions().back().getId());
+    };
+
+    // The first round sizes the reusable batch storage
+    trade();
+
+    countAllocations = true;
+    for (int i = 0; i < 1000; i++) {
+        trade();
+    }
+    countAllocations = false;
+
+    EXPECT_EQ(allocations, 0u);
+    EXPECT_EQ(cut.getOrders().size(), 0u);
+    EXPECT_EQ(cut.latestOrderId, 1002);
+}
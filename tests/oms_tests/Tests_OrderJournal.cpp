@@ -0,0 +1,316 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include "../../src/oms/OrderJournal.hpp"
+#include "../../src/oms/OrderManagement.hpp"
+#include "../../src/util/Config.hpp"
+
+// Acks and fills every order as soon as it is placed
+class FillingBroker : public BrokerBase
+{
+    public:
+        int connect() override { return 1; }
+        int disconnect() override { return 1; }
+        float getLatestPrice(std::string) override { return 0; }
+        Position getLatestPosition(std::string) override { return Position(); }
+
+        int placeOrder(const Order& order) override
+        {
+            int clientOrderId = nextClientOrderId();
+            publishEvent(BrokerEvent::make(BrokerEventType::ACK, order, clientOrderId));
+            BrokerEvent fill = BrokerEvent::make(BrokerEventType::FILL, order, clientOrderId);
+            fill.quantity = order.getQuantity();
+            fill.remainingQuantity = 0;
+            publishEvent(fill);
+            return clientOrderId;
+        }
+};
+
+class OrderJournalTests : public ::testing::Test
+{
+    public:
+
+    void SetUp() override
+    {
+        path = (std::filesystem::temp_directory_path() /
+                ("order_journal_" + std::string(::testing::UnitTest::GetInstance()->current_test_info()->name()))).string();
+        std::filesystem::remove(path);
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove(path);
+    }
+
+    Order MakeOrder(int id, float quantity)
+    {
+        Order order{OrderType::BUY, "AAPL", quantity, 109.0};
+        order.setId(id);
+        order.setStopLossPrice(100.0);
+        order.setTakeProfitPrice(120.0);
+        return order;
+    }
+
+    std::vector<JournalRecord> Replay(const OrderJournal& journal)
+    {
+        std::vector<JournalRecord> records;
+        journal.replay([&records](const JournalRecord& record) { records.push_back(record); });
+        return records;
+    }
+
+    std::string path;
+};
+
+TEST_F(OrderJournalTests, RecordsSurviveReopening)
+{
+    {
+        OrderJournal journal(path, 64);
+        journal.appendOrder(JournalRecordType::ORDER_ADDED, MakeOrder(7, 5));
+        journal.appendPosition(Position{"MSFT", -3, 250.0});
+        journal.appendOrderRemoved(7);
+    }
+
+    OrderJournal journal(path, 64);
+    std::vector<JournalRecord> records = Replay(journal);
+
+    ASSERT_EQ(3, records.size());
+    EXPECT_EQ(3u, journal.getSequence());
+
+    Order order = OrderJournal::decodeOrder(records[0]);
+    EXPECT_EQ(7, order.getId());
+    EXPECT_EQ("AAPL", order.getTicker());
+    EXPECT_FLOAT_EQ(5.0, order.getQuantity());
+    EXPECT_FLOAT_EQ(120.0, order.getTakeProfitPrice());
+
+    Position position = OrderJournal::decodePosition(records[1]);
+    EXPECT_EQ("MSFT", position.getTicker());
+    EXPECT_FLOAT_EQ(-3.0, position.getQuantity());
+
+    EXPECT_EQ(JournalRecordType::ORDER_REMOVED, records[2].type);
+    EXPECT_EQ(7, OrderJournal::decodeId(records[2]));
+}
+
+TEST_F(OrderJournalTests, RejectsAFileWithADifferentLayout)
+{
+    { OrderJournal journal(path, 64); }
+
+    EXPECT_THROW(OrderJournal(path, 128), std::runtime_error);
+}
+
+TEST_F(OrderJournalTests, TornRecordEndsTheJournal)
+{
+    {
+        OrderJournal journal(path, 64);
+        for (int i = 1; i <= 5; i++) {
+            journal.appendOrderRemoved(i);
+        }
+    }
+
+    // Damage the payload of the fourth record as a crash mid-write would
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(JOURNAL_HEADER_SIZE + 3 * sizeof(JournalRecord) + 20);
+        file.put('\x7f');
+    }
+
+    OrderJournal journal(path, 64);
+    EXPECT_EQ(3u, journal.getSequence());
+    EXPECT_EQ(3, Replay(journal).size());
+
+    // New records carry on from the last good one
+    journal.appendOrderRemoved(9);
+    EXPECT_EQ(4u, journal.getSequence());
+}
+
+TEST_F(OrderJournalTests, CheckpointsLetTheRingWrap)
+{
+    {
+        OrderJournal journal(path, 64);
+        for (int i = 1; i <= 1000; i++) {
+            journal.appendOrderRemoved(i);
+            if (journal.needsCheckpoint()) {
+                journal.beginCheckpoint(i, 1);
+                journal.appendOrder(JournalRecordType::ORDER_ADDED, MakeOrder(i, 1));
+                journal.endCheckpoint();
+            }
+        }
+    }
+
+    OrderJournal journal(path, 64);
+    std::vector<JournalRecord> records = Replay(journal);
+
+    ASSERT_GE(records.size(), 3);
+    EXPECT_EQ(JournalRecordType::CHECKPOINT_BEGIN, records[0].type);
+    EXPECT_EQ(JournalRecordType::CHECKPOINT_END, records[2].type);
+    EXPECT_EQ(1000, OrderJournal::decodeId(records.back()));
+}
+
+TEST_F(OrderJournalTests, RefusesToOverwriteWithoutACheckpoint)
+{
+    OrderJournal journal(path, 64);
+    for (int i = 1; i <= 64; i++) {
+        journal.appendOrderRemoved(i);
+    }
+
+    // The 65th record would land on the first
+    EXPECT_THROW(journal.appendOrderRemoved(65), std::runtime_error);
+}
+
+TEST_F(OrderJournalTests, UnfinishedCheckpointIsDiscarded)
+{
+    {
+        OrderJournal journal(path, 64);
+        journal.appendOrderRemoved(1);
+        journal.beginCheckpoint(2, 1);
+        journal.appendOrder(JournalRecordType::ORDER_ADDED, MakeOrder(1, 1));
+    }
+
+    OrderJournal journal(path, 64);
+    EXPECT_EQ(1u, journal.getSequence());
+    EXPECT_EQ(1, Replay(journal).size());
+}
+
+TEST_F(OrderJournalTests, OrderManagementRecoversFromACheckpoint)
+{
+    int latestOrderId = 0;
+    int latestPositionId = 0;
+    {
+        OrderJournal journal(path, 64);
+        OrderManagement oms;
+        oms.attachJournal(&journal);
+
+        // Far more activity than the ring holds, checkpointed as it goes
+        for (int i = 0; i < 100; i++) {
+            Order order{OrderType::SELL, "MSFT", 1, 250.0};
+            oms.addOrder(order);
+            oms.removeOrder(order.getId());
+            if (journal.needsCheckpoint()) {
+                oms.reset();
+                Order kept{OrderType::BUY, "AAPL", 4, 109.0};
+                oms.addOrder(kept);
+                Position held{"AAPL", 4, 105.0};
+                oms.addPosition(held);
+            }
+        }
+        latestOrderId = oms.latestOrderId;
+        latestPositionId = oms.latestPositionId;
+        journal.sync();
+    }
+
+    OrderJournal journal(path, 64);
+    OrderManagement oms;
+    oms.attachJournal(&journal);
+
+    EXPECT_EQ(latestOrderId, oms.latestOrderId);
+    EXPECT_EQ(latestPositionId, oms.latestPositionId);
+    ASSERT_EQ(1, oms.getOrders().size());
+    EXPECT_FLOAT_EQ(4.0, oms.getOrders()[0].getQuantity());
+    EXPECT_FLOAT_EQ(4.0, oms.getHeldQuantity("AAPL"));
+}
+
+TEST_F(OrderJournalTests, PartialFillsAndIdsAreRecovered)
+{
+    {
+        OrderJournal journal(path, 64);
+        OrderManagement oms;
+        oms.attachJournal(&journal);
+
+        for (int i = 0; i < 3; i++) {
+            Order order{OrderType::BUY, "AAPL", 10, 109.0};
+            oms.addOrder(order);
+        }
+
+        BrokerEvent partial = BrokerEvent::make(BrokerEventType::PARTIAL_FILL, *oms.findOrder(2), 1);
+        partial.quantity = 6;
+        partial.price = 110.0;
+        oms.onBrokerEvent(partial);
+        oms.removeOrder(1);
+    }
+
+    OrderJournal journal(path, 64);
+    OrderManagement oms;
+    oms.attachJournal(&journal);
+
+    EXPECT_EQ(4, oms.latestOrderId);
+    EXPECT_EQ(2, oms.latestPositionId);
+    ASSERT_EQ(2, oms.getOrders().size());
+    EXPECT_EQ(nullptr, oms.findOrder(1));
+    ASSERT_NE(nullptr, oms.findOrder(2));
+    EXPECT_FLOAT_EQ(4.0, oms.findOrder(2)->getQuantity());
+    ASSERT_EQ(1, oms.getPositions().size());
+    EXPECT_FLOAT_EQ(6.0, oms.getHeldQuantity("AAPL"));
+
+    // The next order continues the old numbering
+    Order order{OrderType::BUY, "AAPL", 1, 109.0};
+    oms.addOrder(order);
+    EXPECT_EQ(4, order.getId());
+}
+
+TEST_F(OrderJournalTests, RejectsATruncatedFile)
+{
+    { OrderJournal journal(path, 64); }
+    std::filesystem::resize_file(path, JOURNAL_HEADER_SIZE + 10 * sizeof(JournalRecord));
+
+    EXPECT_THROW(OrderJournal(path, 64), std::runtime_error);
+}
+
+TEST_F(OrderJournalTests, MoreFillsThanTheRingHolds)
+{
+    const size_t capacity = 64;
+    const int fills = 1001;     // Several records each, many times the ring
+    float held = 0;
+    {
+        Config config;
+        config.loadJson(config.getTestPath("strategy_tests/test_data/config_test.json"));
+        MarketData marketData;
+        marketData.loadData(config.getTestPath("data_access_tests/test_data/market_data_test_1.csv"));
+
+        OrderJournal journal(path, capacity);
+        FillingBroker broker;
+        OrderManagement oms;
+        oms.setUp(RiskConfig::fromJson(config.loadConfig()), &broker);
+        oms.setMarketData(marketData);
+        oms.attachJournal(&journal);
+
+        for (int i = 0; i < fills; i++) {
+            Order order{i % 2 == 1 ? OrderType::SELL : OrderType::BUY, "AAPL", 2, 109.0};
+            order.setStopLoss(5);
+            order.setTakeProfit(5);
+            ASSERT_EQ(1, oms.onNewOrders(std::span<Order>(&order, 1))) << "fill " << i;
+            ASSERT_EQ(2, oms.processBrokerEvents());
+            held += order.isSell() ? -2 : 2;
+
+            // The book stays the size of the portfolio
+            ASSERT_LE(oms.getPositions().size(), 1);
+            ASSERT_EQ(0, oms.getOrders().size());
+        }
+        EXPECT_GT(journal.getSequence(), 4 * capacity);
+        EXPECT_EQ(0u, broker.getPendingEventCount());
+    }
+
+    OrderJournal journal(path, capacity);
+    OrderManagement oms;
+    oms.attachJournal(&journal);
+    ASSERT_EQ(1, oms.getPositions().size());
+    EXPECT_FLOAT_EQ(held, oms.getPositions()[0].getQuantity());
+    EXPECT_FLOAT_EQ(held, oms.getHeldQuantity("AAPL"));
+}
+
+TEST_F(OrderJournalTests, AppendTakesAFewMicroseconds)
+{
+    OrderJournal journal(path);
+    Order order = MakeOrder(1, 10);
+
+    const int appends = 10000;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < appends; i++) {
+        journal.appendOrder(JournalRecordType::ORDER_ADDED, order);
+    }
+    journal.sync();
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+
+    double perAppend = elapsed.count() / appends;
+    std::cout << "OrderJournal::appendOrder: " << perAppend << " us per record, syncs included" << std::endl;
+    EXPECT_LT(perAppend, 5.0);
+}
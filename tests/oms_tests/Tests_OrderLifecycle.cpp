@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+#include "../../src/oms/OrderLifecycle.hpp"
+
+TEST(OrderLifecycleTests, FollowsAnOrderToItsFill)
+{
+    OrderLifecycle cut;
+    cut.open(1, 100);
+
+    EXPECT_TRUE(cut.transition(1, OrderStatus::VALIDATED, 150));
+    EXPECT_TRUE(cut.transition(1, OrderStatus::SENT, 300));
+    EXPECT_TRUE(cut.transition(1, OrderStatus::ACKED, 1300));
+    EXPECT_TRUE(cut.transition(1, OrderStatus::PARTIALLY_FILLED, 2000));
+    EXPECT_TRUE(cut.transition(1, OrderStatus::PARTIALLY_FILLED, 2500));
+    EXPECT_EQ(cut.getStatus(1), OrderStatus::PARTIALLY_FILLED);
+    EXPECT_TRUE(cut.transition(1, OrderStatus::FILLED, 3000));
+
+    EXPECT_FALSE(cut.isOpen(1));
+    EXPECT_EQ(cut.getOpenCount(), 0u);
+    EXPECT_EQ(cut.getCompletedCount(), 1u);
+    EXPECT_EQ(cut.getStatus(1), OrderStatus::FILLED);
+
+    // Repeated partial fills keep the first one's time
+    EXPECT_EQ(cut.getTimestamp(1, OrderStatus::PARTIALLY_FILLED), 2000);
+    EXPECT_EQ(cut.getLatencies(OrderStatus::NEW, OrderStatus::FILLED).p50, 2900);
+    EXPECT_EQ(cut.getLatencies(OrderStatus::SENT, OrderStatus::ACKED).p50, 1000);
+}
+
+TEST(OrderLifecycleTests, RefusesIllegalTransitions)
+{
+    OrderLifecycle cut;
+    cut.open(1, 100);
+
+    EXPECT_FALSE(cut.transition(1, OrderStatus::FILLED, 200));
+    EXPECT_FALSE(cut.transition(2, OrderStatus::VALIDATED, 200));
+    EXPECT_EQ(cut.getStatus(1), OrderStatus::NEW);
+
+    EXPECT_TRUE(cut.transition(1, OrderStatus::REJECTED, 200));
+    EXPECT_FALSE(cut.transition(1, OrderStatus::VALIDATED, 300));
+    EXPECT_EQ(cut.getIllegalTransitions(), 3u);
+}
+
+TEST(OrderLifecycleTests, FillsMayArriveWithoutAnAck)
+{
+    EXPECT_TRUE(OrderLifecycle::canTransition(OrderStatus::SENT, OrderStatus::FILLED));
+    EXPECT_FALSE(OrderLifecycle::canTransition(OrderStatus::VALIDATED, OrderStatus::ACKED));
+    EXPECT_TRUE(OrderLifecycle::isTerminal(OrderStatus::CANCELLED));
+    EXPECT_FALSE(OrderLifecycle::isTerminal(OrderStatus::PARTIALLY_FILLED));
+}
+
+TEST(OrderLifecycleTests, SummarisesLatencyDistributions)
+{
+    OrderLifecycle cut;
+    for (int id = 1; id <= 100; id++) {
+        cut.open(id, 1000);
+        cut.transition(id, OrderStatus::VALIDATED, 1000);
+        cut.transition(id, OrderStatus::SENT, 1000);
+        cut.transition(id, OrderStatus::FILLED, 1000 + id * 1000);
+    }
+
+    LatencyStats stats = cut.getLatencies(OrderStatus::NEW, OrderStatus::FILLED);
+    EXPECT_EQ(stats.count, 100u);
+    EXPECT_DOUBLE_EQ(stats.mean, 50500.0);
+    EXPECT_EQ(stats.p50, 50000);
+    EXPECT_EQ(stats.p90, 90000);
+    EXPECT_EQ(stats.p99, 99000);
+    EXPECT_EQ(stats.max, 100000);
+
+    // No order was acked, so there is nothing to report for that stage
+    EXPECT_EQ(cut.getLatencies(OrderStatus::SENT, OrderStatus::ACKED).count, 0u);
+}
+
+TEST(OrderLifecycleTests, KeepsABoundedHistory)
+{
+    OrderLifecycle cut(4);
+    for (int id = 1; id <= 10; id++) {
+        cut.open(id, 1);
+        cut.transition(id, OrderStatus::CANCELLED, 2);
+    }
+
+    EXPECT_EQ(cut.getCompletedCount(), 4u);
+    EXPECT_EQ(cut.getStatus(10), OrderStatus::CANCELLED);
+}
@@ -232,4 +232,19 @@ TEST(OrderTests, TakeProfitPriceForShortIsCorrectlyCalculated)
         cut.setTakeProfit(-10);
         EXPECT_EQ(cut.getTakeProfitPrice(), 110);   
     }
-}
\ No newline at end of file
+}
+
+TEST(OrderTests, TickerIsStoredInline)
+{
+    Order cut{OrderType::BUY, "BRK.B", 1, 400.0};
+    cut.setTickerId(3);
+
+    Order copy = cut;
+    EXPECT_EQ(copy.getTicker(), "BRK.B");
+    EXPECT_EQ(copy.getTickerId(), 3);
+
+    // Changing the symbol forgets the interned id, long symbols are truncated
+    copy.setTicker("A_VERY_LONG_TICKER_SYMBOL");
+    EXPECT_EQ(copy.getTickerId(), -1);
+    EXPECT_EQ(copy.getTicker().size(), TICKER_SYMBOL_LENGTH - 1u);
+}
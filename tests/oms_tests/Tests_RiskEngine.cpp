@@ -0,0 +1,200 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <random>
+#include "../../src/oms/OrderValidator.hpp"
+#include "../../src/oms/RiskEngine.hpp"
+
+class RiskEngineTests : public ::testing::Test {
+public:
+
+    RiskEngine cut;
+    OrderValidator validator;
+    Config config;
+    json algoTestConfig;
+    MarketData marketData;
+
+    void SetUp() override
+    {
+        config.loadJson(config.getTestPath("strategy_tests/test_data/config_test.json"));
+        algoTestConfig = config.loadConfig();
+        cut.setParams(RiskConfig::fromJson(algoTestConfig));
+        validator.setParams(RiskConfig::fromJson(algoTestConfig));
+
+        marketData.loadData(config.getTestPath("data_access_tests/test_data/market_data_test_1.csv"));
+    }
+
+    // The test data closes at 109
+    void GivenWeHaveATick(double equity = 0.0)
+    {
+        cut.onTick(0, marketData.getLastClosePrice(), equity);
+    }
+
+    Order MakeOrder(OrderType type, float quantity, float price, float stopLoss = 5, float takeProfit = 5)
+    {
+        Order order{type, "AAPL", quantity, price};
+        order.setStopLoss(stopLoss);
+        order.setTakeProfit(takeProfit);
+        return order;
+    }
+};
+
+TEST_F(RiskEngineTests, AcceptsAValidOrder)
+{
+    GivenWeHaveATick();
+
+    EXPECT_EQ(cut.check(MakeOrder(OrderType::BUY, 10, 109.0), 0), 0u);
+    EXPECT_EQ(cut.check(MakeOrder(OrderType::SELL, 10, 109.0), 0), 0u);
+}
+
+TEST_F(RiskEngineTests, ReportsEveryFailedCheck)
+{
+    GivenWeHaveATick();
+
+    uint32_t failures = cut.check(MakeOrder(OrderType::BUY, 20, 130.0, 0, 0), 0);
+
+    EXPECT_TRUE(failures & RISK_PRICE_BAND);
+    EXPECT_TRUE(failures & RISK_QUANTITY);
+    EXPECT_TRUE(failures & RISK_POSITION_LIMIT);
+    EXPECT_TRUE(failures & RISK_STOP_LOSS);
+    EXPECT_TRUE(failures & RISK_SLIPPAGE);
+    EXPECT_FALSE(failures & RISK_TAKE_PROFIT);
+    EXPECT_FALSE(failures & RISK_ORDER_TYPE);
+    EXPECT_EQ(RiskEngine::describe(RISK_ORDER_TYPE | RISK_SLIPPAGE), "order type, slippage");
+}
+
+TEST_F(RiskEngineTests, RejectsEverythingWithoutMarketData)
+{
+    EXPECT_EQ(cut.check(MakeOrder(OrderType::BUY, 10, 109.0), 0), RISK_NO_MARKET_DATA);
+}
+
+TEST_F(RiskEngineTests, AgreesWithOrderValidator)
+{
+    GivenWeHaveATick();
+    std::vector<Position> positions;
+
+    std::mt19937 gen(11);
+    std::uniform_int_distribution<int> types(0, static_cast<int>(OrderType::UNKNOWN));
+    std::uniform_real_distribution<float> quantities(-1.0f, 14.0f);
+    std::uniform_real_distribution<float> prices(100.0f, 118.0f);
+    std::uniform_int_distribution<int> percentages(0, 12);
+
+    for (int i = 0; i < 5000; i++) {
+        if (i == 2500) {
+            // Second half runs with an existing holding
+            positions.push_back(Position{"AAPL", 4, 105.0});
+            cut.onPositionAdded(0, 4, 105.0);
+        }
+
+        Order order = MakeOrder(static_cast<OrderType>(types(gen)), quantities(gen), prices(gen),
+                                percentages(gen), percentages(gen));
+
+        ASSERT_EQ(cut.check(order, 0) == 0, validator.validateOrder(order, marketData, positions))
+            << order.getTypeAsString() << " " << order.getQuantity() << " @ " << order.getPrice()
+            << " failures: " << RiskEngine::describe(cut.check(order, 0));
+    }
+}
+
+TEST_F(RiskEngineTests, ExposureIsMaintainedIncrementally)
+{
+    cut.onPositionAdded(0, 10, 100.0);
+    EXPECT_DOUBLE_EQ(cut.getGrossExposure(), 1000.0);
+
+    cut.onPrice(0, 110.0);
+    EXPECT_DOUBLE_EQ(cut.getTickerNotional(0), 1100.0);
+
+    cut.onPositionAdded(1, -5, 50.0);
+    EXPECT_DOUBLE_EQ(cut.getGrossExposure(), 1350.0);
+    EXPECT_DOUBLE_EQ(cut.getNetExposure(), 850.0);
+
+    Order working{OrderType::BUY, "AAPL", 2, 110.0};
+    cut.onOrderOpened(0, working);
+    EXPECT_DOUBLE_EQ(cut.getOpenOrderNotional(), 220.0);
+
+    cut.onOrderReduced(0, working, 2);
+    cut.onPositionRemoved(1, -5);
+    EXPECT_DOUBLE_EQ(cut.getOpenOrderNotional(), 0.0);
+    EXPECT_DOUBLE_EQ(cut.getGrossExposure(), 1100.0);
+    EXPECT_DOUBLE_EQ(cut.getNetExposure(), 1100.0);
+}
+
+TEST_F(RiskEngineTests, ExposureIsLimitedToAMultipleOfEquity)
+{
+    // max_exposure 5.0 on $1000 of equity allows $5000 gross
+    GivenWeHaveATick(1000.0);
+    cut.onPositionAdded(1, 40, 100.0);
+
+    EXPECT_EQ(cut.check(MakeOrder(OrderType::BUY, 5, 109.0), 0), 0u);
+
+    // Working orders count against the limit too
+    cut.onOrderOpened(0, Order{OrderType::SELL, "AAPL", 5, 109.0});
+    EXPECT_EQ(cut.check(MakeOrder(OrderType::BUY, 5, 109.0), 0), RISK_EXPOSURE);
+}
+
+TEST_F(RiskEngineTests, OrdersThatReduceExposurePassAtTheLimit)
+{
+    // $5000 allowed, a 45 share long at 109 plus a working buy is over it
+    GivenWeHaveATick(1000.0);
+    cut.onPositionAdded(0, 45, 109.0);
+    cut.onOrderOpened(0, Order{OrderType::BUY, "AAPL", 1, 109.0});
+
+    EXPECT_TRUE(cut.check(MakeOrder(OrderType::BUY, 1, 109.0), 0) & RISK_EXPOSURE);
+    EXPECT_EQ(cut.check(MakeOrder(OrderType::SELL, 5, 109.0), 0), 0u);
+
+    // Covering a short the same way
+    cut.reset();
+    cut.onPositionAdded(0, -46, 109.0);
+    EXPECT_EQ(cut.check(MakeOrder(OrderType::SELL, 1, 109.0), 0), RISK_EXPOSURE);
+    EXPECT_EQ(cut.check(MakeOrder(OrderType::BUY, 5, 109.0), 0), 0u);
+}
+
+TEST_F(RiskEngineTests, OrdersThatFlipThePositionCountTheNewSide)
+{
+    GivenWeHaveATick(1000.0);
+    cut.onPositionAdded(0, 5, 109.0);
+    cut.onPositionAdded(1, 40, 109.0);
+
+    // Long 5 to short 5 leaves gross exposure where it was
+    EXPECT_EQ(cut.check(MakeOrder(OrderType::SELL, 10, 109.0), 0), 0u);
+
+    // With 5 already being sold the same order opens a 10 share short
+    cut.onOrderOpened(0, Order{OrderType::SELL, "AAPL", 5, 109.0});
+    EXPECT_EQ(cut.check(MakeOrder(OrderType::SELL, 10, 109.0), 0), RISK_EXPOSURE);
+}
+
+TEST_F(RiskEngineTests, PositionLimitCountsWorkingBuys)
+{
+    // max_position_size 10
+    GivenWeHaveATick();
+    cut.onPositionAdded(0, 4, 109.0);
+    EXPECT_EQ(cut.check(MakeOrder(OrderType::BUY, 6, 109.0), 0), 0u);
+
+    cut.onOrderOpened(0, Order{OrderType::BUY, "AAPL", 5, 109.0});
+    EXPECT_EQ(cut.check(MakeOrder(OrderType::BUY, 2, 109.0), 0), RISK_POSITION_LIMIT);
+    EXPECT_EQ(cut.check(MakeOrder(OrderType::BUY, 1, 109.0), 0), 0u);
+
+    // Selling never runs into the position limit
+    EXPECT_EQ(cut.check(MakeOrder(OrderType::SELL, 4, 109.0), 0), 0u);
+}
+
+TEST_F(RiskEngineTests, CheckIsUnderAMicrosecond)
+{
+    GivenWeHaveATick(100000.0);
+    std::vector<Order> orders;
+    for (int i = 0; i < 1000; i++) {
+        orders.push_back(MakeOrder(i % 2 ? OrderType::BUY : OrderType::SELL, 1 + i % 10, 105.0 + i % 8));
+    }
+
+    uint32_t combined = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < 100; round++) {
+        for (const Order& order : orders) {
+            combined |= cut.check(order, 0);
+        }
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+    double perCheck = elapsed.count() / (100.0 * orders.size());
+    std::cout << "RiskEngine::check: " << perCheck << " ns per order" << std::endl;
+    EXPECT_LT(perCheck, 1000.0);
+    EXPECT_NE(combined, RISK_NO_MARKET_DATA);
+}
@@ -12,7 +12,7 @@ public:
     {
         config.loadJson(config.getTestPath("strategy_tests/test_data/config_test.json"));
         algoTestConfig = config.loadConfig();
-        cut.setParams(algoTestConfig);
+        cut.setParams(RiskConfig::fromJson(algoTestConfig));
     }
 
     void TearDown() override 
@@ -74,7 +74,7 @@ TEST_F(OrderValidatorTests, CanInstantiate)
 
 TEST_F(OrderValidatorTests, CanSetParams)
 {
-    cut.setParams(algoTestConfig);
+    cut.setParams(RiskConfig::fromJson(algoTestConfig));
 }
 
 TEST_F(OrderValidatorTests, GivenWeHaveABuyOrderType_WeValidateCorrectly)
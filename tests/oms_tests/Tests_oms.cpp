@@ -38,6 +38,12 @@ class OrderManagementTests : public ::testing::Test
         cut->addPosition(position);
     }
 
+    void Fill(OrderType type, float quantity, float price)
+    {
+        Order fill{type, "AAPL", quantity, price};
+        cut->onOrderExecuted(fill);
+    }
+
     Order order;
     Position position;
 };
@@ -192,4 +198,315 @@ TEST_F(OrderManagementTests, ResetWorksCorrectly)
     
     EXPECT_EQ(orders.size(), 0);
     EXPECT_EQ(positions.size(), 0);
-}
\ No newline at end of file
+}
+TEST_F(OrderManagementTests, FillEventAddsSignedPosition) 
+{
+    GenerateOrder();
+    int orderId = cut->getOrders()[0].getId();
+
+    Order sell{OrderType::SELL, "AAPL", 40.0, 120.0};
+    sell.setId(orderId);
+    cut->onBrokerEvent(BrokerEvent::make(BrokerEventType::ACK, sell, 1));
+    EXPECT_EQ(1, cut->getOrders().size());
+
+    BrokerEvent fill = BrokerEvent::make(BrokerEventType::FILL, sell, 1);
+    fill.quantity = 40.0;
+    cut->onBrokerEvent(fill);
+
+    EXPECT_EQ(0, cut->getOrders().size());
+    ASSERT_EQ(1, cut->getPositions().size());
+    EXPECT_FLOAT_EQ(-40.0, cut->getPositions()[0].getQuantity());
+}
+
+TEST_F(OrderManagementTests, RejectEventRemovesOrder) 
+{
+    GenerateOrder();
+    GenerateOrder();
+    Order rejected = cut->getOrders()[0];
+
+    cut->onBrokerEvent(BrokerEvent::make(BrokerEventType::REJECT, rejected, 1));
+
+    ASSERT_EQ(1, cut->getOrders().size());
+    EXPECT_NE(rejected.getId(), cut->getOrders()[0].getId());
+    EXPECT_EQ(0, cut->getPositions().size());
+}
+
+TEST_F(OrderManagementTests, RemovedOrdersAreNoLongerFound) 
+{
+    for (int i = 0; i < 10000; i++)
+        GenerateOrder();
+
+    for (int id = 1; id <= 10000; id += 2)
+        cut->removeOrder(id);
+
+    ASSERT_EQ(5000, cut->getOrders().size());
+    EXPECT_EQ(nullptr, cut->findOrder(1));
+    EXPECT_EQ(nullptr, cut->findOrder(9999));
+    for (int id = 2; id <= 10000; id += 2)
+    {
+        const Order* found = cut->findOrder(id);
+        ASSERT_NE(nullptr, found);
+        EXPECT_EQ(id, found->getId());
+    }
+
+    // Removing an unknown id is a no-op
+    cut->removeOrder(1);
+    EXPECT_EQ(5000, cut->getOrders().size());
+}
+
+TEST_F(OrderManagementTests, HeldQuantityIsTrackedPerTicker) 
+{
+    Position apple{"AAPL", 100.0, 120.0};
+    Position shortApple{"AAPL", -30.0, 121.0};
+    Position nvidia{"NVDA", 5.0, 900.0};
+    cut->addPosition(apple);
+    cut->addPosition(shortApple);
+    cut->addPosition(nvidia);
+
+    EXPECT_FLOAT_EQ(70.0, cut->getHeldQuantity("AAPL"));
+    EXPECT_FLOAT_EQ(5.0, cut->getHeldQuantity("NVDA"));
+    EXPECT_FLOAT_EQ(0.0, cut->getHeldQuantity("MSFT"));
+
+    cut->removePosition(apple.getId());
+    EXPECT_FLOAT_EQ(-30.0, cut->getHeldQuantity("AAPL"));
+    ASSERT_NE(nullptr, cut->findPosition(nvidia.getId()));
+    EXPECT_EQ("NVDA", cut->findPosition(nvidia.getId())->getTicker());
+
+    cut->reset();
+    EXPECT_FLOAT_EQ(0.0, cut->getHeldQuantity("AAPL"));
+    EXPECT_EQ(nullptr, cut->findPosition(nvidia.getId()));
+}
+
+TEST_F(OrderManagementTests, FillsOnTheSameSideAverageThePrice) 
+{
+    Fill(OrderType::BUY, 10, 100.0);
+    Fill(OrderType::BUY, 30, 120.0);
+
+    ASSERT_EQ(1, cut->getPositions().size());
+    EXPECT_FLOAT_EQ(40.0, cut->getPositions()[0].getQuantity());
+    EXPECT_FLOAT_EQ(115.0, cut->getPositions()[0].getAvgPrice());
+    EXPECT_FLOAT_EQ(40.0, cut->getHeldQuantity("AAPL"));
+}
+
+TEST_F(OrderManagementTests, ReducingFillsKeepThePrice) 
+{
+    Fill(OrderType::SELL, 20, 100.0);
+    Fill(OrderType::BUY, 5, 90.0);
+
+    ASSERT_EQ(1, cut->getPositions().size());
+    EXPECT_FLOAT_EQ(-15.0, cut->getPositions()[0].getQuantity());
+    EXPECT_FLOAT_EQ(100.0, cut->getPositions()[0].getAvgPrice());
+    EXPECT_FLOAT_EQ(-15.0, cut->getHeldQuantity("AAPL"));
+}
+
+TEST_F(OrderManagementTests, FlatteningFillsCloseThePosition) 
+{
+    Fill(OrderType::BUY, 10, 100.0);
+    Fill(OrderType::SELL, 4, 105.0);
+    Fill(OrderType::SELL, 6, 110.0);
+
+    EXPECT_EQ(0, cut->getPositions().size());
+    EXPECT_FLOAT_EQ(0.0, cut->getHeldQuantity("AAPL"));
+
+    // The next fill opens a fresh position
+    Fill(OrderType::BUY, 2, 90.0);
+    ASSERT_EQ(1, cut->getPositions().size());
+    EXPECT_FLOAT_EQ(90.0, cut->getPositions()[0].getAvgPrice());
+}
+
+TEST_F(OrderManagementTests, FillsCrossingZeroOpenTheOtherSideAtTheFillPrice) 
+{
+    Fill(OrderType::BUY, 10, 100.0);
+    Fill(OrderType::SELL, 15, 95.0);
+
+    ASSERT_EQ(1, cut->getPositions().size());
+    EXPECT_FLOAT_EQ(-5.0, cut->getPositions()[0].getQuantity());
+    EXPECT_FLOAT_EQ(95.0, cut->getPositions()[0].getAvgPrice());
+
+    Fill(OrderType::BUY, 8, 90.0);
+    ASSERT_EQ(1, cut->getPositions().size());
+    EXPECT_FLOAT_EQ(3.0, cut->getPositions()[0].getQuantity());
+    EXPECT_FLOAT_EQ(90.0, cut->getPositions()[0].getAvgPrice());
+    EXPECT_FLOAT_EQ(3.0, cut->getHeldQuantity("AAPL"));
+}
+
+TEST_F(OrderManagementTests, FillsFindTheirPositionAfterOthersClose) 
+{
+    for (int i = 0; i < 100; i++)
+    {
+        Order buy{OrderType::BUY, "T" + std::to_string(i), static_cast<float>(i + 1), 10.0};
+        cut->onOrderExecuted(buy);
+    }
+
+    // Flattening every other ticker moves the rest around the book
+    for (int i = 0; i < 100; i += 2)
+    {
+        Order sell{OrderType::SELL, "T" + std::to_string(i), static_cast<float>(i + 1), 10.0};
+        cut->onOrderExecuted(sell);
+    }
+    ASSERT_EQ(50, cut->getPositions().size());
+
+    for (int i = 1; i < 100; i += 2)
+    {
+        Order buy{OrderType::BUY, "T" + std::to_string(i), 1.0, 10.0};
+        cut->onOrderExecuted(buy);
+    }
+    ASSERT_EQ(50, cut->getPositions().size());
+    for (const Position& held : cut->getPositions())
+    {
+        int i = std::stoi(held.getTicker().substr(1));
+        EXPECT_FLOAT_EQ(i + 2.0f, held.getQuantity());
+    }
+}
+
+TEST_F(OrderManagementTests, TickerRegistryInternsSymbols) 
+{
+    TickerRegistry& tickers = cut->getTickers();
+    int apple = tickers.intern("AAPL");
+
+    for (int i = 0; i < 100; i++)
+        tickers.intern("T" + std::to_string(i));
+
+    EXPECT_EQ(apple, tickers.intern("AAPL"));
+    EXPECT_EQ(apple, tickers.find("AAPL"));
+    EXPECT_EQ("T42", tickers.getTicker(tickers.find("T42")));
+    EXPECT_EQ(TickerRegistry::NOT_FOUND, tickers.find("MSFT"));
+    EXPECT_EQ(101, tickers.size());
+}
+
+// Records what the OMS submits, accepting or refusing everything
+class RecordingBroker : public BrokerBase
+{
+    public:
+        int connect() override { return 1; }
+        int disconnect() override { return 1; }
+        float getLatestPrice(std::string) override { return 0; }
+        Position getLatestPosition(std::string) override { return Position(); }
+        int placeOrder(const Order&) override { return accept ? ++lastId : 0; }
+
+        int placeOrders(std::span<const Order> batch, std::span<int> clientOrderIds) override
+        {
+            batches++;
+            submitted.insert(submitted.end(), batch.begin(), batch.end());
+            return BrokerBase::placeOrders(batch, clientOrderIds);
+        }
+
+        bool accept = true;
+        int lastId = 0;
+        int batches = 0;
+        std::vector<Order> submitted;
+};
+
+class OrderBatchTests : public ::testing::Test 
+{
+    public:
+
+    void SetUp() override 
+    {
+        config.loadJson(config.getTestPath("strategy_tests/test_data/config_test.json"));
+        cut.setUp(RiskConfig::fromJson(config.loadConfig()), &broker);
+
+        // Closes at 109
+        MarketData marketData;
+        marketData.loadData(config.getTestPath("data_access_tests/test_data/market_data_test_1.csv"));
+        cut.setMarketData(marketData);
+    }
+
+    Order MakeOrder(OrderType type, float quantity, float stopLoss = 5)
+    {
+        Order order{type, "AAPL", quantity, 109.0};
+        order.setStopLoss(stopLoss);
+        order.setTakeProfit(5);
+        return order;
+    }
+
+    Config config;
+    RecordingBroker broker;
+    OrderManagement cut;
+};
+
+TEST_F(OrderBatchTests, OffsettingOrdersAreNettedIntoOneSubmission) 
+{
+    std::vector<Order> batch{MakeOrder(OrderType::BUY, 6), MakeOrder(OrderType::SELL, 4), MakeOrder(OrderType::BUY, 1)};
+
+    EXPECT_EQ(1, cut.onNewOrders(batch));
+
+    EXPECT_EQ(1, broker.batches);
+    ASSERT_EQ(1, broker.submitted.size());
+    EXPECT_EQ(OrderType::BUY, broker.submitted[0].getType());
+    EXPECT_FLOAT_EQ(3.0, broker.submitted[0].getQuantity());
+    ASSERT_EQ(1, cut.getOrders().size());
+    EXPECT_EQ(broker.submitted[0].getId(), cut.getOrders()[0].getId());
+}
+
+TEST_F(OrderBatchTests, FullyOffsettingOrdersSubmitNothing) 
+{
+    std::vector<Order> batch{MakeOrder(OrderType::BUY, 5), MakeOrder(OrderType::SELL, 5)};
+
+    EXPECT_EQ(0, cut.onNewOrders(batch));
+    EXPECT_EQ(0, broker.batches);
+    EXPECT_EQ(0, cut.getOrders().size());
+}
+
+TEST_F(OrderBatchTests, InvalidOrdersAreDroppedBeforeNetting) 
+{
+    // The sell has no stop loss, so it must not offset the buy
+    std::vector<Order> batch{MakeOrder(OrderType::BUY, 6), MakeOrder(OrderType::SELL, 4, 0)};
+
+    EXPECT_EQ(1, cut.onNewOrders(batch));
+    ASSERT_EQ(1, broker.submitted.size());
+    EXPECT_FLOAT_EQ(6.0, broker.submitted[0].getQuantity());
+    EXPECT_TRUE(cut.getLastRiskFailures() & RISK_STOP_LOSS);
+}
+
+TEST_F(OrderBatchTests, NettedOrderIsCheckedAgain) 
+{
+    // Each buy is inside max_position_size (10), together they are not
+    std::vector<Order> batch{MakeOrder(OrderType::BUY, 8), MakeOrder(OrderType::BUY, 7)};
+
+    EXPECT_EQ(0, cut.onNewOrders(batch));
+    EXPECT_TRUE(cut.getLastRiskFailures() & RISK_QUANTITY);
+    EXPECT_EQ(0, cut.getOrders().size());
+}
+
+TEST_F(OrderBatchTests, OrdersTheBrokerRefusesLeaveTheBook) 
+{
+    broker.accept = false;
+    Order order = MakeOrder(OrderType::LIMIT_BUY, 2);
+
+    cut.onNewOrder(order);
+
+    EXPECT_EQ(1, broker.batches);
+    EXPECT_EQ(0, cut.getOrders().size());
+    EXPECT_DOUBLE_EQ(0.0, cut.getRiskEngine().getOpenOrderNotional());
+}
+
+TEST_F(OrderBatchTests, OrdersMoveThroughTheirLifecycle) 
+{
+    Order order = MakeOrder(OrderType::BUY, 2);
+    cut.onNewOrder(order);
+    EXPECT_EQ(OrderStatus::SENT, cut.findOrder(order.getId())->getStatus());
+
+    cut.onBrokerEvent(BrokerEvent::make(BrokerEventType::ACK, order, 1));
+    EXPECT_EQ(OrderStatus::ACKED, cut.findOrder(order.getId())->getStatus());
+
+    BrokerEvent fill = BrokerEvent::make(BrokerEventType::FILL, order, 1);
+    fill.quantity = 2;
+    cut.onBrokerEvent(fill);
+
+    const OrderLifecycle& lifecycle = cut.getLifecycle();
+    EXPECT_EQ(OrderStatus::FILLED, lifecycle.getStatus(order.getId()));
+    EXPECT_EQ(1, lifecycle.getLatencies(OrderStatus::NEW, OrderStatus::FILLED).count);
+    EXPECT_LE(lifecycle.getTimestamp(order.getId(), OrderStatus::SENT),
+              lifecycle.getTimestamp(order.getId(), OrderStatus::ACKED));
+}
+
+TEST_F(OrderBatchTests, OrdersTheBrokerRefusesEndRejected) 
+{
+    broker.accept = false;
+    Order order = MakeOrder(OrderType::BUY, 2);
+    cut.onNewOrder(order);
+
+    EXPECT_EQ(OrderStatus::REJECTED, cut.getLifecycle().getStatus(order.getId()));
+    EXPECT_EQ(0, cut.getLifecycle().getOpenCount());
+}
@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <cmath>
 #include "../../src/strategy_engine/RSI.hpp"
 #include "../../src/strategy_engine/StrategyFactory.hpp"
 
@@ -281,4 +282,31 @@ TEST_F(RSITests, Calculation_10)
                                 431.2, 432.5, 433.1, 432.4, 431.5, 432.7};
 
     EXPECT_EQ(76.87f, rsi.calculateRSI(closes));
-}
\ No newline at end of file
+}
+TEST_F(RSITests, IncrementalWindowMatchesRecalculation)
+{
+    auto strats = strategyFactory.generateStrategies();
+    RSI rsi{strats[0].get()->_strategyAttribute};
+    int period = strats[0].get()->_strategyAttribute.period;
+
+    std::vector<MarketCondition> bars;
+    std::vector<float> allCloses;
+    for (int i = 0; i < 60; i++)
+    {
+        char dateTime[32];
+        std::snprintf(dateTime, sizeof(dateTime), "2025-01-02 10:%02d:00", i);
+        float close = 100.0f + 4.0f * std::sin(i / 5.0f);
+        bars.push_back(MarketCondition(dateTime, "NVDA", close, close, 1000, "1m"));
+        allCloses.push_back(close);
+
+        marketData.update(bars);
+        rsi.supplyData(marketData);
+        rsi.execute();
+
+        if (i + 1 >= period)
+        {
+            std::vector<float> window(allCloses.end() - period, allCloses.end());
+            EXPECT_FLOAT_EQ(rsi.getRSI(), rsi.calculateRSI(window)) << "bar " << i;
+        }
+    }
+}
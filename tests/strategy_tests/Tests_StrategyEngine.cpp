@@ -35,7 +35,7 @@ TEST_F(StrategyEngineTests, CanSetUpStrategyEngine)
     MarketData marketData;
     StrategyFactory stratFactory(stratFilePath);
     SimulatedBroker broker(marketData);
-    cut.setUp(jsonConfig, stratFactory, marketData, &broker);
+    cut.setUp(AppConfig::fromJson(jsonConfig), stratFactory, marketData, &broker);
 }
 
 
@@ -45,4 +45,48 @@ TEST_F(StrategyFactoryTests, StrategyFactory_GenerateStrategies)
     // Check the types of strategies
     EXPECT_EQ("RSI", strats[0].get()->_strategyAttribute.name);
     EXPECT_EQ("MACD", strats[1].get()->_strategyAttribute.name);
-}
\ No newline at end of file
+}
+TEST_F(StrategyFactoryTests, GenerateFleetGroupsByTypeInConfigOrder)
+{
+    StrategyFleet fleet = cut.generateFleet();
+
+    ASSERT_EQ(fleet.size(), 2);
+    EXPECT_EQ(fleet.all<RSI>().size(), 1);
+    EXPECT_EQ(fleet.all<MACD>().size(), 1);
+    EXPECT_TRUE(fleet.all<MEANREV>().empty());
+    EXPECT_EQ("RSI", fleet[0]._strategyAttribute.name);
+    EXPECT_EQ("MACD", fleet[1]._strategyAttribute.name);
+}
+
+TEST_F(StrategyFactoryTests, FleetVisitsEachTypeTogetherWithConfigSlots)
+{
+    json config = {{"strategies", {
+        {{"name", "RSI"}, {"active", 1}, {"period", 14}},
+        {{"name", "MACD"}, {"active", 1}, {"short_period", 12}},
+        {{"name", "RSI"}, {"active", 1}, {"period", 7}}
+    }}};
+    StrategyFleet fleet = StrategyFactory(config).generateFleet();
+
+    std::vector<std::pair<std::string, size_t>> visited;
+    fleet.forEach([&visited](auto& strategy, size_t slot) {
+        visited.push_back({strategy.Name, slot});
+    });
+
+    std::vector<std::pair<std::string, size_t>> expected{{"RSI", 0}, {"RSI", 2}, {"MACD", 1}};
+    EXPECT_EQ(visited, expected);
+    EXPECT_EQ(fleet[2]._strategyAttribute.period, 7);
+    EXPECT_EQ(&fleet[2], &fleet.all<RSI>()[1]);
+}
+
+TEST_F(StrategyFactoryTests, UnknownStrategyNamesAreSkipped)
+{
+    json config = {{"strategies", {
+        {{"name", "NOTASTRAT"}, {"active", 1}},
+        {{"name", "RSI"}, {"active", 1}, {"period", 14}}
+    }}};
+    StrategyFactory factory(config);
+
+    EXPECT_FALSE(StrategyFleet::isRegistered("NOTASTRAT"));
+    EXPECT_EQ(factory.generateFleet().size(), 1);
+    EXPECT_EQ(factory.generateStrategies().size(), 1);
+}
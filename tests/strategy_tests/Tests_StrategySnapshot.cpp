@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <filesystem>
+#include "../../src/strategy_engine/RSI.hpp"
+#include "../../src/strategy_engine/StrategyEngine.hpp"
+#include "../../src/broker/SimulatedBroker.hpp"
+
+namespace fs = std::filesystem;
+
+// One engine's market data, broker and strategies, fed a bar at a time
+struct SnapshotEngine
+{
+    MarketData marketData;
+    SimulatedBroker broker{marketData};
+    StrategyEngine engine;
+    std::vector<MarketCondition> bars;
+
+    explicit SnapshotEngine(const json& config)
+    {
+        StrategyFactory factory(config);
+        engine.setUp(AppConfig::fromJson(config), factory, marketData, &broker);
+    }
+
+    void add(const MarketCondition& bar)
+    {
+        bars.push_back(bar);
+        marketData.update(bars);
+    }
+
+    void step(const MarketCondition& bar)
+    {
+        add(bar);
+        engine.run();
+    }
+
+    RSI& rsi() { return engine.getStrategies().all<RSI>()[0]; }
+};
+
+class StrategySnapshotTests : public ::testing::Test
+{
+    public:
+        Config config;
+        json baseConfig;
+        fs::path snapshot;
+        std::vector<MarketCondition> bars;
+
+        void SetUp() override
+        {
+            config.loadJson(config.getTestPath("strategy_tests/test_data/config_test.json"));
+            baseConfig = config.getJson();
+            snapshot = fs::temp_directory_path() / ("strategy_" + std::string(::testing::UnitTest::GetInstance()->current_test_info()->name()) + ".snapshot");
+            fs::remove(snapshot);
+
+            // Two sessions of minute bars
+            char dateTime[32];
+            for (int i = 0; i < 160; i++) {
+                int day = 2 + i / 80, minute = i % 80;
+                std::snprintf(dateTime, sizeof(dateTime), "2025-01-%02d %02d:%02d:00", day, 9 + (30 + minute) / 60, (30 + minute) % 60);
+                float close = 100.0f + 5.0f * std::sin(i / 6.0f) + 0.02f * i;
+                bars.push_back(MarketCondition(dateTime, "NVDA", close, close, 1000 + i, "1m"));
+            }
+        }
+
+        void TearDown() override
+        {
+            fs::remove(snapshot);
+        }
+
+        // Runs the first session and snapshots its end
+        void runFirstSession(SnapshotEngine& first)
+        {
+            for (int i = 0; i < 80; i++) first.step(bars[i]);
+            ASSERT_TRUE(first.engine.saveSnapshot(snapshot.string()));
+        }
+};
+
+TEST_F(StrategySnapshotTests, NothingToSaveBeforeAnyBar)
+{
+    SnapshotEngine cold(baseConfig);
+    EXPECT_FALSE(cold.engine.saveSnapshot(snapshot.string()));
+    EXPECT_FALSE(cold.engine.loadSnapshot(snapshot.string()));
+}
+
+TEST_F(StrategySnapshotTests, RestartCarriesOnFromTheNextSessionAlone)
+{
+    SnapshotEngine first(baseConfig);
+    runFirstSession(first);
+
+    // A restart that only sees the new day's file
+    SnapshotEngine restarted(baseConfig);
+    restarted.add(bars[80]);
+    ASSERT_TRUE(restarted.engine.loadSnapshot(snapshot.string()));
+    restarted.engine.run();
+    first.step(bars[80]);
+    EXPECT_FLOAT_EQ(restarted.rsi().getRSI(), first.rsi().getRSI());
+
+    for (int i = 81; i < 120; i++) {
+        first.step(bars[i]);
+        restarted.step(bars[i]);
+        EXPECT_FLOAT_EQ(restarted.rsi().getRSI(), first.rsi().getRSI()) << "bar " << i;
+    }
+}
+
+TEST_F(StrategySnapshotTests, RestartOverTheSameFileSkipsBarsAlreadySeen)
+{
+    SnapshotEngine first(baseConfig);
+    runFirstSession(first);
+
+    SnapshotEngine restarted(baseConfig);
+    for (int i = 0; i <= 80; i++) restarted.add(bars[i]);
+    ASSERT_TRUE(restarted.engine.loadSnapshot(snapshot.string()));
+    restarted.engine.run();
+    first.step(bars[80]);
+    EXPECT_FLOAT_EQ(restarted.rsi().getRSI(), first.rsi().getRSI());
+}
+
+TEST_F(StrategySnapshotTests, DifferentDataStartsCold)
+{
+    SnapshotEngine first(baseConfig);
+    runFirstSession(first);
+
+    // The snapshot's last bar with another close
+    MarketCondition revised = bars[79];
+    revised.Close += 1.0f;
+    SnapshotEngine restarted(baseConfig);
+    restarted.add(revised);
+    EXPECT_FALSE(restarted.engine.loadSnapshot(snapshot.string()));
+}
+
+TEST_F(StrategySnapshotTests, ChangedStrategyConfigStartsCold)
+{
+    SnapshotEngine first(baseConfig);
+    runFirstSession(first);
+
+    baseConfig["strategies"][0]["period"] = 7;
+    SnapshotEngine restarted(baseConfig);
+    restarted.add(bars[80]);
+    EXPECT_FALSE(restarted.engine.loadSnapshot(snapshot.string()));
+}
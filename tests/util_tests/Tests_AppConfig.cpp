@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include "../../src/util/Config.hpp"
+
+namespace fs = std::filesystem;
+
+class AppConfigTests : public ::testing::Test
+{
+    public:
+        Config config;
+        json baseConfig;
+        fs::path configFile;
+        fs::path cacheFile;
+
+        void SetUp() override
+        {
+            config.loadJson(config.getTestPath("strategy_tests/test_data/config_test.json"));
+            baseConfig = config.getJson();
+
+            std::string name = ::testing::UnitTest::GetInstance()->current_test_info()->name();
+            configFile = fs::temp_directory_path() / ("app_config_" + name + ".json");
+            cacheFile = fs::temp_directory_path() / ("app_config_" + name + ".bin");
+            fs::remove(cacheFile);
+        }
+
+        void TearDown() override
+        {
+            fs::remove(configFile);
+            fs::remove(cacheFile);
+        }
+
+        void writeConfig(const json& contents)
+        {
+            std::ofstream(configFile) << contents.dump(4);
+        }
+
+        // The message fromJson throws for contents
+        std::string errorFor(const json& contents)
+        {
+            try {
+                AppConfig::fromJson(contents);
+            } catch (const std::runtime_error& e) {
+                return e.what();
+            }
+            return "";
+        }
+};
+
+TEST_F(AppConfigTests, ParsesEverySection)
+{
+    AppConfig cut = AppConfig::fromJson(baseConfig);
+
+    EXPECT_EQ(cut.data.ticker, baseConfig["ticker"]);
+    EXPECT_EQ(cut.data.collectInterval, baseConfig["collectInterval"]);
+    EXPECT_EQ(cut.risk.maxPositionSize, baseConfig["max_position_size"].get<int>());
+    EXPECT_DOUBLE_EQ(cut.risk.maxExposure, baseConfig["max_exposure"].get<double>());
+    ASSERT_EQ(cut.strategies.size(), baseConfig["strategies"].size());
+    EXPECT_EQ(cut.strategies[0].name, "RSI");
+    EXPECT_EQ(cut.strategies[0].attributes.period, baseConfig["strategies"][0]["period"].get<int>());
+    EXPECT_FALSE(cut.broker.costModel.has_value());
+    EXPECT_FALSE(cut.live.strategySnapshotInterval.has_value());
+}
+
+TEST_F(AppConfigTests, CostModelSectionIsTyped)
+{
+    baseConfig["cost_model"] = {{"type", "tiered"}, {"min_commission", 0.5},
+                                {"tiers", {{{"up_to_shares", 1000}, {"per_share", 0.01}}}}};
+    AppConfig cut = AppConfig::fromJson(baseConfig);
+
+    ASSERT_TRUE(cut.broker.costModel.has_value());
+    EXPECT_EQ(cut.broker.costModel->type, "tiered");
+    EXPECT_DOUBLE_EQ(cut.broker.costModel->minCommission, 0.5);
+    EXPECT_DOUBLE_EQ(cut.broker.costModel->maxImpact, DEFAULT_MAX_IMPACT);
+    ASSERT_EQ(cut.broker.costModel->tiers.size(), 1);
+    EXPECT_DOUBLE_EQ(cut.broker.costModel->tiers[0].perShare, 0.01);
+}
+
+TEST_F(AppConfigTests, ErrorsNameTheKey)
+{
+    json missing = baseConfig;
+    missing.erase("max_exposure");
+    EXPECT_EQ(errorFor(missing), "Config: missing 'max_exposure'");
+
+    json wrongType = baseConfig;
+    wrongType["max_exposure"] = "5%";
+    EXPECT_EQ(errorFor(wrongType), "Config: 'max_exposure' should be a number, got \"5%\"");
+
+    json strategy = baseConfig;
+    strategy["strategies"][0].erase("active");
+    EXPECT_EQ(errorFor(strategy), "Config: missing 'strategies[0].active'");
+
+    json costModel = baseConfig;
+    costModel["cost_model"] = {{"tiers", {{{"up_to_shares", 100}}}}};
+    EXPECT_EQ(errorFor(costModel), "Config: missing 'cost_model.tiers[0].per_share'");
+
+    json source = baseConfig;
+    source["market_data_source"] = "ftp";
+    EXPECT_NE(errorFor(source).find("market_data_source"), std::string::npos);
+}
+
+TEST_F(AppConfigTests, NegativeValuesAreRejectedForUnsignedFields)
+{
+    json seed = baseConfig;
+    seed["random_seed"] = -1;
+    EXPECT_EQ(errorFor(seed), "Config: 'random_seed' should be a whole number, 0 or more, got -1");
+
+    json cacheSize = baseConfig;
+    cacheSize["result_cache_max_mb"] = -1.0;
+    EXPECT_EQ(errorFor(cacheSize), "Config: 'result_cache_max_mb' should be a whole number, 0 or more, got -1.0");
+
+    json zero = baseConfig;
+    zero["random_seed"] = 0;
+    EXPECT_EQ(AppConfig::fromJson(zero).backtest.randomSeed, 0u);
+}
+
+TEST_F(AppConfigTests, BinaryRoundTripKeepsEveryField)
+{
+    baseConfig["cost_model"] = {{"type", "flat"}, {"commission", 2.0}};
+    baseConfig["bar_notify_port"] = 47001;
+    baseConfig["random_seed"] = 7;
+    AppConfig original = AppConfig::fromJson(baseConfig);
+
+    std::stringstream encoded;
+    original.saveState(encoded);
+    AppConfig restored;
+    restored.loadState(encoded);
+
+    EXPECT_TRUE(encoded.good());
+    EXPECT_EQ(restored.hash(), original.hash());
+    EXPECT_EQ(restored.data.barNotifyPort, 47001);
+    EXPECT_EQ(restored.backtest.randomSeed, 7u);
+    EXPECT_DOUBLE_EQ(restored.broker.costModel->commission, 2.0);
+}
+
+TEST_F(AppConfigTests, CachedLoadMatchesParsedLoad)
+{
+    writeConfig(baseConfig);
+    AppConfig parsed = AppConfig::load(configFile.string(), cacheFile.string());
+    ASSERT_TRUE(fs::exists(cacheFile));
+
+    AppConfig cached = AppConfig::load(configFile.string(), cacheFile.string());
+    EXPECT_EQ(cached.hash(), parsed.hash());
+    EXPECT_EQ(cached.hash(), AppConfig::fromJson(baseConfig).hash());
+}
+
+TEST_F(AppConfigTests, EditedConfigIsParsedAgain)
+{
+    writeConfig(baseConfig);
+    AppConfig::load(configFile.string(), cacheFile.string());
+
+    baseConfig["ticker"] = "AAPL";
+    writeConfig(baseConfig);
+    EXPECT_EQ(AppConfig::load(configFile.string(), cacheFile.string()).data.ticker, "AAPL");
+}
+
+TEST_F(AppConfigTests, DamagedCacheFallsBackToParsing)
+{
+    writeConfig(baseConfig);
+    AppConfig::load(configFile.string(), cacheFile.string());
+    fs::resize_file(cacheFile, fs::file_size(cacheFile) / 2);
+
+    AppConfig loaded = AppConfig::load(configFile.string(), cacheFile.string());
+    EXPECT_EQ(loaded.hash(), AppConfig::fromJson(baseConfig).hash());
+}
@@ -0,0 +1,43 @@
+#include <gtest/gtest.h>
+#include "../../src/util/ContentHash.hpp"
+
+TEST(ContentHashTests, MatchesFnv1a128Vectors)
+{
+    ContentHash empty;
+    EXPECT_EQ(empty.hex(), "6c62272e07bb014262b821756295c58d");
+
+    ContentHash a;
+    a.update("a", 1);
+    EXPECT_EQ(a.hex(), "d228cb696f1a8caf78912b704e4a8964");
+}
+
+TEST(ContentHashTests, StringsAreLengthPrefixed)
+{
+    ContentHash first;
+    first.update(std::string("ab"));
+    first.update(std::string("c"));
+
+    ContentHash second;
+    second.update(std::string("a"));
+    second.update(std::string("bc"));
+
+    EXPECT_NE(first.hex(), second.hex());
+}
+
+TEST(ContentHashTests, SameInputSameHash)
+{
+    ContentHash first;
+    first.update(100000.0);
+    first.update(42u);
+    first.update(std::string("RSI"));
+
+    ContentHash second;
+    second.update(100000.0);
+    second.update(42u);
+    second.update(std::string("RSI"));
+
+    EXPECT_EQ(first.hex(), second.hex());
+
+    second.update(1.0f);
+    EXPECT_NE(first.hex(), second.hex());
+}
@@ -120,3 +120,11 @@ TEST(DateTimeConversion, HandlesFarPastDate_Year1900)
 
     EXPECT_EQ("1900-01-01", cut.timeNowToDate());
 }
+
+TEST(DateTimeConversion, ParsesDateTimeStringToEpoch)
+{
+    EXPECT_EQ(1735732800, DateTimeConversion::toEpoch("2025-01-01 12:00:00"));
+    EXPECT_EQ(1735732800, DateTimeConversion::toEpoch("2025-01-01T12:00:00"));
+    EXPECT_EQ(1735689600, DateTimeConversion::toEpoch("2025-01-01"));
+    EXPECT_EQ(-1, DateTimeConversion::toEpoch("not a date"));
+}
@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <csignal>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <unistd.h>
+#include "../../src/util/EventLoop.hpp"
+
+namespace fs = std::filesystem;
+
+TEST(EventLoopTests, TimerFiresRepeatedly)
+{
+    EventLoop loop;
+    int fired = 0;
+    loop.addTimer(std::chrono::milliseconds(5), [&fired]() { fired++; }, false);
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (fired < 3 && std::chrono::steady_clock::now() < deadline) {
+        loop.runOnce(100);
+    }
+    EXPECT_GE(fired, 3);
+}
+
+TEST(EventLoopTests, AlignedTimerFiresOnTheBoundary)
+{
+    EventLoop loop;
+    std::chrono::system_clock::time_point firedAt;
+    loop.addTimer(std::chrono::milliseconds(50), [&firedAt]() { firedAt = std::chrono::system_clock::now(); });
+
+    ASSERT_EQ(loop.runOnce(1000), 1);
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(firedAt.time_since_epoch()).count();
+    EXPECT_LT(ms % 50, 20);
+}
+
+TEST(EventLoopTests, FileWatchFiresOnAppendToMatchingFile)
+{
+    fs::path directory = fs::temp_directory_path() / "event_loop_watch";
+    fs::remove_all(directory);
+    fs::create_directories(directory);
+
+    EventLoop loop;
+    int fired = 0;
+    loop.addFileWatch(directory.string(), "marketData_", [&fired]() { fired++; });
+
+    std::ofstream(directory / "other.csv") << "ignored\n";
+    EXPECT_EQ(loop.runOnce(50), 0);
+
+    std::ofstream(directory / "marketData_NVDA.csv", std::ios::app) << "2025-01-02 09:30:00,NVDA,1,1,1,1m\n";
+    EXPECT_EQ(loop.runOnce(1000), 1);
+    EXPECT_EQ(fired, 1);
+
+    fs::remove_all(directory);
+}
+
+TEST(EventLoopTests, ReaderFiresWhenDescriptorIsReadable)
+{
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+
+    EventLoop loop;
+    char received = 0;
+    loop.addReader(fds[0], [&]() { ASSERT_EQ(read(fds[0], &received, 1), 1); });
+
+    ASSERT_EQ(write(fds[1], "x", 1), 1);
+    EXPECT_EQ(loop.runOnce(1000), 1);
+    EXPECT_EQ(received, 'x');
+
+    close(fds[0]);
+    close(fds[1]);
+}
+
+TEST(EventLoopTests, SignalIsDeliveredAsAnEvent)
+{
+    EventLoop loop;
+    bool signalled = false;
+    loop.addSignal(SIGUSR1, [&]() { signalled = true; loop.stop(); });
+
+    kill(getpid(), SIGUSR1);
+    loop.run();
+    EXPECT_TRUE(signalled);
+}
+
+TEST(EventLoopTests, StopFromAnotherThreadEndsRun)
+{
+    EventLoop loop;
+    std::thread stopper([&loop]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        loop.stop();
+    });
+    loop.run();
+    stopper.join();
+    EXPECT_TRUE(loop.isStopped());
+}
+
+TEST(EventLoopTests, ParsesBarIntervals)
+{
+    EXPECT_EQ(intervalToSeconds("30s"), 30);
+    EXPECT_EQ(intervalToSeconds("1m"), 60);
+    EXPECT_EQ(intervalToSeconds("15m"), 900);
+    EXPECT_EQ(intervalToSeconds("1h"), 3600);
+    EXPECT_EQ(intervalToSeconds("1d"), 86400);
+    EXPECT_THROW(intervalToSeconds("m"), std::runtime_error);
+    EXPECT_THROW(intervalToSeconds("5w"), std::runtime_error);
+}
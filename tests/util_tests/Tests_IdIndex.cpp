@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <unordered_map>
+#include "../../src/util/IdIndex.hpp"
+
+TEST(IdIndex, FindsInsertedIds)
+{
+    IdIndex cut;
+    cut.insert(7, 0);
+    cut.insert(42, 1);
+
+    EXPECT_EQ(cut.find(7), 0u);
+    EXPECT_EQ(cut.find(42), 1u);
+    EXPECT_EQ(cut.find(8), IdIndex::NOT_FOUND);
+    EXPECT_EQ(cut.size(), 2u);
+}
+
+TEST(IdIndex, InsertRepointsExistingId)
+{
+    IdIndex cut;
+    cut.insert(7, 0);
+    cut.insert(7, 5);
+
+    EXPECT_EQ(cut.find(7), 5u);
+    EXPECT_EQ(cut.size(), 1u);
+}
+
+TEST(IdIndex, MatchesReferenceMapUnderChurn)
+{
+    // Small table, lots of collisions, inserts and erases interleaved
+    IdIndex cut(4);
+    std::unordered_map<int, uint32_t> reference;
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<int> ids(1, 2000);
+
+    for (uint32_t i = 0; i < 50000; i++) {
+        int id = ids(gen);
+        if (gen() % 3 == 0) {
+            EXPECT_EQ(cut.erase(id), reference.erase(id) == 1);
+        } else {
+            cut.insert(id, i);
+            reference[id] = i;
+        }
+    }
+
+    EXPECT_EQ(cut.size(), reference.size());
+    for (int id = 1; id <= 2000; id++) {
+        auto it = reference.find(id);
+        EXPECT_EQ(cut.find(id), it == reference.end() ? IdIndex::NOT_FOUND : it->second);
+    }
+}
@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include "../../src/util/Logger.hpp"
+
+class LoggerTests : public ::testing::Test
+{
+    protected:
+        std::ostringstream output;
+        LogLevel previousLevel;
+
+        void SetUp() override
+        {
+            previousLevel = Logger::getLevel();
+            Logger::get().setOutput(output);
+        }
+
+        void TearDown() override
+        {
+            Logger::get().setOutput(std::cout);
+            Logger::setLevel(previousLevel);
+        }
+
+        std::vector<std::string> lines()
+        {
+            Logger::get().flush();
+            std::vector<std::string> result;
+            std::istringstream stream(output.str());
+            std::string line;
+            while (std::getline(stream, line)) {
+                result.push_back(line);
+            }
+            return result;
+        }
+};
+
+TEST_F(LoggerTests, FormatsArgumentsOnTheWriterSide)
+{
+    Logger::setLevel(LogLevel::DEBUG);
+    std::string ticker = "AAPL";
+    LOG_INFO("Filled {} {} at ${:.2f} ({})", 10, ticker, 123.456, true);
+
+    std::vector<std::string> written = lines();
+    ASSERT_EQ(written.size(), 1);
+    EXPECT_NE(written[0].find("INFO"), std::string::npos);
+    EXPECT_NE(written[0].find("Filled 10 AAPL at $123.46 (true)"), std::string::npos);
+}
+
+TEST_F(LoggerTests, SkipsRecordsBelowTheLevel)
+{
+    Logger::setLevel(LogLevel::WARN);
+    LOG_DEBUG("debug {}", 1);
+    LOG_INFO("info {}", 2);
+    LOG_WARN("warn {}", 3);
+
+    std::vector<std::string> written = lines();
+    ASSERT_EQ(written.size(), 1);
+    EXPECT_NE(written[0].find("warn 3"), std::string::npos);
+}
+
+TEST_F(LoggerTests, TruncatesLongStringsAndKeepsUnmatchedBraces)
+{
+    LogRecord record{};
+    record.format = "{} {:x} {}";
+    record.argCount = 1;
+    record.args[0].type = LogArg::Type::STRING;
+    std::string longText(40, 'a');
+    std::snprintf(record.args[0].s, sizeof(record.args[0].s), "%s", longText.c_str());
+
+    EXPECT_EQ(Logger::format(record), std::string(LOG_STRING_ARG_SIZE - 1, 'a') + " {:x} {}");
+}
+
+TEST_F(LoggerTests, CollectsRecordsFromManyThreads)
+{
+    Logger::setLevel(LogLevel::INFO);
+    const int threads = 4;
+    const int perThread = 200;
+    uint64_t droppedBefore = Logger::get().getDroppedCount();
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([t]() {
+            for (int i = 0; i < perThread; i++) {
+                LOG_INFO("thread {} record {}", t, i);
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    size_t written = 0;
+    for (const std::string& line : lines()) {
+        written += line.find(" record ") != std::string::npos;
+    }
+    uint64_t dropped = Logger::get().getDroppedCount() - droppedBefore;
+    EXPECT_EQ(written + dropped, static_cast<size_t>(threads * perThread));
+}
+
+TEST_F(LoggerTests, ReportsDroppedRecords)
+{
+    Logger::setLevel(LogLevel::INFO);
+    uint64_t droppedBefore = Logger::get().getDroppedCount();
+
+    // Outrun the writer until the thread's queue overflows
+    for (int i = 0; i < 10000000 && Logger::get().getDroppedCount() == droppedBefore; i++) {
+        LOG_INFO("record {}", i);
+    }
+    ASSERT_GT(Logger::get().getDroppedCount(), droppedBefore);
+
+    std::vector<std::string> written = lines();
+    uint64_t reported = 0;
+    for (const std::string& line : written) {
+        if (line.find("log records dropped") != std::string::npos) {
+            EXPECT_NE(line.find("WARN"), std::string::npos);
+            reported += std::stoull(line.substr(line.find("WARN") + 6));
+        }
+    }
+    EXPECT_EQ(reported, Logger::get().getDroppedCount() - droppedBefore);
+}
+
+TEST_F(LoggerTests, ParsesLevelNames)
+{
+    EXPECT_EQ(stringToLogLevel("debug"), LogLevel::DEBUG);
+    EXPECT_EQ(stringToLogLevel("WARN"), LogLevel::WARN);
+    EXPECT_THROW(stringToLogLevel("verbose"), std::runtime_error);
+}
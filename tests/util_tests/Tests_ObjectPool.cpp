@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+#include "../../src/util/ObjectPool.hpp"
+#include <cstring>
+
+struct Slot
+{
+    char name[16];
+    double value;
+};
+
+TEST(ObjectPool, HandsOutAndReusesSlots)
+{
+    ObjectPool<int> cut;
+    ObjectPool<int>::Handle first = cut.acquire(7);
+    ObjectPool<int>::Handle second = cut.acquire(42);
+
+    EXPECT_EQ(cut[first], 7);
+    EXPECT_EQ(cut[second], 42);
+    EXPECT_EQ(cut.size(), 2u);
+
+    cut.release(first);
+    EXPECT_EQ(cut.acquire(9), first);
+    EXPECT_EQ(cut.size(), 2u);
+}
+
+TEST(ObjectPool, ReferencesSurviveGrowth)
+{
+    ObjectPool<Slot> cut;
+    ObjectPool<Slot>::Handle handle = cut.acquire(Slot{"AAPL", 109.0});
+    Slot& slot = cut[handle];
+
+    for (int i = 0; i < 5000; i++) {
+        cut.acquire(Slot{"MSFT", 250.0});
+    }
+
+    EXPECT_EQ(&slot, &cut[handle]);
+    EXPECT_STREQ(slot.name, "AAPL");
+    EXPECT_GE(cut.getCapacity(), 5001u);
+}
+
+TEST(ObjectPool, ClearKeepsCapacity)
+{
+    ObjectPool<int> cut(1000);
+    size_t capacity = cut.getCapacity();
+    for (int i = 0; i < 1000; i++) {
+        cut.acquire(i);
+    }
+
+    cut.clear();
+
+    EXPECT_EQ(cut.size(), 0u);
+    EXPECT_EQ(cut.getCapacity(), capacity);
+    EXPECT_EQ(cut.acquire(1), 0u);
+}
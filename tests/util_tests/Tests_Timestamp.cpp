@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include <ctime>
+#include "../../src/util/Timestamp.hpp"
+
+TEST(TimestampTests, ParsesFixedLayout)
+{
+    EXPECT_EQ(Timestamp::parse("2025-01-01 12:00:00").seconds(), 1735732800);
+    EXPECT_EQ(Timestamp::parse("2025-01-01T12:00:00").seconds(), 1735732800);
+    EXPECT_EQ(Timestamp::parse("2025-01-01").seconds(), 1735689600);
+    EXPECT_EQ(Timestamp::parse("1970-01-01 00:00:01").nanos(), 1000000000);
+}
+
+TEST(TimestampTests, MatchesTimegm)
+{
+    // A day in each month across a leap year and the turn of a century
+    for (int year : {1999, 2000, 2024, 2025}) {
+        for (int month = 1; month <= 12; month++) {
+            std::tm date{};
+            date.tm_year = year - 1900;
+            date.tm_mon = month - 1;
+            date.tm_mday = month == 2 ? 29 - (year % 4 != 0) : 31 - (month == 4 || month == 6 || month == 9 || month == 11);
+            date.tm_hour = 23;
+            date.tm_min = 59;
+            date.tm_sec = 58;
+            char text[32];
+            std::strftime(text, sizeof(text), "%Y-%m-%d %H:%M:%S", &date);
+
+            EXPECT_EQ(Timestamp::parse(text).seconds(), timegm(&date)) << text;
+        }
+    }
+}
+
+TEST(TimestampTests, FormatRoundTrips)
+{
+    for (const char* text : {"2025-03-31 09:30:00", "2024-02-29 23:59:59", "1969-12-31 00:00:00"}) {
+        EXPECT_EQ(Timestamp::parse(text).format(), text);
+    }
+    EXPECT_EQ(Timestamp::parse("2025-03-31 09:30:00").formatDate(), "2025-03-31");
+    EXPECT_EQ(Timestamp().format(), "");
+}
+
+TEST(TimestampTests, UnpaddedFieldsStillParse)
+{
+    EXPECT_EQ(Timestamp::parse("2025-3-1 9:30:00"), Timestamp::parse("2025-03-01 09:30:00"));
+    EXPECT_EQ(Timestamp::parse("2025-01-1"), Timestamp::parse("2025-01-01"));
+}
+
+TEST(TimestampTests, OutOfRangeFieldsCarryOverLikeTimegm)
+{
+    EXPECT_EQ(Timestamp::parse("2025-03-32 10:00:00"), Timestamp::parse("2025-04-01 10:00:00"));
+    EXPECT_EQ(Timestamp::parse("2025-13-01"), Timestamp::parse("2026-01-01"));
+    EXPECT_EQ(Timestamp::parse("2025-01-01 24:00:00"), Timestamp::parse("2025-01-02"));
+
+    std::tm date{};
+    date.tm_year = 2025 - 1900;
+    date.tm_mon = 1;
+    date.tm_mday = 30;
+    EXPECT_EQ(Timestamp::parse("2025-02-30").seconds(), timegm(&date));
+}
+
+TEST(TimestampTests, RejectsOtherText)
+{
+    for (const char* text : {"", "not a date", "2025/01/01 00:00:00", "2025-01-01 00:00:00Z",
+                             "2025-01-01 0a:00:00", "2025-01-01 10:00"}) {
+        EXPECT_FALSE(Timestamp::parse(text).isValid()) << text;
+    }
+}
+
+TEST(TimestampTests, OrdersByTime)
+{
+    Timestamp invalid;
+    Timestamp early = Timestamp::parse("2025-01-01 09:59:59");
+    Timestamp late = Timestamp::parse("2025-01-01 10:00:00");
+
+    EXPECT_LT(early, late);
+    EXPECT_LT(invalid, early);
+    EXPECT_EQ(late.startOfDay(), Timestamp::parse("2025-01-01"));
+    EXPECT_EQ(late.startOfDay().plusDays(1), Timestamp::parse("2025-01-02"));
+    EXPECT_FALSE(invalid.plusDays(1).isValid());
+}